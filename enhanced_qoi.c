@@ -15,11 +15,6 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// rgbص(ṹ嶨)
-typedef struct {
-	unsigned char r, g, b;
-} qoi_rgb_t;
-
 // alpha(ṹ嶨)
 typedef struct {
 	unsigned char a1, a2, a3, a4;
@@ -29,7 +24,6 @@ typedef struct {
 
 // QOIв
 #define MAX_RUN 31 // RGBγ̳(<=31)
-#define INDEX_TB_L 32 // (<=32)
 #define QOI_COLOR_HASH(C) (C.r + C.g + C.b) // RGBϣ
 
 // RGBģʽ־
@@ -45,24 +39,44 @@ typedef struct {
 #define QOI_MASK_2    0xc0 /* 11000000 */
 #define QOI_MASK_3    0xe0 /* 11100000 */
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-_Bool init_predict_iter(int w, qoi_rgb_t* predict); // ʼԤ
-void get_next_predict_v(qoi_rgb_t* rgb, qoi_rgb_t* predict, int* predict_err); // ȡһԤֵ
-void clear_predict_iter(void); // Ԥ
+// ͵غ(ʱʽ״̬)
+#define OP_KIND_RUN 0 // γ(õǰ)
+#define OP_KIND_INDEX 1 // λ
+#define OP_KIND_RESID 2 // Ԥ(DIFF/DIFF3/LUMA/DIFF2)
+#define OP_KIND_PIXEL 3 // ֵ(RGB)
+
+// ׮(δEQOI_STATSʱչΪ, κο)
+#ifdef EQOI_STATS
+#define STATS_OP(id, len, n) if (stats != NULL) { stats->ops.ops[id]++; stats->ops.bytes[id] += len; stats->ops.pixels[id] += n; }
+#define STATS_PIXEL_BEGIN() size_t stats_p0 = p
+#define STATS_PIXEL_END(x, y) if (stats != NULL) { stats_pixel(stats, x, y, p - stats_p0, px, predict_pixel(prow, prev_row, px_pos, seed)); }
+#else
+#define STATS_OP(id, len, n)
+#define STATS_PIXEL_BEGIN()
+#define STATS_PIXEL_END(x, y)
+#endif
+
+// ֽ׶μʱ(δEQOI_PROFILEʱչΪ), ÿʱ㽫һʱĺʱָ׶
+#ifdef EQOI_PROFILE
+#define PROF_BEGIN(ctx) qoi_prof_t* prof = (ctx)->prof; uint64_t prof_t = qoi_prof_ticks()
+#define PROF_MARK(stage) if (prof != NULL) { uint64_t prof_now = qoi_prof_ticks(); prof->ticks[stage] += prof_now - prof_t; prof->marks[stage]++; prof_t = prof_now; }
+#else
+#define PROF_BEGIN(ctx)
+#define PROF_MARK(stage)
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-qoi_rgb_t index_tb[INDEX_TB_L]; // 
-qoi_rgb_t px; // ǰ
-qoi_rgb_t px_prev; // һ
-
-// Ԥ
-qoi_rgb_t rgb_pre; // һ
-qoi_rgb_t* rgb_pre_line; // һе(׵ַ)
-int predict_w; // ԤͼƬĿ
-_Bool predict_decode_first_line; // λڵһ(־)
-int predict_column_i; // ǰб
+static inline qoi_rgb_t predict_pixel(const unsigned char* prow, const unsigned char* prev_row, size_t px_pos, qoi_rgb_t seed); // صԤֵ
+static inline unsigned char med_predict(unsigned char a, unsigned char b, unsigned char c); // ͨMEDԤ
+static inline qoi_rgb_t pred_feedback(const unsigned char* ppred, const unsigned char* prev); // һصԤԤֵ
+static inline size_t write_resid(qoi_rgb_t px, qoi_rgb_t predict, unsigned char* pCompressed); // Ԥ(RGB)
+static inline size_t op_len(unsigned char b1); // ֽڻȡ͵ĳ
+static inline uint64_t op_pixels(unsigned char b1); // ֽڻȡ͸ǵ
+static inline int read_op(const unsigned char* pencoded, size_t* pp, qoi_rgb_t* v); // ȡһ
+#ifdef EQOI_STATS
+static void stats_pixel(qoi_enc_stats_t* stats, uint32_t x, uint32_t y, size_t bytes, qoi_rgb_t px, qoi_rgb_t predict); // ¼صĲ׮ͳ
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -76,124 +90,335 @@ int predict_column_i; // 
 		img_h ͼ߶
 @return ѹֽ
 *************************/
-int enhanced_qoi_encode(unsigned char* prgb, unsigned char* pCompressed, int img_w, int img_h) {
-	memset(index_tb, 0, INDEX_TB_L * sizeof(qoi_rgb_t));
-	px_prev = (qoi_rgb_t){ 0, 0, 0 };
+#ifndef EQOI_NO_MALLOC
+size_t enhanced_qoi_encode(unsigned char* prgb, unsigned char* pCompressed, uint32_t img_w, uint32_t img_h) {
+	return enhanced_qoi_encode_rect(prgb, (size_t)img_w * 3, pCompressed, img_w, img_h);
+}
 
-	int p = 0;
-	int run = 0;
-	int img_len = img_w * img_h * 3;
-	int px_end = img_len - 4;
+/*************************
+@encode
+@public
+@brief  ͼеľ(ֿ)QOI
+@param  prgb Ͻǵ(ָ)
+		stride ݵп(ֽ)
+		pCompressed ѹݻ(ָ)
+		img_w 
+		img_h ߶
+@return ѹֽ
+*************************/
+size_t enhanced_qoi_encode_rect(unsigned char* prgb, size_t stride, unsigned char* pCompressed, uint32_t img_w, uint32_t img_h) {
+	qoi_encoder_t enc;
 
-	int predict_err[3] = { 0, 0, 0 };
-	qoi_rgb_t pix_predict;
+	if (!enhanced_qoi_encoder_init(&enc, img_w, img_h)) {
+		return 0;
+	}
 
-	init_predict_iter(img_w, &pix_predict);
+	size_t p = enhanced_qoi_encode_rows(&enc, prgb, stride, img_h, pCompressed);
 
-	for (int px_pos = 0; px_pos < img_len; px_pos += 3) {
-		px = (qoi_rgb_t){ prgb[px_pos + 2], prgb[px_pos + 1], prgb[px_pos] };
+	enhanced_qoi_encoder_free(&enc);
 
-		// Ԥ
-		predict_err[0] = px.r - pix_predict.r;
-		predict_err[1] = px.g - pix_predict.g;
-		predict_err[2] = px.b - pix_predict.b;
+	return p;
+}
+#endif
 
-		if (!memcmp(&px, &px_prev, sizeof(qoi_rgb_t))) {
-			run++;
-			if (run == MAX_RUN || px_pos == px_end) {
-				// 3'b111 RUN[4:0]-1
-				pCompressed[p++] = QOI_OP_RUN | (run - 1);
-				run = 0;
-			}
-		}
-		else {
-			unsigned char index_pos = QOI_COLOR_HASH(px) % INDEX_TB_L;
+/*************************
+@encode
+@public
+@brief  ʹõṩݴͼеľ(ֿ)QOI(ڴ)
+@param  prgb Ͻǵ(ָ)
+		stride ݵп(ֽ)
+		pCompressed ѹݻ(ָ)
+		img_w 
+		img_h ߶
+		scratch ݴ(ָ, Сeqoi_scratch_size(img_w)ֽ)
+@return ѹֽ(ݴΪNULLʱ0)
+*************************/
+size_t enhanced_qoi_encode_rect_scratch(unsigned char* prgb, size_t stride, unsigned char* pCompressed, uint32_t img_w, uint32_t img_h,
+	void* scratch) {
+	qoi_encoder_t enc;
 
-			if (run) {
-				// 3'b111 RUN[4:0]-1
-				pCompressed[p++] = QOI_OP_RUN | (run - 1);
-				run = 0;
-			}
+	if (!enhanced_qoi_encoder_init_scratch(&enc, img_w, img_h, scratch)) {
+		return 0;
+	}
+
+	size_t p = enhanced_qoi_encode_rows(&enc, prgb, stride, img_h, pCompressed);
+
+	enhanced_qoi_encoder_free(&enc);
+
+	return p;
+}
+
+/*************************
+@calc
+@public
+@brief  ȡݴС(ֱӶȡ뻺еһ, ݴ)
+@param  img_w ͼ
+@return ݴС(ֽ)
+*************************/
+size_t eqoi_scratch_size(uint32_t img_w) {
+	return sizeof(qoi_rgb_t) * (size_t)img_w;
+}
+
+/*************************
+@init
+@public
+@brief  ʼ(еʽ)
+@param  enc (ָ)
+		img_w ͼ
+		img_h ͼ߶
+@return Ƿɹ
+*************************/
+#ifndef EQOI_NO_MALLOC
+_Bool enhanced_qoi_encoder_init(qoi_encoder_t* enc, uint32_t img_w, uint32_t img_h) {
+	return enhanced_qoi_encoder_init_scratch(enc, img_w, img_h, NULL);
+}
+#endif
 
-			if (!memcmp(index_tb + index_pos, &px, sizeof(qoi_rgb_t))) {
-				// 3'b000 index[4:0]
-				pCompressed[p++] = QOI_OP_INDEX | index_pos;
+/*************************
+@init
+@public
+@brief  ʹõṩݴʼ(ݴڱǰ뱣Ч, ʱͷ)
+@param  enc (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		scratch ݴ(ָ, Сeqoi_scratch_size(img_w)ֽ; ΪNULLʱз, EQOI_NO_MALLOCʱʧ)
+@return Ƿɹ
+*************************/
+_Bool enhanced_qoi_encoder_init_scratch(qoi_encoder_t* enc, uint32_t img_w, uint32_t img_h, void* scratch) {
+	memset(enc->index_tb, 0, INDEX_TB_L * sizeof(qoi_rgb_t));
+	enc->px_prev = (qoi_rgb_t){ 0, 0, 0 };
+	enc->seed = (qoi_rgb_t){ 0, 0, 0 };
+	enc->prev_row = NULL;
+	enc->line_owned = (scratch == NULL);
+#ifdef EQOI_NO_MALLOC
+	enc->line = scratch;
+#else
+	enc->line = scratch != NULL ? scratch : malloc(eqoi_scratch_size(img_w));
+#endif
+	enc->img_w = img_w;
+	enc->img_h = img_h;
+	enc->row = 0;
+	enc->run = 0;
+#ifdef EQOI_STATS
+	enc->stats = NULL;
+#endif
+#ifdef EQOI_PROFILE
+	enc->prof = NULL;
+#endif
+
+	return enc->line != NULL;
+}
+
+/*************************
+@init
+@public
+@brief  ֵñĳʼ״̬(ڳʼ֮󡢱һ֮ǰ, ʱʹͬһֵ)
+@param  enc (ָ)
+		dict ֵ(ָ)
+@return none
+*************************/
+void enhanced_qoi_encoder_set_dict(qoi_encoder_t* enc, const qoi_dict_t* dict) {
+	memcpy(enc->index_tb, dict->index_tb, INDEX_TB_L * sizeof(qoi_rgb_t));
+	enc->px_prev = dict->px;
+	enc->seed = dict->px;
+}
+
+/*************************
+@delete
+@public
+@brief  ٱ
+@param  enc (ָ)
+@return none
+*************************/
+void enhanced_qoi_encoder_free(qoi_encoder_t* enc) {
+#ifndef EQOI_NO_MALLOC
+	if (enc->line_owned) {
+		free(enc->line);
+	}
+#endif
+	enc->line = NULL;
+	enc->prev_row = NULL;
+}
+
+/*************************
+@encode
+@public
+@brief  (뵽һʱδγ)
+@param  enc (ָ)
+		prgb е(ָ)
+		stride ݵп(ֽ)
+		rows 
+		pCompressed ѹݻ(ָ, дrows*img_w*4ֽ)
+@return ֽ
+*************************/
+size_t enhanced_qoi_encode_rows(qoi_encoder_t* enc, unsigned char* prgb, size_t stride, uint32_t rows, unsigned char* pCompressed) {
+	qoi_rgb_t* index_tb = enc->index_tb;
+	qoi_rgb_t px;
+	qoi_rgb_t px_prev = enc->px_prev;
+	qoi_rgb_t seed = enc->seed;
+	const unsigned char* prev_row = enc->prev_row;
+
+	size_t p = 0;
+	int run = enc->run;
+	size_t row_len = (size_t)enc->img_w * 3;
+	size_t px_end = row_len - 3; // һеһ(ڴδγ)
+
+#ifdef EQOI_STATS
+	qoi_enc_stats_t* stats = enc->stats;
+#endif
+	PROF_BEGIN(enc);
+
+	for (uint32_t y = 0; y < rows; y++) {
+		unsigned char* prow = prgb + (size_t)y * stride;
+		_Bool last_row = (enc->row + y == enc->img_h - 1);
+
+		for (size_t px_pos = 0; px_pos < row_len; px_pos += 3) {
+			STATS_PIXEL_BEGIN();
+
+			px = (qoi_rgb_t){ prow[px_pos + 2], prow[px_pos + 1], prow[px_pos] };
+
+			if (!memcmp(&px, &px_prev, sizeof(qoi_rgb_t))) {
+				PROF_MARK(QOI_STAGE_CLASSIFY);
+				run++;
+				if (run == MAX_RUN || (last_row && px_pos == px_end)) {
+					// 3'b111 RUN[4:0]-1
+					pCompressed[p++] = QOI_OP_RUN | (run - 1);
+					STATS_OP(QOI_ID_RUN, 1, run);
+					run = 0;
+				}
 			}
 			else {
-				unsigned char vr = px.r - pix_predict.r;
-				unsigned char vg = px.g - pix_predict.g;
-				unsigned char vb = px.b - pix_predict.b;
-
-				unsigned char vg_r = vr - vg;
-				unsigned char vg_b = vb - vg;
-
-				if (((vr & 0xfe) == 0xfe || (vr & 0xfe) == 0x00) &&
-					((vg & 0xfe) == 0xfe || (vg & 0xfe) == 0x00) &&
-					((vb & 0xfe) == 0xfe || (vb & 0xfe) == 0x00)) {
-					vr &= 0x03;
-					vg &= 0x03;
-					vb &= 0x03;
-
-					// 2'b01 vr[1:0] vg[1:0] vb[1:0]
-					pCompressed[p++] = QOI_OP_DIFF | (vr << 4) | (vg << 2) | vb;
-				}
-				else if (((vr & 0xf8) == 0xf8 || (vr & 0xf8) == 0x00) &&
-					((vg & 0xf0) == 0xf0 || (vg & 0xf0) == 0x00) &&
-					((vb & 0xf8) == 0xf8 || (vb & 0xf8) == 0x00)) {
-					vr &= 0x0f;
-					vg &= 0x1f;
-					vb &= 0x0f;
-
-					// 3'b001 vg[4:0]
-					pCompressed[p++] = QOI_OP_DIFF3 | vg;
-					// vr[3:0] vb[3:0]
-					pCompressed[p++] = (vr << 4) | vb;
-				}
-				else if (((vg_r & 0xf8) == 0xf8 || (vg_r & 0xf8) == 0x00) &&
-					((vg_b & 0xf8) == 0xf8 || (vg_b & 0xf8) == 0x00) &&
-					((vg & 0xe0) == 0xe0 || (vg & 0xe0) == 0x00)) {
-					vg_r &= 0x0f;
-					vg_b &= 0x0f;
-					vg &= 0x3f;
-
-					// 2'b10 vg[5:0]
-					pCompressed[p++] = QOI_OP_LUMA | vg;
-					// vg_r[3:0] vg_b[3:0]
-					pCompressed[p++] = (vg_r << 4) | vg_b;
+				unsigned char index_pos = QOI_COLOR_HASH(px) % INDEX_TB_L;
+
+				PROF_MARK(QOI_STAGE_CLASSIFY);
+
+				if (run) {
+					// 3'b111 RUN[4:0]-1
+					pCompressed[p++] = QOI_OP_RUN | (run - 1);
+					STATS_OP(QOI_ID_RUN, 1, run);
+					run = 0;
+
+					PROF_MARK(QOI_STAGE_EMIT);
 				}
-				else if (((vr & 0xc0) == 0xc0 || (vr & 0xc0) == 0x00) &&
-					((vg & 0xc0) == 0xc0 || (vg & 0xc0) == 0x00) &&
-					((vb & 0xc0) == 0xc0 || (vb & 0xc0) == 0x00)) {
-					vr &= 0x7f;
-					vg &= 0x7f;
-					vb &= 0x7f;
-
-					// 3'b110 vr[4:0]
-					pCompressed[p++] = QOI_OP_DIFF2 | (vr & 0x1f);
-					// vg[5:0] vr[6:5]
-					pCompressed[p++] = (vr >> 5) | ((vg & 0x3f) << 2);
-					// vb[6:0] vg[6]
-					pCompressed[p++] = ((vg & 0x40) >> 6) | (vb << 1);
+
+				_Bool index_hit = !memcmp(index_tb + index_pos, &px, sizeof(qoi_rgb_t));
+
+				PROF_MARK(QOI_STAGE_PROBE);
+
+				if (index_hit) {
+					// 3'b000 index[4:0]
+					pCompressed[p++] = QOI_OP_INDEX | index_pos;
+					STATS_OP(QOI_ID_INDEX, 1, 1);
 				}
 				else {
-					// 8'hff
-					pCompressed[p++] = QOI_OP_RGB;
-					// r[7:0]
-					pCompressed[p++] = px.r;
-					// g[7:0]
-					pCompressed[p++] = px.g;
-					// b[7:0]
-					pCompressed[p++] = px.b;
+					// δγ/ؼԤֵ
+					qoi_rgb_t pix_predict = predict_pixel(prow, prev_row, px_pos, seed);
+
+					PROF_MARK(QOI_STAGE_PREDICT);
+
+					unsigned char vr = px.r - pix_predict.r;
+					unsigned char vg = px.g - pix_predict.g;
+					unsigned char vb = px.b - pix_predict.b;
+
+					unsigned char vg_r = vr - vg;
+					unsigned char vg_b = vb - vg;
+
+					if (((vr & 0xfe) == 0xfe || (vr & 0xfe) == 0x00) &&
+						((vg & 0xfe) == 0xfe || (vg & 0xfe) == 0x00) &&
+						((vb & 0xfe) == 0xfe || (vb & 0xfe) == 0x00)) {
+						PROF_MARK(QOI_STAGE_CLASSIFY);
+
+						vr &= 0x03;
+						vg &= 0x03;
+						vb &= 0x03;
+
+						// 2'b01 vr[1:0] vg[1:0] vb[1:0]
+						pCompressed[p++] = QOI_OP_DIFF | (vr << 4) | (vg << 2) | vb;
+						STATS_OP(QOI_ID_DIFF, 1, 1);
+					}
+					else if (((vr & 0xf8) == 0xf8 || (vr & 0xf8) == 0x00) &&
+						((vg & 0xf0) == 0xf0 || (vg & 0xf0) == 0x00) &&
+						((vb & 0xf8) == 0xf8 || (vb & 0xf8) == 0x00)) {
+						PROF_MARK(QOI_STAGE_CLASSIFY);
+
+						vr &= 0x0f;
+						vg &= 0x1f;
+						vb &= 0x0f;
+
+						// 3'b001 vg[4:0]
+						pCompressed[p++] = QOI_OP_DIFF3 | vg;
+						// vr[3:0] vb[3:0]
+						pCompressed[p++] = (vr << 4) | vb;
+						STATS_OP(QOI_ID_DIFF3, 2, 1);
+					}
+					else if (((vg_r & 0xf8) == 0xf8 || (vg_r & 0xf8) == 0x00) &&
+						((vg_b & 0xf8) == 0xf8 || (vg_b & 0xf8) == 0x00) &&
+						((vg & 0xe0) == 0xe0 || (vg & 0xe0) == 0x00)) {
+						PROF_MARK(QOI_STAGE_CLASSIFY);
+
+						vg_r &= 0x0f;
+						vg_b &= 0x0f;
+						vg &= 0x3f;
+
+						// 2'b10 vg[5:0]
+						pCompressed[p++] = QOI_OP_LUMA | vg;
+						// vg_r[3:0] vg_b[3:0]
+						pCompressed[p++] = (vg_r << 4) | vg_b;
+						STATS_OP(QOI_ID_LUMA, 2, 1);
+					}
+					else if (((vr & 0xc0) == 0xc0 || (vr & 0xc0) == 0x00) &&
+						((vg & 0xc0) == 0xc0 || (vg & 0xc0) == 0x00) &&
+						((vb & 0xc0) == 0xc0 || (vb & 0xc0) == 0x00)) {
+						PROF_MARK(QOI_STAGE_CLASSIFY);
+
+						vr &= 0x7f;
+						vg &= 0x7f;
+						vb &= 0x7f;
+
+						// 3'b110 vr[4:0]
+						pCompressed[p++] = QOI_OP_DIFF2 | (vr & 0x1f);
+						// vg[5:0] vr[6:5]
+						pCompressed[p++] = (vr >> 5) | ((vg & 0x3f) << 2);
+						// vb[6:0] vg[6]
+						pCompressed[p++] = ((vg & 0x40) >> 6) | (vb << 1);
+						STATS_OP(QOI_ID_DIFF2, 3, 1);
+					}
+					else {
+						PROF_MARK(QOI_STAGE_CLASSIFY);
+
+						// 8'hff
+						pCompressed[p++] = QOI_OP_RGB;
+						// r[7:0]
+						pCompressed[p++] = px.r;
+						// g[7:0]
+						pCompressed[p++] = px.g;
+						// b[7:0]
+						pCompressed[p++] = px.b;
+						STATS_OP(QOI_ID_RGB, 4, 1);
+					}
 				}
+				index_tb[index_pos] = px;
 			}
-			index_tb[index_pos] = px;
+			px_prev = px;
+
+			STATS_PIXEL_END((uint32_t)(px_pos / 3), enc->row + y);
+
+			PROF_MARK(QOI_STAGE_EMIT);
 		}
-		px_prev = px;
 
-		get_next_predict_v(&px, &pix_predict, predict_err);
+		prev_row = prow;
+	}
+
+	// ߵػһεʱѱ, һб浽ݴ
+	if (rows && enc->row + rows < enc->img_h) {
+		memcpy(enc->line, prev_row, row_len);
+		prev_row = enc->line;
 	}
 
-	clear_predict_iter();
+	enc->row += rows;
+	enc->px_prev = px_prev;
+	enc->prev_row = prev_row;
+	enc->run = run;
 
 	return p;
 }
@@ -208,255 +433,916 @@ int enhanced_qoi_encode(unsigned char* prgb, unsigned char* pCompressed, int img
 		img_h ͼ߶
 @return none
 *************************/
-void enhanced_qoi_decode(unsigned char* pencoded, unsigned char* pdecoded, int img_w, int img_h) {
-	int px_len = img_w * img_h * 3;
+void enhanced_qoi_decode(unsigned char* pencoded, unsigned char* pdecoded, uint32_t img_w, uint32_t img_h) {
+	enhanced_qoi_decode_rect(pencoded, SIZE_MAX, pdecoded, (size_t)img_w * 3, img_w, img_h);
+}
+
+/*************************
+@decode
+@public
+@brief  ͼеľ(ֿ)QOI
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ(ֽ)
+		pdecoded ϽǵĽ뻺(ָ)
+		stride 뻺п(ֽ)
+		img_w 
+		img_h ߶
+@return none
+*************************/
+void enhanced_qoi_decode_rect(unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride, uint32_t img_w, uint32_t img_h) {
+	qoi_decoder_t dec;
+
+	if (!enhanced_qoi_decoder_init(&dec, pencoded, encoded_len, img_w, img_h)) {
+		return;
+	}
+
+	enhanced_qoi_decode_rows(&dec, pdecoded, stride, img_h);
+	enhanced_qoi_decoder_free(&dec);
+}
+
+/*************************
+@init
+@public
+@brief  ʼ(еʽ)
+@param  dec (ָ)
+		pencoded ѹ(ָ, Ϊڴӳ)
+		encoded_len ѹݳ(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+@return Ƿɹ
+*************************/
+_Bool enhanced_qoi_decoder_init(qoi_decoder_t* dec, unsigned char* pencoded, size_t encoded_len, uint32_t img_w, uint32_t img_h) {
+	memset(dec->index_tb, 0, INDEX_TB_L * sizeof(qoi_rgb_t));
+	dec->px = (qoi_rgb_t){ 0, 0, 0 };
+	dec->seed = (qoi_rgb_t){ 0, 0, 0 };
+	dec->pencoded = pencoded;
+	dec->encoded_len = encoded_len;
+	dec->p = 0;
+	dec->run = 0;
+	dec->img_w = img_w;
+	dec->img_h = img_h;
+	dec->row = 0;
+	dec->prev_row = NULL;
+#ifdef EQOI_PROFILE
+	dec->prof = NULL;
+#endif
+
+	return 1;
+}
+
+/*************************
+@init
+@public
+@brief  ֵýĳʼ״̬(ڳʼ֮󡢽һ֮ǰ)
+@param  dec (ָ)
+		dict ֵ(ָ)
+@return none
+*************************/
+void enhanced_qoi_decoder_set_dict(qoi_decoder_t* dec, const qoi_dict_t* dict) {
+	memcpy(dec->index_tb, dict->index_tb, INDEX_TB_L * sizeof(qoi_rgb_t));
+	dec->px = dict->px;
+	dec->seed = dict->px;
+}
 
-	memset(index_tb, 0, INDEX_TB_L * sizeof(qoi_rgb_t));
-	px = (qoi_rgb_t){ 0, 0, 0 };
+/*************************
+@init
+@public
+@brief  Ա״̬ѽƵָе(ڳʼֵ֮)
+@info   ׵״̬λáʣγ̳ȡһ, ǰؼһеһ
+@param  dec (ָ)
+		mark ׵Ľλ(ָ)
+		row к(Ϊ0ʱֻλ)
+		index_tb ׵(ָ, INDEX_TB_L)
+		prev_row һеĽ(ָ, һʱԤֱӶȡ, 뱣ֵн)
+@return none
+*************************/
+void enhanced_qoi_decoder_seek(qoi_decoder_t* dec, const qoi_mark_t* mark, uint32_t row, const qoi_rgb_t* index_tb,
+	const unsigned char* prev_row) {
+	dec->p = mark->p;
+	dec->run = mark->run;
+
+	if (row > 0) {
+		const unsigned char* last = prev_row + ((size_t)dec->img_w - 1) * 3;
+
+		memcpy(dec->index_tb, index_tb, INDEX_TB_L * sizeof(qoi_rgb_t));
+		dec->px = (qoi_rgb_t){ last[2], last[1], last[0] };
+		dec->prev_row = prev_row;
+		dec->row = row;
+	}
+}
 
-	qoi_rgb_t predict;
-	int predict_err[3] = { 0, 0, 0 };
+/*************************
+@delete
+@public
+@brief  ٽ
+@param  dec (ָ)
+@return none
+*************************/
+void enhanced_qoi_decoder_free(qoi_decoder_t* dec) {
+	// ٳл, ԤʱֱӶȡ뻺еһ
+	dec->prev_row = NULL;
+}
 
-	init_predict_iter(img_w, &predict);
+/*************************
+@decode
+@public
+@brief  
+@info   ԤֱֵӶȡ뻺е//, һεýһ뱣ԭַ
+@param  dec (ָ)
+		pdecoded еĽ뻺(ָ)
+		stride 뻺п(ֽ)
+		rows 
+@return none
+*************************/
+void enhanced_qoi_decode_rows(qoi_decoder_t* dec, unsigned char* pdecoded, size_t stride, uint32_t rows) {
+	qoi_rgb_t* index_tb = dec->index_tb;
+	unsigned char* pencoded = dec->pencoded;
+	size_t encoded_len = dec->encoded_len;
+	size_t row_len = (size_t)dec->img_w * 3;
 
-	int p = 0;
-	unsigned char run = 0;
+	qoi_rgb_t px = dec->px;
+	qoi_rgb_t seed = dec->seed;
+	const unsigned char* prev_row = dec->prev_row;
 
-	for (int px_pos = 0; px_pos < px_len; px_pos += 3) {
-		if (run > 0) {
-			run--;
-		}
-		else {
-			unsigned char b1 = pencoded[p++];
+	size_t p = dec->p;
+	uint64_t run = dec->run;
 
-			//110XXXXX DIFF2
-			if ((b1 & QOI_MASK_3) == QOI_OP_DIFF2) {
-				unsigned char b2 = pencoded[p++];
-				unsigned char b3 = pencoded[p++];
+	PROF_BEGIN(dec);
 
-				unsigned char vr = (b1 & 0x1f);
-				unsigned char vg = ((b2 & 0xfc) >> 2);
-				unsigned char vb = ((b3 & 0xfe) >> 1);
+	for (uint32_t y = 0; y < rows; y++) {
+		unsigned char* prow = pdecoded + (size_t)y * stride;
 
-				vr |= ((b2 & 0x03) << 5);
-				vg |= (b3 & 0x01) << 6;
+		for (size_t px_pos = 0; px_pos < row_len; px_pos += 3) {
+			if (run > 0) {
+				run--;
+			}
+			else if (p >= encoded_len || op_len(pencoded[p]) > encoded_len - p) {
+				// Ѻľ(ɰĩβγ)ضڶֽڱ, Եǰʣಿ
+				p = encoded_len;
+				run = (uint64_t)dec->img_w * dec->img_h;
+			}
+			else {
+				qoi_rgb_t v;
+				int kind = read_op(pencoded, &p, &v);
 
-				// λչ
-				if (vr & 0x40) {
-					vr |= 0x80;
+				PROF_MARK(QOI_STAGE_PARSE);
+
+				if (kind == OP_KIND_RUN) {
+					run = v.r;
 				}
-				if (vg & 0x40) {
-					vg |= 0x80;
+				else if (kind == OP_KIND_INDEX) {
+					px = index_tb[v.r];
 				}
-				if (vb & 0x40) {
-					vb |= 0x80;
+				else if (kind == OP_KIND_PIXEL) {
+					px = v;
 				}
+				else {
+					// д뻺, ϷϷȡһ
+					qoi_rgb_t predict = predict_pixel(prow, prev_row, px_pos, seed);
 
-				px.r = vr;
-				px.g = vg;
-				px.b = vb;
-			}
-			// 11111111 RGB
-			else if (b1 == QOI_OP_RGB) {
-				px = (qoi_rgb_t){ pencoded[p], pencoded[p + 1], pencoded[p + 2] };
-				p += 3;
+					PROF_MARK(QOI_STAGE_PREDICT);
+
+					px.r = v.r + predict.r;
+					px.g = v.g + predict.g;
+					px.b = v.b + predict.b;
+				}
+
+				index_tb[QOI_COLOR_HASH(px) % INDEX_TB_L] = px;
 			}
-			// 111XXXXXҲ11111111 RUN
-			else if ((b1 & QOI_MASK_3) == QOI_OP_RUN) {
-				run = (b1 & 0x1f);
+
+			prow[px_pos] = px.b;
+			prow[px_pos + 1] = px.g;
+			prow[px_pos + 2] = px.r;
+
+			PROF_MARK(QOI_STAGE_RECON);
+		}
+
+		prev_row = prow;
+	}
+
+	dec->row += rows;
+	dec->prev_row = prev_row;
+	dec->px = px;
+	dec->p = p;
+	dec->run = run;
+}
+
+/*************************
+@init
+@public
+@brief  ʼֵԤı״̬(ÿϸӴ״̬ʼ)
+@param  st ״̬(ָ)
+@return none
+*************************/
+void enhanced_qoi_pred_init(qoi_pred_state_t* st) {
+	memset(st->index_tb, 0, INDEX_TB_L * sizeof(qoi_rgb_t));
+	st->px = (qoi_rgb_t){ 0, 0, 0 };
+	st->run = 0;
+	st->p = 0;
+}
+
+/*************************
+@encode
+@public
+@brief  Ե߸Ԥֵһ(ڽģʽϸ, 8λͬ)
+@info   γ̡Ԥжenhanced_qoi_encode_rowsͬ, ֻԤֵMED;
+		γ̿ɿ, lastΪ1ʱصĩβδγ
+@param  st ״̬(ָ)
+		ppx ׸(ָ, b, g, r)
+		step صļ(ֽ)
+		ppred صԤֵ(ָ, , b, g, r)
+		n ظ
+		feedback һصԤԤֵ(־, pred_feedback, ׸ز)
+		last ǷΪһ(־)
+		pCompressed ѹݻ(ָ, дn*4ֽ)
+@return ֽ
+*************************/
+size_t enhanced_qoi_encode_pred(qoi_pred_state_t* st, const unsigned char* ppx, size_t step, const unsigned char* ppred, size_t n,
+	_Bool feedback, _Bool last, unsigned char* pCompressed) {
+	qoi_rgb_t* index_tb = st->index_tb;
+	qoi_rgb_t px_prev = st->px;
+	uint64_t run = st->run;
+	size_t p = 0;
+
+	for (size_t i = 0; i < n; i++, ppx += step, ppred += 3) {
+		qoi_rgb_t px = (qoi_rgb_t){ ppx[2], ppx[1], ppx[0] };
+
+		if (!memcmp(&px, &px_prev, sizeof(qoi_rgb_t))) {
+			run++;
+			if (run == MAX_RUN || (last && i == n - 1)) {
+				pCompressed[p++] = QOI_OP_RUN | (unsigned char)(run - 1);
+				run = 0;
 			}
-			//000XXXXX INDEX
-			else if ((b1 & QOI_MASK_3) == QOI_OP_INDEX) {
-				px = index_tb[b1 % INDEX_TB_L];
+
+			continue;
+		}
+
+		unsigned char index_pos = QOI_COLOR_HASH(px) % INDEX_TB_L;
+
+		if (run) {
+			pCompressed[p++] = QOI_OP_RUN | (unsigned char)(run - 1);
+			run = 0;
+		}
+
+		if (!memcmp(index_tb + index_pos, &px, sizeof(qoi_rgb_t))) {
+			pCompressed[p++] = QOI_OP_INDEX | index_pos;
+		}
+		else {
+			qoi_rgb_t predict = feedback && i ? pred_feedback(ppred, ppx - step) : (qoi_rgb_t){ ppred[2], ppred[1], ppred[0] };
+
+			p += write_resid(px, predict, pCompressed + p);
+		}
+
+		index_tb[index_pos] = px;
+		px_prev = px;
+	}
+
+	st->px = px_prev;
+	st->run = run;
+
+	return p;
+}
+
+/*************************
+@decode
+@public
+@brief  Ե߸Ԥֵһ(enhanced_qoi_encode_predӦ)
+@info   һͳĩβʱֹͣ(ضʱɵʣ), γ
+@param  st ״̬(ָ)
+		pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		ppred صԤֵ(ָ, , b, g, r)
+		n ظ
+		feedback һصԤԤֵ(־, ʱͬ)
+		pdecoded ׸صĽλ(ָ)
+		step صļ(ֽ)
+@return ظ(СnʾѺľ)
+*************************/
+size_t enhanced_qoi_decode_pred(qoi_pred_state_t* st, const unsigned char* pencoded, size_t encoded_len, const unsigned char* ppred,
+	size_t n, _Bool feedback, unsigned char* pdecoded, size_t step) {
+	qoi_rgb_t* index_tb = st->index_tb;
+	qoi_rgb_t px = st->px;
+	uint64_t run = st->run;
+	size_t p = st->p;
+	size_t i;
+
+	for (i = 0; i < n; i++, pdecoded += step, ppred += 3) {
+		if (run > 0) {
+			run--;
+		}
+		else {
+			if (p >= encoded_len || op_len(pencoded[p]) > encoded_len - p) {
+				break;
 			}
-			//001XXXXX DIFF3
-			else if ((b1 & QOI_MASK_3) == QOI_OP_DIFF3) {
-				unsigned char b2 = pencoded[p++];
 
-				unsigned char vr = (b2 >> 4);
-				unsigned char vg = b1 & 0x1f;
-				unsigned char vb = b2 & 0x0f;
+			qoi_rgb_t v;
+			int kind = read_op(pencoded, &p, &v);
 
-				// λչ
-				if (vr & 0x08) {
-					vr |= 0xf0;
+			if (kind == OP_KIND_RUN) {
+				run = v.r;
+			}
+			else {
+				if (kind == OP_KIND_INDEX) {
+					px = index_tb[v.r];
 				}
-				if (vg & 0x10) {
-					vg |= 0xe0;
+				else if (kind == OP_KIND_PIXEL) {
+					px = v;
 				}
-				if (vb & 0x08) {
-					vb |= 0xf0;
+				else {
+					// һдλ
+					qoi_rgb_t predict = feedback && i ? pred_feedback(ppred, pdecoded - step) :
+						(qoi_rgb_t){ ppred[2], ppred[1], ppred[0] };
+
+					px.r = v.r + predict.r;
+					px.g = v.g + predict.g;
+					px.b = v.b + predict.b;
 				}
 
-				px.r = vr;
-				px.g = vg;
-				px.b = vb;
+				index_tb[QOI_COLOR_HASH(px) % INDEX_TB_L] = px;
 			}
-			//01XXXXXX DIFF
-			else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
-				unsigned char vr = (b1 >> 4) & 0x03;
-				unsigned char vg = (b1 >> 2) & 0x03;
-				unsigned char vb = b1 & 0x03;
-
-				// λչ
-				if (vr & 0x02) {
-					vr |= 0xfc;
-				}
-				if (vg & 0x02) {
-					vg |= 0xfc;
-				}
-				if (vb & 0x02) {
-					vb |= 0xfc;
+		}
+
+		pdecoded[0] = px.b;
+		pdecoded[1] = px.g;
+		pdecoded[2] = px.r;
+	}
+
+	st->px = px;
+	st->run = run;
+	st->p = p;
+
+	return i;
+}
+
+/*************************
+@calc
+@public
+@brief  ɨͳƸ(, ÿֱ͵ĳֽھ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		px_cnt ͼ(ľʣؼγ)
+		stats ͳƽ(ָ, ԭмۼ)
+@return none
+*************************/
+void enhanced_qoi_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, qoi_op_stats_t* stats) {
+	static const unsigned char op_len[QOI_ID_CNT] = { 1, 1, 1, 2, 2, 3, 4 }; // ͵ĳ
+	uint64_t px_done = 0;
+	size_t p = 0;
+
+	while (p < encoded_len && px_done < px_cnt) {
+		unsigned char b1 = pencoded[p];
+		int id;
+		uint64_t n = 1;
+
+		if (b1 == QOI_OP_RGB) {
+			id = QOI_ID_RGB;
+		}
+		else if ((b1 & QOI_MASK_3) == QOI_OP_RUN) {
+			id = QOI_ID_RUN;
+			n = (b1 & 0x1f) + 1;
+		}
+		else if ((b1 & QOI_MASK_3) == QOI_OP_DIFF2) {
+			id = QOI_ID_DIFF2;
+		}
+		else if ((b1 & QOI_MASK_3) == QOI_OP_INDEX) {
+			id = QOI_ID_INDEX;
+		}
+		else if ((b1 & QOI_MASK_3) == QOI_OP_DIFF3) {
+			id = QOI_ID_DIFF3;
+		}
+		else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+			id = QOI_ID_DIFF;
+		}
+		else {
+			id = QOI_ID_LUMA;
+		}
+
+		n = __MIN(n, px_cnt - px_done);
+
+		stats->ops[id]++;
+		stats->pixels[id] += n;
+		stats->bytes[id] += op_len[id];
+
+		px_done += n;
+		p += op_len[id];
+	}
+
+	// ɰĩβγ, һ
+	if (px_done < px_cnt) {
+		stats->pixels[QOI_ID_RUN] += px_cnt - px_done;
+	}
+}
+
+/*************************
+@calc
+@public
+@brief  һ͵ʼλÿʼɨ, ֱend֮ǰʼıȫɨ(, ÿֱ͵ĳֽھ)
+@info   Դֽλÿʼɨ(Ѹֽڵ͵ֽ), õıͱ߽ͨڼ
+		ʵı߽غ, ֶβɨʱԴƲεı߽; ضڱмΪڸñʹľ
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		pp ʼλ(ָ, ʱΪ׸endʼı͵λ, ľʱΪencoded_len)
+		end λ
+@return ɨı͸ǵ
+*************************/
+uint64_t enhanced_qoi_scan_span(const unsigned char* pencoded, size_t encoded_len, size_t* pp, size_t end) {
+	uint64_t px_cnt = 0;
+	size_t p = *pp;
+
+	end = __MIN(end, encoded_len);
+
+	// ʣݲıʱض
+	while (p < end && encoded_len - p >= 4) {
+		unsigned char b1 = pencoded[p];
+
+		px_cnt += op_pixels(b1);
+		p += op_len(b1);
+	}
+
+	while (p < end) {
+		unsigned char b1 = pencoded[p];
+
+		if (op_len(b1) > encoded_len - p) {
+			p = encoded_len;
+			break;
+		}
+
+		px_cnt += op_pixels(b1);
+		p += op_len(b1);
+	}
+
+	*pp = p;
+
+	return px_cnt;
+}
+
+/*************************
+@calc
+@public
+@brief  ֪λõıͿʼɨ, õָصĽλ()
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		p ʼλ(Ϊ͵ֽ)
+		px_pos ʼλõı͸ǵ׸ص
+		target Ŀص(Сpx_pos)
+		mark ĿصĽλ(ָ)
+@return none
+*************************/
+void enhanced_qoi_scan_mark(const unsigned char* pencoded, size_t encoded_len, size_t p, uint64_t px_pos, uint64_t target,
+	qoi_mark_t* mark) {
+	while (p < encoded_len) {
+		unsigned char b1 = pencoded[p];
+		size_t len = op_len(b1);
+		uint64_t n = op_pixels(b1);
+
+		if (len > encoded_len - p) {
+			break;
+		}
+
+		// ĿǡΪñ͵׸ʱӸñͿʼ, γм
+		if (px_pos + n > target) {
+			mark->p = px_pos == target ? p : p + len;
+			mark->run = px_pos == target ? 0 : px_pos + n - target;
+
+			return;
+		}
+
+		px_pos += n;
+		p += len;
+	}
+
+	// Ѻľ
+	mark->p = encoded_len;
+	mark->run = 0;
+}
+
+/*************************
+@parse
+@public
+@brief  ׵Ľλеıغ(ǰ, ͬжοɲн)
+@info   ÿصغдkinds, غɰصֽλݴڽ뻺(ԤRGBΪb, g, r,
+		INDEXΪλ), enhanced_qoi_resolve_rowsؽ
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		mark ׵Ľλ(ָ, enhanced_qoi_scan_mark)
+		img_w ͼ
+		rows 
+		pdecoded еĽ뻺(ָ)
+		stride 뻺п(ֽ)
+		kinds еغ(ָ, ÿ1ֽ, )
+@return none
+*************************/
+void enhanced_qoi_parse_rows(const unsigned char* pencoded, size_t encoded_len, const qoi_mark_t* mark, uint32_t img_w, uint32_t rows,
+	unsigned char* pdecoded, size_t stride, unsigned char* kinds) {
+	size_t p = mark->p;
+	uint64_t run = mark->run;
+
+	for (uint32_t y = 0; y < rows; y++) {
+		unsigned char* prow = pdecoded + (size_t)y * stride;
+		unsigned char* krow = kinds + (size_t)y * img_w;
+
+		for (uint32_t x = 0; x < img_w; x++) {
+			if (run > 0) {
+				run--;
+				krow[x] = OP_KIND_RUN;
+			}
+			else if (p >= encoded_len || op_len(pencoded[p]) > encoded_len - p) {
+				// Ѻľ, Եǰʣಿ
+				p = encoded_len;
+				run = UINT64_MAX;
+				krow[x] = OP_KIND_RUN;
+			}
+			else {
+				qoi_rgb_t v;
+				int kind = read_op(pencoded, &p, &v);
+
+				if (kind == OP_KIND_RUN) {
+					run = v.r;
 				}
 
-				px.r = vr;
-				px.g = vg;
-				px.b = vb;
+				krow[x] = (unsigned char)kind;
+				prow[(size_t)x * 3] = v.b;
+				prow[(size_t)x * 3 + 1] = v.g;
+				prow[(size_t)x * 3 + 2] = v.r;
 			}
-			//10XXXXXX LUMA
-			else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
-				unsigned char b2 = pencoded[p++];
+		}
+	}
+}
 
-				unsigned char vg = b1 & 0x3f;
-				unsigned char vg_r = (b2 >> 4) & 0x0f;
-				unsigned char vg_b = b2 & 0x0f;
+/*************************
+@decode
+@public
+@brief  enhanced_qoi_parse_rowsĽؽ(밴е˳)
+@info   ֻʹýǰء׸صԤֵһ, ȡѹ, enhanced_qoi_decode_rowsͬ
+@param  dec (ָ)
+		pdecoded еĽ뻺(ָ, enhanced_qoi_parse_rowsдغ)
+		stride 뻺п(ֽ)
+		kinds еغ(ָ)
+		rows 
+@return none
+*************************/
+void enhanced_qoi_resolve_rows(qoi_decoder_t* dec, unsigned char* pdecoded, size_t stride, const unsigned char* kinds, uint32_t rows) {
+	qoi_rgb_t* index_tb = dec->index_tb;
+	size_t row_len = (size_t)dec->img_w * 3;
 
-				// λչ
-				if (vg & 0x20) {
-					vg |= 0xc0;
-				}
-				if (vg_r & 0x08) {
-					vg_r |= 0xf0;
-				}
-				if (vg_b & 0x08) {
-					vg_b |= 0xf0;
-				}
+	qoi_rgb_t px = dec->px;
+	qoi_rgb_t seed = dec->seed;
+	const unsigned char* prev_row = dec->prev_row;
 
-				px.r = vg + vg_r;
-				px.g = vg;
-				px.b = vg + vg_b;
+	// ǰ֮д, γ̲ٸı; ֻγ̿ʼʱдʼĵǰ
+	if (dec->row == 0 && rows > 0 && kinds[0] == OP_KIND_RUN) {
+		index_tb[QOI_COLOR_HASH(px) % INDEX_TB_L] = px;
+	}
+
+	for (uint32_t y = 0; y < rows; y++) {
+		unsigned char* prow = pdecoded + (size_t)y * stride;
+		const unsigned char* krow = kinds + (size_t)y * dec->img_w;
+
+		for (size_t px_pos = 0; px_pos < row_len; px_pos += 3) {
+			int kind = *krow++;
+
+			if (kind == OP_KIND_RUN) {
+				prow[px_pos] = px.b;
+				prow[px_pos + 1] = px.g;
+				prow[px_pos + 2] = px.r;
+
+				continue;
+			}
+			else if (kind == OP_KIND_INDEX) {
+				px = index_tb[prow[px_pos + 2]];
 			}
+			else if (kind == OP_KIND_PIXEL) {
+				px = (qoi_rgb_t){ prow[px_pos + 2], prow[px_pos + 1], prow[px_pos] };
+			}
+			else {
+				qoi_rgb_t predict = predict_pixel(prow, prev_row, px_pos, seed);
 
-			if ((b1 & QOI_MASK_2) == QOI_OP_DIFF || (b1 & QOI_MASK_2) == QOI_OP_LUMA || (b1 & QOI_MASK_3) == QOI_OP_DIFF2 ||
-				(b1 & QOI_MASK_3) == QOI_OP_DIFF3) {
-				px.r += predict.r;
-				px.g += predict.g;
-				px.b += predict.b;
+				px.r = prow[px_pos + 2] + predict.r;
+				px.g = prow[px_pos + 1] + predict.g;
+				px.b = prow[px_pos] + predict.b;
 			}
 
 			index_tb[QOI_COLOR_HASH(px) % INDEX_TB_L] = px;
+
+			prow[px_pos] = px.b;
+			prow[px_pos + 1] = px.g;
+			prow[px_pos + 2] = px.r;
 		}
 
-		pdecoded[px_pos] = px.b;
-		pdecoded[px_pos + 1] = px.g;
-		pdecoded[px_pos + 2] = px.r;
+		prev_row = prow;
+	}
+
+	dec->row += rows;
+	dec->prev_row = prev_row;
+	dec->px = px;
+}
+
+#ifdef EQOI_STATS
+/*************************
+@calc
+@private
+@brief  ¼صĲ׮ͳ(Ԥֱͼͼ)
+@param  stats ׮ͳ(ָ)
+		x ڱеĺ
+		y ڱе
+		bytes ʱֽ(һγ̵ֽڼ뵱ǰ)
+		px ֵ
+		predict صԤֵ
+@return none
+*************************/
+static void stats_pixel(qoi_enc_stats_t* stats, uint32_t x, uint32_t y, size_t bytes, qoi_rgb_t px, qoi_rgb_t predict) {
+	int predict_err[3] = { px.r - predict.r, px.g - predict.g, px.b - predict.b };
 
-		// Ԥ
-		predict_err[0] = px.r - predict.r;
-		predict_err[1] = px.g - predict.g;
-		predict_err[2] = px.b - predict.b;
+	for (int c = 0; c < 3; c++) {
+		int e = (signed char)predict_err[c];
 
-		get_next_predict_v(&px, &predict, predict_err);
+		stats->resid_hist[c][e < 0 ? -e : e]++;
 	}
 
-	clear_predict_iter();
+	if (stats->heat_bytes != NULL) {
+		uint32_t bx = (stats->org_x + x) / QOI_STATS_BLOCK;
+		uint32_t by = (stats->org_y + y) / QOI_STATS_BLOCK;
+
+		stats->heat_bytes[(size_t)by * stats->heat_w + bx] += (uint32_t)bytes;
+	}
 }
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /*************************
-@init
+@calc
 @private
-@brief  ʼԤ
-@param  w 
-		chn ͨ
-		predict ڴŵǰԤֵؽṹ(ָ)
-@return Ƿɹ
+@brief  صԤֵ(1ȡ, 1ȡϷ, ΪMEDԤ)
+@param  prow ǰ(׵ַ, Ѿ)
+		prev_row һ(׵ַ, ǰΪ1ʱΪNULL)
+		px_pos еֽλ
+		seed ׸صԤֵ
+@return Ԥֵ
 *************************/
-_Bool init_predict_iter(int w, qoi_rgb_t* predict) {
-	predict_decode_first_line = 1;
-	rgb_pre_line = malloc(sizeof(qoi_rgb_t) * w);
-	predict_w = w;
-	predict_column_i = 0;
+static inline qoi_rgb_t predict_pixel(const unsigned char* prow, const unsigned char* prev_row, size_t px_pos, qoi_rgb_t seed) {
+	if (prev_row == NULL) {
+		// ǰ:1, ׸seedԤ(ֵʱΪ0)
+		return px_pos ? (qoi_rgb_t){ prow[px_pos - 1], prow[px_pos - 2], prow[px_pos - 3] } : seed;
+	}
+	else if (!px_pos) {
+		// ǰ:(2+)е1
+		return (qoi_rgb_t){ prev_row[2], prev_row[1], prev_row[0] };
+	}
+	else {
+		// ǰ:(2+)е(2+), a/b/cΪ/Ϸ/Ϸ
+		const unsigned char* a = prow + px_pos - 3;
+		const unsigned char* b = prev_row + px_pos;
+		const unsigned char* c = prev_row + px_pos - 3;
 
-	predict->r = 0;
-	predict->g = 0;
-	predict->b = 0;
+		return (qoi_rgb_t){ med_predict(a[2], b[2], c[2]), med_predict(a[1], b[1], c[1]), med_predict(a[0], b[0], c[0]) };
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  ͨMEDԤ
+@param  a ֵ
+		b Ϸֵ
+		c Ϸֵ
+@return Ԥֵ
+*************************/
+static inline unsigned char med_predict(unsigned char a, unsigned char b, unsigned char c) {
+	unsigned char mn = __MIN(a, b);
+	unsigned char mx = __MAX(a, b);
+	unsigned char g = (unsigned char)(a + b - c);
 
-	return rgb_pre_line != NULL;
+	g = c <= mn ? mx : g;
+
+	return c >= mx ? mn : g;
 }
 
 /*************************
-@delete
+@calc
 @private
-@brief  Ԥ
-@param  none
-@return none
+@brief  һصԤԤֵ(ԤֵһʵֵԤֵ֮һ, 0~255)
+@info   ֵԤؼ(ֵʱˮƽԵ), ӻһʵȲȫӻض
+@param  ppred ǰصԤֵ(ָ, һصԤֵǰ, b, g, r)
+		prev һصʵֵ(ָ, b, g, r)
+@return Ԥֵ
 *************************/
-void clear_predict_iter(void) {
-	if (rgb_pre_line != NULL) {
-		free(rgb_pre_line);
+static inline qoi_rgb_t pred_feedback(const unsigned char* ppred, const unsigned char* prev) {
+	int v[3];
+
+	for (int c = 0; c < 3; c++) {
+		v[c] = ppred[c] + (prev[c] - ppred[c - 3]) / 2;
+		v[c] = v[c] < 0 ? 0 : (v[c] > 255 ? 255 : v[c]);
 	}
+
+	return (qoi_rgb_t){ (unsigned char)v[2], (unsigned char)v[1], (unsigned char)v[0] };
 }
 
 /*************************
-@decoder
+@encode
 @private
-@brief  ȡһԤֵ
-@param  rgb ǰֵ(ָ)
-		predict ǰԤֵ(ָ)
-		predict_err Ԥ(׵ַ)
-@return none
+@brief  صԤ(DIFF, DIFF3, LUMA, DIFF2˳ѡ̵ı, ʱRGB)
+@param  px ֵ
+		predict Ԥֵ
+		pCompressed λ(ָ)
+@return ֽ
 *************************/
-void get_next_predict_v(qoi_rgb_t* rgb, qoi_rgb_t* predict, int* predict_err) {
-	// ػ
-	if (predict_column_i) {
-		rgb_pre_line[predict_column_i - 1] = rgb_pre;
+static inline size_t write_resid(qoi_rgb_t px, qoi_rgb_t predict, unsigned char* pCompressed) {
+	unsigned char vr = px.r - predict.r;
+	unsigned char vg = px.g - predict.g;
+	unsigned char vb = px.b - predict.b;
+
+	unsigned char vg_r = vr - vg;
+	unsigned char vg_b = vb - vg;
+
+	if ((unsigned char)(vr + 2) < 4 && (unsigned char)(vg + 2) < 4 && (unsigned char)(vb + 2) < 4) {
+		// 2'b01 vr[1:0] vg[1:0] vb[1:0]
+		pCompressed[0] = QOI_OP_DIFF | ((vr & 0x03) << 4) | ((vg & 0x03) << 2) | (vb & 0x03);
+
+		return 1;
 	}
-	if (predict_column_i == predict_w - 1) {
-		rgb_pre_line[predict_column_i] = *rgb;
+	if ((unsigned char)(vr + 8) < 16 && (unsigned char)(vg + 16) < 32 && (unsigned char)(vb + 8) < 16) {
+		// 3'b001 vg[4:0], vr[3:0] vb[3:0]
+		pCompressed[0] = QOI_OP_DIFF3 | (vg & 0x1f);
+		pCompressed[1] = ((vr & 0x0f) << 4) | (vb & 0x0f);
+
+		return 2;
 	}
-	rgb_pre = *rgb;
-	if (predict_column_i == predict_w - 1) {
-		predict_column_i = 0;
-		predict_decode_first_line = 0;
+	if ((unsigned char)(vg_r + 8) < 16 && (unsigned char)(vg_b + 8) < 16 && (unsigned char)(vg + 32) < 64) {
+		// 2'b10 vg[5:0], vg_r[3:0] vg_b[3:0]
+		pCompressed[0] = QOI_OP_LUMA | (vg & 0x3f);
+		pCompressed[1] = ((vg_r & 0x0f) << 4) | (vg_b & 0x0f);
+
+		return 2;
 	}
-	else {
-		predict_column_i++;
+	if ((unsigned char)(vr + 64) < 128 && (unsigned char)(vg + 64) < 128 && (unsigned char)(vb + 64) < 128) {
+		// 3'b110 vr[4:0], vg[5:0] vr[6:5], vb[6:0] vg[6]
+		pCompressed[0] = QOI_OP_DIFF2 | (vr & 0x1f);
+		pCompressed[1] = ((vr & 0x7f) >> 5) | ((vg & 0x3f) << 2);
+		pCompressed[2] = ((vg & 0x40) >> 6) | ((vb & 0x7f) << 1);
+
+		return 3;
+	}
+
+	// 8'hff r[7:0] g[7:0] b[7:0]
+	pCompressed[0] = QOI_OP_RGB;
+	pCompressed[1] = px.r;
+	pCompressed[2] = px.g;
+	pCompressed[3] = px.b;
+
+	return 4;
+}
+
+/*************************
+@calc
+@private
+@brief  ֽڻȡ͵ĳ
+@param  b1 ֽ
+@return (ֽ)
+*************************/
+static inline size_t op_len(unsigned char b1) {
+	static const unsigned char len_tb[8] = { 1, 2, 1, 1, 2, 2, 3, 1 }; // 3λ: INDEX, DIFF3, DIFF, DIFF, LUMA, LUMA, DIFF2, RUN
+
+	return b1 == QOI_OP_RGB ? 4 : len_tb[b1 >> 5];
+}
+
+/*************************
+@calc
+@private
+@brief  ֽڻȡ͸ǵ
+@param  b1 ֽ
+@return 
+*************************/
+static inline uint64_t op_pixels(unsigned char b1) {
+	return (b1 & QOI_MASK_3) == QOI_OP_RUN && b1 != QOI_OP_RGB ? (b1 & 0x1f) + 1 : 1;
+}
+
+/*************************
+@parse
+@private
+@brief  ȡһ(ʽ״̬, нֶν)
+@param  pencoded ѹ(ָ)
+		pp ȡλ(ָ, ʱָһ)
+		v غ(ָ): RUNΪγ̳-1, INDEXΪλ(r), ΪԤ, RGBΪֵ
+@return غ(OP_KIND_*)
+*************************/
+static inline int read_op(const unsigned char* pencoded, size_t* pp, qoi_rgb_t* v) {
+	size_t p = *pp;
+	unsigned char b1 = pencoded[p++];
+	int kind = OP_KIND_RESID;
+
+	//110XXXXX DIFF2
+	if ((b1 & QOI_MASK_3) == QOI_OP_DIFF2) {
+		unsigned char b2 = pencoded[p++];
+		unsigned char b3 = pencoded[p++];
+
+		unsigned char vr = (b1 & 0x1f);
+		unsigned char vg = ((b2 & 0xfc) >> 2);
+		unsigned char vb = ((b3 & 0xfe) >> 1);
+
+		vr |= ((b2 & 0x03) << 5);
+		vg |= (b3 & 0x01) << 6;
+
+		// λչ
+		if (vr & 0x40) {
+			vr |= 0x80;
+		}
+		if (vg & 0x40) {
+			vg |= 0x80;
+		}
+		if (vb & 0x40) {
+			vb |= 0x80;
+		}
+
+		v->r = vr;
+		v->g = vg;
+		v->b = vb;
+	}
+	// 11111111 RGB
+	else if (b1 == QOI_OP_RGB) {
+		*v = (qoi_rgb_t){ pencoded[p], pencoded[p + 1], pencoded[p + 2] };
+		kind = OP_KIND_PIXEL;
+		p += 3;
+	}
+	// 111XXXXXҲ11111111 RUN
+	else if ((b1 & QOI_MASK_3) == QOI_OP_RUN) {
+		v->r = (b1 & 0x1f);
+		kind = OP_KIND_RUN;
+	}
+	//000XXXXX INDEX
+	else if ((b1 & QOI_MASK_3) == QOI_OP_INDEX) {
+		v->r = b1 % INDEX_TB_L;
+		kind = OP_KIND_INDEX;
 	}
+	//001XXXXX DIFF3
+	else if ((b1 & QOI_MASK_3) == QOI_OP_DIFF3) {
+		unsigned char b2 = pencoded[p++];
 
-	// Ԥֵ
-	if (predict_decode_first_line) {
-		// ǰ:1е(2+)
-		*predict = rgb_pre;
+		unsigned char vr = (b2 >> 4);
+		unsigned char vg = b1 & 0x1f;
+		unsigned char vb = b2 & 0x0f;
+
+		// λչ
+		if (vr & 0x08) {
+			vr |= 0xf0;
+		}
+		if (vg & 0x10) {
+			vg |= 0xe0;
+		}
+		if (vb & 0x08) {
+			vb |= 0xf0;
+		}
+
+		v->r = vr;
+		v->g = vg;
+		v->b = vb;
 	}
-	else {
-		if (predict_column_i) {
-			// ǰ:(2+)е(2+)
-			qoi_rgb_t a_rgb = rgb_pre;
-			qoi_rgb_t b_rgb = rgb_pre_line[predict_column_i];
-			qoi_rgb_t c_rgb = rgb_pre_line[predict_column_i - 1];
-
-			unsigned char* a = &(a_rgb.r);
-			unsigned char* b = &(b_rgb.r);
-			unsigned char* c = &(c_rgb.r);
-			unsigned char* res = &(predict->r);
-
-			for (unsigned char i = 0; i < 3; i++) {
-				if (c[i] >= __MAX(a[i], b[i])) {
-					res[i] = __MIN(a[i], b[i]);
-				}
-				else if (c[i] <= __MIN(a[i], b[i])) {
-					res[i] = __MAX(a[i], b[i]);
-				}
-				else {
-					res[i] = a[i] + b[i] - c[i];
-				}
-			}
+	//01XXXXXX DIFF
+	else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+		unsigned char vr = (b1 >> 4) & 0x03;
+		unsigned char vg = (b1 >> 2) & 0x03;
+		unsigned char vb = b1 & 0x03;
+
+		// λչ
+		if (vr & 0x02) {
+			vr |= 0xfc;
 		}
-		else {
-			// ǰ:(2+)е1
-			*predict = rgb_pre_line[0];
+		if (vg & 0x02) {
+			vg |= 0xfc;
 		}
+		if (vb & 0x02) {
+			vb |= 0xfc;
+		}
+
+		v->r = vr;
+		v->g = vg;
+		v->b = vb;
 	}
+	//10XXXXXX LUMA
+	else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+		unsigned char b2 = pencoded[p++];
+
+		unsigned char vg = b1 & 0x3f;
+		unsigned char vg_r = (b2 >> 4) & 0x0f;
+		unsigned char vg_b = b2 & 0x0f;
+
+		// λչ
+		if (vg & 0x20) {
+			vg |= 0xc0;
+		}
+		if (vg_r & 0x08) {
+			vg_r |= 0xf0;
+		}
+		if (vg_b & 0x08) {
+			vg_b |= 0xf0;
+		}
+
+		v->r = vg + vg_r;
+		v->g = vg;
+		v->b = vg + vg_b;
+	}
+
+	*pp = p;
+
+	return kind;
 }
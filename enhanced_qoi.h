@@ -5,9 +5,193 @@
 @author ¼ҫ
 ************************************************************************************************************************/
 
+#ifndef __ENHANCED_QOI_H
+#define __ENHANCED_QOI_H
+
 #include "main.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int enhanced_qoi_encode(unsigned char* prgb, unsigned char* pCompressed, int img_w, int img_h); // ͼQOI
-void enhanced_qoi_decode(unsigned char* pencoded, unsigned char* pdecoded, int img_w, int img_h); // ͼQOI
+#define INDEX_TB_L 32 // (<=32)
+
+// ͱ(ͳ)
+#define QOI_ID_RUN 0 // γ
+#define QOI_ID_INDEX 1 // 
+#define QOI_ID_DIFF 2 // 1ֽڲ
+#define QOI_ID_DIFF3 3 // 2ֽڲ
+#define QOI_ID_LUMA 4 // Ȳ
+#define QOI_ID_DIFF2 5 // 3ֽڲ
+#define QOI_ID_RGB 6 // ԭʼ
+#define QOI_ID_CNT 7 // ͸
+
+// EQOI_NO_MALLOCʱmalloc, ֻʹõṩݴ(eqoi_scratch_size);
+// ѡֻenhanced_qoi.c, вڴĽӿΪeqoi_encode_workṩݴeqoi_encode_tile
+// ļͷУ顢eqoi_decode_tile̵߳eqoi_decode(ģʽ), ģԵmalloc
+
+// ׮ͳƲ(ڶEQOI_STATSʱ׮)
+#define QOI_STATS_BLOCK 16 // ͼĿС()
+#define QOI_RESID_BINS 129 // Ԥֱֵͼ(8λƺķֵ0~128)
+
+// ֽ׶μʱĽ׶α(ڶEQOI_PROFILEʱʱ)
+#define QOI_STAGE_PREDICT 0 // Ԥ(δγ/ؼ, ֱӶȡ//)
+#define QOI_STAGE_CLASSIFY 1 // : γжѡ
+#define QOI_STAGE_PROBE 2 // : 
+#define QOI_STAGE_EMIT 3 // : ֽ
+#define QOI_STAGE_PARSE 4 // : ȡ
+#define QOI_STAGE_RECON 5 // : ӻԤֵд
+#define QOI_STAGE_CNT 6 // ׶θ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// rgbص(ṹ嶨)
+typedef struct {
+	unsigned char r, g, b;
+} qoi_rgb_t;
+
+// ֵ: ͬСͼıʼ״̬(ṹ嶨)
+typedef struct {
+	qoi_rgb_t index_tb[INDEX_TB_L]; // ʼ
+	qoi_rgb_t px; // ʼһ(ͬʱΪ׸صԤֵ)
+} qoi_dict_t;
+
+// ͳ(ṹ嶨)
+typedef struct {
+	uint64_t ops[QOI_ID_CNT]; // ͵ĳִ
+	uint64_t pixels[QOI_ID_CNT]; // ͸ǵ
+	uint64_t bytes[QOI_ID_CNT]; // ռõֽ
+} qoi_op_stats_t;
+
+// ׮ͳ(ṹ嶨)
+typedef struct {
+	qoi_op_stats_t ops; // ͵ͳ
+	uint64_t resid_hist[3][QOI_RESID_BINS]; // ͨ(r/g/b)Ԥֱֵͼ
+	uint32_t* heat_bytes; // ÿQOI_STATS_BLOCK*QOI_STATS_BLOCKֽ(դ˳)
+	uint32_t heat_w; // ͼ()
+	uint32_t heat_h; // ͼ߶()
+	uint32_t org_x; // ǰͼеĺ
+	uint32_t org_y; // ǰͼе
+} qoi_enc_stats_t;
+
+// ֽ׶μʱ(ṹ嶨)
+typedef struct {
+	uint64_t ticks[QOI_STAGE_CNT]; // ׶ۼƵʱ
+	uint64_t marks[QOI_STAGE_CNT]; // ׶εļʱ(ڿ۳ʱĿ)
+} qoi_prof_t;
+
+// (ṹ嶨)
+typedef struct {
+	qoi_rgb_t index_tb[INDEX_TB_L]; // 
+	qoi_rgb_t px_prev; // һ
+	qoi_rgb_t seed; // ׸صԤֵ(ֵʱΪ0)
+	const unsigned char* prev_row; // һ(ΪNULL, ԤʱֱӶȡ)
+	unsigned char* line; // ݴ(׵ַ, ʱ汾εõһ)
+	_Bool line_owned; // ݴɱз(־, Ϊ0ʱɵṩ)
+	uint32_t img_w; // ͼ
+	uint32_t img_h; // ͼ߶
+	uint32_t row; // ѱ
+	int run; // ǰγ̳
+#ifdef EQOI_STATS
+	qoi_enc_stats_t* stats; // ׮ͳ(ָ, ΪNULLʱͳ)
+#endif
+#ifdef EQOI_PROFILE
+	qoi_prof_t* prof; // ֽ׶μʱ(ָ, ΪNULLʱʱ)
+#endif
+} qoi_encoder_t;
+
+// (ṹ嶨)
+typedef struct {
+	qoi_rgb_t index_tb[INDEX_TB_L]; // 
+	qoi_rgb_t px; // ǰ
+	qoi_rgb_t seed; // ׸صԤֵ(ֵʱΪ0)
+	const unsigned char* prev_row; // һڽ뻺еĵַ(ΪNULL, ԤʱֱӶȡ)
+	unsigned char* pencoded; // ѹ(ָ)
+	size_t encoded_len; // ѹݳ
+	size_t p; // һȡֽλ
+	uint64_t run; // ʣγ̳
+	uint32_t img_w; // ͼ
+	uint32_t img_h; // ͼ߶
+	uint32_t row; // ѽ
+#ifdef EQOI_PROFILE
+	qoi_prof_t* prof; // ֽ׶μʱ(ָ, ΪNULLʱʱ)
+#endif
+} qoi_decoder_t;
+
+// ֵԤ(ģʽϸ)ı״̬(ṹ嶨)
+typedef struct {
+	qoi_rgb_t index_tb[INDEX_TB_L]; // 
+	qoi_rgb_t px; // һ
+	uint64_t run; // ǰγ̳()ʣγ̳()
+	size_t p; // һȡֽλ(ʹ)
+} qoi_pred_state_t;
+
+// еĽλ(ṹ嶨)
+typedef struct {
+	size_t p; // һȡֽλ
+	uint64_t run; // ʣγ̳(شγмʱ0)
+} qoi_mark_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef EQOI_PROFILE
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+
+// ȡʱ(x86Ϊrdtsc)
+static inline uint64_t qoi_prof_ticks(void) {
+	return __rdtsc();
+}
+#else
+#include <time.h>
+
+// ȡʱ(ƽ̨Եʱӵ)
+static inline uint64_t qoi_prof_ticks(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EQOI_NO_MALLOC
+size_t enhanced_qoi_encode(unsigned char* prgb, unsigned char* pCompressed, uint32_t img_w, uint32_t img_h); // ͼQOI
+size_t enhanced_qoi_encode_rect(unsigned char* prgb, size_t stride, unsigned char* pCompressed, uint32_t img_w, uint32_t img_h); // ͼеľQOI
+#endif
+size_t enhanced_qoi_encode_rect_scratch(unsigned char* prgb, size_t stride, unsigned char* pCompressed, uint32_t img_w, uint32_t img_h,
+	void* scratch); // ʹõṩݴԾQOI
+void enhanced_qoi_decode(unsigned char* pencoded, unsigned char* pdecoded, uint32_t img_w, uint32_t img_h); // ͼQOI
+void enhanced_qoi_decode_rect(unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride, uint32_t img_w, uint32_t img_h); // ͼеľQOI
+
+size_t eqoi_scratch_size(uint32_t img_w); // ȡݴС(ֽ)
+#ifndef EQOI_NO_MALLOC
+_Bool enhanced_qoi_encoder_init(qoi_encoder_t* enc, uint32_t img_w, uint32_t img_h); // ʼ
+#endif
+_Bool enhanced_qoi_encoder_init_scratch(qoi_encoder_t* enc, uint32_t img_w, uint32_t img_h, void* scratch); // ʹõṩݴʼ
+size_t enhanced_qoi_encode_rows(qoi_encoder_t* enc, unsigned char* prgb, size_t stride, uint32_t rows, unsigned char* pCompressed); // 
+void enhanced_qoi_encoder_set_dict(qoi_encoder_t* enc, const qoi_dict_t* dict); // ֵñĳʼ״̬
+void enhanced_qoi_encoder_free(qoi_encoder_t* enc); // ٱ
+_Bool enhanced_qoi_decoder_init(qoi_decoder_t* dec, unsigned char* pencoded, size_t encoded_len, uint32_t img_w, uint32_t img_h); // ʼ
+void enhanced_qoi_decode_rows(qoi_decoder_t* dec, unsigned char* pdecoded, size_t stride, uint32_t rows); // 
+void enhanced_qoi_decoder_set_dict(qoi_decoder_t* dec, const qoi_dict_t* dict); // ֵýĳʼ״̬
+void enhanced_qoi_decoder_seek(qoi_decoder_t* dec, const qoi_mark_t* mark, uint32_t row, const qoi_rgb_t* index_tb,
+	const unsigned char* prev_row); // Ա״̬ѽƵָе
+void enhanced_qoi_decoder_free(qoi_decoder_t* dec); // ٽ
+uint64_t enhanced_qoi_scan_span(const unsigned char* pencoded, size_t encoded_len, size_t* pp, size_t end); // ɨend֮ǰʼı
+void enhanced_qoi_scan_mark(const unsigned char* pencoded, size_t encoded_len, size_t p, uint64_t px_pos, uint64_t target,
+	qoi_mark_t* mark); // ɨõָصĽλ
+void enhanced_qoi_parse_rows(const unsigned char* pencoded, size_t encoded_len, const qoi_mark_t* mark, uint32_t img_w, uint32_t rows,
+	unsigned char* pdecoded, size_t stride, unsigned char* kinds); // ׵Ľλеıغ
+void enhanced_qoi_resolve_rows(qoi_decoder_t* dec, unsigned char* pdecoded, size_t stride, const unsigned char* kinds,
+	uint32_t rows); // ɽؽ
+void enhanced_qoi_pred_init(qoi_pred_state_t* st); // ʼֵԤı״̬
+size_t enhanced_qoi_encode_pred(qoi_pred_state_t* st, const unsigned char* ppx, size_t step, const unsigned char* ppred, size_t n,
+	_Bool feedback, _Bool last, unsigned char* pCompressed); // Ե߸Ԥֵһ
+size_t enhanced_qoi_decode_pred(qoi_pred_state_t* st, const unsigned char* pencoded, size_t encoded_len, const unsigned char* ppred,
+	size_t n, _Bool feedback, unsigned char* pdecoded, size_t step); // Ե߸Ԥֵһ
+
+void enhanced_qoi_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, qoi_op_stats_t* stats); // ɨͳƸ
+
+#endif
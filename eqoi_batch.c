@@ -0,0 +1,248 @@
+/************************************************************************************************************************
+ǿQOI
+@brief  һͼ߳, ÿ鸴ͬһݴ, ѹŲƫƱλ
+@date   2026/10/18
+@info   ʱд밴Ԥλ, ȫɺٰν(eqoi_encodeֿķʽͬ)
+************************************************************************************************************************/
+
+#include "eqoi_batch.h"
+#include "eqoi_parallel.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// (ṹ嶨)
+typedef struct {
+	const eqoi_image_t* imgs; // ͼ(׵ַ)
+	uint32_t n; // ͼ
+	const eqoi_dict_t* dict; // ֵ(ָ, NULLʾʹֵ)
+	unsigned char* dst; // (ָ)
+	uint64_t* offsets; // ͼдλ(׵ַ)
+	uint64_t* chunk_len; // ѹ(׵ַ)
+	unsigned char* scratch; // ݴ(׵ַ)
+	size_t scratch_size; // ÿݴС(ֽ)
+} batch_enc_job_t;
+
+// (ṹ嶨)
+typedef struct {
+	const eqoi_image_t* imgs; // ͼ(׵ַ)
+	uint32_t n; // ͼ
+	const eqoi_dict_t* dict; // ֵ(ָ, NULLʾʹֵ)
+	const unsigned char* src; // ѹ(ָ)
+	const uint64_t* offsets; // ƫƱ(׵ַ)
+} batch_dec_job_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void encode_chunk_task(void* arg, uint32_t k); // һͼ()
+static void decode_chunk_task(void* arg, uint32_t k); // һͼ()
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  󳤶(ÿ4ֽ)
+@param  imgs ͼ(׵ַ)
+		n ͼ
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_batch_max_size(const eqoi_image_t* imgs, uint32_t n) {
+	uint64_t len = 0;
+
+	for (uint32_t i = 0; i < n; i++) {
+		len += (uint64_t)imgs[i].width * imgs[i].height * 4;
+	}
+
+	return len > SIZE_MAX ? SIZE_MAX : (size_t)len;
+}
+
+/*************************
+@encode
+@public
+@brief  һͼ
+@param  imgs ͼ(׵ַ)
+		n ͼ
+		threads ߳(<=0ʾʹȫCPU, 1ʾڵ߳˳)
+		dict ֵ(ָ, NULLʾʹֵ)
+		dst (ָ)
+		cap (Сeqoi_batch_max_size)
+		offsets ƫƱ(׵ַ, n+1, ɱд)
+		out_len ѹܳ(ָ)
+@return 
+*************************/
+int eqoi_encode_batch(const eqoi_image_t* imgs, uint32_t n, int threads, const eqoi_dict_t* dict, unsigned char* dst,
+	size_t cap, uint64_t* offsets, size_t* out_len) {
+	if ((n && (imgs == NULL || dst == NULL)) || offsets == NULL || out_len == NULL) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint32_t max_w = 0;
+	uint64_t p = 0;
+
+	// Ԥͼдλ
+	for (uint32_t i = 0; i < n; i++) {
+		if (imgs[i].prgb == NULL || !imgs[i].width || !imgs[i].height) {
+			return EQOI_ERR_ARG;
+		}
+
+		offsets[i] = p;
+		p += (uint64_t)imgs[i].width * imgs[i].height * 4;
+		max_w = __MAX(max_w, imgs[i].width);
+	}
+
+	offsets[n] = p;
+	*out_len = 0;
+
+	if (p > cap) {
+		return EQOI_ERR_MEM;
+	}
+	if (!n) {
+		return EQOI_OK;
+	}
+
+	uint32_t chunks = (n + EQOI_BATCH_CHUNK - 1) / EQOI_BATCH_CHUNK;
+	size_t scratch_size = eqoi_scratch_size(max_w);
+	unsigned char* arena = malloc((size_t)chunks * (sizeof(uint64_t) + scratch_size));
+
+	if (arena == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	batch_enc_job_t job = { imgs, n, dict, dst, offsets, (uint64_t*)arena, arena + (size_t)chunks * sizeof(uint64_t), scratch_size };
+	eqoi_parallel_for(chunks, threads, encode_chunk_task, &job);
+
+	p = 0;
+
+	for (uint32_t k = 0; k < chunks; k++) {
+		uint32_t first = k * EQOI_BATCH_CHUNK;
+		uint32_t end = __MIN(first + EQOI_BATCH_CHUNK, n);
+		uint64_t base = offsets[first];
+
+		if (base != p) {
+			memmove(dst + p, dst + base, (size_t)job.chunk_len[k]);
+
+			for (uint32_t i = first; i < end; i++) {
+				offsets[i] -= base - p;
+			}
+		}
+
+		p += job.chunk_len[k];
+	}
+
+	offsets[n] = p;
+	*out_len = (size_t)p;
+	free(arena);
+
+	return EQOI_OK;
+}
+
+/*************************
+@decode
+@public
+@brief  һͼ
+@param  src ѹ(ָ)
+		src_len ѹݳ
+		offsets ƫƱ(׵ַ, n+1)
+		imgs ͼ(׵ַ, ָͼĽ뻺)
+		n ͼ
+		threads ߳(<=0ʾʹȫCPU, 1ʾڵ߳˳)
+		dict ʱʹõֵ(ָ, NULLʾʹֵ)
+@return 
+*************************/
+int eqoi_decode_batch(const unsigned char* src, size_t src_len, const uint64_t* offsets, const eqoi_image_t* imgs,
+	uint32_t n, int threads, const eqoi_dict_t* dict) {
+	if (n && (src == NULL || offsets == NULL || imgs == NULL)) {
+		return EQOI_ERR_ARG;
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		if (imgs[i].prgb == NULL || !imgs[i].width || !imgs[i].height) {
+			return EQOI_ERR_ARG;
+		}
+		if (offsets[i] > offsets[i + 1] || offsets[i + 1] > src_len) {
+			return EQOI_ERR_FORMAT;
+		}
+	}
+
+	if (n) {
+		batch_dec_job_t job = { imgs, n, dict, src, offsets };
+
+		eqoi_parallel_for((n + EQOI_BATCH_CHUNK - 1) / EQOI_BATCH_CHUNK, threads, decode_chunk_task, &job);
+	}
+
+	return EQOI_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@encode
+@private
+@brief  һͼ(, ͼдڸԤʼ)
+@param  arg (ָ)
+		k 
+@return none
+*************************/
+static void encode_chunk_task(void* arg, uint32_t k) {
+	batch_enc_job_t* job = (batch_enc_job_t*)arg;
+	uint32_t first = k * EQOI_BATCH_CHUNK;
+	uint32_t end = __MIN(first + EQOI_BATCH_CHUNK, job->n);
+	unsigned char* scratch = job->scratch + (size_t)k * job->scratch_size;
+	uint64_t base = job->offsets[first];
+	uint64_t p = base;
+	qoi_encoder_t enc;
+
+	for (uint32_t i = first; i < end; i++) {
+		const eqoi_image_t* img = job->imgs + i;
+		size_t stride = img->stride ? img->stride : (size_t)img->width * 3;
+
+		enhanced_qoi_encoder_init_scratch(&enc, img->width, img->height, scratch);
+
+		if (job->dict != NULL) {
+			enhanced_qoi_encoder_set_dict(&enc, &job->dict->state);
+		}
+
+		job->offsets[i] = p;
+		p += enhanced_qoi_encode_rows(&enc, img->prgb, stride, img->height, job->dst + p);
+
+		enhanced_qoi_encoder_free(&enc);
+	}
+
+	job->chunk_len[k] = p - base;
+}
+
+/*************************
+@decode
+@private
+@brief  һͼ()
+@param  arg (ָ)
+		k 
+@return none
+*************************/
+static void decode_chunk_task(void* arg, uint32_t k) {
+	batch_dec_job_t* job = (batch_dec_job_t*)arg;
+	uint32_t first = k * EQOI_BATCH_CHUNK;
+	uint32_t end = __MIN(first + EQOI_BATCH_CHUNK, job->n);
+	qoi_decoder_t init, dec;
+
+	// ʼ״̬(ֵ)ÿֻһ, ͼ临ƺֻ滻ߴ
+	enhanced_qoi_decoder_init(&init, NULL, 0, 0, 0);
+
+	if (job->dict != NULL) {
+		enhanced_qoi_decoder_set_dict(&init, &job->dict->state);
+	}
+
+	for (uint32_t i = first; i < end; i++) {
+		const eqoi_image_t* img = job->imgs + i;
+		size_t stride = img->stride ? img->stride : (size_t)img->width * 3;
+
+		dec = init;
+		dec.pencoded = (unsigned char*)job->src + job->offsets[i];
+		dec.encoded_len = (size_t)(job->offsets[i + 1] - job->offsets[i]);
+		dec.img_w = img->width;
+		dec.img_h = img->height;
+
+		enhanced_qoi_decode_rows(&dec, img->prgb, stride, img->height);
+		enhanced_qoi_decoder_free(&dec);
+	}
+}
@@ -0,0 +1,39 @@
+/************************************************************************************************************************
+ǿQOI
+@brief  ӿͷļ
+@date   2026/10/18
+@info   Сͼ(ͼꡢͼ)ӿ: һεñһͼ, ȫѹ,
+		ɵṩƫƱ(ͼ+1)λ, ͼiѹݼΪ[offsets[i], offsets[i+1]),
+		ÿͼΪǿQOI(еķֿͬ, ļͷ)
+		ͬһСͼ(ͼꡢΡͼƬ)ɹһֵ, ÿͼ񶼴ֵ״̬ʼ, ʱ봫ͬһֵ
+		ͼEQOI_BATCH_CHUNKһ߳, ÿ鸴ͬһͬһݴ, ֻһڴ
+************************************************************************************************************************/
+
+#ifndef __EQOI_BATCH_H
+#define __EQOI_BATCH_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_BATCH_CHUNK 256 // ÿͼ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ͼ(ṹ嶨)
+typedef struct {
+	unsigned char* prgb; // (ָ, ʱΪ, ʱΪ)
+	size_t stride; // п(ֽ, 0ʾ*3)
+	uint32_t width; // ͼ
+	uint32_t height; // ͼ߶
+} eqoi_image_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t eqoi_batch_max_size(const eqoi_image_t* imgs, uint32_t n); // 󳤶
+int eqoi_encode_batch(const eqoi_image_t* imgs, uint32_t n, int threads, const eqoi_dict_t* dict, unsigned char* dst,
+	size_t cap, uint64_t* offsets, size_t* out_len); // һͼ
+int eqoi_decode_batch(const unsigned char* src, size_t src_len, const uint64_t* offsets, const eqoi_image_t* imgs,
+	uint32_t n, int threads, const eqoi_dict_t* dict); // һͼ
+
+#endif
@@ -0,0 +1,1023 @@
+/************************************************************************************************************************
+ǿQOIĻ׼
+@brief  ظʱEQOIPNG/memcpy׼, ͳи͵ռ
+@date   2026/10/18
+@info   ÿһִcfg->warmup(ʱ), ִcfg->repsβ¼ÿκʱ, ȡλ99ٷλ,
+		ظ100ʱ99ٷλΪһ
+		͵ռͨɨõ, Ҫڱв׮
+		ĸļд밴ļԤλ, ַʽԽУ
+		λԽ8λƵĿλ, λȷԵľ(ģ⴫; λȫΪ0ʱֱõ
+		ʵѹ), EQOI16λPNGͬһ
+		ҶȲBT.601Ȩת, ͸ΪԲ𻯵; ͨʱMEDչΪRGBͬһҶͼ,
+		Ҷģʽ֮ǰɨĵͼĴʽ, ߵѹʶڵͨԭʼ
+		BayerԽRGBͼüΪżߺɫƬÿйȡ1ͨ, MEDüRGBͼ
+		(ȥ֮ѹ), ѹͬ˵ԭʼ
+		YUVBT.601ȫΧϵת, ɫȡ2x2(4:2:2ʱΪ2x1)ƽֵ; ΪԭRGBͼMED,
+		ѹYUVԭʼ, YUVԲPNG׼
+		𵵲ڵǰĲ֮л¼ʱ(Խָԭĵ), 8λRGBں,
+		Ľֻӳʱ
+************************************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "eqoi_bench.h"
+#include "eqoi_png16.h"
+#include "stb_image.h"
+#include "stb_image_write.h"
+
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// PNG(ṹ嶨)
+typedef struct {
+	unsigned char* buf; // (׵ַ)
+	size_t len; // дĳ
+	size_t cap; // 
+	_Bool failed; // ڴʧ(־)
+} png_sink_t;
+
+// ׼(ṹ嶨)
+typedef struct {
+	const eqoi_bench_cfg_t* cfg; // ׼(ָ)
+	unsigned char* prgb; // ԭʼ(ָ, λʱΪչuint16_t)
+	size_t raw_len; // ԭʼݳ
+	int comp; // PNG׼ͨ
+	uint32_t img_w; // ͼ
+	uint32_t img_h; // ͼ߶
+	unsigned char* file_buf; // EQOIļ(ָ)
+	size_t file_cap; // EQOIļ
+	size_t file_len; // EQOIļ
+	unsigned char* decoded; // (ָ)
+	eqoi_yuv_t yuv; // YUVԭʼݵڴ
+	eqoi_yuv_t yuv_out; // YUVнڴ(ԭʼͬ)
+	png_sink_t png; // PNGļ
+	const eqoi_image_t* imgs; // Եͼ(׵ַ)
+	eqoi_image_t* outs; // ԵĽ(׵ַ)
+	uint32_t n; // Եͼ
+	uint64_t* slots; // ʱļдλ(׵ַ)
+	size_t* lens; // ʱļĳ(׵ַ)
+	uint64_t* offsets; // ƫƱ(׵ַ)
+} bench_ctx_t;
+
+typedef int (*bench_fn)(bench_ctx_t* ctx); // ʱĲ(ش)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char* op_names[QOI_ID_CNT] = { "RUN", "INDEX", "DIFF", "DIFF3", "LUMA", "DIFF2", "RGB" }; // 
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int run_timed(bench_fn fn, bench_ctx_t* ctx, eqoi_bench_time_t* t); // ԤȲظʱһ
+static int do_encode(bench_ctx_t* ctx); // EQOI
+static int do_decode(bench_ctx_t* ctx); // EQOI
+static int do_png_encode(bench_ctx_t* ctx); // PNG
+static int do_png_decode(bench_ctx_t* ctx); // PNG
+static int do_copy(bench_ctx_t* ctx); // memcpy
+static int bench_tiers(bench_ctx_t* ctx, eqoi_bench_result_t* res); // 𵵼ʱEQOI
+static void widen(const unsigned char* src, size_t n, int bit_depth, uint16_t* dst); // 8λչΪλ
+static void to_gray(const unsigned char* prgb, uint32_t img_w, uint32_t img_h, int channels, unsigned char* dst); // RGBͼתΪҶ(Ҷ+͸)
+static void to_bayer(const unsigned char* prgb, uint32_t src_w, uint32_t img_w, uint32_t img_h, int pattern,
+	unsigned char* dst); // RGBͼΪBayer
+static void to_yuv(const unsigned char* prgb, uint32_t img_w, uint32_t img_h, int sub_y, const eqoi_yuv_t* dst); // RGBͼתΪYUV
+static int do_single_encode(bench_ctx_t* ctx); // EQOI
+static int do_single_decode(bench_ctx_t* ctx); // EQOI
+static int do_batch_encode(bench_ctx_t* ctx); // EQOI
+static int do_batch_decode(bench_ctx_t* ctx); // EQOI
+static _Bool batch_matches(const bench_ctx_t* ctx); // УԵĽ
+static void png_write(void* context, void* data, int size); // PNGص
+static void print_share(FILE* fp, const char* label, const uint64_t* v, _Bool gray); // ӡ͵ռ
+static double to_mps(uint64_t pixels, double s); // 
+static int cmp_double(const void* a, const void* b); // Ƚ()
+static double now_s(void); // ȡʱ()
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@init
+@public
+@brief  ʼ׼(Ĭֵ)
+@param  cfg ׼(ָ)
+@return none
+*************************/
+void eqoi_bench_init_cfg(eqoi_bench_cfg_t* cfg) {
+	memset(cfg, 0, sizeof(eqoi_bench_cfg_t));
+
+	cfg->reps = EQOI_BENCH_DEFAULT_REPS;
+	cfg->warmup = EQOI_BENCH_DEFAULT_WARMUP;
+	cfg->threads = 1;
+	cfg->baselines = 1;
+	cfg->codec = EQOI_CODEC_AUTO;
+	cfg->bit_depth = 8;
+	cfg->channels = 3;
+}
+
+/*************************
+@run
+@public
+@brief  һͼл׼(У)
+@param  prgb (ָ, 8λ)
+		img_w ͼ
+		img_h ͼ߶
+		cfg ׼(ָ, λ8ʱչ, ͨС3ʱתΪҶ, ָɫƬʱȲΪ,
+			ָɫȳʱתΪYUV)
+		res ׼Խ(ָ)
+@return (УʧʱEQOI_ERR_FORMAT)
+*************************/
+int eqoi_bench_image(unsigned char* prgb, uint32_t img_w, uint32_t img_h, const eqoi_bench_cfg_t* cfg,
+	eqoi_bench_result_t* res) {
+	_Bool wide = cfg->bit_depth > 8;
+	_Bool gray = cfg->channels < 3;
+	_Bool cfa = cfg->bayer != 0;
+	_Bool yuv = cfg->yuv != 0;
+	uint32_t src_w = img_w;
+	unsigned char* src_rgb = prgb;
+
+	// 2x2Ԫ
+	if (cfa) {
+		img_w &= ~1u;
+		img_h &= ~1u;
+	}
+
+	int comp = cfa ? 1 : gray ? cfg->channels : 3;
+	size_t raw_len = (size_t)img_w * img_h * comp * (wide ? sizeof(uint16_t) : 1);
+	unsigned char* samples = NULL;
+	bench_ctx_t ctx;
+
+	memset(res, 0, sizeof(eqoi_bench_result_t));
+	memset(&ctx, 0, sizeof(bench_ctx_t));
+
+	if (yuv) {
+		raw_len = eqoi_yuv_layout(NULL, img_w, img_h, EQOI_YUV_SUB_Y(cfg->yuv), cfg->yuv_planar, &ctx.yuv);
+	}
+
+	if (!img_w || !img_h || cfg->reps <= 0 || (wide && cfg->bit_depth > EQOI_WIDE_MAX_DEPTH) ||
+		cfg->channels < 1 || cfg->channels > 3 || (wide && gray) || (cfa && (wide || gray || !EQOI_FMT_IS_BAYER(cfg->bayer))) ||
+		(yuv && (wide || gray || cfa || !EQOI_FMT_IS_YUV(cfg->yuv)))) {
+		return EQOI_ERR_ARG;
+	}
+
+	if (wide || gray || cfa || yuv) {
+		samples = malloc(raw_len);
+
+		if (samples == NULL) {
+			return EQOI_ERR_MEM;
+		}
+
+		if (wide) {
+			widen(prgb, (size_t)img_w * img_h * 3, cfg->bit_depth, (uint16_t*)samples);
+		}
+		else if (cfa) {
+			to_bayer(prgb, src_w, img_w, img_h, cfg->bayer, samples);
+		}
+		else if (yuv) {
+			eqoi_yuv_layout(samples, img_w, img_h, EQOI_YUV_SUB_Y(cfg->yuv), cfg->yuv_planar, &ctx.yuv);
+			to_yuv(prgb, img_w, img_h, EQOI_YUV_SUB_Y(cfg->yuv), &ctx.yuv);
+		}
+		else {
+			to_gray(prgb, img_w, img_h, cfg->channels, samples);
+		}
+
+		prgb = samples;
+	}
+
+	ctx.cfg = cfg;
+	ctx.prgb = prgb;
+	ctx.raw_len = raw_len;
+	ctx.comp = comp;
+	ctx.img_w = img_w;
+	ctx.img_h = img_h;
+	ctx.file_cap = wide ? eqoi_max_file_size_wide(img_w, img_h, cfg->tile_w, cfg->tile_h, cfg->bit_depth) :
+		gray || cfa ? eqoi_max_file_size_gray(img_w, img_h, cfg->tile_w, cfg->tile_h, comp) :
+		yuv ? eqoi_max_file_size_yuv(img_w, img_h, cfg->tile_w, cfg->tile_h, cfg->yuv) :
+		eqoi_max_file_size(img_w, img_h, cfg->tile_w, cfg->tile_h);
+	ctx.file_buf = malloc(ctx.file_cap);
+	ctx.decoded = malloc(raw_len);
+
+	if (yuv) {
+		eqoi_yuv_layout(ctx.decoded, img_w, img_h, EQOI_YUV_SUB_Y(cfg->yuv), cfg->yuv_planar, &ctx.yuv_out);
+	}
+
+	int err = (ctx.file_buf == NULL || ctx.decoded == NULL) ? EQOI_ERR_MEM : EQOI_OK;
+
+	if (err == EQOI_OK) {
+		err = run_timed(do_encode, &ctx, &res->enc);
+	}
+	if (err == EQOI_OK) {
+		err = run_timed(do_decode, &ctx, &res->dec);
+	}
+	if (err == EQOI_OK && memcmp(prgb, ctx.decoded, raw_len)) {
+		err = EQOI_ERR_FORMAT;
+	}
+	if (err == EQOI_OK) {
+		eqoi_header_t hdr;
+
+		err = eqoi_parse_header(ctx.file_buf, ctx.file_len, &hdr);
+		if (err == EQOI_OK) {
+			err = eqoi_scan_ops(ctx.file_buf, &hdr, &res->ops);
+		}
+	}
+	if (err == EQOI_OK && cfg->tiers) {
+		err = bench_tiers(&ctx, res);
+	}
+
+	// PNG׼(stbĽӿʹintʾ, ͼ)
+	if (err == EQOI_OK && cfg->baselines && raw_len <= INT_MAX / 2 && !yuv) {
+		err = run_timed(do_png_encode, &ctx, &res->png_enc);
+		if (err == EQOI_OK) {
+			err = run_timed(do_png_decode, &ctx, &res->png_dec);
+		}
+		if (err == EQOI_OK && memcmp(prgb, ctx.decoded, raw_len)) {
+			err = EQOI_ERR_FORMAT;
+		}
+
+		res->png_len = ctx.png.len;
+	}
+	if (err == EQOI_OK && cfg->baselines) {
+		err = run_timed(do_copy, &ctx, &res->copy);
+	}
+
+	// : ͬһҶͼչΪRGB(Bayer/YUVΪ(ü)ԭRGBͼ)MED
+	if (err == EQOI_OK && (cfg->channels == 1 || cfa || yuv)) {
+		unsigned char* expanded = malloc((size_t)img_w * img_h * 3);
+		eqoi_bench_cfg_t rgb_cfg = *cfg;
+		eqoi_bench_result_t rgb_res;
+
+		rgb_cfg.channels = 3;
+		rgb_cfg.bayer = 0;
+		rgb_cfg.yuv = 0;
+		rgb_cfg.codec = EQOI_CODEC_MED;
+		rgb_cfg.baselines = 0;
+		rgb_cfg.tiers = 0;
+
+		if (expanded == NULL) {
+			err = EQOI_ERR_MEM;
+		}
+		else {
+			if (cfa || yuv) {
+				for (uint32_t y = 0; y < img_h; y++) {
+					memcpy(expanded + (size_t)y * img_w * 3, src_rgb + (size_t)y * src_w * 3, (size_t)img_w * 3);
+				}
+			}
+			else {
+				for (size_t i = 0; i < raw_len; i++) {
+					memset(expanded + i * 3, prgb[i], 3);
+				}
+			}
+
+			err = eqoi_bench_image(expanded, img_w, img_h, &rgb_cfg, &rgb_res);
+			free(expanded);
+
+			res->rgb_len = rgb_res.enc_len;
+			res->rgb_enc = rgb_res.enc;
+			res->rgb_dec = rgb_res.dec;
+		}
+	}
+
+	res->images = 1;
+	res->pixels = (uint64_t)img_w * img_h;
+	res->raw_len = raw_len;
+	res->enc_len = ctx.file_len;
+
+	free(ctx.file_buf);
+	free(ctx.decoded);
+	free(ctx.png.buf);
+	free(samples);
+
+	return err;
+}
+
+/*************************
+@calc
+@public
+@brief  ۼӻ׼Խ(ʱ, ʼΪ/ܺʱ)
+@param  total ܽ(ָ)
+		res ͼĽ(ָ)
+@return none
+*************************/
+void eqoi_bench_accumulate(eqoi_bench_result_t* total, const eqoi_bench_result_t* res) {
+	eqoi_bench_time_t* dst[7] = { &total->enc, &total->dec, &total->png_enc, &total->png_dec, &total->copy,
+		&total->rgb_enc, &total->rgb_dec };
+	const eqoi_bench_time_t* src[7] = { &res->enc, &res->dec, &res->png_enc, &res->png_dec, &res->copy,
+		&res->rgb_enc, &res->rgb_dec };
+
+	total->images += res->images;
+	total->pixels += res->pixels;
+	total->raw_len += res->raw_len;
+	total->enc_len += res->enc_len;
+	total->png_len += res->png_len;
+	total->rgb_len += res->rgb_len;
+
+	for (int i = 0; i < 7; i++) {
+		dst[i]->med_s += src[i]->med_s;
+		dst[i]->p99_s += src[i]->p99_s;
+	}
+
+	for (int t = 0; t < EQOI_TIER_CNT; t++) {
+		total->tier_enc[t].med_s += res->tier_enc[t].med_s;
+		total->tier_enc[t].p99_s += res->tier_enc[t].p99_s;
+		total->tier_dec[t].med_s += res->tier_dec[t].med_s;
+		total->tier_dec[t].p99_s += res->tier_dec[t].p99_s;
+	}
+
+	for (int i = 0; i < QOI_ID_CNT; i++) {
+		total->ops.ops[i] += res->ops.ops[i];
+		total->ops.pixels[i] += res->ops.pixels[i];
+		total->ops.bytes[i] += res->ops.bytes[i];
+	}
+}
+
+/*************************
+@io
+@public
+@brief  ӡ׼Խ
+@param  fp ļ
+		title (ͼ·ߴ)
+		res ׼Խ(ָ)
+		cfg ׼(ָ)
+@return none
+*************************/
+void eqoi_bench_print(FILE* fp, const char* title, const eqoi_bench_result_t* res, const eqoi_bench_cfg_t* cfg) {
+	double raw = (double)res->raw_len;
+
+	fprintf(fp, "%s\n", title);
+	fprintf(fp, "  eqoi    ratio %.4f  encode %8.1f MP/s (p99 %8.1f)  decode %8.1f MP/s (p99 %8.1f)\n",
+		res->enc_len / raw, to_mps(res->pixels, res->enc.med_s), to_mps(res->pixels, res->enc.p99_s),
+		to_mps(res->pixels, res->dec.med_s), to_mps(res->pixels, res->dec.p99_s));
+
+	if (cfg->baselines && res->png_len) {
+		fprintf(fp, "  %-7s ratio %.4f  encode %8.1f MP/s (p99 %8.1f)  decode %8.1f MP/s (p99 %8.1f)\n",
+			cfg->bit_depth > 8 ? "png16" : "png", res->png_len / raw, to_mps(res->pixels, res->png_enc.med_s), to_mps(res->pixels, res->png_enc.p99_s),
+			to_mps(res->pixels, res->png_dec.med_s), to_mps(res->pixels, res->png_dec.p99_s));
+	}
+	if (res->rgb_len) {
+		fprintf(fp, "  %-7s ratio %.4f  encode %8.1f MP/s (p99 %8.1f)  decode %8.1f MP/s (p99 %8.1f)\n",
+			cfg->bayer || cfg->yuv ? "rgb" : "as rgb", res->rgb_len / raw, to_mps(res->pixels, res->rgb_enc.med_s), to_mps(res->pixels, res->rgb_enc.p99_s),
+			to_mps(res->pixels, res->rgb_dec.med_s), to_mps(res->pixels, res->rgb_dec.p99_s));
+	}
+	if (cfg->baselines) {
+		fprintf(fp, "  memcpy                copy   %8.1f MP/s (p99 %8.1f)\n",
+			to_mps(res->pixels, res->copy.med_s), to_mps(res->pixels, res->copy.p99_s));
+	}
+	if (cfg->tiers) {
+		for (int t = 0; t < EQOI_TIER_CNT; t++) {
+			if (res->tier_enc[t].med_s > 0) {
+				fprintf(fp, "  %-7s               encode %8.1f MP/s (p99 %8.1f)  decode %8.1f MP/s (p99 %8.1f)%s\n",
+					eqoi_cpu_tier_name(t), to_mps(res->pixels, res->tier_enc[t].med_s), to_mps(res->pixels, res->tier_enc[t].p99_s),
+					to_mps(res->pixels, res->tier_dec[t].med_s), to_mps(res->pixels, res->tier_dec[t].p99_s),
+					t == eqoi_cpu_tier() ? "  (active)" : "");
+			}
+		}
+	}
+
+	// ҶȡҶ+͸ȡCFAYUVģʽʹûҶģʽı
+	_Bool gray = cfg->bit_depth <= 8 && (cfg->channels < 3 || cfg->bayer || cfg->yuv);
+
+	print_share(fp, "  pixels%", res->ops.pixels, gray);
+	print_share(fp, "  bytes% ", res->ops.bytes, gray);
+}
+
+/*************************
+@run
+@public
+@brief  һͼ׼(eqoi_encode/eqoi_decodeӿڶԱ, У)
+@param  imgs ͼ(׵ַ)
+		n ͼ
+		cfg ׼(ָ, ʹ÷ֿ׼)
+		res ׼Խ(ָ)
+@return (УʧʱEQOI_ERR_FORMAT)
+*************************/
+int eqoi_bench_batch(const eqoi_image_t* imgs, uint32_t n, const eqoi_bench_cfg_t* cfg,
+	eqoi_bench_batch_result_t* res) {
+	bench_ctx_t ctx;
+	uint64_t file_cap = 0, raw_len = 0;
+
+	memset(res, 0, sizeof(eqoi_bench_batch_result_t));
+	memset(&ctx, 0, sizeof(bench_ctx_t));
+
+	if (!n || cfg->reps <= 0) {
+		return EQOI_ERR_ARG;
+	}
+
+	ctx.cfg = cfg;
+	ctx.imgs = imgs;
+	ctx.n = n;
+	ctx.outs = malloc(sizeof(eqoi_image_t) * n);
+	ctx.slots = malloc(sizeof(uint64_t) * n);
+	ctx.lens = malloc(sizeof(size_t) * n);
+	ctx.offsets = malloc(sizeof(uint64_t) * ((size_t)n + 1));
+
+	int err = (ctx.outs == NULL || ctx.slots == NULL || ctx.lens == NULL || ctx.offsets == NULL) ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (uint32_t i = 0; i < n && err == EQOI_OK; i++) {
+		if (imgs[i].stride && imgs[i].stride != (size_t)imgs[i].width * 3) {
+			err = EQOI_ERR_ARG;
+			break;
+		}
+
+		ctx.slots[i] = file_cap;
+		file_cap += eqoi_max_file_size(imgs[i].width, imgs[i].height, 0, 0);
+		raw_len += (uint64_t)imgs[i].width * imgs[i].height * 3;
+	}
+
+	if (err == EQOI_OK) {
+		ctx.file_cap = (size_t)__MAX(file_cap, (uint64_t)eqoi_batch_max_size(imgs, n));
+		ctx.file_buf = malloc(ctx.file_cap);
+		ctx.decoded = malloc((size_t)raw_len);
+		err = (ctx.file_buf == NULL || ctx.decoded == NULL) ? EQOI_ERR_MEM : EQOI_OK;
+	}
+
+	if (err == EQOI_OK) {
+		unsigned char* p = ctx.decoded;
+
+		for (uint32_t i = 0; i < n; i++) {
+			ctx.outs[i] = (eqoi_image_t){ p, 0, imgs[i].width, imgs[i].height };
+			p += (size_t)imgs[i].width * imgs[i].height * 3;
+			res->pixels += (uint64_t)imgs[i].width * imgs[i].height;
+		}
+
+		err = run_timed(do_single_encode, &ctx, &res->single_enc);
+	}
+	if (err == EQOI_OK) {
+		err = run_timed(do_single_decode, &ctx, &res->single_dec);
+	}
+	if (err == EQOI_OK && !batch_matches(&ctx)) {
+		err = EQOI_ERR_FORMAT;
+	}
+	if (err == EQOI_OK) {
+		for (uint32_t i = 0; i < n; i++) {
+			res->single_len += ctx.lens[i];
+		}
+
+		memset(ctx.decoded, 0, (size_t)raw_len);
+		err = run_timed(do_batch_encode, &ctx, &res->batch_enc);
+	}
+	if (err == EQOI_OK) {
+		err = run_timed(do_batch_decode, &ctx, &res->batch_dec);
+	}
+	if (err == EQOI_OK && !batch_matches(&ctx)) {
+		err = EQOI_ERR_FORMAT;
+	}
+
+	res->images = n;
+	res->raw_len = raw_len;
+	res->batch_len = ctx.file_len;
+
+	free(ctx.file_buf);
+	free(ctx.decoded);
+	free(ctx.outs);
+	free(ctx.slots);
+	free(ctx.lens);
+	free(ctx.offsets);
+
+	return err;
+}
+
+/*************************
+@io
+@public
+@brief  ӡ׼Խ(ÿͼ)
+@param  fp ļ
+		title 
+		res ׼Խ(ָ)
+@return none
+*************************/
+void eqoi_bench_print_batch(FILE* fp, const char* title, const eqoi_bench_batch_result_t* res) {
+	const eqoi_bench_time_t* enc[2] = { &res->single_enc, &res->batch_enc };
+	const eqoi_bench_time_t* dec[2] = { &res->single_dec, &res->batch_dec };
+	const char* names[2] = { "single", "batch " };
+	uint64_t lens[2] = { res->single_len, res->batch_len };
+
+	fprintf(fp, "%s\n", title);
+
+	for (int k = 0; k < 2; k++) {
+		fprintf(fp, "  %s  ratio %.4f  encode %10.0f img/s %8.1f MP/s  decode %10.0f img/s %8.1f MP/s\n", names[k],
+			(double)lens[k] / res->raw_len, enc[k]->med_s > 0 ? res->images / enc[k]->med_s : 0.0,
+			to_mps(res->pixels, enc[k]->med_s), dec[k]->med_s > 0 ? res->images / dec[k]->med_s : 0.0,
+			to_mps(res->pixels, dec[k]->med_s));
+	}
+
+	fprintf(fp, "  speedup          encode %9.2fx                   decode %9.2fx\n",
+		res->batch_enc.med_s > 0 ? res->single_enc.med_s / res->batch_enc.med_s : 0.0,
+		res->batch_dec.med_s > 0 ? res->single_dec.med_s / res->batch_dec.med_s : 0.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@run
+@private
+@brief  ԤȲظʱһ
+@param  fn ʱĲ
+		ctx ׼(ָ)
+		t ʱ(ָ)
+@return 
+*************************/
+static int run_timed(bench_fn fn, bench_ctx_t* ctx, eqoi_bench_time_t* t) {
+	int reps = ctx->cfg->reps;
+	double* times = malloc(sizeof(double) * reps);
+	int err = times == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (int r = 0; r < ctx->cfg->warmup && err == EQOI_OK; r++) {
+		err = fn(ctx);
+	}
+
+	for (int r = 0; r < reps && err == EQOI_OK; r++) {
+		double t0 = now_s();
+		err = fn(ctx);
+		times[r] = now_s() - t0;
+	}
+
+	if (err == EQOI_OK) {
+		qsort(times, reps, sizeof(double), cmp_double);
+
+		int p99 = (reps * 99 + 99) / 100 - 1; // ceil(0.99 * reps) - 1
+
+		t->med_s = (reps & 1) ? times[reps / 2] : (times[reps / 2 - 1] + times[reps / 2]) / 2;
+		t->p99_s = times[p99];
+	}
+
+	free(times);
+
+	return err;
+}
+
+/*************************
+@run
+@private
+@brief  лCPUֵ֧ÿһں˼ʱEQOI(뵱ǰֽͬ, ָǰ)
+@param  ctx ׼(ָ, Եǰɱ)
+		res ׼Խ(ָ)
+@return (ͬʱEQOI_ERR_FORMAT)
+*************************/
+static int bench_tiers(bench_ctx_t* ctx, eqoi_bench_result_t* res) {
+	int active = eqoi_cpu_tier();
+	size_t len = ctx->file_len;
+	unsigned char* ref = malloc(len);
+	int err = ref == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	if (ref != NULL) {
+		memcpy(ref, ctx->file_buf, len);
+	}
+
+	for (int t = EQOI_TIER_SCALAR; t <= eqoi_cpu_best_tier() && err == EQOI_OK; t++) {
+		eqoi_cpu_set_tier(t);
+
+		err = run_timed(do_encode, ctx, &res->tier_enc[t]);
+		if (err == EQOI_OK && (ctx->file_len != len || memcmp(ctx->file_buf, ref, len))) {
+			err = EQOI_ERR_FORMAT;
+		}
+		if (err == EQOI_OK) {
+			err = run_timed(do_decode, ctx, &res->tier_dec[t]);
+		}
+		if (err == EQOI_OK && memcmp(ctx->prgb, ctx->decoded, ctx->raw_len)) {
+			err = EQOI_ERR_FORMAT;
+		}
+	}
+
+	eqoi_cpu_set_tier(active);
+	free(ref);
+
+	return err;
+}
+
+/*************************
+@encode
+@private
+@brief  EQOI(ʱĲ)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_encode(bench_ctx_t* ctx) {
+	const eqoi_bench_cfg_t* cfg = ctx->cfg;
+
+	if (cfg->bit_depth > 8) {
+		return eqoi_encode_wide((const uint16_t*)ctx->prgb, ctx->img_w, ctx->img_h, cfg->bit_depth, cfg->tile_w, cfg->tile_h,
+			cfg->threads, ctx->file_buf, ctx->file_cap, &ctx->file_len);
+	}
+	if (cfg->yuv) {
+		return eqoi_encode_yuv(&ctx->yuv, ctx->img_w, ctx->img_h, cfg->yuv, cfg->tile_w, cfg->tile_h, cfg->threads,
+			ctx->file_buf, ctx->file_cap, &ctx->file_len);
+	}
+	if (cfg->bayer) {
+		return eqoi_encode_cfa(ctx->prgb, ctx->img_w, ctx->img_h, cfg->bayer, cfg->tile_w, cfg->tile_h, cfg->threads,
+			ctx->file_buf, ctx->file_cap, &ctx->file_len);
+	}
+	if (cfg->channels < 3) {
+		return eqoi_encode_gray(ctx->prgb, ctx->img_w, ctx->img_h, cfg->channels, cfg->tile_w, cfg->tile_h, cfg->threads,
+			ctx->file_buf, ctx->file_cap, &ctx->file_len);
+	}
+
+	return eqoi_encode_codec(ctx->prgb, ctx->img_w, ctx->img_h, cfg->tile_w, cfg->tile_h, cfg->threads, cfg->codec,
+		cfg->dict, ctx->file_buf, ctx->file_cap, &ctx->file_len);
+}
+
+/*************************
+@decode
+@private
+@brief  EQOI(ʱĲ, ļͷ)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_decode(bench_ctx_t* ctx) {
+	eqoi_header_t hdr;
+	int err = eqoi_parse_header(ctx->file_buf, ctx->file_len, &hdr);
+
+	if (err == EQOI_OK) {
+		err = eqoi_use_dict(&hdr, ctx->cfg->dict);
+	}
+	if (err == EQOI_OK && ctx->cfg->yuv) {
+		err = eqoi_decode_yuv(ctx->file_buf, &hdr, ctx->cfg->threads, &ctx->yuv_out);
+	}
+	else if (err == EQOI_OK) {
+		err = eqoi_decode(ctx->file_buf, &hdr, ctx->cfg->threads, ctx->decoded);
+	}
+
+	return err;
+}
+
+/*************************
+@encode
+@private
+@brief  PNG(ʱĲ, stb_image_writeĬѹ, λʱΪ16λPNG)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_png_encode(bench_ctx_t* ctx) {
+	ctx->png.len = 0;
+	ctx->png.failed = 0;
+
+	if (ctx->cfg->bit_depth > 8) {
+		free(ctx->png.buf);
+		ctx->png.buf = eqoi_png16_write_mem((const uint16_t*)ctx->prgb, ctx->img_w, ctx->img_h, &ctx->png.len);
+		ctx->png.cap = ctx->png.len;
+
+		return ctx->png.buf == NULL ? EQOI_ERR_MEM : EQOI_OK;
+	}
+
+	int comp = ctx->comp;
+
+	if (!stbi_write_png_to_func(png_write, &ctx->png, (int)ctx->img_w, (int)ctx->img_h, comp, ctx->prgb, (int)ctx->img_w * comp)) {
+		return EQOI_ERR_ARG;
+	}
+
+	return ctx->png.failed ? EQOI_ERR_MEM : EQOI_OK;
+}
+
+/*************************
+@decode
+@private
+@brief  PNG(ʱĲ, stb_imageڴ)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_png_decode(bench_ctx_t* ctx) {
+	int w, h, n;
+
+	if (ctx->cfg->bit_depth > 8) {
+		stbi_us* data = stbi_load_16_from_memory(ctx->png.buf, (int)ctx->png.len, &w, &h, &n, STBI_rgb);
+
+		if (data == NULL) {
+			return EQOI_ERR_FORMAT;
+		}
+
+		memcpy(ctx->decoded, data, ctx->raw_len);
+		stbi_image_free(data);
+
+		return EQOI_OK;
+	}
+
+	unsigned char* data = stbi_load_from_memory(ctx->png.buf, (int)ctx->png.len, &w, &h, &n, ctx->comp);
+
+	if (data == NULL) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	memcpy(ctx->decoded, data, ctx->raw_len);
+	stbi_image_free(data);
+
+	return EQOI_OK;
+}
+
+/*************************
+@run
+@private
+@brief  memcpy(ʱĲ, ޵Ĳο)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_copy(bench_ctx_t* ctx) {
+	memcpy(ctx->decoded, ctx->prgb, ctx->raw_len);
+
+	return EQOI_OK;
+}
+
+/*************************
+@calc
+@private
+@brief  8λչΪλ(ƵĿλ, λȷԵľ)
+@param  src 8λ(ָ)
+		n 
+		bit_depth Ŀλ
+		dst λ(ָ)
+@return none
+*************************/
+static void widen(const unsigned char* src, size_t n, int bit_depth, uint16_t* dst) {
+	int s = bit_depth - 8;
+	uint32_t noise = 0x9e3779b9u;
+
+	for (size_t i = 0; i < n; i++) {
+		noise ^= noise << 13;
+		noise ^= noise >> 17;
+		noise ^= noise << 5;
+
+		dst[i] = (uint16_t)((src[i] << s) | (noise & ((1u << s) - 1)));
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  RGBͼתΪҶ(BT.601), 2ͨʱ͸ΪԲ𻯵
+@param  prgb RGB(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		channels ͨ(12)
+		dst (ָ)
+@return none
+*************************/
+static void to_gray(const unsigned char* prgb, uint32_t img_w, uint32_t img_h, int channels, unsigned char* dst) {
+	for (uint32_t y = 0; y < img_h; y++) {
+		double dy = (y + 0.5) / img_h * 2 - 1;
+
+		for (uint32_t x = 0; x < img_w; x++) {
+			const unsigned char* q = prgb + ((size_t)y * img_w + x) * 3;
+
+			*dst++ = (unsigned char)((77 * q[0] + 150 * q[1] + 29 * q[2] + 128) >> 8);
+
+			if (channels == 2) {
+				// Բڲ͸, 뾶0.8~1.0֮Թɵȫ͸
+				double dx = (x + 0.5) / img_w * 2 - 1;
+				double r = dx * dx + dy * dy;
+				double a = r <= 0.64 ? 1 : r >= 1 ? 0 : (1 - r) / 0.36;
+
+				*dst++ = (unsigned char)(a * 255 + 0.5);
+			}
+		}
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  RGBͼɫƬвΪBayer(ÿйȡӦ1ͨ)
+@param  prgb RGB(ָ)
+		src_w RGBͼ(пΪsrc_w*3)
+		img_w ˿(ż, src_w)
+		img_h ˸߶(ż)
+		pattern ɫƬ(EQOI_FMT_BAYER_*)
+		dst (ָ)
+@return none
+*************************/
+static void to_bayer(const unsigned char* prgb, uint32_t src_w, uint32_t img_w, uint32_t img_h, int pattern,
+	unsigned char* dst) {
+	// Ͻ2x2Ԫÿλõͨ(0ΪR, 1ΪG, 2ΪB)
+	static const unsigned char cfa_chan[4][4] = {
+		{ 0, 1, 1, 2 }, // RGGB
+		{ 1, 0, 2, 1 }, // GRBG
+		{ 1, 2, 0, 1 }, // GBRG
+		{ 2, 1, 1, 0 } // BGGR
+	};
+	const unsigned char* chan = cfa_chan[pattern - EQOI_FMT_BAYER_RGGB];
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const unsigned char* row = prgb + (size_t)y * src_w * 3;
+
+		for (uint32_t x = 0; x < img_w; x++) {
+			*dst++ = row[(size_t)x * 3 + chan[(y & 1) * 2 + (x & 1)]];
+		}
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  RGBͼתΪYUV(BT.601ȫΧ, ɫȡÿиɫȵƽֵ)
+@param  prgb RGB(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		sub_y ɫȵĴֱ(4:2:0Ϊ2, 4:2:2Ϊ1)
+		dst ڴ(ָ)
+@return none
+*************************/
+static void to_yuv(const unsigned char* prgb, uint32_t img_w, uint32_t img_h, int sub_y, const eqoi_yuv_t* dst) {
+	for (uint32_t y = 0; y < img_h; y++) {
+		for (uint32_t x = 0; x < img_w; x++) {
+			const unsigned char* q = prgb + ((size_t)y * img_w + x) * 3;
+
+			dst->y[(size_t)y * dst->y_stride + x] = (unsigned char)((77 * q[0] + 150 * q[1] + 29 * q[2] + 128) >> 8);
+		}
+	}
+
+	for (uint32_t cy = 0; cy * sub_y < img_h; cy++) {
+		for (uint32_t cx = 0; cx * 2 < img_w; cx++) {
+			int cb = 0, cr = 0, n = 0;
+
+			for (uint32_t y = cy * sub_y; y < __MIN(cy * sub_y + sub_y, img_h); y++) {
+				for (uint32_t x = cx * 2; x < __MIN(cx * 2 + 2, img_w); x++) {
+					const unsigned char* q = prgb + ((size_t)y * img_w + x) * 3;
+
+					// ƫʹλǸ
+					cb += __MIN((-43 * q[0] - 85 * q[1] + 128 * q[2] + 32896) >> 8, 255);
+					cr += __MIN((128 * q[0] - 107 * q[1] - 21 * q[2] + 32896) >> 8, 255);
+					n++;
+				}
+			}
+
+			size_t k = (size_t)cy * dst->c_stride + (size_t)cx * dst->c_step;
+
+			dst->u[k] = (unsigned char)((cb + n / 2) / n);
+			dst->v[k] = (unsigned char)((cr + n / 2) / n);
+		}
+	}
+}
+
+/*************************
+@encode
+@private
+@brief  eqoi_encode(ʱĲ, ÿͼдԤλ)
+@info   һʹMED, ԶѡĵɫģʽʹߵıȽʧȥ
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_single_encode(bench_ctx_t* ctx) {
+	int err = EQOI_OK;
+
+	for (uint32_t i = 0; i < ctx->n && err == EQOI_OK; i++) {
+		const eqoi_image_t* img = ctx->imgs + i;
+
+		err = eqoi_encode_codec(img->prgb, img->width, img->height, 0, 0, ctx->cfg->threads, EQOI_CODEC_MED,
+			ctx->cfg->dict, ctx->file_buf + ctx->slots[i], eqoi_max_file_size(img->width, img->height, 0, 0), ctx->lens + i);
+	}
+
+	return err;
+}
+
+/*************************
+@decode
+@private
+@brief  eqoi_decode(ʱĲ, ļͷ)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_single_decode(bench_ctx_t* ctx) {
+	int err = EQOI_OK;
+
+	for (uint32_t i = 0; i < ctx->n && err == EQOI_OK; i++) {
+		const unsigned char* file = ctx->file_buf + ctx->slots[i];
+		eqoi_header_t hdr;
+
+		err = eqoi_parse_header(file, ctx->lens[i], &hdr);
+		if (err == EQOI_OK) {
+			err = eqoi_use_dict(&hdr, ctx->cfg->dict);
+		}
+		if (err == EQOI_OK) {
+			err = eqoi_decode(file, &hdr, ctx->cfg->threads, ctx->outs[i].prgb);
+		}
+	}
+
+	return err;
+}
+
+/*************************
+@encode
+@private
+@brief  EQOI(ʱĲ)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_batch_encode(bench_ctx_t* ctx) {
+	return eqoi_encode_batch(ctx->imgs, ctx->n, ctx->cfg->threads, ctx->cfg->dict, ctx->file_buf, ctx->file_cap,
+		ctx->offsets, &ctx->file_len);
+}
+
+/*************************
+@decode
+@private
+@brief  EQOI(ʱĲ)
+@param  ctx ׼(ָ)
+@return 
+*************************/
+static int do_batch_decode(bench_ctx_t* ctx) {
+	return eqoi_decode_batch(ctx->file_buf, ctx->file_len, ctx->offsets, ctx->outs, ctx->n, ctx->cfg->threads,
+		ctx->cfg->dict);
+}
+
+/*************************
+@check
+@private
+@brief  УԵĽ
+@param  ctx ׼(ָ)
+@return Ƿԭͼһ
+*************************/
+static _Bool batch_matches(const bench_ctx_t* ctx) {
+	for (uint32_t i = 0; i < ctx->n; i++) {
+		if (memcmp(ctx->imgs[i].prgb, ctx->outs[i].prgb, (size_t)ctx->imgs[i].width * ctx->imgs[i].height * 3)) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/*************************
+@io
+@private
+@brief  PNGص(׷ӵ)
+@param  context PNG(ָ)
+		data (ָ)
+		size ݳ
+@return none
+*************************/
+static void png_write(void* context, void* data, int size) {
+	png_sink_t* sink = (png_sink_t*)context;
+
+	if (sink->len + size > sink->cap) {
+		size_t cap = __MAX(sink->cap * 2, sink->len + size);
+		unsigned char* buf = realloc(sink->buf, cap);
+
+		if (buf == NULL) {
+			sink->failed = 1;
+
+			return;
+		}
+
+		sink->buf = buf;
+		sink->cap = cap;
+	}
+
+	memcpy(sink->buf + sink->len, data, size);
+	sink->len += size;
+}
+
+/*************************
+@io
+@private
+@brief  ӡ͵ռ
+@param  fp ļ
+		label бǩ
+		v ͵ļ(׵ַ)
+		gray ǷΪҶģʽ(ʹûҶģʽı)
+@return none
+*************************/
+static void print_share(FILE* fp, const char* label, const uint64_t* v, _Bool gray) {
+	uint64_t sum = 0;
+
+	for (int i = 0; i < QOI_ID_CNT; i++) {
+		sum += v[i];
+	}
+
+	fprintf(fp, "%s", label);
+	for (int i = 0; i < QOI_ID_CNT; i++) {
+		const char* name = gray ? eqoi_gray_op_name(i) : op_names[i];
+
+		if (name != NULL) {
+			fprintf(fp, "  %s %5.2f", name, sum ? v[i] * 100.0 / sum : 0.0);
+		}
+	}
+	fprintf(fp, "\n");
+}
+
+/*************************
+@calc
+@private
+@brief  
+@param  pixels 
+		s ʱ()
+@return (MP/s)
+*************************/
+static double to_mps(uint64_t pixels, double s) {
+	return s > 0 ? pixels / s / 1e6 : 0.0;
+}
+
+static int cmp_double(const void* a, const void* b) {
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+
+	return (x > y) - (x < y);
+}
+
+/*************************
+@calc
+@private
+@brief  ȡʱ
+@param  none
+@return ʱ()
+*************************/
+static double now_s(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
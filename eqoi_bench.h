@@ -0,0 +1,95 @@
+/************************************************************************************************************************
+ǿQOIĻ׼
+@brief  ӿͷļ
+@date   2026/10/18
+@info   һͼظ(Ԥ, ټʱ), λp99ʡѹԼ͵ռ,
+		PNG(stb_image_write/stb_image)memcpyΪջ׼
+		ͼĽۼΪϿ(ʰ/ܺʱ)
+		ԶԱeqoi_encode/eqoi_decodeһεeqoi_encode_batch/eqoi_decode_batchÿͼ
+		ָλ(9~16)ʱȽ8λͼչΪλuint16_t, Ըλ(eqoi_encode_wide), ͬһݵ16λPNGΪ׼
+		ָ1/2ͨʱȽͼתΪҶ(Ҷ+͸), ԻҶģʽ(eqoi_encode_gray), ͨʱԽҶչΪRGBMED
+		ָ𵵲ʱлCPUֵ֧ÿһں(eqoi_cpu.h)¼ʱ, Уͬ
+************************************************************************************************************************/
+
+#ifndef __EQOI_BENCH_H
+#define __EQOI_BENCH_H
+
+#include "eqoi_batch.h"
+#include "eqoi_cpu.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_BENCH_DEFAULT_REPS 15 // Ĭϵļʱظ
+#define EQOI_BENCH_DEFAULT_WARMUP 2 // ĬϵԤȴ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ׼(ṹ嶨)
+typedef struct {
+	int reps; // ʱظ
+	int warmup; // Ԥȴ(ʱ)
+	int threads; // ߳
+	uint32_t tile_w; // ֿ(0ʾֿ)
+	uint32_t tile_h; // ֿ߶(0ʾֿ)
+	_Bool baselines; // ͬʱPNGmemcpy׼(־)
+	const eqoi_dict_t* dict; // 8λRGBʹõֵ(ָ, NULLʾʹֵ)
+	int codec; // (EQOI_CODEC_*, ĬΪEQOI_CODEC_AUTO)
+	int bit_depth; // ÿͨλ(8Ϊ8λ, 9~16Ϊλ)
+	int channels; // ͨ(3ΪRGB, 1ΪҶ, 2ΪҶ+͸, Ҷֻ֧8λ)
+	int bayer; // ɫƬ(EQOI_FMT_BAYER_*, 0ʱRGBͼ񰴸вΪBayer˺CFAģʽ, 0ʾʹ)
+	int yuv; // ɫȳ(EQOI_FMT_YUV420/EQOI_FMT_YUV422, 0ʱRGBͼתΪYUVYUVģʽ, 0ʾʹ)
+	_Bool yuv_planar; // YUVʹƽ(I420/I422, ΪNV12/NV16)
+	_Bool tiers; // 𵵲Ըں(־)
+} eqoi_bench_cfg_t;
+
+// ʱ(ṹ嶨)
+typedef struct {
+	double med_s; // ʱλ()
+	double p99_s; // ʱ99ٷλ()
+} eqoi_bench_time_t;
+
+// ׼Խ(ṹ嶨)
+typedef struct {
+	int images; // ͼ
+	uint64_t pixels; // 
+	uint64_t raw_len; // ԭʼݳ
+	uint64_t enc_len; // EQOIļ
+	uint64_t png_len; // PNGļ
+	eqoi_bench_time_t enc; // EQOIʱ
+	eqoi_bench_time_t dec; // EQOIʱ
+	eqoi_bench_time_t png_enc; // PNGʱ
+	eqoi_bench_time_t png_dec; // PNGʱ
+	eqoi_bench_time_t copy; // memcpyʱ
+	uint64_t rgb_len; // ҶչΪRGB(Bayer/YUVԭRGBͼ)EQOIļ(ͨBayerYUV)
+	eqoi_bench_time_t rgb_enc; // RGBͼEQOIʱ
+	eqoi_bench_time_t rgb_dec; // RGBͼEQOIʱ
+	eqoi_bench_time_t tier_enc[EQOI_TIER_CNT]; // ں˵EQOIʱ(𵵲, CPUֵ֧ĵΪ0)
+	eqoi_bench_time_t tier_dec[EQOI_TIER_CNT]; // ں˵EQOIʱ
+	qoi_op_stats_t ops; // ͵ͳ
+} eqoi_bench_result_t;
+
+// ׼Խ(ṹ嶨)
+typedef struct {
+	uint32_t images; // ͼ
+	uint64_t pixels; // 
+	uint64_t raw_len; // ԭʼݳ
+	uint64_t single_len; // EQOIļܳ
+	uint64_t batch_len; // ѹݳ(ƫƱ)
+	eqoi_bench_time_t single_enc; // eqoi_encodeĺʱ
+	eqoi_bench_time_t single_dec; // eqoi_decodeĺʱ(ļͷ)
+	eqoi_bench_time_t batch_enc; // eqoi_encode_batchĺʱ
+	eqoi_bench_time_t batch_dec; // eqoi_decode_batchĺʱ
+} eqoi_bench_batch_result_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void eqoi_bench_init_cfg(eqoi_bench_cfg_t* cfg); // ʼ׼(Ĭֵ)
+int eqoi_bench_image(unsigned char* prgb, uint32_t img_w, uint32_t img_h, const eqoi_bench_cfg_t* cfg,
+	eqoi_bench_result_t* res); // һͼл׼
+void eqoi_bench_accumulate(eqoi_bench_result_t* total, const eqoi_bench_result_t* res); // ۼӻ׼Խ
+void eqoi_bench_print(FILE* fp, const char* title, const eqoi_bench_result_t* res, const eqoi_bench_cfg_t* cfg); // ӡ׼Խ
+int eqoi_bench_batch(const eqoi_image_t* imgs, uint32_t n, const eqoi_bench_cfg_t* cfg,
+	eqoi_bench_batch_result_t* res); // һͼ׼
+void eqoi_bench_print_batch(FILE* fp, const char* title, const eqoi_bench_batch_result_t* res); // ӡ׼Խ
+
+#endif
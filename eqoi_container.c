@@ -0,0 +1,1485 @@
+/************************************************************************************************************************
+ǿQOIļʽ
+@brief  ʵֲֿEQOIļͷ/ֿƫƱĶд, Լֿı
+@date   2026/10/18
+************************************************************************************************************************/
+
+#include "eqoi_container.h"
+#include "eqoi_parallel.h"
+#include "eqoi_split.h"
+#include "eqoi_prog.h"
+#include "eqoi_endian.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ֿ(ṹ嶨)
+typedef struct {
+	const eqoi_header_t* hdr; // ļͷ(ָ)
+	unsigned char* pixels; // (ָ, YUVʽʱָeqoi_yuv_t)
+	unsigned char* data; // ѹ(ָ, ʱʹ)
+	const unsigned char* file; // ļ(ָ, ʱʹ)
+	uint64_t* offsets; // ֿдλ(ʱʹ)
+	uint64_t* lens; // ֿѹ(ʱʹ)
+	unsigned char* scratch; // ̱߳ݴ(׵ַ, ʱʹ)
+	size_t scratch_size; // ÿ̵߳ݴС(ֽ)
+	volatile int err; // 
+} tile_job_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t palette_slack(uint32_t w, uint32_t h); // ɫģʽķֿÿ4ֽڵ󳤶
+static int init_codec_header(eqoi_header_t* hdr, const unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w,
+	uint32_t tile_h, int codec, const eqoi_dict_t* dict); // ʼ8λRGBļͷȷ(ģʽ)
+static int parse_header(const unsigned char* file, size_t len, eqoi_header_t* hdr, _Bool prefix); // Уļͷ
+static int encode_tiles(eqoi_header_t* hdr, unsigned char* pixels, unsigned char* dst, size_t* out_len, int threads); // бȫֿ鲢дļͷ
+static void encode_tile_task(void* arg, uint32_t i, int worker); // 뵥ֿ()
+static void decode_tile_task(void* arg, uint32_t i); // 뵥ֿ()
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// CRC32ұ(, ̵߳ʼ)
+static const uint32_t crc32_tb[256] = {
+	0x00000000u, 0x77073096u, 0xee0e612cu, 0x990951bau, 0x076dc419u, 0x706af48fu, 0xe963a535u, 0x9e6495a3u,
+	0x0edb8832u, 0x79dcb8a4u, 0xe0d5e91eu, 0x97d2d988u, 0x09b64c2bu, 0x7eb17cbdu, 0xe7b82d07u, 0x90bf1d91u,
+	0x1db71064u, 0x6ab020f2u, 0xf3b97148u, 0x84be41deu, 0x1adad47du, 0x6ddde4ebu, 0xf4d4b551u, 0x83d385c7u,
+	0x136c9856u, 0x646ba8c0u, 0xfd62f97au, 0x8a65c9ecu, 0x14015c4fu, 0x63066cd9u, 0xfa0f3d63u, 0x8d080df5u,
+	0x3b6e20c8u, 0x4c69105eu, 0xd56041e4u, 0xa2677172u, 0x3c03e4d1u, 0x4b04d447u, 0xd20d85fdu, 0xa50ab56bu,
+	0x35b5a8fau, 0x42b2986cu, 0xdbbbc9d6u, 0xacbcf940u, 0x32d86ce3u, 0x45df5c75u, 0xdcd60dcfu, 0xabd13d59u,
+	0x26d930acu, 0x51de003au, 0xc8d75180u, 0xbfd06116u, 0x21b4f4b5u, 0x56b3c423u, 0xcfba9599u, 0xb8bda50fu,
+	0x2802b89eu, 0x5f058808u, 0xc60cd9b2u, 0xb10be924u, 0x2f6f7c87u, 0x58684c11u, 0xc1611dabu, 0xb6662d3du,
+	0x76dc4190u, 0x01db7106u, 0x98d220bcu, 0xefd5102au, 0x71b18589u, 0x06b6b51fu, 0x9fbfe4a5u, 0xe8b8d433u,
+	0x7807c9a2u, 0x0f00f934u, 0x9609a88eu, 0xe10e9818u, 0x7f6a0dbbu, 0x086d3d2du, 0x91646c97u, 0xe6635c01u,
+	0x6b6b51f4u, 0x1c6c6162u, 0x856530d8u, 0xf262004eu, 0x6c0695edu, 0x1b01a57bu, 0x8208f4c1u, 0xf50fc457u,
+	0x65b0d9c6u, 0x12b7e950u, 0x8bbeb8eau, 0xfcb9887cu, 0x62dd1ddfu, 0x15da2d49u, 0x8cd37cf3u, 0xfbd44c65u,
+	0x4db26158u, 0x3ab551ceu, 0xa3bc0074u, 0xd4bb30e2u, 0x4adfa541u, 0x3dd895d7u, 0xa4d1c46du, 0xd3d6f4fbu,
+	0x4369e96au, 0x346ed9fcu, 0xad678846u, 0xda60b8d0u, 0x44042d73u, 0x33031de5u, 0xaa0a4c5fu, 0xdd0d7cc9u,
+	0x5005713cu, 0x270241aau, 0xbe0b1010u, 0xc90c2086u, 0x5768b525u, 0x206f85b3u, 0xb966d409u, 0xce61e49fu,
+	0x5edef90eu, 0x29d9c998u, 0xb0d09822u, 0xc7d7a8b4u, 0x59b33d17u, 0x2eb40d81u, 0xb7bd5c3bu, 0xc0ba6cadu,
+	0xedb88320u, 0x9abfb3b6u, 0x03b6e20cu, 0x74b1d29au, 0xead54739u, 0x9dd277afu, 0x04db2615u, 0x73dc1683u,
+	0xe3630b12u, 0x94643b84u, 0x0d6d6a3eu, 0x7a6a5aa8u, 0xe40ecf0bu, 0x9309ff9du, 0x0a00ae27u, 0x7d079eb1u,
+	0xf00f9344u, 0x8708a3d2u, 0x1e01f268u, 0x6906c2feu, 0xf762575du, 0x806567cbu, 0x196c3671u, 0x6e6b06e7u,
+	0xfed41b76u, 0x89d32be0u, 0x10da7a5au, 0x67dd4accu, 0xf9b9df6fu, 0x8ebeeff9u, 0x17b7be43u, 0x60b08ed5u,
+	0xd6d6a3e8u, 0xa1d1937eu, 0x38d8c2c4u, 0x4fdff252u, 0xd1bb67f1u, 0xa6bc5767u, 0x3fb506ddu, 0x48b2364bu,
+	0xd80d2bdau, 0xaf0a1b4cu, 0x36034af6u, 0x41047a60u, 0xdf60efc3u, 0xa867df55u, 0x316e8eefu, 0x4669be79u,
+	0xcb61b38cu, 0xbc66831au, 0x256fd2a0u, 0x5268e236u, 0xcc0c7795u, 0xbb0b4703u, 0x220216b9u, 0x5505262fu,
+	0xc5ba3bbeu, 0xb2bd0b28u, 0x2bb45a92u, 0x5cb36a04u, 0xc2d7ffa7u, 0xb5d0cf31u, 0x2cd99e8bu, 0x5bdeae1du,
+	0x9b64c2b0u, 0xec63f226u, 0x756aa39cu, 0x026d930au, 0x9c0906a9u, 0xeb0e363fu, 0x72076785u, 0x05005713u,
+	0x95bf4a82u, 0xe2b87a14u, 0x7bb12baeu, 0x0cb61b38u, 0x92d28e9bu, 0xe5d5be0du, 0x7cdcefb7u, 0x0bdbdf21u,
+	0x86d3d2d4u, 0xf1d4e242u, 0x68ddb3f8u, 0x1fda836eu, 0x81be16cdu, 0xf6b9265bu, 0x6fb077e1u, 0x18b74777u,
+	0x88085ae6u, 0xff0f6a70u, 0x66063bcau, 0x11010b5cu, 0x8f659effu, 0xf862ae69u, 0x616bffd3u, 0x166ccf45u,
+	0xa00ae278u, 0xd70dd2eeu, 0x4e048354u, 0x3903b3c2u, 0xa7672661u, 0xd06016f7u, 0x4969474du, 0x3e6e77dbu,
+	0xaed16a4au, 0xd9d65adcu, 0x40df0b66u, 0x37d83bf0u, 0xa9bcae53u, 0xdebb9ec5u, 0x47b2cf7fu, 0x30b5ffe9u,
+	0xbdbdf21cu, 0xcabac28au, 0x53b39330u, 0x24b4a3a6u, 0xbad03605u, 0xcdd70693u, 0x54de5729u, 0x23d967bfu,
+	0xb3667a2eu, 0xc4614ab8u, 0x5d681b02u, 0x2a6f2b94u, 0xb40bbe37u, 0xc30c8ea1u, 0x5a05df1bu, 0x2d02ef8du
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  CRC32(IEEE 802.3ʽ)
+@param  crc һݵCRC32(׶ݴ0)
+		data (ָ)
+		len ݳ
+@return ۼƵCRC32
+*************************/
+uint32_t eqoi_crc32(uint32_t crc, const void* data, size_t len) {
+	const unsigned char* p = (const unsigned char*)data;
+
+	crc = ~crc;
+
+	for (size_t i = 0; i < len; i++) {
+		crc = crc32_tb[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+	}
+
+	return ~crc;
+}
+
+/*************************
+@calc
+@public
+@brief  ȡ
+@param  err 
+@return ַ
+*************************/
+const char* eqoi_strerror(int err) {
+	switch (err) {
+	case EQOI_OK: return "ok";
+	case EQOI_ERR_ARG: return "invalid argument";
+	case EQOI_ERR_FORMAT: return "not a valid EQOI file";
+	case EQOI_ERR_VERSION: return "unsupported version or codec";
+	case EQOI_ERR_CRC: return "CRC mismatch";
+	case EQOI_ERR_TRUNC: return "file truncated";
+	case EQOI_ERR_MEM: return "out of memory";
+	case EQOI_ERR_IO: return "I/O error";
+	case EQOI_ERR_UNSUPPORTED: return "feature not compiled in";
+	case EQOI_ERR_DICT: return "dictionary missing or mismatched";
+	default: return "unknown error";
+	}
+}
+
+/*************************
+@calc
+@public
+@brief  ֿ
+@param  img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ
+		tile_h ֿ߶
+@return ֿ
+*************************/
+uint64_t eqoi_tile_count(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h) {
+	return (((uint64_t)img_w + tile_w - 1) / tile_w) * (((uint64_t)img_h + tile_h - 1) / tile_h);
+}
+
+/*************************
+@calc
+@public
+@brief  ļ󳤶
+@param  img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_max_file_size(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h) {
+	if (!tile_w || !tile_h) {
+		tile_w = img_w;
+		tile_h = img_h;
+	}
+
+	// ÿռ4ֽ(RGB), ģʽжķֶα; ɫģʽСֿɵɫ
+	uint32_t tiles_x = img_w / tile_w, tiles_y = img_h / tile_h;
+	uint32_t rem_w = img_w % tile_w, rem_h = img_h % tile_h;
+	uint64_t len = EQOI_HEADER_SIZE + (eqoi_tile_count(img_w, img_h, tile_w, tile_h) + 1) * 8 +
+		(uint64_t)img_w * img_h * 4 + EQOI_PROG_TABLE_SIZE +
+		(uint64_t)tiles_x * tiles_y * palette_slack(tile_w, tile_h) + (uint64_t)tiles_y * palette_slack(rem_w, tile_h) +
+		(uint64_t)tiles_x * palette_slack(tile_w, rem_h) + palette_slack(rem_w, rem_h);
+
+	return len > SIZE_MAX ? SIZE_MAX : (size_t)len;
+}
+
+/*************************
+@calc
+@public
+@brief  λͼļ󳤶
+@param  img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		bit_depth ÿͨλ
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_max_file_size_wide(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int bit_depth) {
+	if (!tile_w || !tile_h) {
+		tile_w = img_w;
+		tile_h = img_h;
+	}
+
+	// ÿռһRGB
+	uint64_t len = EQOI_HEADER_SIZE + (eqoi_tile_count(img_w, img_h, tile_w, tile_h) + 1) * 8 +
+		(uint64_t)img_w * img_h * eqoi_wide_max_size(1, 1, bit_depth);
+
+	return len > SIZE_MAX ? SIZE_MAX : (size_t)len;
+}
+
+/*************************
+@calc
+@public
+@brief  Ҷ(Ҷ+͸)ͼļ󳤶
+@param  img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		channels ͨ(12)
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_max_file_size_gray(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int channels) {
+	if (!tile_w || !tile_h) {
+		tile_w = img_w;
+		tile_h = img_h;
+	}
+
+	// ÿصÿͨռһRAW
+	uint64_t len = EQOI_HEADER_SIZE + (eqoi_tile_count(img_w, img_h, tile_w, tile_h) + 1) * 8 +
+		(uint64_t)img_w * img_h * eqoi_gray_max_size(1, 1, channels);
+
+	return len > SIZE_MAX ? SIZE_MAX : (size_t)len;
+}
+
+/*************************
+@calc
+@public
+@brief  YUVͼļ󳤶
+@param  img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		pixel_fmt ظʽ(EQOI_FMT_YUV420EQOI_FMT_YUV422)
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_max_file_size_yuv(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int pixel_fmt) {
+	if (!tile_w || !tile_h) {
+		tile_w = img_w;
+		tile_h = img_h;
+	}
+
+	// ֿ㶼ɫȲı߽, ֿɫȲ֮͵ͼɫȲ
+	uint64_t len = EQOI_HEADER_SIZE + (eqoi_tile_count(img_w, img_h, tile_w, tile_h) + 1) * 8 +
+		(uint64_t)eqoi_yuv_max_size(img_w, img_h, EQOI_YUV_SUB_Y(pixel_fmt));
+
+	return len > SIZE_MAX ? SIZE_MAX : (size_t)len;
+}
+
+/*************************
+@calc
+@public
+@brief  ȡÿصֽ(EQOI_FMT_RGB16Ϊ3uint16_t, ҶȸʽΪͨ, BayerΪ1, YUVʽΪƽ1)
+@param  hdr ļͷ(ָ)
+@return ֽ
+*************************/
+size_t eqoi_pixel_size(const eqoi_header_t* hdr) {
+	switch (hdr->pixel_fmt) {
+	case EQOI_FMT_RGB16: return 3 * sizeof(uint16_t);
+	case EQOI_FMT_GRAY8: return 1;
+	case EQOI_FMT_GA8: return 2;
+	default: return EQOI_FMT_IS_BAYER(hdr->pixel_fmt) || EQOI_FMT_IS_YUV(hdr->pixel_fmt) ? 1 : 3;
+	}
+}
+
+/*************************
+@calc
+@public
+@brief  ȡֽ(YUVʽΪNV12/NV16еܳ, ʽΪwidth*height*eqoi_pixel_size)
+@param  hdr ļͷ(ָ)
+@return ֽ
+*************************/
+size_t eqoi_decoded_size(const eqoi_header_t* hdr) {
+	if (EQOI_FMT_IS_YUV(hdr->pixel_fmt)) {
+		eqoi_yuv_t img;
+
+		return eqoi_yuv_layout(NULL, hdr->width, hdr->height, EQOI_YUV_SUB_Y(hdr->pixel_fmt), 0, &img);
+	}
+
+	return (size_t)hdr->width * hdr->height * eqoi_pixel_size(hdr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@init
+@public
+@brief  ʼļͷ
+@param  hdr ļͷ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+@return none
+*************************/
+void eqoi_init_header(eqoi_header_t* hdr, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h) {
+	if (!tile_w || !tile_h) {
+		tile_w = img_w;
+		tile_h = img_h;
+	}
+
+	memset(hdr, 0, sizeof(eqoi_header_t));
+
+	hdr->version = EQOI_VERSION_BASE;
+	hdr->header_size = EQOI_HEADER_SIZE;
+	hdr->width = img_w;
+	hdr->height = img_h;
+	hdr->pixel_fmt = EQOI_FMT_RGB8;
+	hdr->channels = 3;
+	hdr->bit_depth = 8;
+	hdr->codec = EQOI_CODEC_MED;
+	hdr->tile_w = __MIN(tile_w, img_w);
+	hdr->tile_h = __MIN(tile_h, img_h);
+	hdr->tile_cnt = (uint32_t)eqoi_tile_count(img_w, img_h, hdr->tile_w, hdr->tile_h);
+	hdr->data_offset = EQOI_HEADER_SIZE + ((uint64_t)hdr->tile_cnt + 1) * 8;
+}
+
+/*************************
+@io
+@public
+@brief  дļͷƫƱ
+@param  dst ļʼ(ָ)
+		hdr ļͷ(ָ), дƫƱָ
+		offsets ֿƫƱ(tile_cnt+1)
+@return none
+*************************/
+void eqoi_write_header(unsigned char* dst, eqoi_header_t* hdr, const uint64_t* offsets) {
+	memcpy(dst, EQOI_MAGIC, 4);
+	wr_u16(dst + 4, hdr->version);
+	wr_u16(dst + 6, hdr->header_size);
+	wr_u32(dst + 8, hdr->width);
+	wr_u32(dst + 12, hdr->height);
+	dst[16] = hdr->pixel_fmt;
+	dst[17] = hdr->channels;
+	dst[18] = hdr->bit_depth;
+	dst[19] = hdr->codec;
+	wr_u32(dst + 20, hdr->flags);
+	wr_u32(dst + 24, hdr->tile_w);
+	wr_u32(dst + 28, hdr->tile_h);
+	wr_u32(dst + 32, hdr->tile_cnt);
+	wr_u32(dst + 36, hdr->data_crc);
+	wr_u64(dst + 40, hdr->data_offset);
+	wr_u64(dst + 48, hdr->data_len);
+	wr_u32(dst + 56, hdr->dict_id);
+
+	for (uint32_t i = 0; i <= hdr->tile_cnt; i++) {
+		wr_u64(dst + hdr->header_size + (size_t)i * 8, offsets[i]);
+	}
+
+	uint32_t crc = eqoi_crc32(0, dst, 60);
+	crc = eqoi_crc32(crc, dst + hdr->header_size, ((size_t)hdr->tile_cnt + 1) * 8);
+	wr_u32(dst + 60, crc);
+
+	hdr->table = dst + hdr->header_size;
+}
+
+/*************************
+@io
+@public
+@brief  Уļͷ
+@param  file ļ(ָ, Ϊڴӳ)
+		len ļ
+		hdr õļͷ(ָ)
+@return 
+*************************/
+int eqoi_parse_header(const unsigned char* file, size_t len, eqoi_header_t* hdr) {
+	return parse_header(file, len, hdr, 0);
+}
+
+/*************************
+@io
+@public
+@brief  ضϵļļͷ(ļͷƫƱ, ѹݿԲ, ڽģʽԤ)
+@param  file ļ(ָ)
+		len ʵʶļ
+		hdr õļͷ(ָ, data_lenΪѹݳ)
+@return 
+*************************/
+int eqoi_parse_header_prefix(const unsigned char* file, size_t len, eqoi_header_t* hdr) {
+	return parse_header(file, len, hdr, 1);
+}
+
+/*************************
+@check
+@public
+@brief  УѹݵCRC32
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+@return (δ¼CRC32ʱEQOI_OK)
+*************************/
+int eqoi_check_data(const unsigned char* file, const eqoi_header_t* hdr) {
+	if (!(hdr->flags & EQOI_FLAG_DATA_CRC)) {
+		return EQOI_OK;
+	}
+
+	return eqoi_crc32(0, file + hdr->data_offset, (size_t)hdr->data_len) == hdr->data_crc ? EQOI_OK : EQOI_ERR_CRC;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ֵID(ֵݰֵļеֽ˳CRC32, Ϊ0ʱȡ1, 0"ʹֵ")
+@param  state ĳʼ״̬(ָ)
+@return ֵID
+*************************/
+uint32_t eqoi_dict_id(const qoi_dict_t* state) {
+	unsigned char buf[INDEX_TB_L * 3 + 3];
+
+	for (int i = 0; i < INDEX_TB_L; i++) {
+		buf[i * 3] = state->index_tb[i].r;
+		buf[i * 3 + 1] = state->index_tb[i].g;
+		buf[i * 3 + 2] = state->index_tb[i].b;
+	}
+
+	buf[INDEX_TB_L * 3] = state->px.r;
+	buf[INDEX_TB_L * 3 + 1] = state->px.g;
+	buf[INDEX_TB_L * 3 + 2] = state->px.b;
+
+	uint32_t id = eqoi_crc32(0, buf, sizeof(buf));
+
+	return id ? id : 1;
+}
+
+/*************************
+@io
+@public
+@brief  дֵļ
+@param  dst (ָ, ΪEQOI_DICT_SIZE)
+		dict ֵ(ָ)
+@return none
+*************************/
+void eqoi_write_dict(unsigned char* dst, const eqoi_dict_t* dict) {
+	memset(dst, 0, EQOI_DICT_SIZE);
+	memcpy(dst, EQOI_DICT_MAGIC, 4);
+	wr_u16(dst + 4, EQOI_DICT_VERSION);
+	wr_u32(dst + 8, dict->id);
+
+	for (int i = 0; i < INDEX_TB_L; i++) {
+		dst[12 + i * 3] = dict->state.index_tb[i].r;
+		dst[12 + i * 3 + 1] = dict->state.index_tb[i].g;
+		dst[12 + i * 3 + 2] = dict->state.index_tb[i].b;
+	}
+
+	dst[108] = dict->state.px.r;
+	dst[109] = dict->state.px.g;
+	dst[110] = dict->state.px.b;
+
+	wr_u32(dst + 112, eqoi_crc32(0, dst, 112));
+}
+
+/*************************
+@io
+@public
+@brief  Уֵļ
+@param  file ļ(ָ)
+		len ļ
+		dict õֵ(ָ)
+@return 
+*************************/
+int eqoi_parse_dict(const unsigned char* file, size_t len, eqoi_dict_t* dict) {
+	if (len < 4 || memcmp(file, EQOI_DICT_MAGIC, 4)) {
+		return EQOI_ERR_FORMAT;
+	}
+	if (len < EQOI_DICT_SIZE) {
+		return EQOI_ERR_TRUNC;
+	}
+	if (rd_u16(file + 4) > EQOI_DICT_VERSION) {
+		return EQOI_ERR_VERSION;
+	}
+	if (eqoi_crc32(0, file, 112) != rd_u32(file + 112)) {
+		return EQOI_ERR_CRC;
+	}
+
+	for (int i = 0; i < INDEX_TB_L; i++) {
+		dict->state.index_tb[i] = (qoi_rgb_t){ file[12 + i * 3], file[12 + i * 3 + 1], file[12 + i * 3 + 2] };
+	}
+
+	dict->state.px = (qoi_rgb_t){ file[108], file[109], file[110] };
+	dict->id = rd_u32(file + 8);
+
+	return dict->id == eqoi_dict_id(&dict->state) ? EQOI_OK : EQOI_ERR_FORMAT;
+}
+
+/*************************
+@check
+@public
+@brief  Ϊָļõֵ(ļֵʱԴֵ)
+@param  hdr ѽļͷ(ָ)
+		dict ֵ(ָ, ΪNULL)
+@return (ļֵδṩIDʱEQOI_ERR_DICT)
+*************************/
+int eqoi_use_dict(eqoi_header_t* hdr, const eqoi_dict_t* dict) {
+	if (!hdr->dict_id) {
+		hdr->dict = NULL;
+
+		return EQOI_OK;
+	}
+	if (dict == NULL || dict->id != hdr->dict_id) {
+		return EQOI_ERR_DICT;
+	}
+
+	hdr->dict = dict;
+
+	return EQOI_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ȡֿѹƫ
+@param  hdr ļͷ(ָ)
+		i ֿ(tile_cntʱѹݳ)
+@return ѹʼƫ
+*************************/
+uint64_t eqoi_tile_offset(const eqoi_header_t* hdr, uint32_t i) {
+	if (hdr->table == NULL) {
+		return i ? hdr->data_len : 0;
+	}
+
+	return rd_u64(hdr->table + (size_t)i * 8);
+}
+
+/*************************
+@calc
+@public
+@brief  ȡֿͼеλ
+@param  hdr ļͷ(ָ)
+		i ֿ
+		x ֿϽǺ(ָ)
+		y ֿϽ(ָ)
+		w ֿ(ָ)
+		h ֿ߶(ָ)
+@return none
+*************************/
+void eqoi_tile_rect(const eqoi_header_t* hdr, uint32_t i, uint32_t* x, uint32_t* y, uint32_t* w, uint32_t* h) {
+	uint32_t tiles_x = (hdr->width + hdr->tile_w - 1) / hdr->tile_w;
+
+	*x = (i % tiles_x) * hdr->tile_w;
+	*y = (i / tiles_x) * hdr->tile_h;
+	*w = __MIN(hdr->tile_w, hdr->width - *x);
+	*h = __MIN(hdr->tile_h, hdr->height - *y);
+}
+
+/*************************
+@calc
+@public
+@brief  ֿ󳤶(ʱԤдλ)
+@param  hdr ļͷ(ָ)
+		w ֿ
+		h ֿ߶
+@return 󳤶(ֽ)
+*************************/
+uint64_t eqoi_tile_max_len(const eqoi_header_t* hdr, uint32_t w, uint32_t h) {
+	if (hdr->codec == EQOI_CODEC_PROGRESSIVE) {
+		return eqoi_prog_max_size(w, h);
+	}
+
+	switch (hdr->pixel_fmt) {
+	case EQOI_FMT_RGB16: return eqoi_wide_max_size(w, h, hdr->bit_depth);
+	case EQOI_FMT_GRAY8: return eqoi_gray_max_size(w, h, 1);
+	case EQOI_FMT_GA8: return eqoi_gray_max_size(w, h, 2);
+	case EQOI_FMT_BAYER_RGGB:
+	case EQOI_FMT_BAYER_GRBG:
+	case EQOI_FMT_BAYER_GBRG:
+	case EQOI_FMT_BAYER_BGGR: return eqoi_gray_max_size(w, h, 1);
+	case EQOI_FMT_YUV420:
+	case EQOI_FMT_YUV422: return eqoi_yuv_max_size(w, h, EQOI_YUV_SUB_Y(hdr->pixel_fmt));
+	default: return hdr->codec == EQOI_CODEC_PALETTE ? (uint64_t)w * h * 4 + palette_slack(w, h) :
+		(uint64_t)w * h * 4; // 8λÿռ4ֽ(RGB)
+	}
+}
+
+/*************************
+@init
+@public
+@brief  Էֿʼ8λRGB MEDĽ(ֵʱֵóʼ״̬), нֿ
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+		i ֿ
+		dec (ָ)
+@return 
+*************************/
+int eqoi_open_tile(const unsigned char* file, const eqoi_header_t* hdr, uint32_t i, qoi_decoder_t* dec) {
+	uint64_t start = eqoi_tile_offset(hdr, i);
+	uint64_t end = eqoi_tile_offset(hdr, i + 1);
+	uint32_t x, y, w, h;
+
+	if (start > end || end > hdr->data_len) {
+		return EQOI_ERR_FORMAT;
+	}
+	if (hdr->dict_id && (hdr->dict == NULL || hdr->dict->id != hdr->dict_id)) {
+		return EQOI_ERR_DICT;
+	}
+
+	eqoi_tile_rect(hdr, i, &x, &y, &w, &h);
+	enhanced_qoi_decoder_init(dec, (unsigned char*)file + hdr->data_offset + start, (size_t)(end - start), w, h);
+
+	if (hdr->dict_id) {
+		enhanced_qoi_decoder_set_dict(dec, &hdr->dict->state);
+	}
+
+	return EQOI_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@encode
+@public
+@brief  ͼΪEQOIļ
+@param  prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		threads ߳(ֿ鲢б, <=0ʾʹȫCPU)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size)
+		out_len ļ(ָ)
+@return 
+*************************/
+int eqoi_encode(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int threads,
+	unsigned char* dst, size_t cap, size_t* out_len) {
+	return eqoi_encode_dict(prgb, img_w, img_h, tile_w, tile_h, threads, NULL, dst, cap, out_len);
+}
+
+/*************************
+@encode
+@public
+@brief  ֵ佫ͼΪEQOIļ(ÿֿ鶼ֵ״̬ʼ, ʱṩͬһֵ)
+@param  prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		threads ߳(ֿ鲢б, <=0ʾʹȫCPU)
+		dict ֵ(ָ, NULLʾʹֵ, ʱeqoi_encodeͬ)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size)
+		out_len ļ(ָ)
+@return 
+*************************/
+int eqoi_encode_dict(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int threads,
+	const eqoi_dict_t* dict, unsigned char* dst, size_t cap, size_t* out_len) {
+	return eqoi_encode_codec(prgb, img_w, img_h, tile_w, tile_h, threads, EQOI_CODEC_AUTO, dict, dst, cap, out_len);
+}
+
+/*************************
+@encode
+@public
+@brief  ָı彫ͼΪEQOIļ
+@param  prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		threads ߳(ֿ鲢б, <=0ʾʹȫCPU)
+		codec (EQOI_CODEC_AUTOʾͳɫ, 256ҷֿ鲻СEQOI_PALETTE_MIN_PIXELS
+			ʱʹõɫģʽ; EQOI_CODEC_PROGRESSIVEԷֿߴ, ͼΪһֿ)
+		dict ֵ(ָ, NULLʾʹֵ, ɫģʽ뽥ģʽֵ)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size)
+		out_len ļ(ָ)
+@return (ָɫģʽͼ񳬹EQOI_PALETTE_MAXɫʱEQOI_ERR_ARG)
+*************************/
+int eqoi_encode_codec(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int threads,
+	int codec, const eqoi_dict_t* dict, unsigned char* dst, size_t cap, size_t* out_len) {
+	if (prgb == NULL || dst == NULL || !img_w || !img_h) {
+		return EQOI_ERR_ARG;
+	}
+	if (tile_w && tile_h && eqoi_tile_count(img_w, img_h, tile_w, tile_h) >= UINT32_MAX) {
+		return EQOI_ERR_ARG;
+	}
+	if (cap < eqoi_max_file_size(img_w, img_h, tile_w, tile_h)) {
+		return EQOI_ERR_MEM;
+	}
+
+	eqoi_header_t hdr;
+
+	if (codec == EQOI_CODEC_PROGRESSIVE) {
+		eqoi_init_header(&hdr, img_w, img_h, 0, 0);
+		hdr.codec = EQOI_CODEC_PROGRESSIVE;
+
+		return encode_tiles(&hdr, prgb, dst, out_len, threads);
+	}
+
+	int err = init_codec_header(&hdr, prgb, img_w, img_h, tile_w, tile_h, codec, dict);
+
+	return err == EQOI_OK ? encode_tiles(&hdr, prgb, dst, out_len, threads) : err;
+}
+
+/*************************
+@calc
+@public
+@brief  eqoi_encode_workĹС
+@param  img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+@return С(ֽ): ֿƫƱһֿݴ
+*************************/
+size_t eqoi_encode_work_size(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h) {
+	if (!tile_w || !tile_h) {
+		tile_w = img_w;
+		tile_h = img_h;
+	}
+
+	return (size_t)(eqoi_tile_count(img_w, img_h, tile_w, tile_h) + 1) * sizeof(uint64_t) + eqoi_scratch_size(tile_w);
+}
+
+/*************************
+@encode
+@public
+@brief  ԵṩĹ8λRGBͼΪEQOIļ(ֿ߳, ڴ)
+@info   eqoi_encode_codecĽֽͬ; ֿα뵽յλ, ҪԤдλ,
+		ֻƫƱһֿݴ; EQOI_NO_MALLOCʱڲʹöѵĿ
+@param  prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		codec (ͬeqoi_encode_codec, ֧EQOI_CODEC_PROGRESSIVE)
+		dict ֵ(ָ, NULLʾʹֵ)
+		work (ָ, 8ֽڶ)
+		work_size (Сeqoi_encode_work_size)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size)
+		out_len ļ(ָ)
+@return (ļʱEQOI_ERR_MEM, ģʽEQOI_ERR_UNSUPPORTED)
+*************************/
+int eqoi_encode_work(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int codec,
+	const eqoi_dict_t* dict, void* work, size_t work_size, unsigned char* dst, size_t cap, size_t* out_len) {
+	if (prgb == NULL || work == NULL || dst == NULL || !img_w || !img_h) {
+		return EQOI_ERR_ARG;
+	}
+	if (tile_w && tile_h && eqoi_tile_count(img_w, img_h, tile_w, tile_h) >= UINT32_MAX) {
+		return EQOI_ERR_ARG;
+	}
+	if (codec == EQOI_CODEC_PROGRESSIVE) {
+		return EQOI_ERR_UNSUPPORTED;
+	}
+	if (work_size < eqoi_encode_work_size(img_w, img_h, tile_w, tile_h) || cap < eqoi_max_file_size(img_w, img_h, tile_w, tile_h)) {
+		return EQOI_ERR_MEM;
+	}
+
+	eqoi_header_t hdr;
+	int err = init_codec_header(&hdr, prgb, img_w, img_h, tile_w, tile_h, codec, dict);
+
+	if (err != EQOI_OK) {
+		return err;
+	}
+
+	uint64_t* offsets = (uint64_t*)work;
+	unsigned char* scratch = (unsigned char*)(offsets + hdr.tile_cnt + 1);
+	unsigned char* data = dst + hdr.data_offset;
+	size_t stride = (size_t)img_w * 3;
+	uint64_t p = 0;
+
+	for (uint32_t i = 0; i < hdr.tile_cnt; i++) {
+		uint32_t x, y, w, h;
+		eqoi_tile_rect(&hdr, i, &x, &y, &w, &h);
+
+		size_t len = eqoi_encode_tile(&hdr, prgb + (size_t)y * stride + (size_t)x * 3, stride, w, h, scratch, data + p);
+
+		if (!len) {
+			return EQOI_ERR_MEM;
+		}
+
+		offsets[i] = p;
+		p += len;
+	}
+
+	offsets[hdr.tile_cnt] = p;
+
+	hdr.data_len = p;
+	hdr.data_crc = eqoi_crc32(0, data, (size_t)p);
+	hdr.flags |= EQOI_FLAG_DATA_CRC;
+
+	eqoi_write_header(dst, &hdr, offsets);
+	*out_len = (size_t)(hdr.data_offset + hdr.data_len);
+
+	return EQOI_OK;
+}
+
+/*************************
+@encode
+@public
+@brief  λͼΪEQOIļ(ظʽEQOI_FMT_RGB16, eqoi_wide.h)
+@param  prgb (ָ, ÿ3uint16_t)
+		img_w ͼ
+		img_h ͼ߶
+		bit_depth ÿͨλ(EQOI_WIDE_MIN_DEPTH~EQOI_WIDE_MAX_DEPTH)
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		threads ߳(ֿ鲢б, <=0ʾʹȫCPU)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size_wide)
+		out_len ļ(ָ)
+@return (λΧʱEQOI_ERR_ARG)
+*************************/
+int eqoi_encode_wide(const uint16_t* prgb, uint32_t img_w, uint32_t img_h, int bit_depth, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len) {
+	if (prgb == NULL || dst == NULL || !img_w || !img_h || bit_depth < EQOI_WIDE_MIN_DEPTH || bit_depth > EQOI_WIDE_MAX_DEPTH) {
+		return EQOI_ERR_ARG;
+	}
+	if (tile_w && tile_h && eqoi_tile_count(img_w, img_h, tile_w, tile_h) >= UINT32_MAX) {
+		return EQOI_ERR_ARG;
+	}
+	if (cap < eqoi_max_file_size_wide(img_w, img_h, tile_w, tile_h, bit_depth)) {
+		return EQOI_ERR_MEM;
+	}
+	if (!eqoi_wide_in_range(prgb, (size_t)img_w * 3, img_w, img_h, bit_depth)) {
+		return EQOI_ERR_ARG;
+	}
+
+	eqoi_header_t hdr;
+	eqoi_init_header(&hdr, img_w, img_h, tile_w, tile_h);
+
+	hdr.pixel_fmt = EQOI_FMT_RGB16;
+	hdr.bit_depth = (uint8_t)bit_depth;
+
+	return encode_tiles(&hdr, (unsigned char*)prgb, dst, out_len, threads);
+}
+
+/*************************
+@encode
+@public
+@brief  Ҷ(Ҷ+͸)ͼΪEQOIļ(ظʽEQOI_FMT_GRAY8/EQOI_FMT_GA8, eqoi_gray.h)
+@param  pgray (ָ, Ҷ+͸ʱͨ֯)
+		img_w ͼ
+		img_h ͼ߶
+		channels ͨ(1ΪҶ, 2ΪҶ+͸)
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		threads ߳(ֿ鲢б, <=0ʾʹȫCPU)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size_gray)
+		out_len ļ(ָ)
+@return 
+*************************/
+int eqoi_encode_gray(const unsigned char* pgray, uint32_t img_w, uint32_t img_h, int channels, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len) {
+	if (pgray == NULL || dst == NULL || !img_w || !img_h || (channels != 1 && channels != 2)) {
+		return EQOI_ERR_ARG;
+	}
+	if (tile_w && tile_h && eqoi_tile_count(img_w, img_h, tile_w, tile_h) >= UINT32_MAX) {
+		return EQOI_ERR_ARG;
+	}
+	if (cap < eqoi_max_file_size_gray(img_w, img_h, tile_w, tile_h, channels)) {
+		return EQOI_ERR_MEM;
+	}
+
+	eqoi_header_t hdr;
+	eqoi_init_header(&hdr, img_w, img_h, tile_w, tile_h);
+
+	hdr.pixel_fmt = channels == 1 ? EQOI_FMT_GRAY8 : EQOI_FMT_GA8;
+	hdr.channels = (uint8_t)channels;
+
+	return encode_tiles(&hdr, (unsigned char*)pgray, dst, out_len, threads);
+}
+
+/*************************
+@encode
+@public
+@brief  Bayer˱ΪEQOIļ(CFAģʽ, eqoi_gray.h)
+@param  pcfa ˲(ָ, ÿй1ֽ)
+		img_w ͼ(Ϊż)
+		img_h ͼ߶(Ϊż)
+		pixel_fmt ɫƬ(EQOI_FMT_BAYER_*)
+		tile_w ֿ(0ʾֿ, Ϊż)
+		tile_h ֿ߶(0ʾֿ, Ϊż)
+		threads ߳(ֿ鲢б, <=0ʾʹȫCPU)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size_gray(img_w, img_h, tile_w, tile_h, 1))
+		out_len ļ(ָ)
+@return 
+*************************/
+int eqoi_encode_cfa(const unsigned char* pcfa, uint32_t img_w, uint32_t img_h, int pixel_fmt, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len) {
+	if (pcfa == NULL || dst == NULL || !img_w || !img_h || !EQOI_FMT_IS_BAYER(pixel_fmt) ||
+		((img_w | img_h) & 1) || (tile_w && tile_h && ((tile_w | tile_h) & 1))) {
+		return EQOI_ERR_ARG;
+	}
+	if (tile_w && tile_h && eqoi_tile_count(img_w, img_h, tile_w, tile_h) >= UINT32_MAX) {
+		return EQOI_ERR_ARG;
+	}
+	if (cap < eqoi_max_file_size_gray(img_w, img_h, tile_w, tile_h, 1)) {
+		return EQOI_ERR_MEM;
+	}
+
+	eqoi_header_t hdr;
+	eqoi_init_header(&hdr, img_w, img_h, tile_w, tile_h);
+
+	hdr.pixel_fmt = (uint8_t)pixel_fmt;
+	hdr.channels = 1;
+
+	return encode_tiles(&hdr, (unsigned char*)pcfa, dst, out_len, threads);
+}
+
+/*************************
+@encode
+@public
+@brief  YUVͼΪEQOIļ(YUVģʽ, eqoi_gray.h)
+@param  img YUVͼڴ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		pixel_fmt ɫȳ(EQOI_FMT_YUV420EQOI_FMT_YUV422)
+		tile_w ֿ(0ʾֿ, СͼʱΪż)
+		tile_h ֿ߶(0ʾֿ, 4:2:0ʱСͼ߶Ϊż)
+		threads ߳(ֿ鲢б, <=0ʾʹȫCPU)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_max_file_size_yuv)
+		out_len ļ(ָ)
+@return 
+*************************/
+int eqoi_encode_yuv(const eqoi_yuv_t* img, uint32_t img_w, uint32_t img_h, int pixel_fmt, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len) {
+	if (img == NULL || img->y == NULL || img->u == NULL || img->v == NULL || dst == NULL || !img_w || !img_h ||
+		!EQOI_FMT_IS_YUV(pixel_fmt) || (img->c_step != 1 && img->c_step != 2)) {
+		return EQOI_ERR_ARG;
+	}
+	if (tile_w && tile_h && (eqoi_tile_count(img_w, img_h, tile_w, tile_h) >= UINT32_MAX ||
+		(tile_w < img_w && (tile_w & 1)) || (tile_h < img_h && tile_h % EQOI_YUV_SUB_Y(pixel_fmt)))) {
+		return EQOI_ERR_ARG;
+	}
+	if (cap < eqoi_max_file_size_yuv(img_w, img_h, tile_w, tile_h, pixel_fmt)) {
+		return EQOI_ERR_MEM;
+	}
+
+	eqoi_header_t hdr;
+	eqoi_init_header(&hdr, img_w, img_h, tile_w, tile_h);
+
+	hdr.pixel_fmt = (uint8_t)pixel_fmt;
+
+	return encode_tiles(&hdr, (unsigned char*)img, dst, out_len, threads);
+}
+
+/*************************
+@encode
+@public
+@brief  ļͷظʽ뵥ֿ(֧YUV, ֵʱhdr->dictóʼ״̬)
+@param  hdr ļͷ(ָ)
+		pixels ֿϽǵ(ָ, ͬ)
+		stride п(ֽ)
+		w ֿ
+		h ֿ߶
+		scratch 8λRGB MEDݴ(ָ, Сeqoi_scratch_size(w)ֽ, ΪNULL)
+		dst ѹݻ(ָ, ȲСeqoi_tile_max_len)
+@return ѹݳ(0ʾʧ: ɫɫ޻ڴ治)
+*************************/
+size_t eqoi_encode_tile(const eqoi_header_t* hdr, const unsigned char* pixels, size_t stride, uint32_t w, uint32_t h,
+	void* scratch, unsigned char* dst) {
+	if (hdr->pixel_fmt == EQOI_FMT_GRAY8 || hdr->pixel_fmt == EQOI_FMT_GA8) {
+		return eqoi_gray_encode(pixels, stride, w, h, (int)eqoi_pixel_size(hdr), dst);
+	}
+	if (EQOI_FMT_IS_BAYER(hdr->pixel_fmt)) {
+		return eqoi_cfa_encode(pixels, stride, w, h, dst);
+	}
+	if (hdr->pixel_fmt == EQOI_FMT_RGB16) {
+		return eqoi_wide_encode((const uint16_t*)pixels, stride / sizeof(uint16_t), w, h, hdr->bit_depth, dst);
+	}
+	if (hdr->codec == EQOI_CODEC_PALETTE) {
+		return eqoi_palette_encode(pixels, stride, w, h, dst);
+	}
+	if (hdr->codec == EQOI_CODEC_PROGRESSIVE) {
+		return eqoi_prog_encode(pixels, stride, w, h, dst);
+	}
+
+	qoi_encoder_t enc;
+
+	if (scratch == NULL || !enhanced_qoi_encoder_init_scratch(&enc, w, h, scratch)) {
+		return 0;
+	}
+	if (hdr->dict != NULL) {
+		enhanced_qoi_encoder_set_dict(&enc, &hdr->dict->state);
+	}
+
+	size_t len = enhanced_qoi_encode_rows(&enc, (unsigned char*)pixels, stride, h, dst);
+	enhanced_qoi_encoder_free(&enc);
+
+	return len;
+}
+
+/*************************
+@decode
+@public
+@brief  뵥ֿ
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+		i ֿ
+		pdecoded ֿϽǵĽ뻺(ָ, EQOI_FMT_RGB16밴uint16_t)
+		stride 뻺п(ֽ)
+@return 
+*************************/
+int eqoi_decode_tile(const unsigned char* file, const eqoi_header_t* hdr, uint32_t i, unsigned char* pdecoded, size_t stride) {
+	if (i >= hdr->tile_cnt) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint64_t start = eqoi_tile_offset(hdr, i);
+	uint64_t end = eqoi_tile_offset(hdr, i + 1);
+
+	if (start > end || end > hdr->data_len) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	uint32_t x, y, w, h;
+	qoi_decoder_t dec;
+
+	eqoi_tile_rect(hdr, i, &x, &y, &w, &h);
+
+	if (hdr->codec == EQOI_CODEC_PALETTE) {
+		return eqoi_palette_decode(file + hdr->data_offset + start, (size_t)(end - start), pdecoded, stride, w, h) ?
+			EQOI_OK : EQOI_ERR_FORMAT;
+	}
+	if (hdr->codec == EQOI_CODEC_PROGRESSIVE) {
+		return eqoi_prog_decode(file + hdr->data_offset + start, (size_t)(end - start), (size_t)(end - start), pdecoded, stride,
+			w, h, NULL);
+	}
+	if (hdr->pixel_fmt == EQOI_FMT_RGB16) {
+		return eqoi_wide_decode(file + hdr->data_offset + start, (size_t)(end - start), (uint16_t*)pdecoded,
+			stride / sizeof(uint16_t), w, h, hdr->bit_depth) ? EQOI_OK : EQOI_ERR_FORMAT;
+	}
+	if (hdr->pixel_fmt == EQOI_FMT_GRAY8 || hdr->pixel_fmt == EQOI_FMT_GA8) {
+		return eqoi_gray_decode(file + hdr->data_offset + start, (size_t)(end - start), pdecoded, stride, w, h,
+			(int)eqoi_pixel_size(hdr)) ? EQOI_OK : EQOI_ERR_FORMAT;
+	}
+	if (EQOI_FMT_IS_BAYER(hdr->pixel_fmt)) {
+		return eqoi_cfa_decode(file + hdr->data_offset + start, (size_t)(end - start), pdecoded, stride, w, h) ?
+			EQOI_OK : EQOI_ERR_FORMAT;
+	}
+	if (EQOI_FMT_IS_YUV(hdr->pixel_fmt)) {
+		return EQOI_ERR_ARG; // ɫƽλ, ʹeqoi_decode_tile_yuv
+	}
+
+	int err = eqoi_open_tile(file, hdr, i, &dec);
+
+	if (err != EQOI_OK) {
+		return err;
+	}
+
+	enhanced_qoi_decode_rows(&dec, pdecoded, stride, h);
+	enhanced_qoi_decoder_free(&dec);
+
+	return EQOI_OK;
+}
+
+/*************************
+@decode
+@public
+@brief  ͼ
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+		threads ߳(ֿ鲢н, ֻһĴͼֶβн(eqoi_split.h), <=0ʾʹȫCPU)
+		pdecoded 뻺(ָ, Ϊeqoi_decoded_size(hdr))
+@return 
+*************************/
+int eqoi_decode(const unsigned char* file, const eqoi_header_t* hdr, int threads, unsigned char* pdecoded) {
+	if (eqoi_split_usable(hdr, threads)) {
+		int err = eqoi_decode_split(file, hdr, threads, pdecoded);
+
+		// غͻʧʱ˻˳
+		if (err != EQOI_ERR_MEM) {
+			return err;
+		}
+	}
+	if (EQOI_FMT_IS_YUV(hdr->pixel_fmt)) {
+		eqoi_yuv_t img;
+
+		eqoi_yuv_layout(pdecoded, hdr->width, hdr->height, EQOI_YUV_SUB_Y(hdr->pixel_fmt), 0, &img);
+
+		return eqoi_decode_yuv(file, hdr, threads, &img);
+	}
+
+	tile_job_t job = { hdr, pdecoded, NULL, file, NULL, NULL, NULL, 0, EQOI_OK };
+
+	eqoi_parallel_for(hdr->tile_cnt, threads, decode_tile_task, &job);
+
+	return job.err;
+}
+
+/*************************
+@decode
+@public
+@brief  YUVͼĵֿ
+@param  file ļ(ָ)
+		hdr ļͷ(ָ, ظʽΪEQOI_FMT_YUV420EQOI_FMT_YUV422)
+		i ֿ
+		img ͼڴ(ָ, ֿдͼеλ)
+@return 
+*************************/
+int eqoi_decode_tile_yuv(const unsigned char* file, const eqoi_header_t* hdr, uint32_t i, const eqoi_yuv_t* img) {
+	if (i >= hdr->tile_cnt || !EQOI_FMT_IS_YUV(hdr->pixel_fmt) || (img->c_step != 1 && img->c_step != 2)) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint64_t start = eqoi_tile_offset(hdr, i);
+	uint64_t end = eqoi_tile_offset(hdr, i + 1);
+
+	if (start > end || end > hdr->data_len) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	uint32_t x, y, w, h;
+	int sub_y = EQOI_YUV_SUB_Y(hdr->pixel_fmt);
+	eqoi_yuv_t tile = *img;
+
+	eqoi_tile_rect(hdr, i, &x, &y, &w, &h);
+
+	tile.y += (size_t)y * img->y_stride + x;
+	tile.u += (size_t)(y / sub_y) * img->c_stride + (size_t)(x / 2) * img->c_step;
+	tile.v += (size_t)(y / sub_y) * img->c_stride + (size_t)(x / 2) * img->c_step;
+
+	return eqoi_yuv_decode(file + hdr->data_offset + start, (size_t)(end - start), &tile, w, h, sub_y) ?
+		EQOI_OK : EQOI_ERR_FORMAT;
+}
+
+/*************************
+@decode
+@public
+@brief  ָڴнYUVͼ(eqoi_decodeYUVʽŵNV12/NV16)
+@param  file ļ(ָ)
+		hdr ļͷ(ָ, ظʽΪEQOI_FMT_YUV420EQOI_FMT_YUV422)
+		threads ߳(ֿ鲢н, <=0ʾʹȫCPU)
+		img ڴ(ָ, ʱвͬ)
+@return 
+*************************/
+int eqoi_decode_yuv(const unsigned char* file, const eqoi_header_t* hdr, int threads, const eqoi_yuv_t* img) {
+	if (!EQOI_FMT_IS_YUV(hdr->pixel_fmt)) {
+		return EQOI_ERR_ARG;
+	}
+
+	tile_job_t job = { hdr, (unsigned char*)img, NULL, file, NULL, NULL, NULL, 0, EQOI_OK };
+
+	eqoi_parallel_for(hdr->tile_cnt, threads, decode_tile_task, &job);
+
+	return job.err;
+}
+
+/*************************
+@calc
+@public
+@brief  ͳEQOIļи͵Ĵ//ֽ(ֿɨ, )
+@param  file ļ(ָ)
+		hdr ѽļͷ(ָ)
+		stats ͳƽ(ָ, ԭмۼ)
+@return 
+*************************/
+int eqoi_scan_ops(const unsigned char* file, const eqoi_header_t* hdr, qoi_op_stats_t* stats) {
+	for (uint32_t i = 0; i < hdr->tile_cnt; i++) {
+		uint64_t start = eqoi_tile_offset(hdr, i);
+		uint64_t end = eqoi_tile_offset(hdr, i + 1);
+		uint32_t x, y, w, h;
+
+		if (start > end || end > hdr->data_len) {
+			return EQOI_ERR_FORMAT;
+		}
+
+		eqoi_tile_rect(hdr, i, &x, &y, &w, &h);
+
+		if (hdr->codec == EQOI_CODEC_PALETTE) {
+			eqoi_palette_scan_ops(file + hdr->data_offset + start, (size_t)(end - start), (uint64_t)w * h, stats);
+		}
+		else if (hdr->codec == EQOI_CODEC_PROGRESSIVE) {
+			int err = eqoi_prog_scan_ops(file + hdr->data_offset + start, (size_t)(end - start), w, h, stats);
+
+			if (err != EQOI_OK) {
+				return err;
+			}
+		}
+		else if (hdr->pixel_fmt == EQOI_FMT_RGB16) {
+			eqoi_wide_scan_ops(file + hdr->data_offset + start, (size_t)(end - start), (uint64_t)w * h, hdr->bit_depth, stats);
+		}
+		else if (hdr->pixel_fmt == EQOI_FMT_GRAY8 || hdr->pixel_fmt == EQOI_FMT_GA8 || EQOI_FMT_IS_BAYER(hdr->pixel_fmt)) {
+			eqoi_gray_scan_ops(file + hdr->data_offset + start, (size_t)(end - start), (uint64_t)w * h,
+				(int)eqoi_pixel_size(hdr), stats);
+		}
+		else if (EQOI_FMT_IS_YUV(hdr->pixel_fmt)) {
+			int sub_y = EQOI_YUV_SUB_Y(hdr->pixel_fmt);
+
+			eqoi_gray_scan_ops(file + hdr->data_offset + start, (size_t)(end - start),
+				(uint64_t)w * h + (uint64_t)((w + 1) / 2) * ((h + sub_y - 1) / sub_y) * 2, 1, stats);
+		}
+		else {
+			enhanced_qoi_scan_ops(file + hdr->data_offset + start, (size_t)(end - start), (uint64_t)w * h, stats);
+		}
+	}
+
+	return EQOI_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@encode
+@private
+@brief  бȫֿ鲢дļͷƫƱ(ֿд밴Ԥλ, ν)
+@param  hdr ѳʼļͷ(ָ)
+		pixels (ָ)
+		dst ļ(ָ)
+		out_len ļ(ָ)
+		threads ߳
+@return 
+*************************/
+static int encode_tiles(eqoi_header_t* hdr, unsigned char* pixels, unsigned char* dst, size_t* out_len, int threads) {
+	uint64_t* offsets = malloc(((size_t)hdr->tile_cnt + 1) * sizeof(uint64_t));
+	uint64_t* lens = malloc((size_t)hdr->tile_cnt * sizeof(uint64_t));
+	size_t scratch_size = hdr->pixel_fmt == EQOI_FMT_RGB8 ? eqoi_scratch_size(hdr->tile_w) : 0;
+	int workers = eqoi_parallel_threads(hdr->tile_cnt, threads);
+	unsigned char* scratch = scratch_size ? malloc((size_t)workers * scratch_size) : NULL; // ÿ߳һݴ
+
+	if (offsets == NULL || lens == NULL || (scratch_size && scratch == NULL)) {
+		free(offsets);
+		free(lens);
+		free(scratch);
+
+		return EQOI_ERR_MEM;
+	}
+
+	unsigned char* data = dst + hdr->data_offset;
+	uint64_t p = 0;
+
+	// ֿд밴Ԥλ, бν
+	for (uint32_t i = 0; i < hdr->tile_cnt; i++) {
+		uint32_t x, y, w, h;
+		eqoi_tile_rect(hdr, i, &x, &y, &w, &h);
+
+		offsets[i] = p;
+		p += eqoi_tile_max_len(hdr, w, h);
+	}
+
+	tile_job_t job = { hdr, pixels, data, NULL, offsets, lens, scratch, scratch_size, EQOI_OK };
+	eqoi_parallel_for_worker(hdr->tile_cnt, workers, encode_tile_task, &job);
+	free(scratch);
+
+	if (job.err != EQOI_OK) {
+		free(offsets);
+		free(lens);
+
+		return job.err;
+	}
+
+	p = 0;
+
+	for (uint32_t i = 0; i < hdr->tile_cnt; i++) {
+		if (offsets[i] != p) {
+			memmove(data + p, data + offsets[i], (size_t)lens[i]);
+		}
+
+		offsets[i] = p;
+		p += lens[i];
+	}
+
+	offsets[hdr->tile_cnt] = p;
+
+	hdr->data_len = p;
+	hdr->data_crc = eqoi_crc32(0, data, (size_t)p);
+	hdr->flags |= EQOI_FLAG_DATA_CRC;
+
+	eqoi_write_header(dst, hdr, offsets);
+	free(offsets);
+	free(lens);
+
+	*out_len = (size_t)(hdr->data_offset + hdr->data_len);
+
+	return EQOI_OK;
+}
+
+/*************************
+@init
+@private
+@brief  ʼ8λRGBļͷȷ(ģʽ)
+@param  hdr ļͷ(ָ)
+		prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		codec (EQOI_CODEC_AUTO, EQOI_CODEC_MEDEQOI_CODEC_PALETTE)
+		dict ֵ(ָ, NULLʾʹֵ, ɫģʽֵ)
+@return (ָɫģʽͼ񳬹EQOI_PALETTE_MAXɫʱEQOI_ERR_ARG)
+*************************/
+static int init_codec_header(eqoi_header_t* hdr, const unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w,
+	uint32_t tile_h, int codec, const eqoi_dict_t* dict) {
+	eqoi_init_header(hdr, img_w, img_h, tile_w, tile_h);
+
+	if (codec == EQOI_CODEC_PALETTE ||
+		(codec == EQOI_CODEC_AUTO && (uint64_t)hdr->tile_w * hdr->tile_h >= EQOI_PALETTE_MIN_PIXELS)) {
+		// СֿĵɫĶռѼeqoi_max_file_size, ֻɫ
+		if (eqoi_palette_count(prgb, (size_t)img_w * 3, img_w, img_h) <= EQOI_PALETTE_MAX) {
+			hdr->codec = EQOI_CODEC_PALETTE;
+		}
+		else if (codec == EQOI_CODEC_PALETTE) {
+			return EQOI_ERR_ARG;
+		}
+	}
+
+	if (dict != NULL && hdr->codec == EQOI_CODEC_MED) {
+		hdr->version = EQOI_VERSION_DICT;
+		hdr->dict_id = dict->id;
+		hdr->dict = dict;
+	}
+
+	return EQOI_OK;
+}
+
+/*************************
+@calc
+@private
+@brief  ɫģʽķֿÿ4ֽڵ󳤶(ɫռ769ֽ, С385صķֿΪ0)
+@param  w ֿ
+		h ֿ߶
+@return ĳ(ֽ)
+*************************/
+static uint64_t palette_slack(uint32_t w, uint32_t h) {
+	uint64_t px_cnt = (uint64_t)w * h;
+	uint64_t len = eqoi_palette_max_size(w, h, (uint32_t)__MIN(px_cnt, (uint64_t)EQOI_PALETTE_MAX));
+
+	return len > px_cnt * 4 ? len - px_cnt * 4 : 0;
+}
+
+/*************************
+@io
+@private
+@brief  Уļͷ
+@param  file ļ(ָ, Ϊڴӳ)
+		len ļ
+		hdr õļͷ(ָ)
+		prefix ֻҪļͷƫƱ(־, Ϊ0ʱѹҲ)
+@return 
+*************************/
+static int parse_header(const unsigned char* file, size_t len, eqoi_header_t* hdr, _Bool prefix) {
+	memset(hdr, 0, sizeof(eqoi_header_t));
+
+	if (len >= 4 && !memcmp(file, EQOI_MAGIC, 4)) {
+		if (len < EQOI_HEADER_SIZE) {
+			return EQOI_ERR_TRUNC;
+		}
+
+		hdr->version = rd_u16(file + 4);
+		hdr->header_size = rd_u16(file + 6);
+		hdr->width = rd_u32(file + 8);
+		hdr->height = rd_u32(file + 12);
+		hdr->pixel_fmt = file[16];
+		hdr->channels = file[17];
+		hdr->bit_depth = file[18];
+		hdr->codec = file[19];
+		hdr->flags = rd_u32(file + 20);
+		hdr->tile_w = rd_u32(file + 24);
+		hdr->tile_h = rd_u32(file + 28);
+		hdr->tile_cnt = rd_u32(file + 32);
+		hdr->data_crc = rd_u32(file + 36);
+		hdr->data_offset = rd_u64(file + 40);
+		hdr->data_len = rd_u64(file + 48);
+		hdr->dict_id = hdr->version >= EQOI_VERSION_DICT ? rd_u32(file + 56) : 0;
+
+		if (hdr->version > EQOI_VERSION) {
+			return EQOI_ERR_VERSION;
+		}
+		if (hdr->header_size < EQOI_HEADER_SIZE || !hdr->width || !hdr->height || !hdr->tile_w || !hdr->tile_h ||
+			hdr->tile_cnt != eqoi_tile_count(hdr->width, hdr->height, hdr->tile_w, hdr->tile_h)) {
+			return EQOI_ERR_FORMAT;
+		}
+
+		uint64_t table_end = (uint64_t)hdr->header_size + ((uint64_t)hdr->tile_cnt + 1) * 8;
+
+		if (table_end > len || hdr->data_offset < table_end || hdr->data_offset > len ||
+			(!prefix && hdr->data_len > len - hdr->data_offset)) {
+			return EQOI_ERR_TRUNC;
+		}
+
+		uint32_t crc = eqoi_crc32(0, file, 60);
+		crc = eqoi_crc32(crc, file + hdr->header_size, ((size_t)hdr->tile_cnt + 1) * 8);
+
+		if (crc != rd_u32(file + 60)) {
+			return EQOI_ERR_CRC;
+		}
+
+		hdr->table = file + hdr->header_size;
+
+		if (eqoi_tile_offset(hdr, hdr->tile_cnt) != hdr->data_len) {
+			return EQOI_ERR_FORMAT;
+		}
+	}
+	else {
+		// ɰQoiHeader: 16λ, 16λ߶, 32λѹݳ(MSVC)
+		if (len < EQOI_LEGACY_HEADER_SIZE) {
+			return EQOI_ERR_FORMAT;
+		}
+
+		hdr->width = rd_u16(file);
+		hdr->height = rd_u16(file + 2);
+		hdr->data_len = rd_u32(file + 4);
+
+		if (!hdr->width || !hdr->height || hdr->data_len > len - EQOI_LEGACY_HEADER_SIZE) {
+			return EQOI_ERR_FORMAT;
+		}
+
+		hdr->version = 0;
+		hdr->header_size = EQOI_LEGACY_HEADER_SIZE;
+		hdr->pixel_fmt = EQOI_FMT_RGB8;
+		hdr->channels = 3;
+		hdr->bit_depth = 8;
+		hdr->codec = EQOI_CODEC_MED;
+		hdr->tile_w = hdr->width;
+		hdr->tile_h = hdr->height;
+		hdr->tile_cnt = 1;
+		hdr->data_offset = EQOI_LEGACY_HEADER_SIZE;
+	}
+
+	if (hdr->pixel_fmt < EQOI_FMT_RGB8 || hdr->pixel_fmt > EQOI_FMT_YUV422 ||
+		hdr->codec < EQOI_CODEC_MED || hdr->codec > EQOI_CODEC_PROGRESSIVE ||
+		(hdr->pixel_fmt != EQOI_FMT_RGB8 && hdr->codec != EQOI_CODEC_MED)) {
+		return EQOI_ERR_VERSION;
+	}
+	if (hdr->codec == EQOI_CODEC_PROGRESSIVE && (hdr->tile_cnt != 1 || hdr->dict_id)) {
+		return EQOI_ERR_FORMAT; // ģʽֻһֿ, ʹֵ
+	}
+	if (hdr->pixel_fmt == EQOI_FMT_RGB16 ? hdr->bit_depth < EQOI_WIDE_MIN_DEPTH || hdr->bit_depth > EQOI_WIDE_MAX_DEPTH :
+		hdr->bit_depth != 8) {
+		return EQOI_ERR_FORMAT;
+	}
+	if (EQOI_FMT_IS_BAYER(hdr->pixel_fmt) && ((hdr->width | hdr->height | hdr->tile_w | hdr->tile_h) & 1)) {
+		return EQOI_ERR_FORMAT; // ֿ븲2x2ɫƬԪ
+	}
+	if (EQOI_FMT_IS_YUV(hdr->pixel_fmt) && ((hdr->tile_w < hdr->width && (hdr->tile_w & 1)) ||
+		(hdr->tile_h < hdr->height && hdr->tile_h % EQOI_YUV_SUB_Y(hdr->pixel_fmt)))) {
+		return EQOI_ERR_FORMAT; // ֿɫȲı߽翪ʼ
+	}
+
+	return EQOI_OK;
+}
+
+/*************************
+@encode
+@private
+@brief  뵥ֿ()
+@param  arg ֿ(ָ)
+		i ֿ
+		worker ̱߳(ѡ̵߳ݴ)
+@return none
+*************************/
+static void encode_tile_task(void* arg, uint32_t i, int worker) {
+	tile_job_t* job = (tile_job_t*)arg;
+	uint32_t x, y, w, h;
+
+	eqoi_tile_rect(job->hdr, i, &x, &y, &w, &h);
+
+	if (EQOI_FMT_IS_YUV(job->hdr->pixel_fmt)) {
+		int sub_y = EQOI_YUV_SUB_Y(job->hdr->pixel_fmt);
+		eqoi_yuv_t tile = *(const eqoi_yuv_t*)job->pixels;
+
+		tile.y += (size_t)y * tile.y_stride + x;
+		tile.u += (size_t)(y / sub_y) * tile.c_stride + (size_t)(x / 2) * tile.c_step;
+		tile.v += (size_t)(y / sub_y) * tile.c_stride + (size_t)(x / 2) * tile.c_step;
+
+		job->lens[i] = eqoi_yuv_encode(&tile, w, h, sub_y, job->data + job->offsets[i]);
+
+		return;
+	}
+
+	size_t px_size = eqoi_pixel_size(job->hdr);
+	size_t stride = (size_t)job->hdr->width * px_size;
+
+	job->lens[i] = eqoi_encode_tile(job->hdr, job->pixels + (size_t)y * stride + (size_t)x * px_size, stride, w, h,
+		job->scratch != NULL ? job->scratch + (size_t)worker * job->scratch_size : NULL, job->data + job->offsets[i]);
+
+	if (!job->lens[i]) {
+		job->err = EQOI_ERR_MEM;
+	}
+}
+
+/*************************
+@decode
+@private
+@brief  뵥ֿ()
+@param  arg ֿ(ָ)
+		i ֿ
+@return none
+*************************/
+static void decode_tile_task(void* arg, uint32_t i) {
+	tile_job_t* job = (tile_job_t*)arg;
+	uint32_t x, y, w, h;
+	size_t px_size = eqoi_pixel_size(job->hdr);
+	size_t stride = (size_t)job->hdr->width * px_size;
+
+	eqoi_tile_rect(job->hdr, i, &x, &y, &w, &h);
+
+	int err = EQOI_FMT_IS_YUV(job->hdr->pixel_fmt) ?
+		eqoi_decode_tile_yuv(job->file, job->hdr, i, (const eqoi_yuv_t*)job->pixels) :
+		eqoi_decode_tile(job->file, job->hdr, i, job->pixels + (size_t)y * stride + (size_t)x * px_size, stride);
+
+	if (err != EQOI_OK) {
+		job->err = err;
+	}
+}
@@ -0,0 +1,183 @@
+/************************************************************************************************************************
+ǿQOIļʽ
+@brief  ʽӿͷļ
+@date   2026/10/18
+@info   ֶξΪС, ļͷ64ֽ, ֿƫƱ, ֮Ϊֿѹ
+
+		ƫ  ֶ
+		0    4    ħ"EQOI"
+		4    2    ʽ汾
+		6    2    ļͷ(ƫƱʼλ)
+		8    4    ͼ
+		12   4    ͼ߶
+		16   1    ظʽ(EQOI_FMT_*)
+		17   1    ͨ
+		18   1    ÿͨλ(EQOI_FMT_RGB16Ϊ9~16, ظʽΪ8)
+		19   1    (EQOI_CODEC_*)
+		20   4    ־(EQOI_FLAG_*)
+		24   4    ֿ
+		28   4    ֿ߶
+		32   4    ֿ
+		36   4    ѹݵCRC32
+		40   8    ѹļеƫ
+		48   8    ѹݳ
+		56   4    ֵID(0ʾʹֵ, 汾2Ч)
+		60   4    ļͷƫƱCRC32
+
+		ƫƱ(ֿ+1), ÿ8ֽ, Ϊֿѹʼƫ, һѹݳ,
+		ֿiѹݼΪ[i, i+1), ֿ鰴դ˳, ÿֿ
+
+		ֵļ(汾2)ÿֵֿһؿʼ, ֵ䵥Ϊ116ֽڵֵļ:
+		ƫ  ֶ
+		0    4    ħ"EQDC"
+		4    2    ֵʽ汾
+		6    2    (Ϊ0)
+		8    4    ֵID(ֵݵCRC32, Ϊ0ʱȡ1)
+		12   96   ʼ(32, ÿΪr, g, b)
+		108  3    ʼһ(r, g, b)
+		111  1    (Ϊ0)
+		112  4    ֵļǰ112ֽڵCRC32
+************************************************************************************************************************/
+
+#ifndef __EQOI_CONTAINER_H
+#define __EQOI_CONTAINER_H
+
+#include "eqoi_palette.h"
+#include "eqoi_wide.h"
+#include "eqoi_gray.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ļͷ
+#define EQOI_MAGIC "EQOI" // ħ
+#define EQOI_VERSION 2 // ǰʽ汾()
+#define EQOI_VERSION_BASE 1 // ֵļдİ汾
+#define EQOI_VERSION_DICT 2 // ֵļдİ汾
+#define EQOI_HEADER_SIZE 64 // ļͷ(ֽ)
+#define EQOI_LEGACY_HEADER_SIZE 8 // ɰļͷ(QoiHeader)(ֽ)
+
+// ֵļ
+#define EQOI_DICT_MAGIC "EQDC" // ħ
+#define EQOI_DICT_VERSION 1 // ֵʽ汾
+#define EQOI_DICT_SIZE 116 // ֵļ(ֽ)
+
+// ظʽ
+#define EQOI_FMT_RGB8 1 // 3ͨ֯, ÿͨ8λ(ͨ˳һ)
+#define EQOI_FMT_RGB16 2 // 3ͨ֯, ÿͨһuint16_t(ֽ, ЧλΪÿͨλ, eqoi_wide.h)
+#define EQOI_FMT_GRAY8 3 // ͨҶ, 8λ(eqoi_gray.h)
+#define EQOI_FMT_GA8 4 // Ҷ+͸2ͨ֯, ÿͨ8λ(eqoi_gray.h)
+#define EQOI_FMT_BAYER_RGGB 5 // Bayer, ÿй8λ, Ͻ2x2ΪR G / G B(CFAģʽ, eqoi_gray.h)
+#define EQOI_FMT_BAYER_GRBG 6 // Bayer, Ͻ2x2ΪG R / B G
+#define EQOI_FMT_BAYER_GBRG 7 // Bayer, Ͻ2x2ΪG B / R G
+#define EQOI_FMT_BAYER_BGGR 8 // Bayer, Ͻ2x2ΪB G / G R
+#define EQOI_FMT_YUV420 9 // YCbCrƽ, ɫˮƽ봹ֱ(eqoi_gray.h, NV12)
+#define EQOI_FMT_YUV422 10 // YCbCrƽ, ɫˮƽ(NV16)
+#define EQOI_FMT_IS_BAYER(F) ((F) >= EQOI_FMT_BAYER_RGGB && (F) <= EQOI_FMT_BAYER_BGGR) // ǷΪBayer
+#define EQOI_FMT_IS_YUV(F) ((F) == EQOI_FMT_YUV420 || (F) == EQOI_FMT_YUV422) // ǷΪYUVƽʽ
+#define EQOI_YUV_SUB_Y(F) ((F) == EQOI_FMT_YUV420 ? 2 : 1) // YUVʽɫȵĴֱ
+
+// 
+#define EQOI_CODEC_AUTO 0 // ʱԶѡ(256ɫʱʹõɫģʽ, дļ)
+#define EQOI_CODEC_MED 1 // JPEG-LSԤ + 7ֱ
+#define EQOI_CODEC_PALETTE 2 // ɫ + γ(eqoi_palette.h, ʹֵ)
+#define EQOI_CODEC_PROGRESSIVE 3 // ӲĻͼ + ֵԤϸ(eqoi_prog.h, ֻһֿ, ʹֵ)
+
+// ־
+#define EQOI_FLAG_DATA_CRC 0x00000001 // ѹݵCRC32Ч
+
+// 
+#define EQOI_OK 0 // ɹ
+#define EQOI_ERR_ARG -1 // 
+#define EQOI_ERR_FORMAT -2 // ЧEQOIļ
+#define EQOI_ERR_VERSION -3 // ֵ֧ĸʽ汾
+#define EQOI_ERR_CRC -4 // CRCУʧ
+#define EQOI_ERR_TRUNC -5 // ļض
+#define EQOI_ERR_MEM -6 // ڴʧ
+#define EQOI_ERR_IO -7 // ļдʧ
+#define EQOI_ERR_UNSUPPORTED -8 // δ
+#define EQOI_ERR_DICT -9 // ȱļõֵֵID
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ֵ(ṹ嶨)
+typedef struct {
+	uint32_t id; // ֵID
+	qoi_dict_t state; // ĳʼ״̬
+} eqoi_dict_t;
+
+// ļͷ(ṹ嶨)
+typedef struct {
+	uint16_t version; // ʽ汾(0ʾɰQoiHeader)
+	uint16_t header_size; // ļͷ
+	uint32_t width; // ͼ
+	uint32_t height; // ͼ߶
+	uint8_t pixel_fmt; // ظʽ
+	uint8_t channels; // ͨ
+	uint8_t bit_depth; // ÿͨλ
+	uint8_t codec; // 
+	uint32_t flags; // ־
+	uint32_t tile_w; // ֿ
+	uint32_t tile_h; // ֿ߶
+	uint32_t tile_cnt; // ֿ
+	uint32_t data_crc; // ѹݵCRC32
+	uint64_t data_offset; // ѹļеƫ
+	uint64_t data_len; // ѹݳ
+	uint32_t dict_id; // ֵID(0ʾʹֵ)
+	const eqoi_dict_t* dict; // ʹõֵ(ָ, eqoi_use_dict)
+	const unsigned char* table; // ֿƫƱ(ָļ, ɰļΪNULL)
+} eqoi_header_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t eqoi_crc32(uint32_t crc, const void* data, size_t len); // CRC32
+const char* eqoi_strerror(int err); // ȡ
+uint64_t eqoi_tile_count(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h); // ֿ
+size_t eqoi_max_file_size(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h); // ļ󳤶
+size_t eqoi_max_file_size_wide(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int bit_depth); // λͼļ󳤶
+size_t eqoi_max_file_size_gray(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int channels); // Ҷͼļ󳤶
+size_t eqoi_max_file_size_yuv(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int pixel_fmt); // YUVͼļ󳤶
+size_t eqoi_pixel_size(const eqoi_header_t* hdr); // ȡÿصֽ
+size_t eqoi_decoded_size(const eqoi_header_t* hdr); // ȡֽ
+
+void eqoi_init_header(eqoi_header_t* hdr, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h); // ʼļͷ
+void eqoi_write_header(unsigned char* dst, eqoi_header_t* hdr, const uint64_t* offsets); // дļͷƫƱ
+int eqoi_parse_header(const unsigned char* file, size_t len, eqoi_header_t* hdr); // Уļͷ
+int eqoi_parse_header_prefix(const unsigned char* file, size_t len, eqoi_header_t* hdr); // ضϵļļͷ
+int eqoi_check_data(const unsigned char* file, const eqoi_header_t* hdr); // УѹݵCRC32
+
+uint32_t eqoi_dict_id(const qoi_dict_t* state); // ֵID
+void eqoi_write_dict(unsigned char* dst, const eqoi_dict_t* dict); // дֵļ
+int eqoi_parse_dict(const unsigned char* file, size_t len, eqoi_dict_t* dict); // Уֵļ
+int eqoi_use_dict(eqoi_header_t* hdr, const eqoi_dict_t* dict); // Ϊָļõֵ
+
+uint64_t eqoi_tile_offset(const eqoi_header_t* hdr, uint32_t i); // ȡֿѹƫ
+uint64_t eqoi_tile_max_len(const eqoi_header_t* hdr, uint32_t w, uint32_t h); // ֿ󳤶
+void eqoi_tile_rect(const eqoi_header_t* hdr, uint32_t i, uint32_t* x, uint32_t* y, uint32_t* w, uint32_t* h); // ȡֿͼеλ
+int eqoi_open_tile(const unsigned char* file, const eqoi_header_t* hdr, uint32_t i, qoi_decoder_t* dec); // Էֿʼ
+
+int eqoi_encode(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int threads,
+	unsigned char* dst, size_t cap, size_t* out_len); // ͼΪEQOIļ
+int eqoi_encode_dict(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int threads,
+	const eqoi_dict_t* dict, unsigned char* dst, size_t cap, size_t* out_len); // ֵ佫ͼΪEQOIļ
+int eqoi_encode_codec(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int threads,
+	int codec, const eqoi_dict_t* dict, unsigned char* dst, size_t cap, size_t* out_len); // ָı彫ͼΪEQOIļ
+size_t eqoi_encode_work_size(uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h); // eqoi_encode_workĹС
+int eqoi_encode_work(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h, int codec,
+	const eqoi_dict_t* dict, void* work, size_t work_size, unsigned char* dst, size_t cap, size_t* out_len); // ԵṩĹͼΪEQOIļ(ڴ)
+int eqoi_encode_wide(const uint16_t* prgb, uint32_t img_w, uint32_t img_h, int bit_depth, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len); // λͼΪEQOIļ
+int eqoi_encode_gray(const unsigned char* pgray, uint32_t img_w, uint32_t img_h, int channels, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len); // Ҷ(Ҷ+͸)ͼΪEQOIļ
+int eqoi_encode_cfa(const unsigned char* pcfa, uint32_t img_w, uint32_t img_h, int pixel_fmt, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len); // Bayer˱ΪEQOIļ
+int eqoi_encode_yuv(const eqoi_yuv_t* img, uint32_t img_w, uint32_t img_h, int pixel_fmt, uint32_t tile_w, uint32_t tile_h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len); // YUVͼΪEQOIļ
+size_t eqoi_encode_tile(const eqoi_header_t* hdr, const unsigned char* pixels, size_t stride, uint32_t w, uint32_t h,
+	void* scratch, unsigned char* dst); // ļͷĸʽ뵥ֿ
+int eqoi_decode_tile(const unsigned char* file, const eqoi_header_t* hdr, uint32_t i, unsigned char* pdecoded, size_t stride); // 뵥ֿ
+int eqoi_decode(const unsigned char* file, const eqoi_header_t* hdr, int threads, unsigned char* pdecoded); // ͼ
+int eqoi_decode_tile_yuv(const unsigned char* file, const eqoi_header_t* hdr, uint32_t i, const eqoi_yuv_t* img); // YUVͼĵֿ
+int eqoi_decode_yuv(const unsigned char* file, const eqoi_header_t* hdr, int threads, const eqoi_yuv_t* img); // ָڴнYUVͼ
+int eqoi_scan_ops(const unsigned char* file, const eqoi_header_t* hdr, qoi_op_stats_t* stats); // ͳƸ
+
+#endif
@@ -0,0 +1,142 @@
+/************************************************************************************************************************
+ǿQOICPUԼں˷
+@brief  CPUֵָ֧, ȷģʹõں˵λ
+@date   2026/10/18
+@info   λ״ʹʱȷ(POSIXƽ̨pthread_onceֻ֤ʼһ): EQOI_CPU_TIERָ˵λʱʹøõ
+		(CPUֵ֧ߵ), ȡCPUֵ֧ߵEQOI_TIER_AUTO_MAXнϵ; AVX/AVX-512Ƿ
+		__builtin_cpu_supports, ѰϵͳǷ񱣴ӦĴ״̬ļ
+************************************************************************************************************************/
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#define EQOI_USE_PTHREAD
+#endif
+
+#include "eqoi_cpu.h"
+
+#ifdef EQOI_USE_PTHREAD
+#include <pthread.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char* tier_names[EQOI_TIER_CNT] = { "scalar", "sse2", "sse41", "avx2", "avx512" }; // λ
+
+static int cpu_best = EQOI_TIER_SCALAR; // CPUֵ֧ߵ
+static int cpu_tier = -1; // ǰʹõĵ(-1ʾδʼ)
+#ifdef EQOI_USE_PTHREAD
+static pthread_once_t tier_once = PTHREAD_ONCE_INIT; // λĳʼ־
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void init_tier(void); // ȷʼĵλ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  CPUֵ֧ߵ
+@param  none
+@return λ(EQOI_TIER_*)
+*************************/
+int eqoi_cpu_best_tier(void) {
+#ifdef EQOI_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+		return EQOI_TIER_AVX512;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return EQOI_TIER_AVX2;
+	}
+	if (__builtin_cpu_supports("sse4.1")) {
+		return EQOI_TIER_SSE41;
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		return EQOI_TIER_SSE2;
+	}
+#endif
+
+	return EQOI_TIER_SCALAR;
+}
+
+/*************************
+@calc
+@public
+@brief  ȡǰʹõĵ(״εʱCPUȡEQOI_CPU_TIER)
+@param  none
+@return λ(EQOI_TIER_*)
+*************************/
+int eqoi_cpu_tier(void) {
+#ifdef EQOI_USE_PTHREAD
+	pthread_once(&tier_once, init_tier);
+#else
+	if (cpu_tier < 0) {
+		init_tier();
+	}
+#endif
+
+	return cpu_tier;
+}
+
+/*************************
+@set
+@public
+@brief  лʹõĵ(CPUֵ֧ߵ; ûнеıʱ)
+@param  tier λ(EQOI_TIER_*)
+@return ʵʹõĵ
+*************************/
+int eqoi_cpu_set_tier(int tier) {
+	eqoi_cpu_tier();
+
+	cpu_tier = tier < EQOI_TIER_SCALAR ? EQOI_TIER_SCALAR : __MIN(tier, cpu_best);
+
+	return cpu_tier;
+}
+
+/*************************
+@calc
+@public
+@brief  ȡλ
+@param  tier λ(EQOI_TIER_*)
+@return ("scalar", "sse2", "sse41", "avx2""avx512")
+*************************/
+const char* eqoi_cpu_tier_name(int tier) {
+	return tier >= 0 && tier < EQOI_TIER_CNT ? tier_names[tier] : "unknown";
+}
+
+/*************************
+@parse
+@public
+@brief  Ʋҵλ
+@param  name 
+@return λ(EQOI_TIER_*, δ֪Ʒ-1)
+*************************/
+int eqoi_cpu_parse_tier(const char* name) {
+	for (int i = 0; i < EQOI_TIER_CNT; i++) {
+		if (!strcmp(name, tier_names[i])) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@init
+@private
+@brief  ȷʼĵλ(ָĵ, CPUֵ֧ߵEQOI_TIER_AUTO_MAXнϵ)
+@param  none
+@return none
+*************************/
+static void init_tier(void) {
+	const char* env = getenv(EQOI_TIER_ENV);
+	int tier = env != NULL ? eqoi_cpu_parse_tier(env) : -1;
+
+	cpu_best = eqoi_cpu_best_tier();
+	cpu_tier = tier < 0 ? __MIN(cpu_best, EQOI_TIER_AUTO_MAX) : __MIN(tier, cpu_best);
+}
@@ -0,0 +1,51 @@
+/************************************************************************************************************************
+ǿQOICPUԼں˷
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ͬһִļҪָͬĻ, ں(Ҷ/CFA/YUVλԤҶȱ
+		ɨγ)x86ϰ汾(ԺtargetԱ, ҪΪļָ-mavx2ѡ),
+		״ʹʱCPUֵ֧ߵѡʹõĵ, ģ鰴ں˱ȡӦĺ:
+		scalar  (ƽ̨벻ַ֧ɵıֻʹһ)
+		sse2    168λͨ/816λ
+		sse41   ͬsse2, blendvѡMEDĽ, 16λʹ޷min/max
+		avx2    328λͨ/1616λ
+		avx512  648λͨ/3216λ(AVX-512FAVX-512BW)
+		ֽͬ; Զѡʱֻõavx2(AVX-512ںʵûи, Ƶ巴), 
+		EQOI_CPU_TIERָCPUֵ֧һ(EQOI_CPU_TIER=scalaravx512), ڲԱ
+		8λRGBصCģ, ܷӰ
+************************************************************************************************************************/
+
+#ifndef __EQOI_CPU_H
+#define __EQOI_CPU_H
+
+#include "main.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// x86ں˲ʱ(GCC/Clang, EQOI_NO_DISPATCHʱֻʹñ)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(EQOI_NO_DISPATCH)
+#define EQOI_X86
+#define EQOI_TARGET(T) __attribute__((target(T)))
+#endif
+
+// ں˵λ
+#define EQOI_TIER_SCALAR 0
+#define EQOI_TIER_SSE2 1
+#define EQOI_TIER_SSE41 2
+#define EQOI_TIER_AVX2 3
+#define EQOI_TIER_AVX512 4
+#define EQOI_TIER_CNT 5
+
+#define EQOI_TIER_AUTO_MAX EQOI_TIER_AVX2 // Զѡʱߵ
+
+#define EQOI_TIER_ENV "EQOI_CPU_TIER" // ָλĻ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int eqoi_cpu_best_tier(void); // CPUֵ֧ߵ
+int eqoi_cpu_tier(void); // ȡǰʹõĵ
+int eqoi_cpu_set_tier(int tier); // лʹõĵ
+const char* eqoi_cpu_tier_name(int tier); // ȡλ
+int eqoi_cpu_parse_tier(const char* name); // Ʋҵλ
+
+#endif
@@ -0,0 +1,201 @@
+/************************************************************************************************************************
+ǿQOIֵѵ
+@brief  ͳиɫڶٷͼ, Ϊÿλѡɫ
+@date   2026/10/18
+@info   ÿͼһɫֻеһγʱҪֵ(֮иɫ), ˰"ڶٷͼ",
+		һͬγ̱, ͳ
+************************************************************************************************************************/
+
+#include "eqoi_dict.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define DICT_HT_INIT 4096 // ɫĳʼ(Ϊ2)
+
+// ɫı(ṹ嶨)
+typedef struct {
+	uint32_t key; // ɫ(0xRRGGBB | 1 << 24, 0ʾ)
+	uint32_t cnt; // ָɫͼ
+	uint32_t last; // һμͼ+1
+} dict_ht_ent_t;
+
+// ɫ(ṹ嶨)
+typedef struct {
+	dict_ht_ent_t* ents; // (׵ַ)
+	size_t cap; // (2)
+	size_t used; // ʹõı
+} dict_ht_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int ht_count(dict_ht_t* ht, uint32_t key, uint32_t img); // Ϊɫ(ͬһͼֻһ)
+static int ht_grow(dict_ht_t* ht); // ɫ
+static qoi_rgb_t ent_rgb(const dict_ht_ent_t* e); // ȡɫ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  һͼѵֵ(ÿλȡͼеɫ, ʼһȡ׸)
+@param  imgs ͼ(׵ַ)
+		n 
+		dict ѵõֵ(ָ)
+@return 
+*************************/
+int eqoi_train_dict(const eqoi_image_t* imgs, uint32_t n, eqoi_dict_t* dict) {
+	if (imgs == NULL || !n || dict == NULL) {
+		return EQOI_ERR_ARG;
+	}
+
+	dict_ht_t ht = { calloc(DICT_HT_INIT, sizeof(dict_ht_ent_t)), DICT_HT_INIT, 0 };
+	dict_ht_t first = { calloc(DICT_HT_INIT, sizeof(dict_ht_ent_t)), DICT_HT_INIT, 0 };
+	int err = (ht.ents == NULL || first.ents == NULL) ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (uint32_t i = 0; i < n && err == EQOI_OK; i++) {
+		const eqoi_image_t* img = imgs + i;
+		size_t stride = img->stride ? img->stride : (size_t)img->width * 3;
+		uint32_t prev = 0;
+
+		if (img->prgb == NULL || !img->width || !img->height) {
+			err = EQOI_ERR_ARG;
+			break;
+		}
+
+		for (uint32_t y = 0; y < img->height && err == EQOI_OK; y++) {
+			const unsigned char* p = img->prgb + (size_t)y * stride;
+
+			for (uint32_t x = 0; x < img->width && err == EQOI_OK; x++, p += 3) {
+				// ذb, g, r
+				uint32_t key = (uint32_t)p[2] << 16 | (uint32_t)p[1] << 8 | p[0] | 1u << 24;
+
+				if (!(x | y)) {
+					err = ht_count(&first, key, i);
+				}
+				if (err == EQOI_OK && key != prev) {
+					err = ht_count(&ht, key, i);
+				}
+
+				prev = key;
+			}
+		}
+	}
+
+	if (err == EQOI_OK) {
+		const dict_ht_ent_t* best[INDEX_TB_L] = { NULL };
+		const dict_ht_ent_t* seed = NULL;
+
+		// ͬΪʱȡֵСɫ, ʹѵ˳޹
+		for (size_t k = 0; k < ht.cap; k++) {
+			const dict_ht_ent_t* e = ht.ents + k;
+			qoi_rgb_t c = ent_rgb(e);
+			const dict_ht_ent_t** b = best + (c.r + c.g + c.b) % INDEX_TB_L;
+
+			if (e->key && (*b == NULL || e->cnt > (*b)->cnt || (e->cnt == (*b)->cnt && e->key < (*b)->key))) {
+				*b = e;
+			}
+		}
+
+		for (size_t k = 0; k < first.cap; k++) {
+			const dict_ht_ent_t* e = first.ents + k;
+
+			if (e->key && (seed == NULL || e->cnt > seed->cnt || (e->cnt == seed->cnt && e->key < seed->key))) {
+				seed = e;
+			}
+		}
+
+		for (int k = 0; k < INDEX_TB_L; k++) {
+			dict->state.index_tb[k] = best[k] == NULL ? (qoi_rgb_t){ 0, 0, 0 } : ent_rgb(best[k]);
+		}
+
+		dict->state.px = ent_rgb(seed);
+		dict->id = eqoi_dict_id(&dict->state);
+	}
+
+	free(ht.ents);
+	free(first.ents);
+
+	return err;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@private
+@brief  Ϊɫ(ͬһͼֻһ, һʱ)
+@param  ht ɫ(ָ)
+		key ɫ
+		img ͼ
+@return 
+*************************/
+static int ht_count(dict_ht_t* ht, uint32_t key, uint32_t img) {
+	if (ht->used * 2 >= ht->cap && ht_grow(ht) != EQOI_OK) {
+		return EQOI_ERR_MEM;
+	}
+
+	size_t mask = ht->cap - 1;
+	size_t k = (key * 2654435761u) & mask;
+
+	while (ht->ents[k].key && ht->ents[k].key != key) {
+		k = (k + 1) & mask;
+	}
+
+	dict_ht_ent_t* e = ht->ents + k;
+
+	if (!e->key) {
+		e->key = key;
+		ht->used++;
+	}
+	if (e->last != img + 1) {
+		e->last = img + 1;
+		e->cnt++;
+	}
+
+	return EQOI_OK;
+}
+
+/*************************
+@calc
+@private
+@brief  ɫΪ2
+@param  ht ɫ(ָ)
+@return 
+*************************/
+static int ht_grow(dict_ht_t* ht) {
+	size_t cap = ht->cap * 2;
+	dict_ht_ent_t* ents = calloc(cap, sizeof(dict_ht_ent_t));
+
+	if (ents == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	for (size_t i = 0; i < ht->cap; i++) {
+		if (ht->ents[i].key) {
+			size_t k = (ht->ents[i].key * 2654435761u) & (cap - 1);
+
+			while (ents[k].key) {
+				k = (k + 1) & (cap - 1);
+			}
+
+			ents[k] = ht->ents[i];
+		}
+	}
+
+	free(ht->ents);
+	ht->ents = ents;
+	ht->cap = cap;
+
+	return EQOI_OK;
+}
+
+/*************************
+@calc
+@private
+@brief  ȡɫ
+@param  e (ָ)
+@return ɫ
+*************************/
+static qoi_rgb_t ent_rgb(const dict_ht_ent_t* e) {
+	return (qoi_rgb_t){ (unsigned char)(e->key >> 16), (unsigned char)(e->key >> 8), (unsigned char)e->key };
+}
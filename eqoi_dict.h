@@ -0,0 +1,19 @@
+/************************************************************************************************************************
+ǿQOIֵѵ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ͬһСͼ(ͼƬͼͼ)Դȫʼ, ͷֽڶѧϰͬɫ,
+		ֵһѵʼʼһ, ֻһ(EQDCֵļ), ֵID,
+		ֵ״̬ʼ, صĿ
+************************************************************************************************************************/
+
+#ifndef __EQOI_DICT_H
+#define __EQOI_DICT_H
+
+#include "eqoi_batch.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int eqoi_train_dict(const eqoi_image_t* imgs, uint32_t n, eqoi_dict_t* dict); // һͼѵֵ
+
+#endif
@@ -0,0 +1,498 @@
+/************************************************************************************************************************
+ǿQOIѹüƴ
+@brief  ķֿ鸴, ֿ±
+@date   2026/10/18
+************************************************************************************************************************/
+
+#include "eqoi_edit.h"
+#include "eqoi_parallel.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ԴͼƬ(ṹ嶨)
+typedef struct {
+	const unsigned char* file; // Դļ(ָ)
+	const eqoi_header_t* hdr; // Դļͷ(ָ)
+	uint32_t src_x; // ƬԴͼеϽǺ
+	uint32_t src_y; // ƬԴͼеϽ
+	uint32_t dst_x; // ƬͼеϽǺ
+	uint32_t dst_y; // ƬͼеϽ
+	uint32_t w; // Ƭο
+	uint32_t h; // Ƭθ߶
+} edit_piece_t;
+
+// ѹ༭(ṹ嶨)
+typedef struct {
+	const eqoi_header_t* hdr; // ļͷ(ָ)
+	const edit_piece_t* pieces; // ԴͼƬ(׵ַ)
+	uint32_t piece_cnt; // Ƭθ
+	unsigned char* data; // ѹ(ָ)
+	uint64_t* offsets; // ֿдλ
+	uint64_t* lens; // ֿѹ
+	unsigned char* copied; // ֿǷԴ(־)
+	volatile int err; // 
+} edit_job_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static _Bool editable(const eqoi_header_t* hdr); // жļǷѹб༭
+static void init_output(eqoi_header_t* out, const eqoi_header_t* src, uint32_t img_w, uint32_t img_h); // Դļĸʽʼļͷ
+static int edit_tiles(eqoi_header_t* hdr, const edit_piece_t* pieces, uint32_t piece_cnt, int threads, unsigned char* dst,
+	size_t cap, size_t* out_len, eqoi_edit_stats_t* stats); // ֿ鸴ƻر벢дļͷ
+static void edit_tile_task(void* arg, uint32_t i); // ɵֿ()
+static int copy_tile(const edit_job_t* job, const edit_piece_t* pc, uint32_t i, uint32_t x, uint32_t y, uint32_t w,
+	uint32_t h); // ԸԴֿ
+static int reencode_tile(const edit_job_t* job, uint32_t i, uint32_t x, uint32_t y, uint32_t w, uint32_t h); // ±
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ü/ƴӽļ
+@param  hdr Դļͷ(ָ, ƴʱΪ׸Դļ, ṩظʽֿߴ)
+		img_w Ŀ
+		img_h ĸ߶
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_edit_max_size(const eqoi_header_t* hdr, uint32_t img_w, uint32_t img_h) {
+	eqoi_header_t out;
+
+	init_output(&out, hdr, img_w, img_h);
+
+	uint64_t size = out.data_offset;
+
+	for (uint32_t i = 0; i < out.tile_cnt; i++) {
+		uint32_t x, y, w, h;
+		eqoi_tile_rect(&out, i, &x, &y, &w, &h);
+
+		size += eqoi_tile_max_len(&out, w, h);
+	}
+
+	return (size_t)size;
+}
+
+/*************************
+@edit
+@public
+@brief  ѹвüͼ(ü鸴, пķֿ±)
+@param  file Դļ(ָ)
+		hdr Դļͷ(ָ, ֵʱeqoi_use_dictֵָ)
+		x üϽǵк
+		y üϽǵк
+		w ü
+		h ü߶
+		threads ߳(ֿ鲢, <=0ʾʹȫCPU)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_edit_max_size(hdr, w, h))
+		out_len ļ(ָ)
+		stats ͳ(ָ, ΪNULL)
+@return 
+*************************/
+int eqoi_crop(const unsigned char* file, const eqoi_header_t* hdr, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len, eqoi_edit_stats_t* stats) {
+	if (!w || !h || x >= hdr->width || y >= hdr->height || w > hdr->width - x || h > hdr->height - y || !editable(hdr)) {
+		return EQOI_ERR_ARG;
+	}
+	if (EQOI_FMT_IS_BAYER(hdr->pixel_fmt) && ((x | y | w | h) & 1)) {
+		return EQOI_ERR_ARG; // ɫƬ2x2Ԫ
+	}
+
+	edit_piece_t piece = { file, hdr, x, y, 0, 0, w, h };
+	eqoi_header_t out;
+
+	init_output(&out, hdr, w, h);
+
+	return edit_tiles(&out, &piece, 1, threads, dst, cap, out_len, stats);
+}
+
+/*************************
+@check
+@public
+@brief  ƴ(ʽһ, ͬһи߶ͬ, ͬһпͬ)ĳߴ
+@param  hdrs Դļͷ(դ˳, cols*rows)
+		cols 
+		rows 
+		img_w Ŀ(ָ)
+		img_h ĸ߶(ָ)
+@return 
+*************************/
+int eqoi_stitch_dims(const eqoi_header_t* hdrs, uint32_t cols, uint32_t rows, uint32_t* img_w, uint32_t* img_h) {
+	if (!cols || !rows || (uint64_t)cols * rows > UINT32_MAX || !editable(&hdrs[0])) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint64_t w = 0;
+	uint64_t h = 0;
+
+	for (uint32_t c = 0; c < cols; c++) {
+		w += hdrs[c].width;
+	}
+	for (uint32_t r = 0; r < rows; r++) {
+		h += hdrs[(size_t)r * cols].height;
+	}
+
+	if (w > UINT32_MAX || h > UINT32_MAX ||
+		eqoi_tile_count((uint32_t)w, (uint32_t)h, hdrs[0].tile_w, hdrs[0].tile_h) >= UINT32_MAX) {
+		return EQOI_ERR_ARG;
+	}
+
+	for (size_t i = 0; i < (size_t)cols * rows; i++) {
+		const eqoi_header_t* a = &hdrs[i];
+
+		if (a->width != hdrs[i % cols].width || a->height != hdrs[i - i % cols].height ||
+			a->pixel_fmt != hdrs[0].pixel_fmt || a->channels != hdrs[0].channels || a->bit_depth != hdrs[0].bit_depth ||
+			a->codec != hdrs[0].codec || a->dict_id != hdrs[0].dict_id) {
+			return EQOI_ERR_ARG;
+		}
+	}
+
+	*img_w = (uint32_t)w;
+	*img_h = (uint32_t)h;
+
+	return EQOI_OK;
+}
+
+/*************************
+@edit
+@public
+@brief  ѹƴͼ(ֿϵԴֿ鸴, ԽƴӴķֿ±)
+@param  files Դļ(դ˳, cols*rows)
+		hdrs Դļͷ(դ˳, ֵʱeqoi_use_dictֵָ)
+		cols 
+		rows 
+		threads ߳(ֿ鲢, <=0ʾʹȫCPU)
+		dst ļ(ָ)
+		cap ļ(Сeqoi_edit_max_size(&hdrs[0], Ŀ, ĸ߶))
+		out_len ļ(ָ)
+		stats ͳ(ָ, ΪNULL)
+@return (һʱEQOI_ERR_ARG)
+*************************/
+int eqoi_stitch(const unsigned char* const* files, const eqoi_header_t* hdrs, uint32_t cols, uint32_t rows, int threads,
+	unsigned char* dst, size_t cap, size_t* out_len, eqoi_edit_stats_t* stats) {
+	uint32_t img_w, img_h;
+	int err = eqoi_stitch_dims(hdrs, cols, rows, &img_w, &img_h);
+
+	if (err != EQOI_OK) {
+		return err;
+	}
+
+	uint32_t n = cols * rows;
+	edit_piece_t* pieces = malloc((size_t)n * sizeof(edit_piece_t));
+
+	if (pieces == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	uint32_t y = 0;
+
+	for (uint32_t r = 0; r < rows; r++) {
+		uint32_t x = 0;
+
+		for (uint32_t c = 0; c < cols; c++) {
+			uint32_t i = r * cols + c;
+			edit_piece_t piece = { files[i], &hdrs[i], 0, 0, x, y, hdrs[i].width, hdrs[i].height };
+
+			pieces[i] = piece;
+			x += hdrs[i].width;
+		}
+
+		y += hdrs[r * cols].height;
+	}
+
+	eqoi_header_t out;
+
+	init_output(&out, &hdrs[0], img_w, img_h);
+	err = edit_tiles(&out, pieces, n, threads, dst, cap, out_len, stats);
+	free(pieces);
+
+	return err;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@check
+@private
+@brief  жļǷѹб༭(֧YUV뽥ģʽ)
+@param  hdr ļͷ(ָ)
+@return ǷԱ༭
+*************************/
+static _Bool editable(const eqoi_header_t* hdr) {
+	return !EQOI_FMT_IS_YUV(hdr->pixel_fmt) && hdr->codec != EQOI_CODEC_PROGRESSIVE;
+}
+
+/*************************
+@init
+@private
+@brief  Դļĸʽʼļͷ(ֿߴ硢ظʽֵͬԴļ)
+@param  out ļͷ(ָ)
+		src Դļͷ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+@return none
+*************************/
+static void init_output(eqoi_header_t* out, const eqoi_header_t* src, uint32_t img_w, uint32_t img_h) {
+	eqoi_init_header(out, img_w, img_h, src->tile_w, src->tile_h);
+
+	out->pixel_fmt = src->pixel_fmt;
+	out->channels = src->channels;
+	out->bit_depth = src->bit_depth;
+	out->codec = src->codec;
+	out->dict_id = src->dict_id;
+	out->dict = src->dict;
+	out->version = src->dict_id ? EQOI_VERSION_DICT : EQOI_VERSION_BASE;
+}
+
+/*************************
+@edit
+@private
+@brief  ֿ鸴ƻر벢дļͷƫƱ(ֿд밴Ԥλ, ν)
+@param  hdr ѳʼļͷ(ָ)
+		pieces ԴͼƬ(׵ַ, ǡøͼ)
+		piece_cnt Ƭθ
+		threads ߳
+		dst ļ(ָ)
+		cap ļ
+		out_len ļ(ָ)
+		stats ͳ(ָ, ΪNULL)
+@return 
+*************************/
+static int edit_tiles(eqoi_header_t* hdr, const edit_piece_t* pieces, uint32_t piece_cnt, int threads, unsigned char* dst,
+	size_t cap, size_t* out_len, eqoi_edit_stats_t* stats) {
+	if (dst == NULL) {
+		return EQOI_ERR_ARG;
+	}
+	if (hdr->dict_id && (hdr->dict == NULL || hdr->dict->id != hdr->dict_id)) {
+		return EQOI_ERR_DICT;
+	}
+	if (cap < eqoi_edit_max_size(hdr, hdr->width, hdr->height)) {
+		return EQOI_ERR_MEM;
+	}
+
+	uint64_t* offsets = malloc(((size_t)hdr->tile_cnt + 1) * sizeof(uint64_t));
+	uint64_t* lens = malloc((size_t)hdr->tile_cnt * sizeof(uint64_t));
+	unsigned char* copied = malloc(hdr->tile_cnt);
+
+	if (offsets == NULL || lens == NULL || copied == NULL) {
+		free(offsets);
+		free(lens);
+		free(copied);
+
+		return EQOI_ERR_MEM;
+	}
+
+	unsigned char* data = dst + hdr->data_offset;
+	edit_job_t job = { hdr, pieces, piece_cnt, data, offsets, lens, copied, EQOI_OK };
+	uint64_t p = 0;
+
+	for (uint32_t i = 0; i < hdr->tile_cnt; i++) {
+		uint32_t x, y, w, h;
+		eqoi_tile_rect(hdr, i, &x, &y, &w, &h);
+
+		offsets[i] = p;
+		p += eqoi_tile_max_len(hdr, w, h);
+	}
+
+	eqoi_parallel_for(hdr->tile_cnt, threads, edit_tile_task, &job);
+
+	// ɫرķֿɫ: MED(岻ͬ, ȫֿر)
+	if (job.err == EQOI_ERR_ARG && hdr->codec == EQOI_CODEC_PALETTE) {
+		hdr->codec = EQOI_CODEC_MED;
+		job.err = EQOI_OK;
+		eqoi_parallel_for(hdr->tile_cnt, threads, edit_tile_task, &job);
+	}
+
+	if (job.err != EQOI_OK) {
+		free(offsets);
+		free(lens);
+		free(copied);
+
+		return job.err;
+	}
+
+	eqoi_edit_stats_t st = { 0, 0, 0 };
+	p = 0;
+
+	for (uint32_t i = 0; i < hdr->tile_cnt; i++) {
+		if (offsets[i] != p) {
+			memmove(data + p, data + offsets[i], (size_t)lens[i]);
+		}
+		if (copied[i]) {
+			st.copied++;
+			st.copied_bytes += lens[i];
+		}
+		else {
+			st.reencoded++;
+		}
+
+		offsets[i] = p;
+		p += lens[i];
+	}
+
+	offsets[hdr->tile_cnt] = p;
+
+	hdr->data_len = p;
+	hdr->data_crc = eqoi_crc32(0, data, (size_t)p);
+	hdr->flags |= EQOI_FLAG_DATA_CRC;
+
+	eqoi_write_header(dst, hdr, offsets);
+	free(offsets);
+	free(lens);
+	free(copied);
+
+	*out_len = (size_t)(hdr->data_offset + hdr->data_len);
+
+	if (stats != NULL) {
+		*stats = st;
+	}
+
+	return EQOI_OK;
+}
+
+/*************************
+@edit
+@private
+@brief  ɵֿ(): ܸԴֿʱ, ±
+@param  arg ༭(ָ)
+		i ֿ
+@return none
+*************************/
+static void edit_tile_task(void* arg, uint32_t i) {
+	edit_job_t* job = (edit_job_t*)arg;
+	uint32_t x, y, w, h;
+
+	if (job->err != EQOI_OK) {
+		return;
+	}
+
+	eqoi_tile_rect(job->hdr, i, &x, &y, &w, &h);
+
+	// ֿϽǵƬǸ÷ֿʱſܸ
+	for (uint32_t k = 0; k < job->piece_cnt; k++) {
+		const edit_piece_t* pc = &job->pieces[k];
+
+		if (x >= pc->dst_x && y >= pc->dst_y && x - pc->dst_x < pc->w && y - pc->dst_y < pc->h) {
+			if (w <= pc->w - (x - pc->dst_x) && h <= pc->h - (y - pc->dst_y)) {
+				int err = copy_tile(job, pc, i, x, y, w, h);
+
+				if (err != EQOI_ERR_ARG) {
+					if (err != EQOI_OK) {
+						job->err = err;
+					}
+
+					return;
+				}
+			}
+
+			break;
+		}
+	}
+
+	int err = reencode_tile(job, i, x, y, w, h);
+
+	if (err != EQOI_OK) {
+		job->err = err;
+	}
+}
+
+/*************************
+@edit
+@private
+@brief  ԸԴֿ(ֿԴͼеλڷֿҳߴԴֿͬ)
+@param  job ༭(ָ)
+		pc Ǹ÷ֿƬ(ָ)
+		i ֿ
+		x ֿϽǺ
+		y ֿϽ
+		w ֿ
+		h ֿ߶
+@return (ܸʱEQOI_ERR_ARG)
+*************************/
+static int copy_tile(const edit_job_t* job, const edit_piece_t* pc, uint32_t i, uint32_t x, uint32_t y, uint32_t w,
+	uint32_t h) {
+	const eqoi_header_t* src = pc->hdr;
+	uint32_t sx = pc->src_x + (x - pc->dst_x);
+	uint32_t sy = pc->src_y + (y - pc->dst_y);
+
+	if (src->codec != job->hdr->codec || sx % src->tile_w || sy % src->tile_h) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint32_t j = (sy / src->tile_h) * ((src->width + src->tile_w - 1) / src->tile_w) + sx / src->tile_w;
+	uint32_t rx, ry, rw, rh;
+
+	eqoi_tile_rect(src, j, &rx, &ry, &rw, &rh);
+
+	if (rw != w || rh != h) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint64_t start = eqoi_tile_offset(src, j);
+	uint64_t end = eqoi_tile_offset(src, j + 1);
+
+	if (start > end || end > src->data_len || end - start > eqoi_tile_max_len(job->hdr, w, h)) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	memcpy(job->data + job->offsets[i], pc->file + src->data_offset + start, (size_t)(end - start));
+	job->lens[i] = end - start;
+	job->copied[i] = 1;
+
+	return EQOI_OK;
+}
+
+/*************************
+@edit
+@private
+@brief  ཻĸƬֿ, ٰĸʽ±
+@param  job ༭(ָ)
+		i ֿ
+		x ֿϽǺ
+		y ֿϽ
+		w ֿ
+		h ֿ߶
+@return (ɫɫʱEQOI_ERR_ARG)
+*************************/
+static int reencode_tile(const edit_job_t* job, uint32_t i, uint32_t x, uint32_t y, uint32_t w, uint32_t h) {
+	const eqoi_header_t* hdr = job->hdr;
+	size_t px_size = eqoi_pixel_size(hdr);
+	size_t stride = (size_t)w * px_size;
+	size_t scratch_size = hdr->pixel_fmt == EQOI_FMT_RGB8 ? eqoi_scratch_size(w) : 0;
+	unsigned char* pixels = malloc(stride * h + scratch_size);
+	int err = pixels == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (uint32_t k = 0; k < job->piece_cnt && err == EQOI_OK; k++) {
+		const edit_piece_t* pc = &job->pieces[k];
+
+		// ƬֿĽ(ͼе)
+		uint32_t x0 = __MAX(x, pc->dst_x);
+		uint32_t y0 = __MAX(y, pc->dst_y);
+		uint64_t x1 = __MIN((uint64_t)x + w, (uint64_t)pc->dst_x + pc->w);
+		uint64_t y1 = __MIN((uint64_t)y + h, (uint64_t)pc->dst_y + pc->h);
+
+		if (x1 > x0 && y1 > y0) {
+			err = eqoi_decode_region(pc->file, pc->hdr, NULL, pc->src_x + (x0 - pc->dst_x), pc->src_y + (y0 - pc->dst_y),
+				(uint32_t)(x1 - x0), (uint32_t)(y1 - y0), pixels + (size_t)(y0 - y) * stride + (size_t)(x0 - x) * px_size,
+				stride);
+		}
+	}
+
+	if (err == EQOI_OK && hdr->codec == EQOI_CODEC_PALETTE) {
+		uint32_t colors = eqoi_palette_count(pixels, stride, w, h);
+
+		// ɫڵɫԤλõķΧ
+		if (colors > EQOI_PALETTE_MAX || eqoi_palette_max_size(w, h, colors) > eqoi_tile_max_len(hdr, w, h)) {
+			err = EQOI_ERR_ARG;
+		}
+	}
+	if (err == EQOI_OK) {
+		job->lens[i] = eqoi_encode_tile(hdr, pixels, stride, w, h, pixels + stride * h, job->data + job->offsets[i]);
+		job->copied[i] = 0;
+		err = job->lens[i] ? EQOI_OK : EQOI_ERR_MEM;
+	}
+
+	free(pixels);
+
+	return err;
+}
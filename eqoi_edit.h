@@ -0,0 +1,44 @@
+/************************************************************************************************************************
+ǿQOIѹüƴ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ֿ, üƴѱͼʱֿԭ; (׸)Դļķֿߴ,
+		ֿȷԴ:
+		    ֿǡĳԴļһֿ(Դͼеλڷֿҳߴͬ), ֱӸ
+				÷ֿ, ֻƫƱдµλ
+		ر  ֿ(üԵпķֿ顢ƴӴԽԴͼķֿ)(eqoi_index.h)ֻ
+				ཻԴֿҪĲ, ٰĸʽ±
+		üϽԴֿʱֻҲһײһзֿҪر; ʱÿֿ鶼
+		ԽԴֿ, ȫر(ÿԴֿ౻4)
+		ƴӵԴͼ񰴹դ˳ųcols*rows, ͬһи߶ͬ, ͬһпͬ; һһ,
+		ԴͼĿΪֿߴʱȫֿ鶼Ը
+		ü/ƴٱͼͬ(Ƶķֿ鱣Դļ, ļһֽͬ);
+		Դļظʽλֵͬ, ֧YUV뽥ģʽ(ͼΪһֿ, ûпɸƵ
+		ֿ); Bayer˵ĲüżпʼҿΪż; ɫرķֿɫʱ
+		MED±
+************************************************************************************************************************/
+
+#ifndef __EQOI_EDIT_H
+#define __EQOI_EDIT_H
+
+#include "eqoi_index.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ѹ༭ͳ(ṹ嶨)
+typedef struct {
+	uint32_t copied; // ķֿ
+	uint32_t reencoded; // رķֿ
+	uint64_t copied_bytes; // Ƶֽ
+} eqoi_edit_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t eqoi_edit_max_size(const eqoi_header_t* hdr, uint32_t img_w, uint32_t img_h); // ü/ƴӽļ
+int eqoi_crop(const unsigned char* file, const eqoi_header_t* hdr, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+	int threads, unsigned char* dst, size_t cap, size_t* out_len, eqoi_edit_stats_t* stats); // ѹвüͼ
+int eqoi_stitch_dims(const eqoi_header_t* hdrs, uint32_t cols, uint32_t rows, uint32_t* img_w, uint32_t* img_h); // ƴ񲢼ĳߴ
+int eqoi_stitch(const unsigned char* const* files, const eqoi_header_t* hdrs, uint32_t cols, uint32_t rows, int threads,
+	unsigned char* dst, size_t cap, size_t* out_len, eqoi_edit_stats_t* stats); // ѹƴͼ
+
+#endif
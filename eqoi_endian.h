@@ -0,0 +1,48 @@
+/************************************************************************************************************************
+ǿQOIСд
+@brief  ڲͷļ(೵뽥ģʽķֶα, ڶӿ)
+@date   2026/10/18
+@info   ļеĶֶֽξΪС, ֽڶдֽ򼰶޹
+************************************************************************************************************************/
+
+#ifndef __EQOI_ENDIAN_H
+#define __EQOI_ENDIAN_H
+
+#include "main.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// д16λС
+static inline void wr_u16(unsigned char* p, uint16_t v) {
+	p[0] = (unsigned char)v;
+	p[1] = (unsigned char)(v >> 8);
+}
+
+// д32λС
+static inline void wr_u32(unsigned char* p, uint32_t v) {
+	wr_u16(p, (uint16_t)v);
+	wr_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+// д64λС
+static inline void wr_u64(unsigned char* p, uint64_t v) {
+	wr_u32(p, (uint32_t)v);
+	wr_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+// 16λС
+static inline uint16_t rd_u16(const unsigned char* p) {
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// 32λС
+static inline uint32_t rd_u32(const unsigned char* p) {
+	return (uint32_t)rd_u16(p) | ((uint32_t)rd_u16(p + 2) << 16);
+}
+
+// 64λС
+static inline uint64_t rd_u64(const unsigned char* p) {
+	return (uint64_t)rd_u32(p) | ((uint64_t)rd_u32(p + 4) << 32);
+}
+
+#endif
@@ -0,0 +1,1217 @@
+/************************************************************************************************************************
+ǿQOIĻҶģʽ
+@brief  ƽ1ͨ(Ҷ)2ͨ(Ҷ+͸)ͼ, ÿֻ1Ԥ; ͬɫBayer;
+		ƽYUVͼ
+@date   2026/10/18
+@info   (GRAY_BLOCK)ԤȼεMEDԤ, 8λͨÿδ16/32/64(SSE2/AVX2/
+		AVX-512, eqoi_cpu_tier; Ҷ+͸ȵĽ֯/λ뱥ʹȡͨ), ƽ̨ʹõȼ۵
+		; ֮ѡγ/PAIR/DIFF/RAW, Ϊ0Ԥںһ
+		γ̱ʾԤΪ0һͬ, ƽ̹ˮƽ/ֱԵγγ
+		رԤ, رڼĴ, ϷϷֱӶȡ뻺
+		ɫģʽͬ, ֻʹջϵĶ, ڴ
+************************************************************************************************************************/
+
+#include "eqoi_gray.h"
+#include "eqoi_cpu.h"
+
+#ifdef EQOI_X86
+#include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define GRAY_BLOCK 256 // ÿԤȼԤظ
+#define GRAY_MAX_RUN 32 // γ̵󳤶
+#define GRAY_MAX_LONG_RUN (GRAY_MAX_RUN + 4096) // γ̵󳤶
+#define GRAY_INDEX_L 15 // 
+#define GRAY_HASH(V) ((V) % GRAY_INDEX_L) // ϣ
+
+// ͱ־
+#define GRAY_OP_DIFF 0x00 /* 0xxxxxxx */
+#define GRAY_OP_PAIR 0x80 /* 10xxxxxx */
+#define GRAY_OP_RUN 0xc0 /* 110xxxxx */
+#define GRAY_OP_LONG_RUN 0xe0 /* 1110xxxx */
+#define GRAY_OP_INDEX 0xf0 /* 1111xxxx, 0xff */
+#define GRAY_OP_RAW 0xff /* 11111111 */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Ҷģʽͳе(QOI_ID_*; γռûҶûеQOI_ID_LUMA, QOI_ID_DIFF2ʹ)
+static const char* gray_op_names[QOI_ID_CNT] = { "RUN", "INDEX", "PAIR", "DIFF", "LONG_RUN", NULL, "RAW" };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Ҷģʽں(ṹ嶨)
+typedef struct {
+	uint32_t (*resid)(const unsigned char* prow, const unsigned char* up, size_t step, size_t chan, uint32_t x,
+		uint32_t x_end, signed char* resid); // ɿԤ(δ׸λ, NULLʾȫɱ)
+	size_t (*zero_len)(const signed char* resid, size_t n); // Ϊ0Ԥ
+	size_t (*flat_len)(const unsigned char* up, size_t n); // һͬظ
+} gray_kernels_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static size_t encode_plane(const unsigned char* pgray, size_t stride, size_t step, size_t chan, uint32_t img_w,
+	uint32_t img_h, unsigned char* dst); // һƽ
+static size_t encode_row(const unsigned char* prow, const unsigned char* up, size_t step, size_t chan, uint32_t img_w,
+	unsigned char* index_tb, uint32_t* prun, unsigned char* dst); // һеһͬ
+static inline size_t decode_plane(const unsigned char* src, size_t len, unsigned char* pdecoded, size_t stride, size_t step,
+	uint32_t img_w, uint32_t img_h); // һƽ
+static inline _Bool decode_row(const unsigned char* src, size_t len, size_t* pp, unsigned char* prow,
+	const unsigned char* up, size_t step, size_t k_end, unsigned char* index_tb, uint32_t* prun); // һеһͬ
+static void gray_resid(const gray_kernels_t* kern, const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid); // һصԤ
+static inline unsigned char gray_med(unsigned char a, unsigned char b, unsigned char c); // ͨMEDԤ
+static size_t zero_len_scalar(const signed char* resid, size_t n); // Ϊ0Ԥ()
+static size_t flat_len_scalar(const unsigned char* up, size_t n); // һͬظ()
+#ifdef EQOI_X86
+static inline EQOI_TARGET("sse2") __m128i gray_load(const unsigned char* px, size_t step, size_t chan); // ȡ16еһͨ
+static inline EQOI_TARGET("avx2") __m256i gray_load_avx2(const unsigned char* px, size_t step, size_t chan); // ȡ32еһͨ
+static inline EQOI_TARGET("avx512f,avx512bw") __m512i gray_load_avx512(const unsigned char* px, size_t step,
+	size_t chan); // ȡ64еһͨ
+static EQOI_TARGET("sse2") uint32_t resid_sse2(const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid); // ɿԤ(SSE2)
+static EQOI_TARGET("sse4.1") uint32_t resid_sse41(const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid); // ɿԤ(SSE4.1)
+static EQOI_TARGET("avx2") uint32_t resid_avx2(const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid); // ɿԤ(AVX2)
+static EQOI_TARGET("avx512f,avx512bw") uint32_t resid_avx512(const unsigned char* prow, const unsigned char* up,
+	size_t step, size_t chan, uint32_t x, uint32_t x_end, signed char* resid); // ɿԤ(AVX-512)
+static EQOI_TARGET("sse2") size_t zero_len_sse2(const signed char* resid, size_t n); // Ϊ0Ԥ(SSE2)
+static EQOI_TARGET("avx2") size_t zero_len_avx2(const signed char* resid, size_t n); // Ϊ0Ԥ(AVX2)
+static EQOI_TARGET("avx512f,avx512bw") size_t zero_len_avx512(const signed char* resid, size_t n); // Ϊ0Ԥ(AVX-512)
+static EQOI_TARGET("sse2") size_t flat_len_sse2(const unsigned char* up, size_t n); // һͬظ(SSE2)
+static EQOI_TARGET("avx2") size_t flat_len_avx2(const unsigned char* up, size_t n); // һͬظ(AVX2)
+static EQOI_TARGET("avx512f,avx512bw") size_t flat_len_avx512(const unsigned char* up, size_t n); // һͬظ(AVX-512)
+#endif
+static inline size_t put_run(unsigned char* dst, uint32_t run); // γ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ں(EQOI_TIER_*, SSE4.1ɨγSSE2)
+static const gray_kernels_t gray_kernels[EQOI_TIER_CNT] = {
+	{ NULL, zero_len_scalar, flat_len_scalar },
+#ifdef EQOI_X86
+	{ resid_sse2, zero_len_sse2, flat_len_sse2 },
+	{ resid_sse41, zero_len_sse2, flat_len_sse2 },
+	{ resid_avx2, zero_len_avx2, flat_len_avx2 },
+	{ resid_avx512, zero_len_avx512, flat_len_avx512 },
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  Ҷģʽ󳤶(ÿƽÿΪRAW2ֽ)
+@param  img_w ͼ
+		img_h ͼ߶
+		channels ͨ(12)
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_gray_max_size(uint32_t img_w, uint32_t img_h, int channels) {
+	uint64_t len = (uint64_t)img_w * img_h * 2 * channels;
+
+	return len > SIZE_MAX ? SIZE_MAX : (size_t)len;
+}
+
+/*************************
+@encode
+@public
+@brief  ԻҶģʽ
+@param  pgray (ָ, Ҷ+͸ʱͨ֯)
+		stride п(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		channels ͨ(12)
+		pCompressed ѹݻ(ָ, Сeqoi_gray_max_size)
+@return ѹֽ
+*************************/
+size_t eqoi_gray_encode(const unsigned char* pgray, size_t stride, uint32_t img_w, uint32_t img_h, int channels,
+	unsigned char* pCompressed) {
+	size_t p = 0;
+
+	for (int c = 0; c < channels; c++) {
+		p += encode_plane(pgray + c, stride, (size_t)channels, (size_t)c, img_w, img_h, pCompressed + p);
+	}
+
+	return p;
+}
+
+/*************************
+@decode
+@public
+@brief  Ҷģʽ(ضʱʧ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		pdecoded 뻺(ָ)
+		stride 뻺п(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		channels ͨ(12)
+@return Ƿɹ
+*************************/
+_Bool eqoi_gray_decode(const unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h, int channels) {
+	size_t p = 0;
+
+	for (int c = 0; c < channels; c++) {
+		// ΪʱչΪרô
+		size_t n = channels == 1 ? decode_plane(pencoded + p, encoded_len - p, pdecoded + c, stride, 1, img_w, img_h) :
+			decode_plane(pencoded + p, encoded_len - p, pdecoded + c, stride, 2, img_w, img_h);
+
+		if (!n) {
+			return 0;
+		}
+
+		p += n;
+	}
+
+	return 1;
+}
+
+/*************************
+@encode
+@public
+@brief  CFAģʽBayer(αżλ, Ԥʹͬɫ/Ϸ/Ϸ)
+@param  pcfa ˲(ָ, ÿй1ֽ)
+		stride п(ֽ)
+		img_w ͼ(Ϊż)
+		img_h ͼ߶(Ϊż)
+		pCompressed ѹݻ(ָ, Сeqoi_gray_max_size(img_w, img_h, 1))
+@return ѹֽ
+*************************/
+size_t eqoi_cfa_encode(const unsigned char* pcfa, size_t stride, uint32_t img_w, uint32_t img_h, unsigned char* pCompressed) {
+	unsigned char index_tb[4][GRAY_INDEX_L] = { { 0 } }; // ÿλһ
+	size_t p = 0;
+	uint32_t run = 0;
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const unsigned char* prow = pcfa + (size_t)y * stride;
+		const unsigned char* up = y >= 2 ? prow - 2 * stride : NULL;
+
+		for (size_t dx = 0; dx < 2; dx++) {
+			p += encode_row(prow + dx, up != NULL ? up + dx : NULL, 2, dx, img_w / 2, index_tb[(y & 1) * 2 + dx], &run,
+				pCompressed + p);
+		}
+	}
+
+	if (run) {
+		p += put_run(pCompressed + p, run);
+	}
+
+	return p;
+}
+
+/*************************
+@decode
+@public
+@brief  CFAģʽ(ضʱʧ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		pdecoded 뻺(ָ)
+		stride 뻺п(ֽ)
+		img_w ͼ(Ϊż)
+		img_h ͼ߶(Ϊż)
+@return Ƿɹ
+*************************/
+_Bool eqoi_cfa_decode(const unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h) {
+	unsigned char index_tb[4][GRAY_INDEX_L] = { { 0 } };
+	size_t p = 0;
+	uint32_t run = 0;
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		unsigned char* prow = pdecoded + (size_t)y * stride;
+		const unsigned char* up = y >= 2 ? prow - 2 * stride : NULL;
+
+		for (size_t dx = 0; dx < 2; dx++) {
+			if (!decode_row(pencoded, encoded_len, &p, prow + dx, up != NULL ? up + dx : NULL, 2, img_w & ~1u,
+				index_tb[(y & 1) * 2 + dx], &run)) {
+				return 0;
+			}
+		}
+	}
+
+	return !run;
+}
+
+/*************************
+@calc
+@public
+@brief  ŵYUVͼ(ΪYƽCbCrƽ, ƽʽʱΪ֯CbCrƽ, н)
+@param  buf ͼ(ָ, ֻ㳤ʱΪNULL)
+		img_w ͼ
+		img_h ͼ߶
+		sub_y ɫȵĴֱ(4:2:0Ϊ2, 4:2:2Ϊ1)
+		planar ǷΪƽʽ(I420/I422, ΪNV12/NV16)
+		img YUVͼڴ(ָ)
+@return ͼݵܳ(ֽ)
+*************************/
+size_t eqoi_yuv_layout(unsigned char* buf, uint32_t img_w, uint32_t img_h, int sub_y, _Bool planar,
+	eqoi_yuv_t* img) {
+	size_t y_len = (size_t)img_w * img_h;
+	size_t c_w = (img_w + 1) / 2;
+	size_t c_len = c_w * ((img_h + sub_y - 1) / sub_y);
+
+	img->y = buf;
+	img->y_stride = img_w;
+
+	if (planar) {
+		img->u = buf + y_len;
+		img->v = buf + y_len + c_len;
+		img->c_stride = c_w;
+		img->c_step = 1;
+	}
+	else {
+		img->u = buf + y_len;
+		img->v = buf + y_len + 1;
+		img->c_stride = c_w * 2;
+		img->c_step = 2;
+	}
+
+	return y_len + c_len * 2;
+}
+
+/*************************
+@calc
+@public
+@brief  YUVģʽ󳤶(ÿΪRAW2ֽ)
+@param  img_w ͼ
+		img_h ͼ߶
+		sub_y ɫȵĴֱ(4:2:0Ϊ2, 4:2:2Ϊ1)
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_yuv_max_size(uint32_t img_w, uint32_t img_h, int sub_y) {
+	uint64_t c_len = (uint64_t)((img_w + 1) / 2) * ((img_h + sub_y - 1) / sub_y);
+	uint64_t len = ((uint64_t)img_w * img_h + c_len * 2) * 2;
+
+	return len > SIZE_MAX ? SIZE_MAX : (size_t)len;
+}
+
+/*************************
+@encode
+@public
+@brief  YUVģʽ(αYCbCrƽ)
+@param  img YUVͼڴ(ָ, c_stepΪ12)
+		img_w ͼ
+		img_h ͼ߶
+		sub_y ɫȵĴֱ(4:2:0Ϊ2, 4:2:2Ϊ1)
+		pCompressed ѹݻ(ָ, Сeqoi_yuv_max_size)
+@return ѹֽ
+*************************/
+size_t eqoi_yuv_encode(const eqoi_yuv_t* img, uint32_t img_w, uint32_t img_h, int sub_y, unsigned char* pCompressed) {
+	uint32_t c_w = (img_w + 1) / 2;
+	uint32_t c_h = (img_h + sub_y - 1) / sub_y;
+	// ƽʽн֯ɫͨҶ+͸ͬ, ͨλ
+	size_t u_chan = img->c_step == 2 && img->u > img->v;
+	size_t p = encode_plane(img->y, img->y_stride, 1, 0, img_w, img_h, pCompressed);
+
+	p += encode_plane(img->u, img->c_stride, img->c_step, u_chan, c_w, c_h, pCompressed + p);
+	p += encode_plane(img->v, img->c_stride, img->c_step, img->c_step == 2 && !u_chan, c_w, c_h, pCompressed + p);
+
+	return p;
+}
+
+/*************************
+@decode
+@public
+@brief  YUVģʽ(ضʱʧ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		img ڴ(ָ, c_stepΪ12, ʱвͬ)
+		img_w ͼ
+		img_h ͼ߶
+		sub_y ɫȵĴֱ(4:2:0Ϊ2, 4:2:2Ϊ1)
+@return Ƿɹ
+*************************/
+_Bool eqoi_yuv_decode(const unsigned char* pencoded, size_t encoded_len, const eqoi_yuv_t* img, uint32_t img_w,
+	uint32_t img_h, int sub_y) {
+	uint32_t c_w = (img_w + 1) / 2;
+	uint32_t c_h = (img_h + sub_y - 1) / sub_y;
+	unsigned char* planes[2] = { img->u, img->v };
+	size_t p = decode_plane(pencoded, encoded_len, img->y, img->y_stride, 1, img_w, img_h);
+
+	for (int c = 0; c < 2 && p; c++) {
+		size_t n = img->c_step == 1 ? decode_plane(pencoded + p, encoded_len - p, planes[c], img->c_stride, 1, c_w, c_h) :
+			decode_plane(pencoded + p, encoded_len - p, planes[c], img->c_stride, 2, c_w, c_h);
+
+		p = n ? p + n : 0;
+	}
+
+	return p != 0;
+}
+
+/*************************
+@calc
+@public
+@brief  ɨҶģʽͳƸ(; PAIRΪQOI_ID_DIFF, DIFFΪQOI_ID_DIFF3, RAWΪQOI_ID_RGB,
+		γ̼ΪQOI_ID_RUN, γ̼ΪQOI_ID_LUMA, INDEXΪQOI_ID_INDEX, Ƽeqoi_gray_op_name; Ҷ+͸ȵƽϼ, CFAģʽͨͳ,
+		YUVģʽƽĲΪͨͳ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		px_cnt ͼ
+		channels ͨ(12)
+		stats ͳƽ(ָ, ԭмۼ)
+@return none
+*************************/
+void eqoi_gray_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, int channels,
+	qoi_op_stats_t* stats) {
+	uint64_t px_total = px_cnt * channels;
+	uint64_t px_done = 0;
+	size_t p = 0;
+
+	while (p < encoded_len && px_done < px_total) {
+		unsigned char b1 = pencoded[p];
+		size_t len = 1;
+		uint64_t n = 1;
+		int id;
+
+		if (b1 < GRAY_OP_PAIR) {
+			id = QOI_ID_DIFF3;
+		}
+		else if (b1 < GRAY_OP_RUN) {
+			id = QOI_ID_DIFF;
+			n = 2;
+		}
+		else if (b1 < GRAY_OP_LONG_RUN) {
+			id = QOI_ID_RUN;
+			n = (uint64_t)(b1 & 0x1f) + 1;
+		}
+		else if (b1 < GRAY_OP_INDEX) {
+			id = QOI_ID_LUMA;
+			n = p + 1 < encoded_len ? GRAY_MAX_RUN + 1 + (((uint64_t)(b1 & 0x0f) << 8) | pencoded[p + 1]) : 1;
+			len = 2;
+		}
+		else if (b1 < GRAY_OP_RAW) {
+			id = QOI_ID_INDEX;
+		}
+		else {
+			id = QOI_ID_RGB;
+			len = 2;
+		}
+
+		stats->ops[id]++;
+		stats->pixels[id] += n;
+		stats->bytes[id] += len;
+
+		px_done += n;
+		p += len;
+	}
+}
+
+/*************************
+@calc
+@public
+@brief  ȡҶģʽͳе(eqoi_gray_scan_opsļŶӦ)
+@param  id ͱ(QOI_ID_*)
+@return (ҶģʽʹõıŷNULL)
+*************************/
+const char* eqoi_gray_op_name(int id) {
+	return id >= 0 && id < QOI_ID_CNT ? gray_op_names[id] : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@encode
+@private
+@brief  һƽ(γ̿ɿ, PAIR)
+@param  pgray ƽ׸(ָ)
+		stride п(ֽ)
+		step صļ(ֽ, ͨ)
+		chan ͨеλ
+		img_w ͼ
+		img_h ͼ߶
+		dst λ(ָ)
+@return ֽ
+*************************/
+static size_t encode_plane(const unsigned char* pgray, size_t stride, size_t step, size_t chan, uint32_t img_w,
+	uint32_t img_h, unsigned char* dst) {
+	unsigned char index_tb[GRAY_INDEX_L] = { 0 };
+	size_t p = 0;
+	uint32_t run = 0;
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const unsigned char* prow = pgray + (size_t)y * stride;
+
+		p += encode_row(prow, y ? prow - stride : NULL, step, chan, img_w, index_tb, &run, dst + p);
+	}
+
+	if (run) {
+		p += put_run(dst + p, run);
+	}
+
+	return p;
+}
+
+/*************************
+@encode
+@private
+@brief  һеһͬ(PAIR, ĩδγһε)
+@param  prow ǰ(ָ, ָ׸صıͨ)
+		up Ԥʹõһ(ָ, ûʱΪNULL)
+		step صļ(ֽ)
+		chan ͨеλ
+		img_w ظ
+		index_tb (׵ַ)
+		prun δγ̳(ָ)
+		dst λ(ָ)
+@return ֽ
+*************************/
+static size_t encode_row(const unsigned char* prow, const unsigned char* up, size_t step, size_t chan, uint32_t img_w,
+	unsigned char* index_tb, uint32_t* prun, unsigned char* dst) {
+	const gray_kernels_t* kern = &gray_kernels[eqoi_cpu_tier()];
+	signed char resid[GRAY_BLOCK];
+	size_t p = 0;
+	uint32_t run = *prun;
+
+	for (uint32_t x0 = 0; x0 < img_w; x0 += GRAY_BLOCK) {
+		uint32_t n = __MIN(GRAY_BLOCK, img_w - x0);
+
+		gray_resid(kern, prow, up, step, chan, x0, x0 + n, resid);
+
+		for (uint32_t i = 0; i < n; i++) {
+			int v = resid[i];
+
+			if (!v) {
+				// һΪ0Ԥγ(0ں)
+				uint32_t m = i + 1 < n && !resid[i + 1] ? (uint32_t)kern->zero_len(resid + i, n - i) : 1;
+
+				while (m) {
+					uint32_t t = __MIN(m, GRAY_MAX_LONG_RUN - run);
+
+					run += t;
+					i += t;
+					m -= t;
+
+					if (run == GRAY_MAX_LONG_RUN) {
+						p += put_run(dst + p, run);
+						run = 0;
+					}
+				}
+
+				i--;
+
+				continue;
+			}
+
+			if (run) {
+				p += put_run(dst + p, run);
+				run = 0;
+			}
+
+			unsigned char px = prow[(size_t)(x0 + i) * step];
+			unsigned char index_pos = GRAY_HASH(px);
+
+			// һͬһʱųPAIR(鲻)
+			if (i + 1 < n && (unsigned)(v + 4) < 8 && (unsigned)(resid[i + 1] + 4) < 8) {
+				dst[p++] = (unsigned char)(GRAY_OP_PAIR | ((v & 7) << 3) | (resid[i + 1] & 7));
+				index_tb[index_pos] = px;
+				i++;
+
+				px = prow[(size_t)(x0 + i) * step];
+				index_pos = GRAY_HASH(px);
+			}
+			else if ((unsigned)(v + 64) < 128) {
+				dst[p++] = (unsigned char)(GRAY_OP_DIFF | (v & 0x7f));
+			}
+			else if (index_tb[index_pos] == px) {
+				dst[p++] = (unsigned char)(GRAY_OP_INDEX | index_pos);
+			}
+			else {
+				dst[p++] = GRAY_OP_RAW;
+				dst[p++] = px;
+			}
+
+			index_tb[index_pos] = px;
+		}
+	}
+
+	*prun = run;
+
+	return p;
+}
+
+/*************************
+@decode
+@private
+@brief  һƽ
+@param  src (ָ)
+		len 
+		pdecoded ƽ׸صĽλ(ָ)
+		stride п(ֽ)
+		step صļ(ֽ, ͨ)
+		img_w ͼ
+		img_h ͼ߶
+@return ĵֽ(ʧʱΪ0)
+*************************/
+static inline size_t decode_plane(const unsigned char* src, size_t len, unsigned char* pdecoded, size_t stride, size_t step,
+	uint32_t img_w, uint32_t img_h) {
+	unsigned char index_tb[GRAY_INDEX_L] = { 0 };
+	size_t p = 0;
+	uint32_t run = 0;
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		unsigned char* prow = pdecoded + (size_t)y * stride;
+
+		if (!decode_row(src, len, &p, prow, y ? prow - stride : NULL, step, (size_t)img_w * step, index_tb, &run)) {
+			return 0;
+		}
+	}
+
+	// γƽĩβ
+	return run ? 0 : p;
+}
+
+/*************************
+@decode
+@private
+@brief  һеһͬ(ĩδγһε)
+@param  src (ָ)
+		len 
+		pp ȡλ(ָ)
+		prow ǰ(ָ, ָ׸صıͨ)
+		up Ԥʹõһ(ָ, ûʱΪNULL)
+		step صļ(ֽ)
+		k_end εĽλ(ֽ, ظ*step)
+		index_tb (׵ַ)
+		prun δγ̳(ָ)
+@return Ƿɹ
+*************************/
+static inline _Bool decode_row(const unsigned char* src, size_t len, size_t* pp, unsigned char* prow,
+	const unsigned char* up, size_t step, size_t k_end, unsigned char* index_tb, uint32_t* prun) {
+	const gray_kernels_t* kern = &gray_kernels[eqoi_cpu_tier()];
+	size_t p = *pp;
+	uint32_t run = *prun;
+	unsigned char a = 0; // 
+	size_t k = 0;
+
+	while (k < k_end) {
+		if (run) {
+			// ԤΪ0һ: ؼΪԤֵ, ֱ
+			size_t n = __MIN((size_t)run, (k_end - k) / step);
+
+			run -= (uint32_t)n;
+
+			if (up == NULL) {
+				for (; n; n--, k += step) {
+					prow[k] = a;
+				}
+			}
+			else {
+				if (!k) {
+					a = prow[0] = up[0];
+					k = step;
+					n--;
+				}
+
+				while (n) {
+					// ϷϷͬʱMEDĽΪ, һͬһֱ
+					size_t m = step == 1 && up[k] == up[k - 1] ? kern->flat_len(up + k, n) : 0;
+
+					if (m) {
+						memset(prow + k, a, m);
+						k += m;
+						n -= m;
+					}
+					else {
+						a = prow[k] = gray_med(a, up[k], up[k - step]);
+						k += step;
+						n--;
+					}
+				}
+			}
+
+			continue;
+		}
+
+		if (p >= len) {
+			return 0;
+		}
+
+		unsigned char pred = up == NULL ? a : k ? gray_med(a, up[k], up[k - step]) : up[0];
+		unsigned char b1 = src[p++];
+
+		if (b1 < GRAY_OP_PAIR) {
+			a = pred + (unsigned char)(b1 | ((b1 & 0x40) << 1));
+		}
+		else if (b1 < GRAY_OP_RUN) {
+			if (k + step >= k_end) {
+				return 0;
+			}
+
+			// 3λз: 44
+			a = prow[k] = pred + (unsigned char)((((b1 >> 3) & 7) ^ 4) - 4);
+			index_tb[GRAY_HASH(a)] = a;
+			k += step;
+
+			pred = up == NULL ? a : gray_med(a, up[k], up[k - step]);
+			a = pred + (unsigned char)(((b1 & 7) ^ 4) - 4);
+		}
+		else if (b1 < GRAY_OP_LONG_RUN) {
+			run = b1 & 0x1f;
+			prow[k] = a = pred;
+			k += step;
+
+			continue;
+		}
+		else if (b1 < GRAY_OP_INDEX) {
+			if (p >= len) {
+				return 0;
+			}
+
+			run = GRAY_MAX_RUN + (((uint32_t)(b1 & 0x0f) << 8) | src[p++]);
+			prow[k] = a = pred;
+			k += step;
+
+			continue;
+		}
+		else if (b1 < GRAY_OP_RAW) {
+			a = index_tb[b1 & 0x0f];
+		}
+		else if (p < len) {
+			a = src[p++];
+		}
+		else {
+			return 0;
+		}
+
+		// γÿضд
+		index_tb[GRAY_HASH(a)] = a;
+		prow[k] = a;
+		k += step;
+	}
+
+	*pp = p;
+	*prun = run;
+
+	return 1;
+}
+
+/*************************
+@calc
+@private
+@brief  һصԤ(8λ; ÿ׸ں˴ĩβɱ)
+@param  kern ں(ָ)
+		prow ǰ(ָ, ָ׸صıͨ)
+		up һ(ָ, ΪNULL)
+		step صļ(ֽ)
+		chan ͨеλ
+		x ʼλ
+		x_end λ()
+		resid Ԥ(׵ַ, x_end-x)
+@return none
+*************************/
+static void gray_resid(const gray_kernels_t* kern, const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid) {
+	// ÿ׸û
+	if (!x && x < x_end) {
+		*resid++ = (signed char)(prow[0] - (up != NULL ? up[0] : 0));
+		x++;
+	}
+
+	if (kern->resid != NULL) {
+		uint32_t x1 = kern->resid(prow, up, step, chan, x, x_end, resid);
+
+		resid += x1 - x;
+		x = x1;
+	}
+
+	for (; x < x_end; x++) {
+		size_t k = (size_t)x * step;
+		unsigned char pred = up == NULL ? prow[k - step] : gray_med(prow[k - step], up[k], up[k - step]);
+
+		*resid++ = (signed char)(prow[k] - pred);
+	}
+}
+
+#ifdef EQOI_X86
+/*************************
+@calc
+@private
+@brief  ɿԤ(SSE2, ÿ16, MEDѡ/ʵ)
+@param  prow ǰ(ָ, ָ׸صıͨ)
+		up һ(ָ, ΪNULL)
+		step صļ(ֽ)
+		chan ͨеλ
+		x ʼλ(С1)
+		x_end λ()
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("sse2") uint32_t resid_sse2(const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid) {
+	for (; x + 16 <= x_end; x += 16, resid += 16) {
+		size_t k = (size_t)x * step - chan;
+		__m128i cur = gray_load(prow + k, step, chan);
+		__m128i a = gray_load(prow + k - step, step, chan);
+		__m128i pred = a;
+
+		if (up != NULL) {
+			__m128i b = gray_load(up + k, step, chan);
+			__m128i c = gray_load(up + k - step, step, chan);
+			__m128i mn = _mm_min_epu8(a, b);
+			__m128i mx = _mm_max_epu8(a, b);
+			__m128i ge = _mm_cmpeq_epi8(_mm_max_epu8(c, mx), c); // c >= max(a, b)
+			__m128i le = _mm_cmpeq_epi8(_mm_min_epu8(c, mn), c); // c <= min(a, b)
+			__m128i grad = _mm_sub_epi8(_mm_add_epi8(a, b), c);
+
+			pred = _mm_or_si128(_mm_and_si128(le, mx), _mm_andnot_si128(le, grad));
+			pred = _mm_or_si128(_mm_and_si128(ge, mn), _mm_andnot_si128(ge, pred));
+		}
+
+		_mm_storeu_si128((__m128i*)resid, _mm_sub_epi8(cur, pred));
+	}
+
+	return x;
+}
+
+/*************************
+@calc
+@private
+@brief  ɿԤ(SSE4.1, ÿ16, MEDѡblendvʵ)
+@param  prow ǰ(ָ, ָ׸صıͨ)
+		up һ(ָ, ΪNULL)
+		step صļ(ֽ)
+		chan ͨеλ
+		x ʼλ(С1)
+		x_end λ()
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("sse4.1") uint32_t resid_sse41(const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid) {
+	for (; x + 16 <= x_end; x += 16, resid += 16) {
+		size_t k = (size_t)x * step - chan;
+		__m128i cur = gray_load(prow + k, step, chan);
+		__m128i a = gray_load(prow + k - step, step, chan);
+		__m128i pred = a;
+
+		if (up != NULL) {
+			__m128i b = gray_load(up + k, step, chan);
+			__m128i c = gray_load(up + k - step, step, chan);
+			__m128i mn = _mm_min_epu8(a, b);
+			__m128i mx = _mm_max_epu8(a, b);
+			__m128i ge = _mm_cmpeq_epi8(_mm_max_epu8(c, mx), c); // c >= max(a, b)
+			__m128i le = _mm_cmpeq_epi8(_mm_min_epu8(c, mn), c); // c <= min(a, b)
+			__m128i grad = _mm_sub_epi8(_mm_add_epi8(a, b), c);
+
+			pred = _mm_blendv_epi8(_mm_blendv_epi8(grad, mx, le), mn, ge);
+		}
+
+		_mm_storeu_si128((__m128i*)resid, _mm_sub_epi8(cur, pred));
+	}
+
+	return x;
+}
+
+/*************************
+@calc
+@private
+@brief  ɿԤ(AVX2, ÿ32)
+@param  prow ǰ(ָ, ָ׸صıͨ)
+		up һ(ָ, ΪNULL)
+		step صļ(ֽ)
+		chan ͨеλ
+		x ʼλ(С1)
+		x_end λ()
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("avx2") uint32_t resid_avx2(const unsigned char* prow, const unsigned char* up, size_t step,
+	size_t chan, uint32_t x, uint32_t x_end, signed char* resid) {
+	for (; x + 32 <= x_end; x += 32, resid += 32) {
+		size_t k = (size_t)x * step - chan;
+		__m256i cur = gray_load_avx2(prow + k, step, chan);
+		__m256i a = gray_load_avx2(prow + k - step, step, chan);
+		__m256i pred = a;
+
+		if (up != NULL) {
+			__m256i b = gray_load_avx2(up + k, step, chan);
+			__m256i c = gray_load_avx2(up + k - step, step, chan);
+			__m256i mn = _mm256_min_epu8(a, b);
+			__m256i mx = _mm256_max_epu8(a, b);
+			__m256i ge = _mm256_cmpeq_epi8(_mm256_max_epu8(c, mx), c); // c >= max(a, b)
+			__m256i le = _mm256_cmpeq_epi8(_mm256_min_epu8(c, mn), c); // c <= min(a, b)
+			__m256i grad = _mm256_sub_epi8(_mm256_add_epi8(a, b), c);
+
+			pred = _mm256_blendv_epi8(_mm256_blendv_epi8(grad, mx, le), mn, ge);
+		}
+
+		_mm256_storeu_si256((__m256i*)resid, _mm256_sub_epi8(cur, pred));
+	}
+
+	return x;
+}
+
+/*************************
+@calc
+@private
+@brief  ɿԤ(AVX-512, ÿ64, ȽϽֱΪѡ)
+@param  prow ǰ(ָ, ָ׸صıͨ)
+		up һ(ָ, ΪNULL)
+		step صļ(ֽ)
+		chan ͨеλ
+		x ʼλ(С1)
+		x_end λ()
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("avx512f,avx512bw") uint32_t resid_avx512(const unsigned char* prow, const unsigned char* up,
+	size_t step, size_t chan, uint32_t x, uint32_t x_end, signed char* resid) {
+	for (; x + 64 <= x_end; x += 64, resid += 64) {
+		size_t k = (size_t)x * step - chan;
+		__m512i cur = gray_load_avx512(prow + k, step, chan);
+		__m512i a = gray_load_avx512(prow + k - step, step, chan);
+		__m512i pred = a;
+
+		if (up != NULL) {
+			__m512i b = gray_load_avx512(up + k, step, chan);
+			__m512i c = gray_load_avx512(up + k - step, step, chan);
+			__m512i mn = _mm512_min_epu8(a, b);
+			__m512i mx = _mm512_max_epu8(a, b);
+			__mmask64 ge = _mm512_cmpge_epu8_mask(c, mx); // c >= max(a, b)
+			__mmask64 le = _mm512_cmple_epu8_mask(c, mn); // c <= min(a, b)
+			__m512i grad = _mm512_sub_epi8(_mm512_add_epi8(a, b), c);
+
+			pred = _mm512_mask_blend_epi8(ge, _mm512_mask_blend_epi8(le, grad, mx), mn);
+		}
+
+		_mm512_storeu_si512((void*)resid, _mm512_sub_epi8(cur, pred));
+	}
+
+	return x;
+}
+
+/*************************
+@calc
+@private
+@brief  ȡ16еһͨ(Ҷ+͸ʱȡ16ص32ֽ, λȡͨ󱥺ʹ)
+@param  px ׸صʼֽ(ָ)
+		step صļ(ֽ, 12)
+		chan ͨеλ
+@return 168λֵͨ
+*************************/
+static inline EQOI_TARGET("sse2") __m128i gray_load(const unsigned char* px, size_t step, size_t chan) {
+	if (step == 1) {
+		return _mm_loadu_si128((const __m128i*)px);
+	}
+
+	__m128i lo = _mm_loadu_si128((const __m128i*)px);
+	__m128i hi = _mm_loadu_si128((const __m128i*)(px + 16));
+
+	if (chan) {
+		return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+	}
+
+	const __m128i lo_mask = _mm_set1_epi16(0x00ff);
+
+	return _mm_packus_epi16(_mm_and_si128(lo, lo_mask), _mm_and_si128(hi, lo_mask));
+}
+
+/*************************
+@calc
+@private
+@brief  ȡ32еһͨ(ʹڸ128λͨڽ, ֮64λΪԭ˳)
+@param  px ׸صʼֽ(ָ)
+		step صļ(ֽ, 12)
+		chan ͨеλ
+@return 328λֵͨ
+*************************/
+static inline EQOI_TARGET("avx2") __m256i gray_load_avx2(const unsigned char* px, size_t step, size_t chan) {
+	if (step == 1) {
+		return _mm256_loadu_si256((const __m256i*)px);
+	}
+
+	__m256i lo = _mm256_loadu_si256((const __m256i*)px);
+	__m256i hi = _mm256_loadu_si256((const __m256i*)(px + 32));
+	__m256i v;
+
+	if (chan) {
+		v = _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+	}
+	else {
+		const __m256i lo_mask = _mm256_set1_epi16(0x00ff);
+
+		v = _mm256_packus_epi16(_mm256_and_si256(lo, lo_mask), _mm256_and_si256(hi, lo_mask));
+	}
+
+	return _mm256_permute4x64_epi64(v, 0xd8);
+}
+
+/*************************
+@calc
+@private
+@brief  ȡ64еһͨ(ʹڸ128λͨڽ, ֮64λΪԭ˳)
+@param  px ׸صʼֽ(ָ)
+		step صļ(ֽ, 12)
+		chan ͨеλ
+@return 648λֵͨ
+*************************/
+static inline EQOI_TARGET("avx512f,avx512bw") __m512i gray_load_avx512(const unsigned char* px, size_t step,
+	size_t chan) {
+	if (step == 1) {
+		return _mm512_loadu_si512((const void*)px);
+	}
+
+	__m512i lo = _mm512_loadu_si512((const void*)px);
+	__m512i hi = _mm512_loadu_si512((const void*)(px + 64));
+	__m512i v;
+
+	if (chan) {
+		v = _mm512_packus_epi16(_mm512_srli_epi16(lo, 8), _mm512_srli_epi16(hi, 8));
+	}
+	else {
+		const __m512i lo_mask = _mm512_set1_epi16(0x00ff);
+
+		v = _mm512_packus_epi16(_mm512_and_si512(lo, lo_mask), _mm512_and_si512(hi, lo_mask));
+	}
+
+	return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), v);
+}
+#endif
+
+/*************************
+@calc
+@private
+@brief  ͨMEDԤ
+@param  a ֵ
+		b Ϸֵ
+		c Ϸֵ
+@return Ԥֵ
+*************************/
+static inline unsigned char gray_med(unsigned char a, unsigned char b, unsigned char c) {
+	if (c >= __MAX(a, b)) {
+		return __MIN(a, b);
+	}
+	else if (c <= __MIN(a, b)) {
+		return __MAX(a, b);
+	}
+	else {
+		return a + b - c;
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  residΪ0Ԥ(, ÿαȽ8ֽ)
+@param  resid Ԥ(׵ַ)
+		n ĸ
+@return 
+*************************/
+static size_t zero_len_scalar(const signed char* resid, size_t n) {
+	size_t m = 0;
+
+	for (; m + 8 <= n; m += 8) {
+		uint64_t v;
+
+		memcpy(&v, resid + m, 8);
+
+		if (v) {
+			break;
+		}
+	}
+
+	while (m < n && !resid[m]) {
+		m++;
+	}
+
+	return m;
+}
+
+/*************************
+@calc
+@private
+@brief  һдupͬظ(, ÿαȽ8ֽ)
+@param  up һеʼ(ָ, )
+		n ظ
+@return ظ
+*************************/
+static size_t flat_len_scalar(const unsigned char* up, size_t n) {
+	size_t m = 0;
+
+	for (; m + 8 <= n; m += 8) {
+		uint64_t b, c;
+
+		memcpy(&b, up + m, 8);
+		memcpy(&c, up + m - 1, 8);
+
+		if (b != c) {
+			break;
+		}
+	}
+
+	while (m < n && up[m] == up[m - 1]) {
+		m++;
+	}
+
+	return m;
+}
+
+#ifdef EQOI_X86
+/*************************
+@calc
+@private
+@brief  Ϊ0Ԥ(SSE2, ÿαȽ16ֽ, 16ʱɱ봦)
+@param  resid Ԥ(׵ַ)
+		n ĸ
+@return 
+*************************/
+static EQOI_TARGET("sse2") size_t zero_len_sse2(const signed char* resid, size_t n) {
+	size_t m = 0;
+
+	for (; m + 16 <= n; m += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(resid + m));
+		unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()));
+
+		if (mask != 0xffff) {
+			return m + (size_t)__builtin_ctz(~mask);
+		}
+	}
+
+	return m + zero_len_scalar(resid + m, n - m);
+}
+
+/*************************
+@calc
+@private
+@brief  Ϊ0Ԥ(AVX2, ÿαȽ32ֽ)
+@param  resid Ԥ(׵ַ)
+		n ĸ
+@return 
+*************************/
+static EQOI_TARGET("avx2") size_t zero_len_avx2(const signed char* resid, size_t n) {
+	size_t m = 0;
+
+	for (; m + 32 <= n; m += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(resid + m));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256()));
+
+		if (mask != 0xffffffffu) {
+			return m + (size_t)__builtin_ctz(~mask);
+		}
+	}
+
+	return m + zero_len_scalar(resid + m, n - m);
+}
+
+/*************************
+@calc
+@private
+@brief  Ϊ0Ԥ(AVX-512, ÿμ64ֽ, 0ֽڵֱȡλ)
+@param  resid Ԥ(׵ַ)
+		n ĸ
+@return 
+*************************/
+static EQOI_TARGET("avx512f,avx512bw") size_t zero_len_avx512(const signed char* resid, size_t n) {
+	size_t m = 0;
+
+	for (; m + 64 <= n; m += 64) {
+		__m512i v = _mm512_loadu_si512((const void*)(resid + m));
+		uint64_t mask = _mm512_test_epi8_mask(v, v);
+
+		if (mask) {
+			return m + (size_t)__builtin_ctzll(mask);
+		}
+	}
+
+	return m + zero_len_scalar(resid + m, n - m);
+}
+
+/*************************
+@calc
+@private
+@brief  һͬظ(SSE2, ÿαȽ16ֽ)
+@param  up һеʼ(ָ, )
+		n ظ
+@return ظ
+*************************/
+static EQOI_TARGET("sse2") size_t flat_len_sse2(const unsigned char* up, size_t n) {
+	size_t m = 0;
+
+	for (; m + 16 <= n; m += 16) {
+		__m128i b = _mm_loadu_si128((const __m128i*)(up + m));
+		__m128i c = _mm_loadu_si128((const __m128i*)(up + m - 1));
+		unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(b, c));
+
+		if (mask != 0xffff) {
+			return m + (size_t)__builtin_ctz(~mask);
+		}
+	}
+
+	return m + flat_len_scalar(up + m, n - m);
+}
+
+/*************************
+@calc
+@private
+@brief  һͬظ(AVX2, ÿαȽ32ֽ)
+@param  up һеʼ(ָ, )
+		n ظ
+@return ظ
+*************************/
+static EQOI_TARGET("avx2") size_t flat_len_avx2(const unsigned char* up, size_t n) {
+	size_t m = 0;
+
+	for (; m + 32 <= n; m += 32) {
+		__m256i b = _mm256_loadu_si256((const __m256i*)(up + m));
+		__m256i c = _mm256_loadu_si256((const __m256i*)(up + m - 1));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, c));
+
+		if (mask != 0xffffffffu) {
+			return m + (size_t)__builtin_ctz(~mask);
+		}
+	}
+
+	return m + flat_len_scalar(up + m, n - m);
+}
+
+/*************************
+@calc
+@private
+@brief  һͬظ(AVX-512, ÿαȽ64ֽ)
+@param  up һеʼ(ָ, )
+		n ظ
+@return ظ
+*************************/
+static EQOI_TARGET("avx512f,avx512bw") size_t flat_len_avx512(const unsigned char* up, size_t n) {
+	size_t m = 0;
+
+	for (; m + 64 <= n; m += 64) {
+		__m512i b = _mm512_loadu_si512((const void*)(up + m));
+		__m512i c = _mm512_loadu_si512((const void*)(up + m - 1));
+		uint64_t mask = _mm512_cmpneq_epi8_mask(b, c);
+
+		if (mask) {
+			return m + (size_t)__builtin_ctzll(mask);
+		}
+	}
+
+	return m + flat_len_scalar(up + m, n - m);
+}
+#endif
+
+/*************************
+@encode
+@private
+@brief  γ(1~GRAY_MAX_LONG_RUN)
+@param  dst λ(ָ)
+		run γ̳
+@return ֽ
+*************************/
+static inline size_t put_run(unsigned char* dst, uint32_t run) {
+	if (run <= GRAY_MAX_RUN) {
+		dst[0] = (unsigned char)(GRAY_OP_RUN | (run - 1));
+
+		return 1;
+	}
+
+	run -= GRAY_MAX_RUN + 1;
+	dst[0] = (unsigned char)(GRAY_OP_LONG_RUN | (run >> 8));
+	dst[1] = (unsigned char)run;
+
+	return 2;
+}
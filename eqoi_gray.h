@@ -0,0 +1,66 @@
+/************************************************************************************************************************
+ǿQOIĻҶģʽ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ɨĵͼֻ1ͨ(Ҷ+͸2ͨ), չΪRGBMEDԤԤж϶Ҫ3, ͬ
+		3ͨQOI_OP_RGBظд; Ҷģʽͨ(ƽ), ÿֻ1Ԥ:
+		0x00~0x7f  DIFF     Ԥ(7λз, -64~63)
+		0x80~0xbf  PAIR     ͬһ2صԤ(3λΪǰһ, 3λΪһ, -4~3)
+		0xc0~0xdf  RUN      (5λ+1)صԤΪ0(1~32, ɿ)
+		0xe0~0xef  LONGRUN  (33+4λ1ֽɵ12λ)صԤΪ0(33~4128, ɿ)
+		0xf0~0xfe  INDEX    ֵΪ15еĵ(4λ)
+		0xff       RAW      1ֽΪֵ
+		ֵ%15ֵ(ʼȫΪ0), γÿضд, ĵֽ
+		ֻ֮1ֽ
+		Ԥ8λͬ(ȡ, ׸ԤΪ0, еȡϷ, ʹMED),
+		Ԥ8λ; Ҷ+͸ȱҶƽ, ٽű͸ƽ, ļͷ,
+		ظʽΪEQOI_FMT_GRAY8EQOI_FMT_GA8
+		CFAģʽͬһͱBayer(ÿй1, Ϊż): ȱżСٱ
+		, ÿλֻͬɫԤ, ڲΪ2λʹMED(Ϊx-2, ϷΪy-2, ϷΪ(x-2, y-2)),
+		γڸλ֮, 4λһ; ֻʵǰ(ÿλел),
+		ظʽΪEQOI_FMT_BAYER_*(¼ɫƬ, Ӱ)
+		YUVģʽԻҶƽYCbCrƽ, ɫȱԭеĳ(ˮƽ, 4:2:0ʱֱҲ, ߴȡ),
+		ڴ޹: ƽʽ(I420/I422)ƽʽ(NV12/NV16, CbCr֯)ͬ, ʱֱ
+		һ; ظʽΪEQOI_FMT_YUV420EQOI_FMT_YUV422
+************************************************************************************************************************/
+
+#ifndef __EQOI_GRAY_H
+#define __EQOI_GRAY_H
+
+#include "enhanced_qoi.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// YUVͼڴ(ṹ嶨)
+typedef struct {
+	unsigned char* y; // ƽ(ָ)
+	unsigned char* u; // Cbƽ(ָ, ƽʽʱָ֯еCb)
+	unsigned char* v; // Crƽ(ָ, ƽʽʱָ֯еCr)
+	size_t y_stride; // ƽп(ֽ)
+	size_t c_stride; // ɫƽп(ֽ)
+	size_t c_step; // ɫȲļ(ֽ, ƽʽΪ1, ƽʽΪ2, ʱCbCr뽻֯)
+} eqoi_yuv_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t eqoi_gray_max_size(uint32_t img_w, uint32_t img_h, int channels); // Ҷģʽ󳤶
+size_t eqoi_gray_encode(const unsigned char* pgray, size_t stride, uint32_t img_w, uint32_t img_h, int channels,
+	unsigned char* pCompressed); // ԻҶģʽ
+_Bool eqoi_gray_decode(const unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h, int channels); // Ҷģʽ
+size_t eqoi_cfa_encode(const unsigned char* pcfa, size_t stride, uint32_t img_w, uint32_t img_h,
+	unsigned char* pCompressed); // CFAģʽBayer
+_Bool eqoi_cfa_decode(const unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h); // CFAģʽ
+size_t eqoi_yuv_layout(unsigned char* buf, uint32_t img_w, uint32_t img_h, int sub_y, _Bool planar,
+	eqoi_yuv_t* img); // ŵYUVͼ
+size_t eqoi_yuv_max_size(uint32_t img_w, uint32_t img_h, int sub_y); // YUVģʽ󳤶
+size_t eqoi_yuv_encode(const eqoi_yuv_t* img, uint32_t img_w, uint32_t img_h, int sub_y,
+	unsigned char* pCompressed); // YUVģʽ
+_Bool eqoi_yuv_decode(const unsigned char* pencoded, size_t encoded_len, const eqoi_yuv_t* img, uint32_t img_w,
+	uint32_t img_h, int sub_y); // YUVģʽ
+void eqoi_gray_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, int channels,
+	qoi_op_stats_t* stats); // ͳƻҶģʽеĸ
+const char* eqoi_gray_op_name(int id); // ȡҶģʽͳе
+
+#endif
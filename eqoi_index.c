@@ -0,0 +1,361 @@
+/************************************************************************************************************************
+ǿQOIм೵
+@brief  ˳һ¼׵Ľ״̬, ȡʱļָ; ֻ
+		ཻķֿ(֮)
+@date   2026/10/18
+************************************************************************************************************************/
+
+#include "eqoi_index.h"
+#include "eqoi_endian.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static _Bool indexable(const eqoi_header_t* hdr); // жļǷΪ8λRGB MED
+static void seek_index(qoi_decoder_t* dec, const eqoi_index_t* index, uint32_t k); // Ӽָ״̬
+static int decode_span(qoi_decoder_t* dec, uint32_t skip, uint32_t rows, uint32_t x, uint32_t w, unsigned char* pdecoded,
+	size_t stride); // кеһ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ೵ĳ
+@param  hdr ļͷ(ָ)
+		interval ()
+@return (ֽ, Ϊ0ʱ0)
+*************************/
+size_t eqoi_index_size(const eqoi_header_t* hdr, uint32_t interval) {
+	if (!interval) {
+		return 0;
+	}
+
+	size_t cp_cnt = (hdr->height - 1) / interval;
+
+	return EQOI_INDEX_HEADER_SIZE + cp_cnt * (EQOI_INDEX_CP_SIZE + (size_t)hdr->width * 3) + 4;
+}
+
+/*************************
+@encode
+@public
+@brief  ˳һ鲢д೵(뵽һΪֹ)
+@param  file ļ(ָ)
+		hdr ļͷ(ָ, ֻһֿ, ظʽΪEQOI_FMT_RGB8, ΪEQOI_CODEC_MED)
+		interval ()
+		dst (ָ)
+		cap (Сeqoi_index_size(hdr, interval))
+		out_len (ָ)
+@return 
+*************************/
+int eqoi_build_index(const unsigned char* file, const eqoi_header_t* hdr, uint32_t interval, unsigned char* dst, size_t cap,
+	size_t* out_len) {
+	size_t len = eqoi_index_size(hdr, interval);
+
+	if (!len) {
+		return EQOI_ERR_ARG;
+	}
+	if (cap < len) {
+		return EQOI_ERR_MEM;
+	}
+
+	if (!indexable(hdr)) {
+		return EQOI_ERR_ARG;
+	}
+
+	qoi_decoder_t dec;
+	int err = eqoi_open_tile(file, hdr, 0, &dec);
+
+	if (err != EQOI_OK) {
+		return err;
+	}
+
+	size_t row_len = (size_t)hdr->width * 3;
+	uint32_t cp_cnt = (hdr->height - 1) / interval;
+	size_t cp_size = EQOI_INDEX_CP_SIZE + row_len;
+	unsigned char* rows = cp_cnt ? malloc(row_len * 2) : NULL;
+
+	if (cp_cnt && rows == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	memset(dst, 0, EQOI_INDEX_HEADER_SIZE);
+	memcpy(dst, EQOI_INDEX_MAGIC, 4);
+	wr_u16(dst + 4, EQOI_INDEX_VERSION);
+	wr_u16(dst + 6, EQOI_INDEX_HEADER_SIZE);
+	wr_u32(dst + 8, hdr->width);
+	wr_u32(dst + 12, hdr->height);
+	wr_u32(dst + 16, interval);
+	wr_u32(dst + 20, cp_cnt);
+	wr_u64(dst + 24, hdr->data_len);
+	wr_u32(dst + 32, hdr->data_crc);
+	wr_u32(dst + 36, hdr->dict_id);
+
+	// л, ÿеױ״̬һ
+	for (uint32_t k = 0; k < cp_cnt; k++) {
+		unsigned char* cp = dst + EQOI_INDEX_HEADER_SIZE + (size_t)k * cp_size;
+
+		for (uint32_t y = k * interval; y < (k + 1) * interval; y++) {
+			enhanced_qoi_decode_rows(&dec, rows + (y & 1) * row_len, row_len, 1);
+		}
+
+		wr_u64(cp, dec.p);
+		wr_u64(cp + 8, dec.run);
+
+		for (int i = 0; i < INDEX_TB_L; i++) {
+			cp[16 + i * 3] = dec.index_tb[i].r;
+			cp[16 + i * 3 + 1] = dec.index_tb[i].g;
+			cp[16 + i * 3 + 2] = dec.index_tb[i].b;
+		}
+
+		memcpy(cp + EQOI_INDEX_CP_SIZE, dec.prev_row, row_len);
+	}
+
+	wr_u32(dst + len - 4, eqoi_crc32(0, dst, len - 4));
+	enhanced_qoi_decoder_free(&dec);
+	free(rows);
+
+	*out_len = len;
+
+	return EQOI_OK;
+}
+
+/*************************
+@io
+@public
+@brief  У೵
+@param  idx (ָ, ʱֱӶȡ, 뱣Ч)
+		len 
+		hdr Ӧļļͷ(ָ)
+		index õ(ָ)
+@return (ļӦʱEQOI_ERR_FORMAT)
+*************************/
+int eqoi_parse_index(const unsigned char* idx, size_t len, const eqoi_header_t* hdr, eqoi_index_t* index) {
+	if (len < 4 || memcmp(idx, EQOI_INDEX_MAGIC, 4)) {
+		return EQOI_ERR_FORMAT;
+	}
+	if (len < EQOI_INDEX_HEADER_SIZE + 4) {
+		return EQOI_ERR_TRUNC;
+	}
+	if (rd_u16(idx + 4) > EQOI_INDEX_VERSION) {
+		return EQOI_ERR_VERSION;
+	}
+
+	uint16_t header_size = rd_u16(idx + 6);
+	uint32_t interval = rd_u32(idx + 16);
+	uint32_t cp_cnt = rd_u32(idx + 20);
+
+	if (header_size < EQOI_INDEX_HEADER_SIZE || !interval || cp_cnt != (hdr->height - 1) / interval) {
+		return EQOI_ERR_FORMAT;
+	}
+	if (rd_u32(idx + 8) != hdr->width || rd_u32(idx + 12) != hdr->height || rd_u64(idx + 24) != hdr->data_len ||
+		rd_u32(idx + 32) != hdr->data_crc || rd_u32(idx + 36) != hdr->dict_id) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	size_t cp_size = EQOI_INDEX_CP_SIZE + (size_t)hdr->width * 3;
+
+	if (len < (size_t)header_size + 4 || (len - header_size - 4) / cp_size < cp_cnt) {
+		return EQOI_ERR_TRUNC;
+	}
+	if (eqoi_crc32(0, idx, len - 4) != rd_u32(idx + len - 4)) {
+		return EQOI_ERR_CRC;
+	}
+
+	index->data = idx + header_size;
+	index->interval = interval;
+	index->cp_cnt = cp_cnt;
+	index->cp_size = cp_size;
+
+	return EQOI_OK;
+}
+
+/*************************
+@decode
+@public
+@brief  ļָ(ĶӦֽͬ)
+@info   һֱӴжȡ; ֮н뵽еݴ
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+		index ѽĲ೵(ָ)
+		y к
+		rows 
+		pdecoded 뻺(ָ, rows)
+		stride 뻺п(ֽ)
+@return 
+*************************/
+int eqoi_decode_rows_indexed(const unsigned char* file, const eqoi_header_t* hdr, const eqoi_index_t* index, uint32_t y,
+	uint32_t rows, unsigned char* pdecoded, size_t stride) {
+	return eqoi_decode_region(file, hdr, index, 0, y, hdr->width, rows, pdecoded, stride);
+}
+
+/*************************
+@decode
+@public
+@brief  ͼеһ(ĶӦֽͬ)
+@info   ֿļֻཻķֿ, ÿֿ뵽һΪֹ; ļ֮ǰ
+		(δṩʱΪͷ)뵽һ, ÿ; زд뻺
+		8λRGBMEDн뵽еݴٸڵ, ظʽ뵽ݴ
+@param  file ļ(ָ)
+		hdr ļͷ(ָ, ֧YUV)
+		index ѽĲ೵(ָ, ΪNULL, ֻڵļ)
+		x Ͻǵк
+		y Ͻǵк
+		w 
+		h ߶
+		pdecoded 뻺(ָ, h, ÿw)
+		stride 뻺п(ֽ)
+@return 
+*************************/
+int eqoi_decode_region(const unsigned char* file, const eqoi_header_t* hdr, const eqoi_index_t* index, uint32_t x,
+	uint32_t y, uint32_t w, uint32_t h, unsigned char* pdecoded, size_t stride) {
+	if (!w || !h || x >= hdr->width || y >= hdr->height || w > hdr->width - x || h > hdr->height - y ||
+		EQOI_FMT_IS_YUV(hdr->pixel_fmt)) {
+		return EQOI_ERR_ARG;
+	}
+
+	size_t px_size = eqoi_pixel_size(hdr);
+	uint32_t tiles_x = (hdr->width + hdr->tile_w - 1) / hdr->tile_w;
+	uint32_t tx0 = x / hdr->tile_w;
+	uint32_t tx1 = (x + w - 1) / hdr->tile_w;
+	uint32_t ty0 = y / hdr->tile_h;
+	uint32_t ty1 = (y + h - 1) / hdr->tile_h;
+	unsigned char* tile = NULL;
+	int err = EQOI_OK;
+
+	for (uint32_t ty = ty0; ty <= ty1 && err == EQOI_OK; ty++) {
+		for (uint32_t tx = tx0; tx <= tx1 && err == EQOI_OK; tx++) {
+			uint32_t i = ty * tiles_x + tx;
+			uint32_t rx, ry, rw, rh;
+
+			eqoi_tile_rect(hdr, i, &rx, &ry, &rw, &rh);
+
+			// ֿĽ(ڷֿϽ)
+			uint32_t cx0 = __MAX(x, rx) - rx;
+			uint32_t cy0 = __MAX(y, ry) - ry;
+			uint32_t cx1 = __MIN(x + w, rx + rw) - rx;
+			uint32_t cy1 = __MIN(y + h, ry + rh) - ry;
+			unsigned char* dst = pdecoded + (size_t)(ry + cy0 - y) * stride + (size_t)(rx + cx0 - x) * px_size;
+
+			if (hdr->pixel_fmt == EQOI_FMT_RGB8 && hdr->codec == EQOI_CODEC_MED) {
+				qoi_decoder_t dec;
+				uint32_t k = 0;
+
+				err = eqoi_open_tile(file, hdr, i, &dec);
+
+				if (err == EQOI_OK && index != NULL && hdr->tile_cnt == 1) {
+					k = __MIN(cy0 / index->interval, index->cp_cnt);
+					seek_index(&dec, index, k);
+					k *= index->interval;
+					err = dec.p > dec.encoded_len ? EQOI_ERR_FORMAT : EQOI_OK;
+				}
+				if (err == EQOI_OK) {
+					err = decode_span(&dec, cy0 - k, cy1 - cy0, cx0, cx1 - cx0, dst, stride);
+				}
+
+				enhanced_qoi_decoder_free(&dec);
+				continue;
+			}
+
+			// ظʽ: 뵽ݴ(ķֿһ)
+			size_t tile_stride = (size_t)rw * px_size;
+
+			if (tile == NULL) {
+				tile = malloc((size_t)hdr->tile_w * hdr->tile_h * px_size);
+			}
+
+			err = tile == NULL ? EQOI_ERR_MEM : eqoi_decode_tile(file, hdr, i, tile, tile_stride);
+
+			for (uint32_t r = cy0; r < cy1 && err == EQOI_OK; r++) {
+				memcpy(dst + (size_t)(r - cy0) * stride, tile + r * tile_stride + cx0 * px_size, (cx1 - cx0) * px_size);
+			}
+		}
+	}
+
+	free(tile);
+
+	return err;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@check
+@private
+@brief  жļǷΪ8λRGB MED(Խ೵)
+@param  hdr ļͷ(ָ)
+@return ǷԽ
+*************************/
+static _Bool indexable(const eqoi_header_t* hdr) {
+	return hdr->tile_cnt == 1 && hdr->pixel_fmt == EQOI_FMT_RGB8 && hdr->codec == EQOI_CODEC_MED;
+}
+
+/*************************
+@init
+@private
+@brief  Ӽָ״̬
+@param  dec ѳʼĽ(ָ)
+		index ѽĲ೵(ָ)
+		k ֮ǰж(Ϊ0ʱֳʼ״̬, ӵk-1㼴k*Nе׻ָ)
+@return none
+*************************/
+static void seek_index(qoi_decoder_t* dec, const eqoi_index_t* index, uint32_t k) {
+	if (!k) {
+		return;
+	}
+
+	const unsigned char* cp = index->data + (size_t)(k - 1) * index->cp_size;
+	qoi_rgb_t index_tb[INDEX_TB_L];
+	qoi_mark_t mark = { (size_t)rd_u64(cp), rd_u64(cp + 8) };
+
+	for (int i = 0; i < INDEX_TB_L; i++) {
+		index_tb[i] = (qoi_rgb_t){ cp[16 + i * 3], cp[16 + i * 3 + 1], cp[16 + i * 3 + 2] };
+	}
+
+	enhanced_qoi_decoder_seek(dec, &mark, k * index->interval, index_tb, cp + EQOI_INDEX_CP_SIZE);
+}
+
+/*************************
+@decode
+@private
+@brief  кеһ
+@info   ʱֱӽ뵽뻺, н뵽еݴ(ʹ, Ԥȡһбԭַ)
+		ٸڵ; ͬ뵽ݴ
+@param  dec (ָ)
+		skip 
+		rows 
+		x 
+		w 
+		pdecoded 뻺(ָ)
+		stride 뻺п(ֽ)
+@return 
+*************************/
+static int decode_span(qoi_decoder_t* dec, uint32_t skip, uint32_t rows, uint32_t x, uint32_t w, unsigned char* pdecoded,
+	size_t stride) {
+	size_t row_len = (size_t)dec->img_w * 3;
+	_Bool whole = x == 0 && w == dec->img_w;
+	unsigned char* scratch = skip || !whole ? malloc(row_len * 2) : NULL;
+
+	if ((skip || !whole) && scratch == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	for (uint32_t i = 0; i < skip; i++) {
+		enhanced_qoi_decode_rows(dec, scratch + (i & 1) * row_len, row_len, 1);
+	}
+
+	if (whole) {
+		enhanced_qoi_decode_rows(dec, pdecoded, stride, rows);
+	}
+	else {
+		for (uint32_t i = 0; i < rows; i++) {
+			unsigned char* row = scratch + ((skip + i) & 1) * row_len;
+
+			enhanced_qoi_decode_rows(dec, row, row_len, 1);
+			memcpy(pdecoded + (size_t)i * stride, row + (size_t)x * 3, (size_t)w * 3);
+		}
+	}
+
+	free(scratch);
+
+	return EQOI_OK;
+}
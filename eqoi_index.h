@@ -0,0 +1,66 @@
+/************************************************************************************************************************
+ǿQOIм೵
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ֻһͼ(ɰļֻһֿļ)û, ȡͼвļҲҪͷ;
+		೵һ˳ÿNм¼һ, ׵Ľ״̬, ֮Ķȡļ
+		ָ, ͼΪ϶ȡ
+		೵Ϊ.eqixļ, ֶξΪС:
+		ƫ  ֶ
+		0    4    ħ"EQIX"
+		4    2    ʽ汾
+		6    2    ͷ(׸λ)
+		8    4    ͼ
+		12   4    ͼ߶
+		16   4    N()
+		20   4    (N, 2N, ..., (ͼ߶-1)/N)
+		24   8    ѹݳ
+		32   4    ѹݵCRC32(ȡļͷ, ɰļΪ0)
+		36   4    ֵID
+		Ϊ, ÿ112+ͼ*3ֽ:
+		0    8    ׵һȡֽλ
+		8    8    ʣγ̳
+		16   96   (32, ÿΪr, g, b)
+		112  -    һеĽ(b, g, r)
+		4ֽΪǰȫݵCRC32
+		ļͼߴ硢ѹݳȡCRC32ֵIDӦ; һԭʼش, ԼΪ1/N
+		ֻ8λRGBMED
+		ֻཻķֿ(ֿļ)ļ㿪ʼ(ļ), ֻдڵ;
+		ֿļĴ۽ӽ, ļÿ
+************************************************************************************************************************/
+
+#ifndef __EQOI_INDEX_H
+#define __EQOI_INDEX_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_INDEX_MAGIC "EQIX" // ħ
+#define EQOI_INDEX_VERSION 1 // ʽ汾
+#define EQOI_INDEX_HEADER_SIZE 40 // ͷ(ֽ)
+#define EQOI_INDEX_CP_SIZE 112 // ״̬ĳ(ֽ, һ)
+#define EQOI_INDEX_INTERVAL 128 // Ĭϵļ()
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ѽĲ೵(ṹ嶨)
+typedef struct {
+	const unsigned char* data; // (ָ, ʱֱӶȡ, 뱣Ч)
+	uint32_t interval; // ()
+	uint32_t cp_cnt; // 
+	size_t cp_size; // ÿĳ(ֽ)
+} eqoi_index_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t eqoi_index_size(const eqoi_header_t* hdr, uint32_t interval); // ೵ĳ
+int eqoi_build_index(const unsigned char* file, const eqoi_header_t* hdr, uint32_t interval, unsigned char* dst, size_t cap,
+	size_t* out_len); // ˳һ鲢д೵
+int eqoi_parse_index(const unsigned char* idx, size_t len, const eqoi_header_t* hdr, eqoi_index_t* index); // У೵
+int eqoi_decode_rows_indexed(const unsigned char* file, const eqoi_header_t* hdr, const eqoi_index_t* index, uint32_t y,
+	uint32_t rows, unsigned char* pdecoded, size_t stride); // ļָ
+int eqoi_decode_region(const unsigned char* file, const eqoi_header_t* hdr, const eqoi_index_t* index, uint32_t x,
+	uint32_t y, uint32_t w, uint32_t h, unsigned char* pdecoded, size_t stride); // ͼеһ
+
+#endif
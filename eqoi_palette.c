@@ -0,0 +1,549 @@
+/************************************************************************************************************************
+ǿQOIĵɫģʽ
+@brief  ɫ256ֵͼԵɫ(1/2/4/8λ)ظ/γ̰
+@date   2026/10/18
+@info   ǰɫͳڳ256ɫʱ, Ƭͼֻɨ迪ͷ
+		ϴķֿʱ"һֽ -> ֽȫ"Ĳұչ, ÿֽһβһζ,
+		λ; ͬ, ֻʹջϵĶ, ڴ
+************************************************************************************************************************/
+
+#include "eqoi_palette.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PAL_HT_L 1024 // ɫϣ(Ϊ2, ҲС2*EQOI_PALETTE_MAX)
+#define PAL_LIT_MAX 128 // ظ
+#define PAL_REP_MAX 64 // ظظ
+#define PAL_RUN_SHORT 63 // γ̰ظ
+#define PAL_RUN_LONG (64 + (1 << 21) - 1) // γ̰ظ(ظ-643ֽLEB128ʾ)
+
+// 
+#define PAL_OP_REP 0x80 // ظ(0x80~0xbf)
+#define PAL_OP_RUN 0xc0 // γ̰(0xc0~0xfe)
+#define PAL_OP_RUN_LONG 0xff // γ̰
+
+// ɫϣ(ṹ嶨)
+typedef struct {
+	uint32_t key[PAL_HT_L]; // ɫ(b0 | b1 << 8 | b2 << 16 | 1 << 24, 0ʾ)
+	unsigned char idx[PAL_HT_L]; // ɫڵɫе
+	uint32_t n; // ɫ
+} pal_ht_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static _Bool pal_build(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, pal_ht_t* ht); // ɫ
+static uint32_t pal_ht_put(pal_ht_t* ht, uint32_t key); // ɫϣвɫ(ʱ)
+static int pal_bits(uint32_t colors); // ɫÿλ
+static size_t emit_lit(unsigned char* dst, const unsigned char* lit, uint32_t m, int bits); // 
+static size_t emit_run(unsigned char* dst, unsigned char idx, uint32_t len); // γ̰
+static size_t rd_run_len(const unsigned char* p, const unsigned char* end, uint32_t* len); // ȡγ̰ظ
+static size_t end_run(unsigned char* dst, size_t pos, unsigned char* lit, uint32_t* m, unsigned char idx, uint32_t run,
+	int bits); // һγ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ͳɫ(EQOI_PALETTE_MAXʱǰ)
+@param  prgb (ָ)
+		stride п(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+@return ɫ(EQOI_PALETTE_MAXʱEQOI_PALETTE_MAX+1)
+*************************/
+uint32_t eqoi_palette_count(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h) {
+	pal_ht_t ht;
+
+	return pal_build(prgb, stride, img_w, img_h, &ht) ? ht.n : EQOI_PALETTE_MAX + 1;
+}
+
+/*************************
+@calc
+@public
+@brief  ɫģʽ󳤶(ÿ2ֽ, end_run˵)
+@param  img_w ͼ
+		img_h ͼ߶
+		colors ɫ
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_palette_max_size(uint32_t img_w, uint32_t img_h, uint32_t colors) {
+	return 1 + (size_t)colors * 3 + (size_t)img_w * img_h * 2;
+}
+
+/*************************
+@encode
+@public
+@brief  Եɫģʽ(ɫóEQOI_PALETTE_MAX, ɫ尴ɫ״γֵ˳)
+@param  prgb (ָ)
+		stride п(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		pCompressed ѹݻ(ָ, ȲСeqoi_palette_max_size)
+@return ѹݳ(ɫEQOI_PALETTE_MAXʱ0)
+*************************/
+size_t eqoi_palette_encode(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, unsigned char* pCompressed) {
+	pal_ht_t ht;
+
+	// 1: ɫ
+	if (!pal_build(prgb, stride, img_w, img_h, &ht)) {
+		return 0;
+	}
+
+	size_t pos = 1 + (size_t)ht.n * 3;
+
+	pCompressed[0] = (unsigned char)(ht.n - 1);
+
+	for (uint32_t k = 0; k < PAL_HT_L; k++) {
+		if (ht.key[k]) {
+			unsigned char* c = pCompressed + 1 + (size_t)ht.idx[k] * 3;
+
+			c[0] = (unsigned char)ht.key[k];
+			c[1] = (unsigned char)(ht.key[k] >> 8);
+			c[2] = (unsigned char)(ht.key[k] >> 16);
+		}
+	}
+
+	// 2: γ
+	int bits = pal_bits(ht.n);
+	unsigned char lit[PAL_LIT_MAX];
+	uint32_t m = 0;
+	uint32_t run = 0;
+	unsigned char run_idx = 0;
+	uint32_t last = 0;
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const unsigned char* p = prgb + (size_t)y * stride;
+
+		for (uint32_t x = 0; x < img_w; x++, p += 3) {
+			uint32_t key = p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | 1u << 24;
+
+			if (key == last && run < PAL_RUN_LONG) {
+				run++;
+				continue;
+			}
+
+			pos = end_run(pCompressed, pos, lit, &m, run_idx, run, bits);
+			run_idx = (unsigned char)pal_ht_put(&ht, key);
+			run = 1;
+			last = key;
+		}
+	}
+
+	pos = end_run(pCompressed, pos, lit, &m, run_idx, run, bits);
+
+	if (m) {
+		pos += emit_lit(pCompressed + pos, lit, m, bits);
+	}
+
+	return pos;
+}
+
+/*************************
+@decode
+@public
+@brief  ɫģʽ(ɫΪ0)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		pdecoded 뻺(ָ)
+		stride 뻺п(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+@return Ƿ(ʱʣرֲ)
+*************************/
+_Bool eqoi_palette_decode(const unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h) {
+	unsigned char pal[EQOI_PALETTE_MAX][3];
+	unsigned char lut[256][24]; // ֽ -> ֽȫ
+	uint32_t colors = encoded_len ? (uint32_t)pencoded[0] + 1 : 0;
+
+	if (!colors || encoded_len < 1 + (size_t)colors * 3) {
+		return 0;
+	}
+
+	memset(pal, 0, sizeof(pal));
+	memcpy(pal, pencoded + 1, (size_t)colors * 3);
+
+	int bits = pal_bits(colors);
+	uint32_t ppb = 8 / bits; // ÿֽڵظ
+	uint32_t mask = (1u << bits) - 1;
+	// ұĽΪ256 * ppb, ֻڷֿ㹻ʱʹ, 8λʱɫ屾Ϊұ
+	_Bool use_lut = bits < 8 && (uint64_t)img_w * img_h >= 256 * 8;
+
+	if (use_lut) {
+		for (uint32_t v = 0; v < 256; v++) {
+			for (uint32_t j = 0; j < ppb; j++) {
+				memcpy(lut[v] + j * 3, pal[(v >> (j * bits)) & mask], 3);
+			}
+		}
+	}
+
+	const unsigned char* p = pencoded + 1 + (size_t)colors * 3;
+	const unsigned char* end = pencoded + encoded_len;
+	const unsigned char* prev = pal[0];
+	unsigned char* row = pdecoded;
+	uint32_t x = 0, y = 0;
+
+	while (y < img_h) {
+		if (p >= end) {
+			return 0;
+		}
+
+		unsigned char c = *p++;
+
+		if (c < PAL_OP_REP) {
+			// 
+			uint32_t m = (uint32_t)c + 1;
+			size_t nbytes = ((size_t)m * bits + 7) / 8;
+
+			if ((size_t)(end - p) < nbytes) {
+				return 0;
+			}
+
+			for (size_t k = 0; k < nbytes && y < img_h; k++) {
+				uint32_t cnt = __MIN(ppb, m);
+
+				m -= cnt;
+
+				if (use_lut && img_w - x >= cnt) {
+					memcpy(row + (size_t)x * 3, lut[p[k]], (size_t)cnt * 3);
+					x += cnt;
+					prev = lut[p[k]] + (cnt - 1) * 3;
+				}
+				else {
+					for (uint32_t j = 0; j < cnt && y < img_h; j++) {
+						prev = pal[(p[k] >> (j * bits)) & mask];
+						memcpy(row + (size_t)x * 3, prev, 3);
+
+						if (++x == img_w) {
+							x = 0;
+							y++;
+							row += stride;
+						}
+					}
+				}
+
+				if (x == img_w) {
+					x = 0;
+					y++;
+					row += stride;
+				}
+			}
+
+			p += nbytes;
+		}
+		else {
+			// ظ/γ̰
+			uint32_t len = (uint32_t)c - 0x7f;
+
+			if (c >= PAL_OP_RUN) {
+				len = (uint32_t)c - 0xbf;
+
+				if (c == PAL_OP_RUN_LONG) {
+					size_t k = rd_run_len(p, end, &len);
+
+					if (!k) {
+						return 0;
+					}
+
+					p += k;
+				}
+				if (p >= end) {
+					return 0;
+				}
+
+				prev = pal[*p++];
+			}
+
+			unsigned char px[3] = { prev[0], prev[1], prev[2] };
+
+			while (len && y < img_h) {
+				uint32_t cnt = __MIN(len, img_w - x);
+				unsigned char* q = row + (size_t)x * 3;
+
+				for (uint32_t j = 0; j < cnt; j++, q += 3) {
+					q[0] = px[0];
+					q[1] = px[1];
+					q[2] = px[2];
+				}
+
+				len -= cnt;
+				x += cnt;
+
+				if (x == img_w) {
+					x = 0;
+					y++;
+					row += stride;
+				}
+			}
+		}
+	}
+
+	return 1;
+}
+
+/*************************
+@calc
+@public
+@brief  ͳƵɫģʽеĸ(ΪQOI_ID_INDEX, ظ/γ̰ΪQOI_ID_RUN, ɫQOI_ID_INDEXֽ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		px_cnt ظ
+		stats ͳƽ(ָ, ԭмۼ)
+@return none
+*************************/
+void eqoi_palette_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, qoi_op_stats_t* stats) {
+	if (!encoded_len) {
+		return;
+	}
+
+	uint32_t colors = (uint32_t)pencoded[0] + 1;
+	int bits = pal_bits(colors);
+	size_t p = 1 + (size_t)colors * 3;
+	uint64_t px_done = 0;
+
+	stats->bytes[QOI_ID_INDEX] += __MIN(p, encoded_len);
+
+	while (p < encoded_len && px_done < px_cnt) {
+		unsigned char c = pencoded[p];
+		int id = c < PAL_OP_REP ? QOI_ID_INDEX : QOI_ID_RUN;
+		uint64_t n;
+		size_t len;
+
+		if (c < PAL_OP_REP) {
+			n = (uint64_t)c + 1;
+			len = 1 + ((size_t)n * bits + 7) / 8;
+		}
+		else if (c == PAL_OP_RUN_LONG) {
+			uint32_t run = 0;
+
+			len = 2 + rd_run_len(pencoded + p + 1, pencoded + encoded_len, &run);
+			n = run;
+		}
+		else if (c >= PAL_OP_RUN) {
+			n = (uint64_t)c - 0xbf;
+			len = 2;
+		}
+		else {
+			n = (uint64_t)c - 0x7f;
+			len = 1;
+		}
+
+		n = __MIN(n, px_cnt - px_done);
+
+		stats->ops[id]++;
+		stats->pixels[id] += n;
+		stats->bytes[id] += len;
+
+		px_done += n;
+		p += len;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@private
+@brief  ɫ(EQOI_PALETTE_MAXɫʱǰ)
+@param  prgb (ָ)
+		stride п(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		ht ɫϣ(ָ)
+@return ɫǷ񲻳EQOI_PALETTE_MAX
+*************************/
+static _Bool pal_build(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, pal_ht_t* ht) {
+	uint32_t last = 0;
+
+	memset(ht, 0, sizeof(pal_ht_t));
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const unsigned char* p = prgb + (size_t)y * stride;
+
+		for (uint32_t x = 0; x < img_w; x++, p += 3) {
+			uint32_t key = p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | 1u << 24;
+
+			if (key != last) {
+				if (pal_ht_put(ht, key) >= EQOI_PALETTE_MAX) {
+					return 0;
+				}
+
+				last = key;
+			}
+		}
+	}
+
+	return 1;
+}
+
+/*************************
+@calc
+@private
+@brief  ɫϣвɫ(ʱ)
+@param  ht ɫϣ(ָ)
+		key ɫ
+@return ɫڵɫе(ɫEQOI_PALETTE_MAXʱEQOI_PALETTE_MAX)
+*************************/
+static uint32_t pal_ht_put(pal_ht_t* ht, uint32_t key) {
+	uint32_t k = (key * 2654435761u) >> 22; // ȡ˷ϣĸ10λ(PAL_HT_L == 1024)
+
+	while (ht->key[k]) {
+		if (ht->key[k] == key) {
+			return ht->idx[k];
+		}
+
+		k = (k + 1) & (PAL_HT_L - 1);
+	}
+
+	if (ht->n == EQOI_PALETTE_MAX) {
+		return EQOI_PALETTE_MAX;
+	}
+
+	ht->key[k] = key;
+	ht->idx[k] = (unsigned char)ht->n;
+
+	return ht->n++;
+}
+
+/*************************
+@calc
+@private
+@brief  ɫÿλ
+@param  colors ɫ
+@return λ(1/2/4/8)
+*************************/
+static int pal_bits(uint32_t colors) {
+	return colors <= 2 ? 1 : colors <= 4 ? 2 : colors <= 16 ? 4 : 8;
+}
+
+/*************************
+@encode
+@private
+@brief  
+@param  dst λ(ָ)
+		lit (׵ַ)
+		m ظ(1~PAL_LIT_MAX)
+		bits ÿλ
+@return ֽ
+*************************/
+static size_t emit_lit(unsigned char* dst, const unsigned char* lit, uint32_t m, int bits) {
+	size_t nbytes = ((size_t)m * bits + 7) / 8;
+
+	dst[0] = (unsigned char)(m - 1);
+	memset(dst + 1, 0, nbytes);
+
+	for (uint32_t k = 0; k < m; k++) {
+		dst[1 + k * bits / 8] |= (unsigned char)(lit[k] << (k * bits % 8));
+	}
+
+	return 1 + nbytes;
+}
+
+/*************************
+@encode
+@private
+@brief  γ̰
+@param  dst λ(ָ)
+		idx 
+		len ظ(1~PAL_RUN_LONG)
+@return ֽ
+*************************/
+static size_t emit_run(unsigned char* dst, unsigned char idx, uint32_t len) {
+	if (len <= PAL_RUN_SHORT) {
+		dst[0] = (unsigned char)(0xbf + len);
+		dst[1] = idx;
+
+		return 2;
+	}
+
+	size_t k = 1;
+
+	dst[0] = PAL_OP_RUN_LONG;
+
+	for (len -= 64; len >= 0x80; len >>= 7) {
+		dst[k++] = (unsigned char)(len | 0x80);
+	}
+
+	dst[k++] = (unsigned char)len;
+	dst[k++] = idx;
+
+	return k;
+}
+
+/*************************
+@decode
+@private
+@brief  ȡγ̰ظ
+@param  p ظʼλ(ָ)
+		end λ(ָ)
+		len ظ(ָ)
+@return ظռõֽ(ضϻ򳬹3ֽʱ0)
+*************************/
+static size_t rd_run_len(const unsigned char* p, const unsigned char* end, uint32_t* len) {
+	uint32_t v = 0;
+
+	for (size_t k = 0; k < 3 && p + k < end; k++) {
+		v |= (uint32_t)(p[k] & 0x7f) << (k * 7);
+
+		if (!(p[k] & 0x80)) {
+			*len = 64 + v;
+
+			return k + 1;
+		}
+	}
+
+	return 0;
+}
+
+/*************************
+@encode
+@private
+@brief  һγ, Ƶλ3ַʽȡС(ظγ̰ض, ʱ֮1ֽ):
+		; ׸ز, ظ; γ̰
+		ÿز2ֽ, ظÿز1ֽ, γֻ̰ڲ3ֽʱ, ÿز2ֽ
+@param  dst ѹݻ(ָ)
+		pos ǰλ
+		lit (׵ַ)
+		m (ָ)
+		idx γ̵
+		run γ̳(0ʾûγ)
+		bits ÿλ
+@return µλ
+*************************/
+static size_t end_run(unsigned char* dst, size_t pos, unsigned char* lit, uint32_t* m, unsigned char idx, uint32_t run,
+	int bits) {
+	uint32_t cost_lit = run * bits;
+	uint32_t cost_rep = run > 1 && run - 1 <= PAL_REP_MAX ? (uint32_t)bits + (*m ? 16 : 24) : UINT32_MAX;
+	uint32_t cost_run = (run <= PAL_RUN_SHORT ? 16 : run < 64 + 0x80 ? 24 : run < 64 + 0x4000 ? 32 : 40) + 8;
+
+	if (cost_lit <= cost_rep && cost_lit <= cost_run) {
+		for (uint32_t k = 0; k < run; k++) {
+			lit[(*m)++] = idx;
+
+			if (*m == PAL_LIT_MAX) {
+				pos += emit_lit(dst + pos, lit, *m, bits);
+				*m = 0;
+			}
+		}
+
+		return pos;
+	}
+
+	if (cost_rep <= cost_run) {
+		lit[(*m)++] = idx;
+		pos += emit_lit(dst + pos, lit, *m, bits);
+		*m = 0;
+
+		dst[pos] = (unsigned char)(0x7f + run - 1);
+
+		return pos + 1;
+	}
+
+	if (*m) {
+		pos += emit_lit(dst + pos, lit, *m, bits);
+		*m = 0;
+	}
+
+	return pos + emit_run(dst + pos, idx, run);
+}
@@ -0,0 +1,34 @@
+/************************************************************************************************************************
+ǿQOIĵɫģʽ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ػͼԭͼزͨ256ɫ, 32ЩɫƵͻ, ÿγ1~4ֽ
+		ɫģʽ(бΪEQOI_CODEC_PALETTE, ÿֿ):
+		1ֽɫ-1, ɫ*3ֽڵɫ(ͨ˳һ), ֮Ϊդ˳İ:
+		0x00~0x7f  : Ϊ(ֽ+1)ص, ÿbitsλֽڵĵλ, ĩֽڲʱ0
+		0x80~0xbf  ظ: һظ(ֽ-0x7f)
+		0xc0~0xfe  γ̰: (ֽ-0xbf), 1ֽΪ
+		0xff       γ̰: 1~3ֽΪظ-64(LEB128, ÿֽڵ7λ, λʾ滹ֽ), 1ֽΪ
+		bitsɫ: 2ɫ1λ, 4ɫ2λ, 16ɫ4λ, 8λ
+************************************************************************************************************************/
+
+#ifndef __EQOI_PALETTE_H
+#define __EQOI_PALETTE_H
+
+#include "enhanced_qoi.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_PALETTE_MAX 256 // ɫɫ
+#define EQOI_PALETTE_MIN_PIXELS 1024 // ԶѡɫģʽʱֿСظ(Сķֿϵɫ屾Ŀ)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t eqoi_palette_count(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h); // ͳɫ(256ʱǰ)
+size_t eqoi_palette_max_size(uint32_t img_w, uint32_t img_h, uint32_t colors); // ɫģʽ󳤶
+size_t eqoi_palette_encode(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, unsigned char* pCompressed); // Եɫģʽ
+_Bool eqoi_palette_decode(const unsigned char* pencoded, size_t encoded_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h); // ɫģʽ
+void eqoi_palette_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, qoi_op_stats_t* stats); // ͳƵɫģʽеĸ
+
+#endif
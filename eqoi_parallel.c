@@ -0,0 +1,181 @@
+/************************************************************************************************************************
+ǿQOIĲִй
+@brief  Զ̬ȵķʽ䵽ִ߳
+@date   2026/10/18
+************************************************************************************************************************/
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#define EQOI_USE_PTHREAD
+#endif
+
+#include "eqoi_parallel.h"
+
+#ifdef EQOI_USE_PTHREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// (ṹ嶨)
+typedef struct {
+	eqoi_task_fn fn; // (ΪNULLʱʹworker_fn)
+	eqoi_worker_fn worker_fn; // ̱߳ŵ
+	void* arg; // 
+	uint32_t n; // 
+	volatile uint32_t next; // һȡ
+} parallel_job_t;
+
+// ߳(ṹ嶨)
+typedef struct {
+	parallel_job_t* job; // (ָ)
+	int index; // ̱߳(߳Ϊ0)
+} parallel_worker_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void run_job(parallel_job_t* job, int threads); // ִ߳񲢵ȴ
+static void* worker_main(void* worker); // ߳
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ȡõCPU
+@param  none
+@return CPU(Ϊ1)
+*************************/
+int eqoi_cpu_count(void) {
+#ifdef EQOI_USE_PTHREAD
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return n > 0 ? (int)__MIN(n, EQOI_MAX_THREADS) : 1;
+#else
+	return 1;
+#endif
+}
+
+/*************************
+@calc
+@public
+@brief  ȡִnʱʵʹõ߳(̷߳ݴʱݴȷ)
+@param  n 
+		threads ߳(<=0ʾʹȫCPU)
+@return ߳(nΪ0ʱΪ0)
+*************************/
+int eqoi_parallel_threads(uint32_t n, int threads) {
+	if (threads <= 0) {
+		threads = eqoi_cpu_count();
+	}
+
+	return (int)__MIN((uint32_t)__MIN(threads, EQOI_MAX_THREADS), n);
+}
+
+/*************************
+@run
+@public
+@brief  ʹöִ߳бΪ[0, n)(߳Ҳִ, ȫɺ󷵻)
+@param  n 
+		threads ߳(<=0ʾʹȫCPU)
+		fn 
+		arg 
+@return none
+*************************/
+void eqoi_parallel_for(uint32_t n, int threads, eqoi_task_fn fn, void* arg) {
+	parallel_job_t job = { fn, NULL, arg, n, 0 };
+
+	run_job(&job, eqoi_parallel_threads(n, threads));
+}
+
+/*************************
+@run
+@public
+@brief  ʹöִ߳бΪ[0, n), ִ̱߳
+@info   ̱߳Сeqoi_parallel_threads(n, threads), ͬһʱֻһʹĳ
+@param  n 
+		threads ߳(<=0ʾʹȫCPU)
+		fn 
+		arg 
+@return none
+*************************/
+void eqoi_parallel_for_worker(uint32_t n, int threads, eqoi_worker_fn fn, void* arg) {
+	parallel_job_t job = { NULL, fn, arg, n, 0 };
+
+	run_job(&job, eqoi_parallel_threads(n, threads));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@run
+@private
+@brief  ִ߳񲢵ȴ(߳Ϊ0ִ̲߳)
+@param  job (ָ)
+		threads ߳
+@return none
+*************************/
+static void run_job(parallel_job_t* job, int threads) {
+	parallel_worker_t workers[EQOI_MAX_THREADS];
+
+	if (threads <= 0) {
+		return; // û
+	}
+
+	for (int t = 0; t < threads; t++) {
+		workers[t] = (parallel_worker_t){ job, t };
+	}
+
+#ifdef EQOI_USE_PTHREAD
+	pthread_t tid[EQOI_MAX_THREADS];
+	int started = 0;
+
+	for (int t = 1; t < threads; t++) {
+		if (pthread_create(&tid[started], NULL, worker_main, &workers[t]) == 0) {
+			started++;
+		}
+	}
+
+	worker_main(&workers[0]);
+
+	for (int t = 0; t < started; t++) {
+		pthread_join(tid[t], NULL);
+	}
+#else
+	worker_main(&workers[0]);
+#endif
+}
+
+/*************************
+@run
+@private
+@brief  ߳(ѭȡֱȫȡ)
+@param  worker ߳(ָ)
+@return NULL
+*************************/
+static void* worker_main(void* worker) {
+	parallel_job_t* pjob = ((parallel_worker_t*)worker)->job;
+	int index = ((parallel_worker_t*)worker)->index;
+
+	for (;;) {
+#ifdef EQOI_USE_PTHREAD
+		uint32_t i = __sync_fetch_and_add(&pjob->next, 1);
+#else
+		uint32_t i = pjob->next++;
+#endif
+
+		if (i >= pjob->n) {
+			break;
+		}
+
+		if (pjob->fn != NULL) {
+			pjob->fn(pjob->arg, i);
+		}
+		else {
+			pjob->worker_fn(pjob->arg, i, index);
+		}
+	}
+
+	return NULL;
+}
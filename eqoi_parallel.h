@@ -0,0 +1,29 @@
+/************************************************************************************************************************
+ǿQOIĲִй
+@brief  ӿͷļ
+@date   2026/10/18
+@info   POSIXƽ̨ʹpthread, ƽ̨˻Ϊ˳ִ
+************************************************************************************************************************/
+
+#ifndef __EQOI_PARALLEL_H
+#define __EQOI_PARALLEL_H
+
+#include "main.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_MAX_THREADS 256 // ߳
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef void (*eqoi_task_fn)(void* arg, uint32_t i); // (argΪ, iΪ)
+typedef void (*eqoi_worker_fn)(void* arg, uint32_t i, int worker); // (workerΪִи̱߳, Сʵ߳)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int eqoi_cpu_count(void); // ȡõCPU
+int eqoi_parallel_threads(uint32_t n, int threads); // ȡִnʱʵʹõ߳
+void eqoi_parallel_for(uint32_t n, int threads, eqoi_task_fn fn, void* arg); // ʹöִ߳бΪ[0, n)
+void eqoi_parallel_for_worker(uint32_t n, int threads, eqoi_worker_fn fn, void* arg); // ͬ, ̱߳(ڰ̷߳ݴ)
+
+#endif
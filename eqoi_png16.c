@@ -0,0 +1,246 @@
+/************************************************************************************************************************
+ǿQOI16λPNGд
+@brief  stb_image_writezlibѹд3ͨ16λPNG
+@date   2026/10/18
+@info   PNGеĲΪ, ˲ֽΪλ, Ϊ6ֽ֮ǰֽ
+************************************************************************************************************************/
+
+#include "eqoi_png16.h"
+#include "stb_image_write.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PNG16_BPP 6 // ÿֽ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality); // zlibѹ(stb_image_writeֻʵֲ)
+
+static void filter_row(const unsigned char* cur, const unsigned char* prev, size_t len, int type, unsigned char* out); // һн˲
+static unsigned char paeth(int a, int b, int c); // PaethԤ
+static unsigned char* put_chunk(unsigned char* o, const char* type, const unsigned char* data, uint32_t len); // дһݿ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@encode
+@public
+@brief  3ͨ16λͼдΪPNG(λ16, ɫ2)
+@param  prgb (ָ, ÿ3uint16_t)
+		img_w ͼ
+		img_h ͼ߶
+		out_len PNG(ָ)
+@return PNG(freeͷ, ʧʱNULL)
+*************************/
+unsigned char* eqoi_png16_write_mem(const uint16_t* prgb, uint32_t img_w, uint32_t img_h, size_t* out_len) {
+	size_t row_len = (size_t)img_w * PNG16_BPP;
+	uint64_t filt_len = (uint64_t)(row_len + 1) * img_h;
+
+	// stbi_zlib_compressʹintʾ
+	if (!img_w || !img_h || filt_len > INT_MAX) {
+		return NULL;
+	}
+
+	unsigned char* filt = malloc((size_t)filt_len);
+	unsigned char* rows = malloc(row_len * 3);
+
+	if (filt == NULL || rows == NULL) {
+		free(filt);
+		free(rows);
+
+		return NULL;
+	}
+
+	unsigned char* cur = rows;
+	unsigned char* prev = rows + row_len;
+	unsigned char* line = rows + row_len * 2;
+
+	memset(prev, 0, row_len);
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const uint16_t* prow = prgb + (size_t)y * img_w * 3;
+		unsigned char* dst = filt + (size_t)y * (row_len + 1);
+		uint64_t best = UINT64_MAX;
+		int best_type = 0;
+
+		for (size_t k = 0; k < (size_t)img_w * 3; k++) {
+			cur[k * 2] = (unsigned char)(prow[k] >> 8);
+			cur[k * 2 + 1] = (unsigned char)prow[k];
+		}
+
+		// ˲Ƹе(ֵ֮), ȡС
+		for (int type = 0; type < 5; type++) {
+			uint64_t est = 0;
+
+			filter_row(cur, prev, row_len, type, line);
+
+			for (size_t k = 0; k < row_len; k++) {
+				est += (uint64_t)abs((signed char)line[k]);
+			}
+
+			if (est < best) {
+				best = est;
+				best_type = type;
+			}
+		}
+
+		dst[0] = (unsigned char)best_type;
+		filter_row(cur, prev, row_len, best_type, dst + 1);
+
+		unsigned char* t = prev;
+		prev = cur;
+		cur = t;
+	}
+
+	free(rows);
+
+	int zlen;
+	unsigned char* zlib = stbi_zlib_compress(filt, (int)filt_len, &zlen, stbi_write_png_compression_level);
+
+	free(filt);
+
+	if (zlib == NULL) {
+		return NULL;
+	}
+
+	static const unsigned char sig[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+	unsigned char ihdr[13] = { 0 };
+	unsigned char* out = malloc(8 + 12 + 13 + 12 + (size_t)zlen + 12);
+
+	if (out == NULL) {
+		free(zlib);
+
+		return NULL;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		ihdr[i] = (unsigned char)(img_w >> (24 - i * 8));
+		ihdr[4 + i] = (unsigned char)(img_h >> (24 - i * 8));
+	}
+
+	ihdr[8] = 16; // λ
+	ihdr[9] = 2; // ɫ: RGB
+
+	unsigned char* o = out;
+
+	memcpy(o, sig, 8);
+	o = put_chunk(o + 8, "IHDR", ihdr, 13);
+	o = put_chunk(o, "IDAT", zlib, (uint32_t)zlen);
+	o = put_chunk(o, "IEND", NULL, 0);
+
+	free(zlib);
+	*out_len = (size_t)(o - out);
+
+	return out;
+}
+
+/*************************
+@io
+@public
+@brief  3ͨ16λͼдΪPNGļ
+@param  path ļ·
+		prgb (ָ, ÿ3uint16_t)
+		img_w ͼ
+		img_h ͼ߶
+@return Ƿɹ
+*************************/
+int eqoi_png16_write(const char* path, const uint16_t* prgb, uint32_t img_w, uint32_t img_h) {
+	size_t len;
+	unsigned char* png = eqoi_png16_write_mem(prgb, img_w, img_h, &len);
+
+	if (png == NULL) {
+		return 0;
+	}
+
+	FILE* fp = fopen(path, "wb");
+	int ok = fp != NULL && fwrite(png, 1, len, fp) == len;
+
+	if (fp != NULL && fclose(fp) != 0) {
+		ok = 0;
+	}
+
+	free(png);
+
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@encode
+@private
+@brief  һн˲(0: 1:Sub 2:Up 3:Average 4:Paeth)
+@param  cur ǰ(ָ)
+		prev һ(ָ, Ϊȫ0)
+		len г(ֽ)
+		type ˲
+		out ˲(ָ)
+@return none
+*************************/
+static void filter_row(const unsigned char* cur, const unsigned char* prev, size_t len, int type, unsigned char* out) {
+	for (size_t k = 0; k < len; k++) {
+		int a = k >= PNG16_BPP ? cur[k - PNG16_BPP] : 0;
+		int b = prev[k];
+		int c = k >= PNG16_BPP ? prev[k - PNG16_BPP] : 0;
+
+		switch (type) {
+		case 1: out[k] = (unsigned char)(cur[k] - a); break;
+		case 2: out[k] = (unsigned char)(cur[k] - b); break;
+		case 3: out[k] = (unsigned char)(cur[k] - ((a + b) >> 1)); break;
+		case 4: out[k] = (unsigned char)(cur[k] - paeth(a, b, c)); break;
+		default: out[k] = cur[k]; break;
+		}
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  PaethԤ
+@param  a ֽ
+		b Ϸֽ
+		c Ϸֽ
+@return Ԥֵ
+*************************/
+static unsigned char paeth(int a, int b, int c) {
+	int p = a + b - c;
+	int pa = abs(p - a);
+	int pb = abs(p - b);
+	int pc = abs(p - c);
+
+	if (pa <= pb && pa <= pc) {
+		return (unsigned char)a;
+	}
+
+	return (unsigned char)(pb <= pc ? b : c);
+}
+
+/*************************
+@io
+@private
+@brief  дһݿ( +  +  + CRC32, )
+@param  o дλ(ָ)
+		type ݿ(4ַ)
+		data (ָ)
+		len ݳ
+@return ݿ֮дλ
+*************************/
+static unsigned char* put_chunk(unsigned char* o, const char* type, const unsigned char* data, uint32_t len) {
+	for (int i = 0; i < 4; i++) {
+		o[i] = (unsigned char)(len >> (24 - i * 8));
+	}
+
+	memcpy(o + 4, type, 4);
+
+	if (len) {
+		memcpy(o + 8, data, len);
+	}
+
+	uint32_t crc = eqoi_crc32(0, o + 4, (size_t)len + 4);
+
+	for (int i = 0; i < 4; i++) {
+		o[8 + len + i] = (unsigned char)(crc >> (24 - i * 8));
+	}
+
+	return o + 12 + len;
+}
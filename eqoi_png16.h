@@ -0,0 +1,20 @@
+/************************************************************************************************************************
+ǿQOI16λPNGд
+@brief  ӿͷļ
+@date   2026/10/18
+@info   stb_image_writeֻд8λPNG, λĶջ׼Ҫ16λPNG(ȡʹstb_imagestbi_load_16)
+		˲stb_image_writeͬ(г5˲, ȡֵ֮С, ֽھΪһص6ֽ),
+		ѹʹstb_image_writestbi_zlib_compressͬѹ, 8λPNG׼Ŀɱ
+************************************************************************************************************************/
+
+#ifndef __EQOI_PNG16_H
+#define __EQOI_PNG16_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned char* eqoi_png16_write_mem(const uint16_t* prgb, uint32_t img_w, uint32_t img_h, size_t* out_len); // 3ͨ16λͼдΪPNG
+int eqoi_png16_write(const char* path, const uint16_t* prgb, uint32_t img_w, uint32_t img_h); // 3ͨ16λͼдΪPNGļ
+
+#endif
@@ -0,0 +1,369 @@
+/************************************************************************************************************************
+ǿQOIķֽ׶
+@brief  Լʱظһͼ, ܸ׶εʱαӲ
+@date   2026/10/18
+@info   ÿ:
+		--һֹҽqoi_prof_t, ׶εļ۳ʱĿ(ʱ궨)
+		--ڶֲҽqoi_prof_t, αʱperf_event_openӲ, Ϊܼʱŵ
+		ֻʹõֿ顢߳, Ͳ޹
+		perf_event_openں˽ֹ(perf_event_paranoid)Linuxƽ̨ʱ, ʱӦΪ-1
+************************************************************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "eqoi_prof.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CALIB_MARKS 100000 // 궨ʱ㿪ʱļʱ
+#define CALIB_ROUNDS 5 // 궨(ȡСֵ)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Ӳ(ṹ嶨)
+typedef struct {
+	int fd[EQOI_PERF_CNT]; // ļ(-1ʾ)
+} perf_group_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char* stage_names[QOI_STAGE_CNT] = { "predict", "classify", "probe", "emit", "parse", "recon" }; // ׶
+static const char* perf_names[EQOI_PERF_CNT] = { "cycles", "instr", "br-miss", "L1d-miss" }; // Ӳ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef EQOI_PROFILE
+static double calibrate_mark(void); // 궨ʱĿ
+static void perf_open(perf_group_t* g); // Ӳ
+static void perf_start(perf_group_t* g); // 㲢Ӳ
+static void perf_stop(perf_group_t* g, int64_t* acc); // ֹͣӲۼӶ
+static void perf_close(perf_group_t* g); // رӲ
+#endif
+static void print_stages(FILE* fp, const char* label, const qoi_prof_t* prof, const int* stages, int n, double mark_ticks,
+	uint64_t pixels); // ӡһ׶εÿؼ
+static void print_perf(FILE* fp, const char* label, uint64_t ticks, const int64_t* perf, uint64_t pixels); // ӡαÿؼ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@run
+@public
+@brief  ֽ׶һͼı
+@param  prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		reps ظ(ÿ)
+		res (ָ)
+@return (δEQOI_PROFILEʱEQOI_ERR_UNSUPPORTED)
+*************************/
+int eqoi_profile_image(unsigned char* prgb, uint32_t img_w, uint32_t img_h, int reps, eqoi_prof_result_t* res) {
+	memset(res, 0, sizeof(eqoi_prof_result_t));
+
+#ifdef EQOI_PROFILE
+	if (!img_w || !img_h || reps <= 0) {
+		return EQOI_ERR_ARG;
+	}
+
+	size_t raw_len = (size_t)img_w * img_h * 3;
+	unsigned char* encoded = malloc((size_t)img_w * img_h * 4);
+	unsigned char* decoded = malloc(raw_len);
+	void* scratch = malloc(eqoi_scratch_size(img_w));
+	size_t encoded_len = 0;
+	perf_group_t perf;
+	int err = (encoded == NULL || decoded == NULL || scratch == NULL) ? EQOI_ERR_MEM : EQOI_OK;
+
+	res->mark_ticks = calibrate_mark();
+	perf_open(&perf);
+
+	for (int pass = 0; pass < 2 && err == EQOI_OK; pass++) {
+		for (int r = 0; r < reps && err == EQOI_OK; r++) {
+			qoi_encoder_t enc;
+			qoi_decoder_t dec;
+
+			if (!enhanced_qoi_encoder_init_scratch(&enc, img_w, img_h, scratch)) {
+				err = EQOI_ERR_MEM;
+				break;
+			}
+
+			enc.prof = pass == 0 ? &res->enc : NULL;
+			perf_start(&perf);
+			uint64_t t0 = qoi_prof_ticks();
+			encoded_len = enhanced_qoi_encode_rows(&enc, prgb, (size_t)img_w * 3, img_h, encoded);
+			uint64_t t1 = qoi_prof_ticks();
+			perf_stop(&perf, pass == 0 ? NULL : res->enc_perf);
+			enhanced_qoi_encoder_free(&enc);
+
+			if (!enhanced_qoi_decoder_init(&dec, encoded, encoded_len, img_w, img_h)) {
+				err = EQOI_ERR_MEM;
+				break;
+			}
+
+			dec.prof = pass == 0 ? &res->dec : NULL;
+			perf_start(&perf);
+			uint64_t t2 = qoi_prof_ticks();
+			enhanced_qoi_decode_rows(&dec, decoded, (size_t)img_w * 3, img_h);
+			uint64_t t3 = qoi_prof_ticks();
+			perf_stop(&perf, pass == 0 ? NULL : res->dec_perf);
+			enhanced_qoi_decoder_free(&dec);
+
+			if (pass == 1) {
+				res->enc_ticks += t1 - t0;
+				res->dec_ticks += t3 - t2;
+				res->pixels += (uint64_t)img_w * img_h;
+			}
+		}
+	}
+
+	if (err == EQOI_OK && memcmp(prgb, decoded, raw_len)) {
+		err = EQOI_ERR_FORMAT;
+	}
+
+	// õļΪ-1
+	for (int k = 0; k < EQOI_PERF_CNT; k++) {
+		if (perf.fd[k] < 0) {
+			res->enc_perf[k] = -1;
+			res->dec_perf[k] = -1;
+		}
+	}
+
+	perf_close(&perf);
+	free(encoded);
+	free(decoded);
+	free(scratch);
+
+	return err;
+#else
+	(void)prgb;
+	(void)img_w;
+	(void)img_h;
+	(void)reps;
+
+	return EQOI_ERR_UNSUPPORTED;
+#endif
+}
+
+/*************************
+@io
+@public
+@brief  ӡÿص
+@param  fp ļ
+		res (ָ)
+@return none
+*************************/
+void eqoi_print_profile(FILE* fp, const eqoi_prof_result_t* res) {
+	static const int enc_stages[] = { QOI_STAGE_PREDICT, QOI_STAGE_CLASSIFY, QOI_STAGE_PROBE, QOI_STAGE_EMIT };
+	static const int dec_stages[] = { QOI_STAGE_PARSE, QOI_STAGE_RECON, QOI_STAGE_PREDICT };
+
+	fprintf(fp, "  stage ticks/px (timer overhead %.1f ticks/mark removed)\n", res->mark_ticks);
+	print_stages(fp, "encode", &res->enc, enc_stages, 4, res->mark_ticks, res->pixels);
+	print_stages(fp, "decode", &res->dec, dec_stages, 3, res->mark_ticks, res->pixels);
+
+	fprintf(fp, "  whole pass per pixel (stage timers off)\n");
+	print_perf(fp, "encode", res->enc_ticks, res->enc_perf, res->pixels);
+	print_perf(fp, "decode", res->dec_ticks, res->dec_perf, res->pixels);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef EQOI_PROFILE
+/*************************
+@calc
+@private
+@brief  궨ʱĿ(PROF_MARKĲͬ)
+@param  none
+@return ÿʱʱ
+*************************/
+static double calibrate_mark(void) {
+	double best = 0.0;
+
+	for (int round = 0; round < CALIB_ROUNDS; round++) {
+		volatile qoi_prof_t prof;
+		uint64_t prof_t = qoi_prof_ticks();
+		uint64_t t0 = prof_t;
+
+		memset((void*)&prof, 0, sizeof(qoi_prof_t));
+
+		for (int i = 0; i < CALIB_MARKS; i++) {
+			uint64_t prof_now = qoi_prof_ticks();
+
+			prof.ticks[i & 1] += prof_now - prof_t;
+			prof.marks[i & 1]++;
+			prof_t = prof_now;
+		}
+
+		double per_mark = (double)(qoi_prof_ticks() - t0) / CALIB_MARKS;
+
+		if (round == 0 || per_mark < best) {
+			best = per_mark;
+		}
+	}
+
+	return best;
+}
+
+/*************************
+@init
+@private
+@brief  Ӳ(ֻͳû̬, ʧܵļΪ)
+@param  g Ӳ(ָ)
+@return none
+*************************/
+static void perf_open(perf_group_t* g) {
+	for (int k = 0; k < EQOI_PERF_CNT; k++) {
+		g->fd[k] = -1;
+	}
+
+#ifdef __linux__
+	static const uint32_t types[EQOI_PERF_CNT] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE };
+	static const uint64_t configs[EQOI_PERF_CNT] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_BRANCH_MISSES,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+	};
+
+	for (int k = 0; k < EQOI_PERF_CNT; k++) {
+		struct perf_event_attr attr;
+
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = types[k];
+		attr.config = configs[k];
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		g->fd[k] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	}
+#endif
+}
+
+/*************************
+@run
+@private
+@brief  㲢Ӳ
+@param  g Ӳ(ָ)
+@return none
+*************************/
+static void perf_start(perf_group_t* g) {
+#ifdef __linux__
+	for (int k = 0; k < EQOI_PERF_CNT; k++) {
+		if (g->fd[k] >= 0) {
+			ioctl(g->fd[k], PERF_EVENT_IOC_RESET, 0);
+			ioctl(g->fd[k], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#else
+	(void)g;
+#endif
+}
+
+/*************************
+@run
+@private
+@brief  ֹͣӲۼӶ
+@param  g Ӳ(ָ)
+		acc ۼӵĶ(׵ַ, ΪNULL)
+@return none
+*************************/
+static void perf_stop(perf_group_t* g, int64_t* acc) {
+#ifdef __linux__
+	for (int k = 0; k < EQOI_PERF_CNT; k++) {
+		uint64_t v;
+
+		if (g->fd[k] < 0) {
+			continue;
+		}
+
+		ioctl(g->fd[k], PERF_EVENT_IOC_DISABLE, 0);
+
+		if (acc != NULL && read(g->fd[k], &v, sizeof(v)) == (ssize_t)sizeof(v)) {
+			acc[k] += (int64_t)v;
+		}
+	}
+#else
+	(void)g;
+	(void)acc;
+#endif
+}
+
+/*************************
+@delete
+@private
+@brief  رӲ
+@param  g Ӳ(ָ)
+@return none
+*************************/
+static void perf_close(perf_group_t* g) {
+#ifdef __linux__
+	for (int k = 0; k < EQOI_PERF_CNT; k++) {
+		if (g->fd[k] >= 0) {
+			close(g->fd[k]);
+		}
+	}
+#else
+	(void)g;
+#endif
+}
+#endif
+
+/*************************
+@io
+@private
+@brief  ӡһ׶εÿؼ
+@param  fp ļ
+		label бǩ
+		prof ֽ׶μʱ(ָ)
+		stages ׶α(׵ַ)
+		n ׶θ
+		mark_ticks ÿʱĿ
+		pixels 
+@return none
+*************************/
+static void print_stages(FILE* fp, const char* label, const qoi_prof_t* prof, const int* stages, int n, double mark_ticks,
+	uint64_t pixels) {
+	double sum = 0.0;
+
+	fprintf(fp, "    %-7s", label);
+	for (int i = 0; i < n; i++) {
+		int s = stages[i];
+		double v = (double)prof->ticks[s] - mark_ticks * prof->marks[s];
+		double per_px = pixels ? __MAX(v, 0.0) / pixels : 0.0;
+
+		sum += per_px;
+		fprintf(fp, "  %s %7.2f", stage_names[s], per_px);
+	}
+	fprintf(fp, "  (sum %.2f)\n", sum);
+}
+
+/*************************
+@io
+@private
+@brief  ӡαÿؼ
+@param  fp ļ
+		label бǩ
+		ticks ʱ
+		perf Ӳ(׵ַ, -1ʾ)
+		pixels 
+@return none
+*************************/
+static void print_perf(FILE* fp, const char* label, uint64_t ticks, const int64_t* perf, uint64_t pixels) {
+	fprintf(fp, "    %-7s  ticks %7.2f", label, pixels ? (double)ticks / pixels : 0.0);
+
+	for (int k = 0; k < EQOI_PERF_CNT; k++) {
+		if (perf[k] < 0) {
+			fprintf(fp, "  %s n/a", perf_names[k]);
+		}
+		else {
+			fprintf(fp, "  %s %.3f", perf_names[k], pixels ? (double)perf[k] / pixels : 0.0);
+		}
+	}
+	fprintf(fp, "\n");
+}
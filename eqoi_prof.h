@@ -0,0 +1,44 @@
+/************************************************************************************************************************
+ǿQOIķֽ׶
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ʱEQOI_PROFILE(gcc -DEQOI_PROFILE), ѭڸ׶֮ȡʱ(x86Ϊrdtsc),
+		õԤ/ѡ//ֽ(Ϊ/ؽ/Ԥ)׶εÿʱ;
+		Linuxperf_event_openͳαָ֧ԤʧL1ݻȱʧ
+		δEQOI_PROFILEʱеļʱչΪ, eqoi_profile_imageEQOI_ERR_UNSUPPORTED
+************************************************************************************************************************/
+
+#ifndef __EQOI_PROF_H
+#define __EQOI_PROF_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Ӳ
+#define EQOI_PERF_CYCLES 0 // CPU
+#define EQOI_PERF_INSTR 1 // ָ
+#define EQOI_PERF_BRANCH_MISS 2 // ֧Ԥʧ
+#define EQOI_PERF_L1D_MISS 3 // L1ݻȱʧ
+#define EQOI_PERF_CNT 4 // Ӳ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// (ṹ嶨)
+typedef struct {
+	uint64_t pixels; // ۼƱ(*ظ)
+	qoi_prof_t enc; // ׶εļʱ
+	qoi_prof_t dec; // ׶εļʱ
+	double mark_ticks; // ÿʱĿ(ʱ, ѴӸ׶п۳)
+	uint64_t enc_ticks; // ʱ׶ʱαʱ
+	uint64_t dec_ticks; // ʱ׶ʱνʱ
+	int64_t enc_perf[EQOI_PERF_CNT]; // αӲ(-1ʾ)
+	int64_t dec_perf[EQOI_PERF_CNT]; // νӲ(-1ʾ)
+} eqoi_prof_result_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int eqoi_profile_image(unsigned char* prgb, uint32_t img_w, uint32_t img_h, int reps, eqoi_prof_result_t* res); // ֽ׶һͼı
+void eqoi_print_profile(FILE* fp, const eqoi_prof_result_t* res); // ӡÿص
+
+#endif
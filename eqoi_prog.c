@@ -0,0 +1,381 @@
+/************************************************************************************************************************
+ǿQOIĽģʽ
+@brief  ȱÿ8x8ȡ1صĻͼ, ɴֵϸѽֵԤ
+@date   2026/10/18
+************************************************************************************************************************/
+
+#include "eqoi_prog.h"
+#include "eqoi_endian.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ϸ(ṹ嶨)
+typedef struct {
+	uint32_t x0; // ÿ׸صĺ
+	uint32_t y0; // е
+	uint32_t dx; // صļ
+	uint32_t dy; // еļ
+	uint32_t h; // ֵصľ
+	_Bool vertical; // ֵ(־, Ϊ0ʱֵ)
+} prog_pass_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void get_pass(int k, prog_pass_t* pass); // ȡϸλֵ
+static uint32_t pass_cols(const prog_pass_t* pass, uint32_t img_w); // ϸÿеظ
+static void predict_row(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, const prog_pass_t* pass,
+	uint32_t y, uint32_t n, unsigned char* ppred); // ϸһصĲֵԤֵ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  㽥ģʽ󳤶
+@param  img_w ͼ
+		img_h ͼ߶
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_prog_max_size(uint32_t img_w, uint32_t img_h) {
+	// ÿֻڻͼһϸ, ռ4ֽ(RGB)
+	return EQOI_PROG_TABLE_SIZE + (size_t)img_w * img_h * 4;
+}
+
+/*************************
+@encode
+@public
+@brief  Խģʽ
+@param  prgb (ָ)
+		stride ݵп(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		pCompressed ѹݻ(ָ, Сeqoi_prog_max_size)
+@return ѹֽ(ڴʧʱ0)
+*************************/
+size_t eqoi_prog_encode(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, unsigned char* pCompressed) {
+	uint32_t base_w = (img_w + EQOI_PROG_STEP - 1) / EQOI_PROG_STEP;
+	uint32_t base_h = (img_h + EQOI_PROG_STEP - 1) / EQOI_PROG_STEP;
+	unsigned char* line = malloc((size_t)img_w * 3 + eqoi_scratch_size(base_w));
+
+	if (line == NULL) {
+		return 0;
+	}
+
+	unsigned char* data = pCompressed + EQOI_PROG_TABLE_SIZE;
+	size_t p = 0;
+
+	memset(pCompressed, 0, EQOI_PROG_TABLE_SIZE);
+	wr_u32(pCompressed, EQOI_PROG_STREAMS);
+
+	// ͼ: гȡлMED
+	qoi_encoder_t enc;
+
+	enhanced_qoi_encoder_init_scratch(&enc, base_w, base_h, line + (size_t)img_w * 3);
+
+	for (uint32_t by = 0; by < base_h; by++) {
+		const unsigned char* src = prgb + (size_t)by * EQOI_PROG_STEP * stride;
+
+		for (uint32_t bx = 0; bx < base_w; bx++) {
+			memcpy(line + (size_t)bx * 3, src + (size_t)bx * EQOI_PROG_STEP * 3, 3);
+		}
+
+		p += enhanced_qoi_encode_rows(&enc, line, (size_t)base_w * 3, 1, data + p);
+	}
+
+	enhanced_qoi_encoder_free(&enc);
+	wr_u64(pCompressed + 8, p);
+
+	// ϸ: ÿؾɴǰֵԤ, 
+	for (int k = 1; k < EQOI_PROG_STREAMS; k++) {
+		prog_pass_t pass;
+		qoi_pred_state_t st;
+
+		get_pass(k, &pass);
+		enhanced_qoi_pred_init(&st);
+
+		uint32_t n = pass_cols(&pass, img_w);
+
+		for (uint32_t y = pass.y0; y < img_h && n; y += pass.dy) {
+			predict_row(prgb, stride, img_w, img_h, &pass, y, n, line);
+			p += enhanced_qoi_encode_pred(&st, prgb + (size_t)y * stride + (size_t)pass.x0 * 3, (size_t)pass.dx * 3, line, n,
+				pass.vertical, y + pass.dy >= img_h, data + p);
+		}
+
+		wr_u64(pCompressed + 8 + (size_t)k * 8, p);
+	}
+
+	free(line);
+
+	return EQOI_PROG_TABLE_SIZE + p;
+}
+
+/*************************
+@decode
+@public
+@brief  뽥ģʽ(ɱض: ͼʱ, δȡֵԤֵ, õõԤ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݵ
+		avail_len ʵʿõĳ(encoded_len, Сencoded_lenʾض)
+		pdecoded 뻺(ָ)
+		stride 뻺п(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		streams (ָ, ΪNULL, ͼȫϸʱΪEQOI_PROG_STREAMS)
+@return (ͼʱEQOI_ERR_TRUNC)
+*************************/
+int eqoi_prog_decode(const unsigned char* pencoded, size_t encoded_len, size_t avail_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h, int* streams) {
+	uint64_t ends[EQOI_PROG_STREAMS];
+
+	if (streams != NULL) {
+		*streams = 0;
+	}
+	if (encoded_len < EQOI_PROG_TABLE_SIZE) {
+		return EQOI_ERR_FORMAT;
+	}
+	if (avail_len < EQOI_PROG_TABLE_SIZE) {
+		return EQOI_ERR_TRUNC;
+	}
+	if (rd_u32(pencoded) != EQOI_PROG_STREAMS) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	for (int k = 0; k < EQOI_PROG_STREAMS; k++) {
+		ends[k] = rd_u64(pencoded + 8 + (size_t)k * 8);
+
+		if (ends[k] < (k ? ends[k - 1] : 0)) {
+			return EQOI_ERR_FORMAT;
+		}
+	}
+
+	if (ends[EQOI_PROG_STREAMS - 1] != encoded_len - EQOI_PROG_TABLE_SIZE) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	const unsigned char* data = pencoded + EQOI_PROG_TABLE_SIZE;
+	size_t avail = avail_len - EQOI_PROG_TABLE_SIZE;
+
+	if (ends[0] > avail) {
+		return EQOI_ERR_TRUNC;
+	}
+
+	uint32_t base_w = (img_w + EQOI_PROG_STEP - 1) / EQOI_PROG_STEP;
+	uint32_t base_h = (img_h + EQOI_PROG_STEP - 1) / EQOI_PROG_STEP;
+	unsigned char* line = malloc(__MAX((size_t)img_w, (size_t)base_w * 2) * 3);
+
+	if (line == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	// ͼ: л(Ԥȡһбԭַ), ٷɢԵλ
+	qoi_decoder_t dec;
+
+	enhanced_qoi_decoder_init(&dec, (unsigned char*)data, (size_t)ends[0], base_w, base_h);
+
+	for (uint32_t by = 0; by < base_h; by++) {
+		unsigned char* row = line + (size_t)(by & 1) * base_w * 3;
+		unsigned char* dst = pdecoded + (size_t)by * EQOI_PROG_STEP * stride;
+
+		enhanced_qoi_decode_rows(&dec, row, (size_t)base_w * 3, 1);
+
+		for (uint32_t bx = 0; bx < base_w; bx++) {
+			memcpy(dst + (size_t)bx * EQOI_PROG_STEP * 3, row + (size_t)bx * 3, 3);
+		}
+	}
+
+	enhanced_qoi_decoder_free(&dec);
+
+	int done = 1;
+	int err = EQOI_OK;
+
+	// ϸ: ľòµȡԤֵ, ֮ĸճǲֵ
+	for (int k = 1; k < EQOI_PROG_STREAMS; k++) {
+		prog_pass_t pass;
+		qoi_pred_state_t st;
+
+		get_pass(k, &pass);
+		enhanced_qoi_pred_init(&st);
+
+		uint32_t n = pass_cols(&pass, img_w);
+		size_t start = (size_t)__MIN(ends[k - 1], (uint64_t)avail);
+		size_t len = (size_t)__MIN(ends[k], (uint64_t)avail) - start;
+		_Bool complete = ends[k] <= avail;
+		_Bool short_stream = 0;
+
+		for (uint32_t y = pass.y0; y < img_h && n; y += pass.dy) {
+			unsigned char* dst = pdecoded + (size_t)y * stride + (size_t)pass.x0 * 3;
+
+			predict_row(pdecoded, stride, img_w, img_h, &pass, y, n, line);
+
+			size_t m = enhanced_qoi_decode_pred(&st, data + start, len, line, n, pass.vertical, dst,
+				(size_t)pass.dx * 3);
+
+			for (size_t i = m; i < n; i++) {
+				memcpy(dst + i * pass.dx * 3, line + i * 3, 3);
+			}
+
+			short_stream |= m < n;
+		}
+
+		if (complete && (short_stream || st.p != len || st.run)) {
+			err = EQOI_ERR_FORMAT; // ǡøǸòȫ
+		}
+
+		done += complete && !short_stream;
+	}
+
+	free(line);
+
+	if (streams != NULL) {
+		*streams = done;
+	}
+
+	return err;
+}
+
+/*************************
+@decode
+@public
+@brief  ܱضϵĽģʽļ(ͼ)
+@param  file ļ(ָ)
+		len ʵʶļ
+		hdr ļͷ(ָ, eqoi_parse_headereqoi_parse_header_prefix, ΪEQOI_CODEC_PROGRESSIVE)
+		pdecoded 뻺(ָ, Ϊeqoi_decoded_size(hdr))
+		streams (ָ, ΪNULL)
+@return (ѹݽضڻͼ֮ʱEQOI_ERR_TRUNC)
+*************************/
+int eqoi_decode_progressive(const unsigned char* file, size_t len, const eqoi_header_t* hdr, unsigned char* pdecoded,
+	int* streams) {
+	if (hdr->codec != EQOI_CODEC_PROGRESSIVE) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint64_t start = eqoi_tile_offset(hdr, 0);
+	uint64_t end = eqoi_tile_offset(hdr, 1);
+	uint64_t avail = len > hdr->data_offset ? len - hdr->data_offset : 0;
+
+	if (start > end || end > hdr->data_len) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	return eqoi_prog_decode(file + hdr->data_offset + start, (size_t)(end - start),
+		(size_t)(__MIN(end, avail) - __MIN(start, avail)), pdecoded, (size_t)hdr->width * 3, hdr->width, hdr->height, streams);
+}
+
+/*************************
+@calc
+@public
+@brief  ͳƽģʽеĸ(ͼϸıͬ)
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		img_w ͼ
+		img_h ͼ߶
+		stats ͳƽ(ָ, ԭмۼ)
+@return 
+*************************/
+int eqoi_prog_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint32_t img_w, uint32_t img_h, qoi_op_stats_t* stats) {
+	if (encoded_len < EQOI_PROG_TABLE_SIZE || rd_u32(pencoded) != EQOI_PROG_STREAMS) {
+		return EQOI_ERR_FORMAT;
+	}
+
+	uint64_t start = 0;
+
+	for (int k = 0; k < EQOI_PROG_STREAMS; k++) {
+		uint64_t end = rd_u64(pencoded + 8 + (size_t)k * 8);
+		uint64_t px_cnt;
+
+		if (end < start || end > encoded_len - EQOI_PROG_TABLE_SIZE) {
+			return EQOI_ERR_FORMAT;
+		}
+
+		if (k == 0) {
+			px_cnt = (uint64_t)((img_w + EQOI_PROG_STEP - 1) / EQOI_PROG_STEP) * ((img_h + EQOI_PROG_STEP - 1) / EQOI_PROG_STEP);
+		}
+		else {
+			prog_pass_t pass;
+
+			get_pass(k, &pass);
+			px_cnt = img_h > pass.y0 ? (uint64_t)pass_cols(&pass, img_w) * ((img_h - pass.y0 + pass.dy - 1) / pass.dy) : 0;
+		}
+
+		enhanced_qoi_scan_ops(pencoded + EQOI_PROG_TABLE_SIZE + start, (size_t)(end - start), px_cnt, stats);
+		start = end;
+	}
+
+	return EQOI_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@private
+@brief  ȡϸλֵ
+@info   Ϊs֪ʱ, ֵͬһее(y%s==0, x%s==s/2), ֵ֮
+		һ(y%s==s/2, x%(s/2)==0), ֮Ϊs/2֪; sΪ8, 4, 2, 6
+@param  k (1~EQOI_PROG_STREAMS-1)
+		pass ϸ(ָ)
+@return none
+*************************/
+static void get_pass(int k, prog_pass_t* pass) {
+	uint32_t s = EQOI_PROG_STEP >> ((k - 1) / 2);
+
+	pass->h = s / 2;
+	pass->vertical = (k - 1) & 1;
+
+	if (pass->vertical) {
+		pass->x0 = 0;
+		pass->y0 = s / 2;
+		pass->dx = s / 2;
+	}
+	else {
+		pass->x0 = s / 2;
+		pass->y0 = 0;
+		pass->dx = s;
+	}
+
+	pass->dy = s;
+}
+
+/*************************
+@calc
+@private
+@brief  ϸÿеظ
+@param  pass ϸ(ָ)
+		img_w ͼ
+@return ظ
+*************************/
+static uint32_t pass_cols(const prog_pass_t* pass, uint32_t img_w) {
+	return img_w > pass->x0 ? (img_w - pass->x0 + pass->dx - 1) / pass->dx : 0;
+}
+
+/*************************
+@calc
+@private
+@brief  ϸһصĲֵԤֵ(ľֵ, һ೬ͼʱȡ֪һ)
+@param  prgb ͼ(ָ, ǰѾ)
+		stride ͼп(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		pass ϸ(ָ)
+		y к
+		n еظ
+		ppred Ԥֵ(ָ, , b, g, r)
+@return none
+*************************/
+static void predict_row(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, const prog_pass_t* pass,
+	uint32_t y, uint32_t n, unsigned char* ppred) {
+	const unsigned char* row = prgb + (size_t)y * stride;
+	size_t off = pass->vertical ? pass->h * stride : (size_t)pass->h * 3;
+	_Bool far = pass->vertical && y + pass->h < img_h;
+
+	for (uint32_t i = 0; i < n; i++) {
+		uint32_t x = pass->x0 + i * pass->dx;
+		const unsigned char* a = row + (size_t)x * 3 - off;
+		const unsigned char* b = (pass->vertical ? far : x + pass->h < img_w) ? row + (size_t)x * 3 + off : a;
+
+		ppred[i * 3] = (unsigned char)((a[0] + b[0] + 1) >> 1);
+		ppred[i * 3 + 1] = (unsigned char)((a[1] + b[1] + 1) >> 1);
+		ppred[i * 3 + 2] = (unsigned char)((a[2] + b[2] + 1) >> 1);
+	}
+}
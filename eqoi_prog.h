@@ -0,0 +1,45 @@
+/************************************************************************************************************************
+ǿQOIĽģʽ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ˳ضϺֻܵõͼϰ벿; ģʽ(бΪEQOI_CODEC_PROGRESSIVE, ֻһֿ,
+		ظʽΪEQOI_FMT_RGB8, ʹֵ)ֱɵ͵, ضϵļҲܽԤ:
+		ͼ  ÿ8x8ȡϽ1(x%8==0y%8==0)ɵСͼ, MED
+		ϸ  Ϊs֪ʱ, ȱͬһее(y%s==0, x%s==s/2), ԤֵΪ֪صľֵ,
+				ٱ֮һ(y%s==s/2, x%(s/2)==0), ԤֵΪ֪صľֵ(һ೬ͼʱ
+				ȡ֪һ), ֮Ϊs/2֪; sΪ8, 4, 2, 6
+		ϸԵ߸ĲֵԤֵMED, ͡γ8λͬ, ÿ㰴դ˳
+		ӳʼ״̬ʼ; ͷΪ64ֽڵķֶα:
+		ƫ  ֶ
+		0    4    (EQOI_PROG_STREAMS)
+		4    4    (Ϊ0)
+		8    56   Ľλ(7, ÿ8ֽ, ڷֶα֮; Ϊͼ6ϸ)
+		ضϵʱ, ͼ, ľ֮ԺȡֵԤֵ, ൱ڰѽĲַŴ
+		ֲԶ, ÿһɫıԵÿһ㶼Ҫ±, ļ˳: ƬԼ1%~8%,
+		ͼɫԼ10%~13%, ƽɴ84%; ͼҪضԤʱӦʹMED
+************************************************************************************************************************/
+
+#ifndef __EQOI_PROG_H
+#define __EQOI_PROG_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_PROG_STEP 8 // ͼĳ
+#define EQOI_PROG_STREAMS 7 // (ͼ + 6ϸ)
+#define EQOI_PROG_TABLE_SIZE 64 // ֶα(ֽ)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t eqoi_prog_max_size(uint32_t img_w, uint32_t img_h); // 㽥ģʽ󳤶
+size_t eqoi_prog_encode(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h,
+	unsigned char* pCompressed); // Խģʽ
+int eqoi_prog_decode(const unsigned char* pencoded, size_t encoded_len, size_t avail_len, unsigned char* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h, int* streams); // 뽥ģʽ
+int eqoi_decode_progressive(const unsigned char* file, size_t len, const eqoi_header_t* hdr, unsigned char* pdecoded,
+	int* streams); // ܱضϵĽģʽļ
+int eqoi_prog_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint32_t img_w, uint32_t img_h,
+	qoi_op_stats_t* stats); // ͳƽģʽеĸ
+
+#endif
@@ -0,0 +1,231 @@
+/************************************************************************************************************************
+ǿQOIС(ͼ)
+@brief  н벢ۼӵͼһеķ, ۼһз
+@date   2026/10/18
+************************************************************************************************************************/
+
+#include "eqoi_scale.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static _Bool valid_scale(int scale); // жСǷЧ
+static void add_row(uint16_t* acc, const unsigned char* row, uint32_t img_w, int scale); // һۼӵ
+static void emit_row(uint16_t* acc, uint32_t img_w, int scale, uint32_t rows, unsigned char* dst); // ɷһͼ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ͼĳߴ(ͼߴСȡ)
+@param  hdr ļͷ(ָ)
+		scale С(2, 48)
+		w ͼ(ָ)
+		h ͼ߶(ָ)
+@return none
+*************************/
+void eqoi_scaled_dims(const eqoi_header_t* hdr, int scale, uint32_t* w, uint32_t* h) {
+	*w = (uint32_t)(((uint64_t)hdr->width + scale - 1) / scale);
+	*h = (uint32_t)(((uint64_t)hdr->height + scale - 1) / scale);
+}
+
+/*************************
+@decode
+@public
+@brief  벢СΪͼ(eqoi_box_reduceСֽͬ)
+@param  file ļ(ָ)
+		hdr ļͷ(ָ, ظʽΪEQOI_FMT_RGB8)
+		scale С(2, 48)
+		pdecoded ͼ(ָ, ߴeqoi_scaled_dims, ذb, g, r)
+		stride ͼп(ֽ)
+@return 
+*************************/
+int eqoi_decode_scaled(const unsigned char* file, const eqoi_header_t* hdr, int scale, unsigned char* pdecoded,
+	size_t stride) {
+	if (!valid_scale(scale) || hdr->pixel_fmt != EQOI_FMT_RGB8) {
+		return EQOI_ERR_ARG;
+	}
+
+	size_t row_len = (size_t)hdr->width * 3;
+	int err = EQOI_OK;
+
+	if (hdr->codec != EQOI_CODEC_MED) {
+		// ɫûнĽӿ: С
+		unsigned char* data = malloc(row_len * hdr->height);
+
+		err = data == NULL ? EQOI_ERR_MEM : eqoi_decode(file, hdr, 1, data);
+
+		if (err == EQOI_OK) {
+			eqoi_box_reduce(data, row_len, hdr->width, hdr->height, scale, pdecoded, stride);
+		}
+
+		free(data);
+
+		return err;
+	}
+
+	uint32_t tiles_x = (hdr->width + hdr->tile_w - 1) / hdr->tile_w;
+	uint32_t out_w, out_h;
+
+	eqoi_scaled_dims(hdr, scale, &out_w, &out_h);
+
+	unsigned char* rows = malloc(row_len * 2);
+	uint16_t* acc = calloc((size_t)out_w * 3, sizeof(uint16_t));
+	qoi_decoder_t* decs = malloc(tiles_x * sizeof(qoi_decoder_t));
+
+	if (rows == NULL || acc == NULL || decs == NULL) {
+		err = EQOI_ERR_MEM;
+	}
+
+	// ֿ: 򿪸еĸֿ, ÿͼɸֿԵһ, ۼӵ
+	for (uint32_t i = 0; i < hdr->tile_cnt && err == EQOI_OK; i += tiles_x) {
+		uint32_t rx, ry, rw, rh;
+
+		for (uint32_t t = 0; t < tiles_x && err == EQOI_OK; t++) {
+			err = eqoi_open_tile(file, hdr, i + t, &decs[t]);
+		}
+
+		eqoi_tile_rect(hdr, i, &rx, &ry, &rw, &rh);
+
+		for (uint32_t y = ry; y < ry + rh && err == EQOI_OK; y++) {
+			unsigned char* row = rows + (y & 1) * row_len;
+
+			for (uint32_t t = 0; t < tiles_x; t++) {
+				enhanced_qoi_decode_rows(&decs[t], row + (size_t)t * hdr->tile_w * 3, row_len, 1);
+			}
+
+			add_row(acc, row, hdr->width, scale);
+
+			if ((y + 1) % scale == 0 || y + 1 == hdr->height) {
+				emit_row(acc, hdr->width, scale, y % scale + 1, pdecoded + (size_t)(y / scale) * stride);
+			}
+		}
+
+		for (uint32_t t = 0; t < tiles_x; t++) {
+			enhanced_qoi_decoder_free(&decs[t]);
+		}
+	}
+
+	free(rows);
+	free(acc);
+	free(decs);
+
+	return err;
+}
+
+/*************************
+@calc
+@public
+@brief  ѽͼ񰴷С(ÿΪscale*scaleصľֵ, Ҳײķȡʵصľֵ)
+@param  prgb ͼ(ָ, ÿ3ֽ)
+		stride ͼп(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		scale С(2, 48, ֵ)
+		pdecoded ͼ(ָ, ߴeqoi_scaled_dims)
+		out_stride ͼп(ֽ)
+@return none
+*************************/
+void eqoi_box_reduce(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, int scale,
+	unsigned char* pdecoded, size_t out_stride) {
+	uint32_t out_w = (uint32_t)(((uint64_t)img_w + scale - 1) / scale);
+	uint16_t* acc = valid_scale(scale) ? calloc((size_t)out_w * 3, sizeof(uint16_t)) : NULL;
+
+	if (acc == NULL) {
+		return;
+	}
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		add_row(acc, prgb + (size_t)y * stride, img_w, scale);
+
+		if ((y + 1) % scale == 0 || y + 1 == img_h) {
+			emit_row(acc, img_w, scale, y % scale + 1, pdecoded + (size_t)(y / scale) * out_stride);
+		}
+	}
+
+	free(acc);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@check
+@private
+@brief  жСǷЧ
+@param  scale С
+@return ǷΪ2, 48
+*************************/
+static _Bool valid_scale(int scale) {
+	return scale == 2 || scale == 4 || scale == 8;
+}
+
+/*************************
+@calc
+@private
+@brief  һۼӵ(8x88λֵ֮Ͳ16320, 16λۼ)
+@param  acc (ָ, ÿ3)
+		row (ָ)
+		img_w ͼ
+		scale С
+@return none
+*************************/
+static void add_row(uint16_t* acc, const unsigned char* row, uint32_t img_w, int scale) {
+	uint32_t full = img_w / scale;
+
+	for (uint32_t ox = 0; ox < full; ox++) {
+		const unsigned char* p = row + (size_t)ox * scale * 3;
+		uint16_t* a = acc + (size_t)ox * 3;
+		uint32_t b = 0, g = 0, r = 0;
+
+		for (int k = 0; k < scale * 3; k += 3) {
+			b += p[k];
+			g += p[k + 1];
+			r += p[k + 2];
+		}
+
+		a[0] += (uint16_t)b;
+		a[1] += (uint16_t)g;
+		a[2] += (uint16_t)r;
+	}
+
+	// Ҳ಻ķ
+	for (uint32_t x = full * scale; x < img_w; x++) {
+		uint16_t* a = acc + (size_t)full * 3;
+
+		a[0] += row[x * 3];
+		a[1] += row[x * 3 + 1];
+		a[2] += row[x * 3 + 2];
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  ɷһͼ(ȡֵ), 㷽
+@param  acc (ָ)
+		img_w ͼ
+		scale С
+		rows ʵ
+		dst ͼ(ָ)
+@return none
+*************************/
+static void emit_row(uint16_t* acc, uint32_t img_w, int scale, uint32_t rows, unsigned char* dst) {
+	uint32_t out_w = (uint32_t)(((uint64_t)img_w + scale - 1) / scale);
+	uint32_t full = rows == (uint32_t)scale ? img_w / scale : 0;
+	int shift = scale == 2 ? 2 : scale == 4 ? 4 : 6;
+
+	// ķscale*scale, λ
+	for (size_t i = 0; i < (size_t)full * 3; i++) {
+		dst[i] = (unsigned char)((acc[i] + (1u << (shift - 1))) >> shift);
+	}
+
+	for (uint32_t ox = full; ox < out_w; ox++) {
+		uint32_t cnt = (uint32_t)__MIN((uint64_t)scale, img_w - (uint64_t)ox * scale) * rows;
+
+		for (int c = 0; c < 3; c++) {
+			dst[(size_t)ox * 3 + c] = (unsigned char)((acc[(size_t)ox * 3 + c] + cnt / 2) / cnt);
+		}
+	}
+
+	memset(acc, 0, (size_t)out_w * 3 * sizeof(uint16_t));
+}
@@ -0,0 +1,31 @@
+/************************************************************************************************************************
+ǿQOIС(ͼ)
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ȽͼСҪдȫֱʵĽ; Сн, ÿнۼӵͼһе
+		ۼӻ(ÿضӦscale*scaleصķ), ۼscaleмһͼ:
+		ֿ(ͬһзֿ)ĸֿһ, 뵽ȫл(Ԥȡһ
+		ԭַ), ˳лۼӻⲻҪڴ, ڴԼΪС
+		1/(scale*scale)
+		ͼߴΪͼߴscaleȡ, Ҳײķȡʵصľֵ(), 
+		󰴷Сֽͬ; нֻ8λRGBMED, ɫС
+************************************************************************************************************************/
+
+#ifndef __EQOI_SCALE_H
+#define __EQOI_SCALE_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_SCALE_MAX 8 // С
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void eqoi_scaled_dims(const eqoi_header_t* hdr, int scale, uint32_t* w, uint32_t* h); // ͼĳߴ
+int eqoi_decode_scaled(const unsigned char* file, const eqoi_header_t* hdr, int scale, unsigned char* pdecoded,
+	size_t stride); // 벢СΪͼ
+void eqoi_box_reduce(const unsigned char* prgb, size_t stride, uint32_t img_w, uint32_t img_h, int scale,
+	unsigned char* pdecoded, size_t out_stride); // ѽͼ񰴷С
+
+#endif
@@ -0,0 +1,279 @@
+/************************************************************************************************************************
+ǿQOIĵֶβн
+@brief  Ʋֽڶεıͱ߽粢, жβн, ٰжε˳ؽ
+@date   2026/10/18
+************************************************************************************************************************/
+
+#if !defined(_WIN32)
+#define EQOI_USE_SYNC
+#endif
+
+#include "eqoi_split.h"
+#include "eqoi_parallel.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ж֮ͬ(POSIXƽ̨ΪGCC˳һµԭӲ, ƽ̨eqoi_parallel_for˳ִ)
+#ifdef EQOI_USE_SYNC
+#define SPLIT_LOAD(v) __atomic_load_n(&(v), __ATOMIC_SEQ_CST)
+#define SPLIT_STORE(v, x) __atomic_store_n(&(v), x, __ATOMIC_SEQ_CST)
+#define SPLIT_TRY_ACQUIRE(v) __sync_bool_compare_and_swap(&(v), 0, 1)
+#else
+#define SPLIT_LOAD(v) (v)
+#define SPLIT_STORE(v, x) ((v) = (x))
+#define SPLIT_TRY_ACQUIRE(v) ((v) ? 0 : ((v) = 1))
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ֶν(ṹ嶨)
+typedef struct {
+	const unsigned char* pencoded; // ѹ(ָ)
+	size_t encoded_len; // ѹݳ
+	unsigned char* pdecoded; // 뻺(ָ)
+	unsigned char* kinds; // غ(ָ, ÿ1ֽ)
+	uint32_t img_w; // ͼ
+	uint32_t img_h; // ͼ߶
+	uint32_t chunk_cnt; // ֽڶ
+	size_t chunk_len; // ÿֽڶεĳ
+	uint64_t* spec_px; // ֽڶδӶƲɨõ()
+	size_t* spec_end; // ֽڶƲɨĽλ()
+	size_t* chunk_p; // ֽڶ׸͵ʵλ(, chunk_cnt+1)
+	uint64_t* chunk_px; // ñ͸ǵ׸ص(, chunk_cnt+1)
+	uint32_t seg_rows; // ÿжε
+	uint32_t seg_cnt; // ж
+	qoi_decoder_t dec; // ؽõĽ(ǰһ)
+	unsigned char* parsed; // жѽ(־)
+	uint32_t resolved; // ؽж
+	int resolving; // ߳ؽ(־)
+} split_job_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void spec_task(void* arg, uint32_t k); // ֽڶεĶƲɨ()
+static void fix_chunks(split_job_t* job); // ֽڶεıͱ߽
+static void split_task(void* arg, uint32_t i); // һж, ؽѾж()
+static void resolve_ready(split_job_t* job); // ˳ؽѽж
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@check
+@public
+@brief  жǷʺϷֶβн(8λRGB MED, ܶ㹻, ҿö1߳)
+@info   ߳õCPU: ֻ1ʱֶνƲȫǶ⿪, Ӧʹ˳
+@param  hdr ļͷ(ָ)
+		threads ߳(<=0ʾʹȫCPU)
+@return Ƿʺ
+*************************/
+_Bool eqoi_split_usable(const eqoi_header_t* hdr, int threads) {
+	if (hdr->tile_cnt != 1 || hdr->pixel_fmt != EQOI_FMT_RGB8 || hdr->codec != EQOI_CODEC_MED) {
+		return 0;
+	}
+	if ((uint64_t)hdr->width * hdr->height < EQOI_SPLIT_MIN_PX ||
+		hdr->data_len * EQOI_SPLIT_MIN_DENSITY < (uint64_t)hdr->width * hdr->height) {
+		return 0;
+	}
+
+	return __MIN(threads <= 0 ? eqoi_cpu_count() : threads, eqoi_cpu_count()) > 1;
+}
+
+/*************************
+@decode
+@public
+@brief  ֶβн뵥ͼ(eqoi_decodeֽͬ)
+@param  file ļ(ָ)
+		hdr ļͷ(ָ, ֻһֿ, ظʽΪEQOI_FMT_RGB8, ΪEQOI_CODEC_MED)
+		threads ߳(<=0ʾʹȫCPU)
+		pdecoded 뻺(ָ, Ϊeqoi_decoded_size(hdr))
+@return 
+*************************/
+int eqoi_decode_split(const unsigned char* file, const eqoi_header_t* hdr, int threads, unsigned char* pdecoded) {
+	if (hdr->tile_cnt != 1 || hdr->pixel_fmt != EQOI_FMT_RGB8 || hdr->codec != EQOI_CODEC_MED) {
+		return EQOI_ERR_ARG;
+	}
+
+	uint64_t start = eqoi_tile_offset(hdr, 0);
+	uint64_t end = eqoi_tile_offset(hdr, 1);
+
+	if (start > end || end > hdr->data_len) {
+		return EQOI_ERR_FORMAT;
+	}
+	if (hdr->dict_id && (hdr->dict == NULL || hdr->dict->id != hdr->dict_id)) {
+		return EQOI_ERR_DICT;
+	}
+
+	// ֶʵʿɲе߳ȷ(߳CPUʱֻƲĿ)
+	threads = threads <= 0 ? eqoi_cpu_count() : __MIN(threads, eqoi_cpu_count());
+
+	uint64_t segs = (uint64_t)threads * EQOI_SPLIT_SEGS_PER_THREAD;
+	uint32_t seg_rows = (uint32_t)__MAX((hdr->height + segs - 1) / segs, EQOI_SPLIT_MIN_ROWS);
+	uint32_t seg_cnt = (hdr->height + seg_rows - 1) / seg_rows;
+	size_t encoded_len = (size_t)(end - start);
+	uint32_t chunk_cnt = (uint32_t)__MAX(__MIN(segs, encoded_len / EQOI_SPLIT_MIN_CHUNK), 1);
+	size_t px_cnt = (size_t)hdr->width * hdr->height;
+	size_t chunk_size = 2 * sizeof(uint64_t) + 2 * sizeof(size_t);
+	unsigned char* arena = malloc((size_t)(chunk_cnt + 1) * chunk_size + px_cnt + seg_cnt);
+
+	if (arena == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	split_job_t job;
+
+	job.pencoded = file + hdr->data_offset + start;
+	job.encoded_len = encoded_len;
+	job.pdecoded = pdecoded;
+	job.img_w = hdr->width;
+	job.img_h = hdr->height;
+	job.chunk_cnt = chunk_cnt;
+	job.chunk_len = (encoded_len + chunk_cnt - 1) / chunk_cnt;
+	job.spec_px = (uint64_t*)arena;
+	job.chunk_px = job.spec_px + chunk_cnt + 1;
+	job.spec_end = (size_t*)(job.chunk_px + chunk_cnt + 1);
+	job.chunk_p = job.spec_end + chunk_cnt + 1;
+	job.kinds = (unsigned char*)(job.chunk_p + chunk_cnt + 1);
+	job.parsed = job.kinds + px_cnt;
+	job.seg_rows = seg_rows;
+	job.seg_cnt = seg_cnt;
+	job.resolved = 0;
+	job.resolving = 0;
+
+	memset(job.parsed, 0, seg_cnt);
+	enhanced_qoi_decoder_init(&job.dec, (unsigned char*)job.pencoded, encoded_len, hdr->width, hdr->height);
+
+	if (hdr->dict_id) {
+		enhanced_qoi_decoder_set_dict(&job.dec, &hdr->dict->state);
+	}
+
+	// Ʋֽڶεıͱ߽(), (˳, ͨÿֻɨ輸), ٽؽж
+	eqoi_parallel_for(chunk_cnt, threads, spec_task, &job);
+	fix_chunks(&job);
+	eqoi_parallel_for(seg_cnt, threads, split_task, &job);
+
+	enhanced_qoi_decoder_free(&job.dec);
+	free(arena);
+
+	return EQOI_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@private
+@brief  ֽڶεĶƲɨ(Ѷֽڵ͵ֽ, )
+@param  arg ֶν(ָ)
+		k ֽڶκ
+@return none
+*************************/
+static void spec_task(void* arg, uint32_t k) {
+	split_job_t* job = (split_job_t*)arg;
+	size_t p = __MIN((size_t)k * job->chunk_len, job->encoded_len);
+
+	job->spec_px[k] = enhanced_qoi_scan_span(job->pencoded, job->encoded_len, &p, p + job->chunk_len);
+	job->spec_end[k] = p;
+}
+
+/*************************
+@calc
+@private
+@brief  ֽڶεıͱ߽
+@info   ֽ֪ڶ׸͵ʵλú, Ӹλͬʱɨ(ÿƽһ), 
+		غϺƲɨĽΪʵ; ֱβԲغʱʵɨƲ
+@param  job ֶν(ָ)
+@return none
+*************************/
+static void fix_chunks(split_job_t* job) {
+	job->chunk_p[0] = 0;
+	job->chunk_px[0] = 0;
+
+	for (uint32_t k = 0; k < job->chunk_cnt; k++) {
+		size_t ps = __MIN((size_t)k * job->chunk_len, job->encoded_len);
+		size_t end = __MIN(ps + job->chunk_len, job->encoded_len);
+		size_t pt = job->chunk_p[k];
+		uint64_t nt = 0;
+		uint64_t ns = 0;
+
+		while (pt != ps && pt < end) {
+			if (pt < ps) {
+				nt += enhanced_qoi_scan_span(job->pencoded, job->encoded_len, &pt, pt + 1);
+			}
+			else {
+				ns += enhanced_qoi_scan_span(job->pencoded, job->encoded_len, &ps, ps + 1);
+			}
+		}
+
+		if (pt == ps && pt < end) {
+			nt += job->spec_px[k] - ns;
+			pt = job->spec_end[k];
+		}
+
+		job->chunk_p[k + 1] = pt;
+		job->chunk_px[k + 1] = job->chunk_px[k] + nt;
+	}
+}
+
+/*************************
+@run
+@private
+@brief  һж, ؽѾж()
+@param  arg ֶν(ָ)
+		i жκ
+@return none
+*************************/
+static void split_task(void* arg, uint32_t i) {
+	split_job_t* job = (split_job_t*)arg;
+	uint32_t y = i * job->seg_rows;
+	uint32_t rows = __MIN(job->seg_rows, job->img_h - y);
+	size_t stride = (size_t)job->img_w * 3;
+	uint64_t target = (uint64_t)y * job->img_w;
+	uint32_t lo = 0;
+	uint32_t hi = job->chunk_cnt;
+	qoi_mark_t mark;
+
+	// һز׵ֽڶ, ׸ɨ赽
+	while (lo < hi) {
+		uint32_t mid = (lo + hi + 1) / 2;
+
+		if (job->chunk_px[mid] <= target) {
+			lo = mid;
+		}
+		else {
+			hi = mid - 1;
+		}
+	}
+
+	enhanced_qoi_scan_mark(job->pencoded, job->encoded_len, job->chunk_p[lo], job->chunk_px[lo], target, &mark);
+	enhanced_qoi_parse_rows(job->pencoded, job->encoded_len, &mark, job->img_w, rows, job->pdecoded + (size_t)y * stride,
+		stride, job->kinds + (size_t)y * job->img_w);
+
+	SPLIT_STORE(job->parsed[i], 1);
+
+	resolve_ready(job);
+}
+
+/*************************
+@decode
+@private
+@brief  ˳ؽѽж(ͬһʱֻһ߳ؽ, ̼߳)
+@info   ؽ̷߳ؽȨ֮ټһһж, ڴڼɽȴؽȨռöصж
+@param  job ֶν(ָ)
+@return none
+*************************/
+static void resolve_ready(split_job_t* job) {
+	size_t stride = (size_t)job->img_w * 3;
+	uint32_t i;
+
+	while ((i = SPLIT_LOAD(job->resolved)) < job->seg_cnt && SPLIT_LOAD(job->parsed[i]) && SPLIT_TRY_ACQUIRE(job->resolving)) {
+		while ((i = SPLIT_LOAD(job->resolved)) < job->seg_cnt && SPLIT_LOAD(job->parsed[i])) {
+			uint32_t y = i * job->seg_rows;
+
+			enhanced_qoi_resolve_rows(&job->dec, job->pdecoded + (size_t)y * stride, stride, job->kinds + (size_t)y * job->img_w,
+				__MIN(job->seg_rows, job->img_h - y));
+			SPLIT_STORE(job->resolved, i + 1);
+		}
+
+		SPLIT_STORE(job->resolving, 0);
+	}
+}
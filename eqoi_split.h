@@ -0,0 +1,38 @@
+/************************************************************************************************************************
+ǿQOIĵֶβн
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ɰļ(8ֽQoiHeader)ֻһֿļͼΪһ, ûпɹе; ֶβн뽫
+		Ϊͬļ:
+		Ʋ  ֽھΪɶ, ΰѶֽڵ͵ֽڲɨ(ÿֱ͵ĳֽ
+			  , γ̳Ϊֽڵĵ5λ), ֻۼ
+		  ˳һεʵλ: ʵλͬʱɨ, ߽ͨڼغ,
+			  غϺƲΪʵ, õ׸͵λ
+		  жֽڶɨ赽, ٲн, õÿصغغ(Ԥ
+			  RGBλ), һǰ
+		ؽ  MEDԤǰȫ, һ̰߳жε˳ؽ: ĳжνɺ, ǰжξ
+			  ؽ, ɽ̼߳ؽж, ؽжεĽн
+		رƲ: Դһʼʱ, ԤMEDһֱ´, ʵ⼸ڶ
+		ʵغ, ؽ˳, ٱؽٶΪ; ÿ1ֽڵغͻ
+		˳ֽͬ; ֻ8λRGBMED, ظʽ尴ֿ
+****************************************************************************************************************/
+
+#ifndef __EQOI_SPLIT_H
+#define __EQOI_SPLIT_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_SPLIT_MIN_PX (1u << 20) // eqoi_decodeԶʹ÷ֶβнС
+#define EQOI_SPLIT_MIN_DENSITY 2 // ԶʹʱÿEQOI_SPLIT_MIN_DENSITY1ֽ(γΪؽ˳)
+#define EQOI_SPLIT_MIN_ROWS 8 // ÿεС
+#define EQOI_SPLIT_SEGS_PER_THREAD 8 // ÿ߳ƽֵж
+#define EQOI_SPLIT_MIN_CHUNK 4096 // ƲɨֽڶεС
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+_Bool eqoi_split_usable(const eqoi_header_t* hdr, int threads); // жǷʺϷֶβн
+int eqoi_decode_split(const unsigned char* file, const eqoi_header_t* hdr, int threads, unsigned char* pdecoded); // ֶβн뵥ͼ
+
+#endif
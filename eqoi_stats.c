@@ -0,0 +1,240 @@
+/************************************************************************************************************************
+ǿQOIĲ׮ͳ
+@brief  Բ׮ֿͼ, ܸ͵ֽԤֱͼÿֽ
+@date   2026/10/18
+@info   ͳʱֿ˳̱߳(ֿ鹲ͬһͳ), eqoi_encodeֽͬ
+		ͼÿֽɫ: 0Ϊɫ, ɫɫɵ4ֽ/(QOI_OP_RGB)Ϊɫ
+************************************************************************************************************************/
+
+#include "eqoi_stats.h"
+#include "stb_image_write.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define HEAT_MAX_BPP 4.0 // ͼɫӳ(ֽ/)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char* op_names[QOI_ID_CNT] = { "RUN", "INDEX", "DIFF", "DIFF3", "LUMA", "DIFF2", "RGB" }; // 
+static const int resid_edges[] = { 0, 1, 2, 3, 4, 8, 16, 32, 64, QOI_RESID_BINS }; // ֱͼӡʱ߽
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void heat_color(double bpp, unsigned char* rgb); // ÿֽӳΪɫ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@run
+@public
+@brief  Բ׮ͼռͳ
+@param  prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		stats ͳƽ(ָ, ʹúeqoi_free_stats)
+@return (δEQOI_STATSʱEQOI_ERR_UNSUPPORTED)
+*************************/
+int eqoi_collect_stats(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h,
+	qoi_enc_stats_t* stats) {
+	memset(stats, 0, sizeof(qoi_enc_stats_t));
+
+#ifdef EQOI_STATS
+	if (!img_w || !img_h) {
+		return EQOI_ERR_ARG;
+	}
+
+	eqoi_header_t hdr;
+	eqoi_init_header(&hdr, img_w, img_h, tile_w, tile_h);
+
+	stats->heat_w = (img_w + QOI_STATS_BLOCK - 1) / QOI_STATS_BLOCK;
+	stats->heat_h = (img_h + QOI_STATS_BLOCK - 1) / QOI_STATS_BLOCK;
+	stats->heat_bytes = calloc((size_t)stats->heat_w * stats->heat_h, sizeof(uint32_t));
+
+	unsigned char* buf = malloc((size_t)hdr.tile_w * hdr.tile_h * 4);
+	void* scratch = malloc(eqoi_scratch_size(hdr.tile_w));
+	size_t stride = (size_t)img_w * 3;
+	int err = (stats->heat_bytes == NULL || buf == NULL || scratch == NULL) ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (uint32_t i = 0; i < hdr.tile_cnt && err == EQOI_OK; i++) {
+		qoi_encoder_t enc;
+		uint32_t x, y, w, h;
+
+		eqoi_tile_rect(&hdr, i, &x, &y, &w, &h);
+
+		if (!enhanced_qoi_encoder_init_scratch(&enc, w, h, scratch)) {
+			err = EQOI_ERR_MEM;
+			break;
+		}
+
+		stats->org_x = x;
+		stats->org_y = y;
+		enc.stats = stats;
+
+		enhanced_qoi_encode_rows(&enc, prgb + (size_t)y * stride + (size_t)x * 3, stride, h, buf);
+		enhanced_qoi_encoder_free(&enc);
+	}
+
+	free(buf);
+	free(scratch);
+
+	if (err != EQOI_OK) {
+		eqoi_free_stats(stats);
+	}
+
+	return err;
+#else
+	(void)prgb;
+	(void)img_w;
+	(void)img_h;
+	(void)tile_w;
+	(void)tile_h;
+
+	return EQOI_ERR_UNSUPPORTED;
+#endif
+}
+
+/*************************
+@delete
+@public
+@brief  ͷͳռõڴ
+@param  stats ͳƽ(ָ)
+@return none
+*************************/
+void eqoi_free_stats(qoi_enc_stats_t* stats) {
+	free(stats->heat_bytes);
+	stats->heat_bytes = NULL;
+}
+
+/*************************
+@io
+@public
+@brief  ӡͳƽ(͵Ĵ/ֽ/λÿ, ͨԤֵķֲ)
+@param  fp ļ
+		stats ͳƽ(ָ)
+@return none
+*************************/
+void eqoi_print_stats(FILE* fp, const qoi_enc_stats_t* stats) {
+	uint64_t px_sum = 0, byte_sum = 0;
+
+	for (int i = 0; i < QOI_ID_CNT; i++) {
+		px_sum += stats->ops.pixels[i];
+		byte_sum += stats->ops.bytes[i];
+	}
+
+	fprintf(fp, "  op          count        bytes  bytes%%   pixels%%  bits/px\n");
+	for (int i = 0; i < QOI_ID_CNT; i++) {
+		const qoi_op_stats_t* o = &stats->ops;
+
+		fprintf(fp, "  %-6s %10llu %12llu  %6.2f  %7.2f  %7.3f\n", op_names[i], (unsigned long long)o->ops[i],
+			(unsigned long long)o->bytes[i], byte_sum ? o->bytes[i] * 100.0 / byte_sum : 0.0,
+			px_sum ? o->pixels[i] * 100.0 / px_sum : 0.0, o->pixels[i] ? o->bytes[i] * 8.0 / o->pixels[i] : 0.0);
+	}
+	fprintf(fp, "  total  %10s %12llu  bits/px %.3f\n", "", (unsigned long long)byte_sum,
+		px_sum ? byte_sum * 8.0 / px_sum : 0.0);
+
+	fprintf(fp, "  |resid|");
+	for (int k = 0; k + 1 < (int)(sizeof(resid_edges) / sizeof(resid_edges[0])); k++) {
+		char label[16];
+
+		if (resid_edges[k + 1] - resid_edges[k] == 1) {
+			snprintf(label, sizeof(label), "%d", resid_edges[k]);
+		}
+		else {
+			snprintf(label, sizeof(label), "%d-%d", resid_edges[k], resid_edges[k + 1] - 1);
+		}
+		fprintf(fp, " %7s", label);
+	}
+	fprintf(fp, "   (%% of pixels)\n");
+
+	for (int c = 0; c < 3; c++) {
+		uint64_t sum = 0;
+
+		for (int b = 0; b < QOI_RESID_BINS; b++) {
+			sum += stats->resid_hist[c][b];
+		}
+
+		fprintf(fp, "  %c      ", "rgb"[c]);
+		for (int k = 0; k + 1 < (int)(sizeof(resid_edges) / sizeof(resid_edges[0])); k++) {
+			uint64_t n = 0;
+
+			for (int b = resid_edges[k]; b < resid_edges[k + 1]; b++) {
+				n += stats->resid_hist[c][b];
+			}
+			fprintf(fp, " %7.2f", sum ? n * 100.0 / sum : 0.0);
+		}
+		fprintf(fp, "\n");
+	}
+}
+
+/*************************
+@io
+@public
+@brief  ͼΪPNG(ÿŴΪQOI_STATS_BLOCK*QOI_STATS_BLOCK, ԭͼ)
+@param  stats ͳƽ(ָ)
+		path ļ·
+		img_w ͼ
+		img_h ͼ߶
+@return 
+*************************/
+int eqoi_write_heatmap(const qoi_enc_stats_t* stats, const char* path, uint32_t img_w, uint32_t img_h) {
+	if (stats->heat_bytes == NULL || img_w > INT_MAX / 3 || img_h > INT_MAX) {
+		return EQOI_ERR_ARG;
+	}
+
+	unsigned char* img = malloc((size_t)img_w * img_h * 3);
+
+	if (img == NULL) {
+		return EQOI_ERR_MEM;
+	}
+
+	for (uint32_t by = 0; by < stats->heat_h; by++) {
+		uint32_t y0 = by * QOI_STATS_BLOCK;
+		uint32_t bh = __MIN(QOI_STATS_BLOCK, img_h - y0);
+
+		for (uint32_t bx = 0; bx < stats->heat_w; bx++) {
+			uint32_t x0 = bx * QOI_STATS_BLOCK;
+			uint32_t bw = __MIN(QOI_STATS_BLOCK, img_w - x0);
+			unsigned char rgb[3];
+
+			heat_color((double)stats->heat_bytes[(size_t)by * stats->heat_w + bx] / (bw * bh), rgb);
+
+			for (uint32_t y = y0; y < y0 + bh; y++) {
+				unsigned char* p = img + ((size_t)y * img_w + x0) * 3;
+
+				for (uint32_t x = 0; x < bw; x++, p += 3) {
+					p[0] = rgb[0];
+					p[1] = rgb[1];
+					p[2] = rgb[2];
+				}
+			}
+		}
+	}
+
+	int ok = stbi_write_png(path, (int)img_w, (int)img_h, 3, img, (int)img_w * 3);
+
+	free(img);
+
+	return ok ? EQOI_OK : EQOI_ERR_IO;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@private
+@brief  ÿֽӳΪɫ(---)
+@param  bpp ÿֽ
+		rgb ɫ(׵ַ)
+@return none
+*************************/
+static void heat_color(double bpp, unsigned char* rgb) {
+	double v = bpp / HEAT_MAX_BPP * 3.0;
+
+	v = v < 0.0 ? 0.0 : v > 3.0 ? 3.0 : v;
+
+	rgb[0] = (unsigned char)(255.0 * __MIN(v, 1.0));
+	rgb[1] = (unsigned char)(255.0 * (v > 1.0 ? __MIN(v - 1.0, 1.0) : 0.0));
+	rgb[2] = (unsigned char)(255.0 * (v > 2.0 ? v - 2.0 : 0.0));
+}
@@ -0,0 +1,23 @@
+/************************************************************************************************************************
+ǿQOIĲ׮ͳ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ͳƸ͵ֽͨԤֱֵͼ, Լÿ16x16ÿֽ(ͼ)
+		׮ڱʱEQOI_STATS(gcc -DEQOI_STATS)ʱ, еĲ׮չΪ,
+		eqoi_collect_statsEQOI_ERR_UNSUPPORTED
+************************************************************************************************************************/
+
+#ifndef __EQOI_STATS_H
+#define __EQOI_STATS_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int eqoi_collect_stats(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h,
+	qoi_enc_stats_t* stats); // Բ׮ͼռͳ
+void eqoi_free_stats(qoi_enc_stats_t* stats); // ͷͳռõڴ
+void eqoi_print_stats(FILE* fp, const qoi_enc_stats_t* stats); // ӡͳƽ
+int eqoi_write_heatmap(const qoi_enc_stats_t* stats, const char* path, uint32_t img_w, uint32_t img_h); // ͼΪPNG
+
+#endif
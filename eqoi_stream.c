@@ -0,0 +1,368 @@
+/************************************************************************************************************************
+ǿQOI(out-of-core)
+@brief  дڶȡԭʼļʽ, Դ˳д
+@date   2026/10/18
+@info   ԴļΪļͷ(raw_offsetֽ)3ͨ8λ֯, ֮
+		ڴ봰֮:
+		--ֿȵͼʱ, 봰ڵڴ޾, Сڷֿ߶
+		--ֿСͼʱ, Ҫһζֿ(tile_h)
+************************************************************************************************************************/
+
+#define _FILE_OFFSET_BITS 64
+#define _POSIX_C_SOURCE 200809L
+
+#include "eqoi_stream.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// (ṹ嶨)
+typedef struct {
+	int fd; // ļ
+	unsigned char* buf; // (׵ַ)
+	size_t cap; // 
+	size_t fill; // ддֽ
+	uint64_t data_pos; // Ѳѹݳ(δдĲ)
+	uint32_t crc; // дѹݵCRC32
+	eqoi_stream_stats_t* stats; // ͳϢ(ָ)
+} out_stream_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static double now_s(void); // ȡʱ()
+static int read_full(int fd, unsigned char* buf, size_t len, uint64_t offset, eqoi_stream_stats_t* stats); // ָ
+static int write_full(int fd, const unsigned char* buf, size_t len, uint64_t offset); // дָ
+static int out_reserve(out_stream_t* out, size_t len); // ֤㹻ʣռ
+static int out_flush(out_stream_t* out); // де
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@encode
+@public
+@brief  ԭʼļ
+@param  raw_path ԭʼļ·
+		raw_offset Դļеƫ(ֽ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		out_path EQOIļ·
+		mem_limit ڴ(ֽ, 0ʾʹĬֵ)
+		stats ͳϢ(ָ, ΪNULL)
+@return (ڴ޲һлһֿʱEQOI_ERR_MEM; ʱɾдĲļ)
+*************************/
+int eqoi_encode_raw_file(const char* raw_path, uint64_t raw_offset, uint32_t img_w, uint32_t img_h,
+	uint32_t tile_w, uint32_t tile_h, const char* out_path, size_t mem_limit, eqoi_stream_stats_t* stats) {
+	eqoi_stream_stats_t local_stats;
+	double t_start = now_s();
+
+	if (stats == NULL) {
+		stats = &local_stats;
+	}
+	memset(stats, 0, sizeof(eqoi_stream_stats_t));
+
+	if (!img_w || !img_h) {
+		return EQOI_ERR_ARG;
+	}
+	if (tile_w && tile_h && eqoi_tile_count(img_w, img_h, tile_w, tile_h) >= UINT32_MAX) {
+		return EQOI_ERR_ARG;
+	}
+	if (!mem_limit) {
+		mem_limit = EQOI_STREAM_DEFAULT_MEM;
+	}
+
+	eqoi_header_t hdr;
+	eqoi_init_header(&hdr, img_w, img_h, tile_w, tile_h);
+
+	uint32_t tiles_x = (img_w + hdr.tile_w - 1) / hdr.tile_w;
+	size_t row_bytes = (size_t)img_w * 3;
+	size_t line_bytes = eqoi_scratch_size(hdr.tile_w); // ݴ(л)
+	uint32_t win_rows;
+	size_t in_cap, out_cap;
+
+	// 봰֮ڴ
+	if (tiles_x == 1) {
+		size_t per_row = row_bytes + (size_t)img_w * 4;
+
+		// ڴҪһ뼰ȵ
+		if (line_bytes + per_row > mem_limit) {
+			return EQOI_ERR_MEM;
+		}
+
+		size_t avail = mem_limit - line_bytes;
+
+		win_rows = (uint32_t)__MIN(avail / per_row, (size_t)hdr.tile_h);
+		in_cap = win_rows * row_bytes;
+		out_cap = avail - in_cap;
+	}
+	else {
+		size_t tile_out = (size_t)hdr.tile_w * hdr.tile_h * 4;
+
+		win_rows = hdr.tile_h;
+		in_cap = win_rows * row_bytes;
+
+		if (in_cap + tile_out + line_bytes > mem_limit) {
+			return EQOI_ERR_MEM;
+		}
+
+		out_cap = mem_limit - in_cap - line_bytes;
+	}
+
+	int ret = EQOI_OK;
+	int fd_in = open(raw_path, O_RDONLY);
+	int fd_out = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	unsigned char* inbuf = malloc(in_cap);
+	uint64_t* offsets = malloc(((size_t)hdr.tile_cnt + 1) * sizeof(uint64_t));
+	unsigned char* hdr_buf = malloc((size_t)hdr.data_offset);
+	unsigned char* scratch = malloc(line_bytes);
+	out_stream_t out = { fd_out, malloc(out_cap), out_cap, 0, 0, 0, stats };
+
+	if (fd_in < 0 || fd_out < 0) {
+		ret = EQOI_ERR_IO;
+		goto done;
+	}
+	if (inbuf == NULL || offsets == NULL || hdr_buf == NULL || scratch == NULL || out.buf == NULL) {
+		ret = EQOI_ERR_MEM;
+		goto done;
+	}
+
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(fd_in, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+	// ѹݽļͷƫƱ֮, ļͷڱ
+	if (lseek(fd_out, (off_t)hdr.data_offset, SEEK_SET) < 0) {
+		ret = EQOI_ERR_IO;
+		goto done;
+	}
+
+	stats->mem_used = in_cap + out_cap + line_bytes;
+	stats->window_rows = win_rows;
+
+	uint32_t tile_i = 0;
+
+	for (uint32_t band_y = 0; band_y < img_h && ret == EQOI_OK; band_y += hdr.tile_h) {
+		uint32_t band_rows = __MIN(hdr.tile_h, img_h - band_y);
+
+		if (tiles_x == 1) {
+			// ֿ鸲: ڶȡ, 細ڱ״̬
+			qoi_encoder_t enc;
+
+			if (!enhanced_qoi_encoder_init_scratch(&enc, img_w, band_rows, scratch)) {
+				ret = EQOI_ERR_MEM;
+				break;
+			}
+
+			offsets[tile_i++] = out.data_pos;
+
+			for (uint32_t r = 0; r < band_rows; r += win_rows) {
+				uint32_t n = __MIN(win_rows, band_rows - r);
+
+				ret = read_full(fd_in, inbuf, n * row_bytes, raw_offset + (uint64_t)(band_y + r) * row_bytes, stats);
+				if (ret == EQOI_OK) {
+					ret = out_reserve(&out, (size_t)n * img_w * 4);
+				}
+				if (ret != EQOI_OK) {
+					break;
+				}
+
+				double t0 = now_s();
+				size_t len = enhanced_qoi_encode_rows(&enc, inbuf, row_bytes, n, out.buf + out.fill);
+				stats->compute_s += now_s() - t0;
+
+				out.fill += len;
+				out.data_pos += len;
+			}
+
+			enhanced_qoi_encoder_free(&enc);
+		}
+		else {
+			// ֿ: һζtile_h, αڵĸֿ
+			ret = read_full(fd_in, inbuf, band_rows * row_bytes, raw_offset + (uint64_t)band_y * row_bytes, stats);
+
+			for (uint32_t tx = 0; tx < tiles_x && ret == EQOI_OK; tx++) {
+				uint32_t x = tx * hdr.tile_w;
+				uint32_t w = __MIN(hdr.tile_w, img_w - x);
+
+				ret = out_reserve(&out, (size_t)w * band_rows * 4);
+				if (ret != EQOI_OK) {
+					break;
+				}
+
+				double t0 = now_s();
+				size_t len = enhanced_qoi_encode_rect_scratch(inbuf + (size_t)x * 3, row_bytes, out.buf + out.fill, w, band_rows, scratch);
+				stats->compute_s += now_s() - t0;
+
+				offsets[tile_i++] = out.data_pos;
+				out.fill += len;
+				out.data_pos += len;
+			}
+		}
+	}
+
+	if (ret == EQOI_OK) {
+		ret = out_flush(&out);
+	}
+
+	if (ret == EQOI_OK) {
+		offsets[hdr.tile_cnt] = out.data_pos;
+
+		hdr.data_len = out.data_pos;
+		hdr.data_crc = out.crc;
+		hdr.flags |= EQOI_FLAG_DATA_CRC;
+
+		eqoi_write_header(hdr_buf, &hdr, offsets);
+
+		double t0 = now_s();
+		ret = write_full(fd_out, hdr_buf, (size_t)hdr.data_offset, 0);
+		stats->write_s += now_s() - t0;
+		stats->bytes_written += hdr.data_offset;
+	}
+
+done:
+	if (fd_in >= 0) {
+		close(fd_in);
+	}
+	if (fd_out >= 0 && close(fd_out) != 0 && ret == EQOI_OK) {
+		ret = EQOI_ERR_IO;
+	}
+	if (fd_out >= 0 && ret != EQOI_OK) {
+		unlink(out_path); // ļͷδĲ
+	}
+
+	free(inbuf);
+	free(offsets);
+	free(hdr_buf);
+	free(scratch);
+	free(out.buf);
+
+	stats->total_s = now_s() - t_start;
+
+	return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@io
+@private
+@brief  ֤㹻ʣռ(ʱд)
+@param  out (ָ)
+		len Ҫʣռ
+@return 
+*************************/
+static int out_reserve(out_stream_t* out, size_t len) {
+	if (out->cap - out->fill >= len) {
+		return EQOI_OK;
+	}
+
+	return out_flush(out);
+}
+
+/*************************
+@io
+@private
+@brief  де(˳д)
+@param  out (ָ)
+@return 
+*************************/
+static int out_flush(out_stream_t* out) {
+	if (!out->fill) {
+		return EQOI_OK;
+	}
+
+	double t0 = now_s();
+	out->crc = eqoi_crc32(out->crc, out->buf, out->fill);
+	double t1 = now_s();
+
+	int ret = write_full(out->fd, out->buf, out->fill, (uint64_t)-1);
+	double t2 = now_s();
+
+	out->stats->compute_s += t1 - t0;
+	out->stats->write_s += t2 - t1;
+	out->stats->bytes_written += out->fill;
+	out->fill = 0;
+
+	return ret;
+}
+
+/*************************
+@io
+@private
+@brief  ָ
+@param  fd ļ
+		buf (ָ)
+		len 
+		offset ļƫ
+		stats ͳϢ(ָ)
+@return 
+*************************/
+static int read_full(int fd, unsigned char* buf, size_t len, uint64_t offset, eqoi_stream_stats_t* stats) {
+	double t0 = now_s();
+
+	while (len) {
+		ssize_t n = pread(fd, buf, len, (off_t)offset);
+
+		if (n <= 0) {
+			stats->read_s += now_s() - t0;
+
+			return n == 0 ? EQOI_ERR_TRUNC : EQOI_ERR_IO;
+		}
+
+		buf += n;
+		len -= (size_t)n;
+		offset += (uint64_t)n;
+		stats->bytes_read += (uint64_t)n;
+	}
+
+	stats->read_s += now_s() - t0;
+
+	return EQOI_OK;
+}
+
+/*************************
+@io
+@private
+@brief  дָ
+@param  fd ļ
+		buf (ָ)
+		len 
+		offset ļƫ((uint64_t)-1ʱڵǰλ˳д)
+@return 
+*************************/
+static int write_full(int fd, const unsigned char* buf, size_t len, uint64_t offset) {
+	while (len) {
+		ssize_t n = offset == (uint64_t)-1 ? write(fd, buf, len) : pwrite(fd, buf, len, (off_t)offset);
+
+		if (n <= 0) {
+			return EQOI_ERR_IO;
+		}
+
+		buf += n;
+		len -= (size_t)n;
+		if (offset != (uint64_t)-1) {
+			offset += (uint64_t)n;
+		}
+	}
+
+	return EQOI_OK;
+}
+
+/*************************
+@calc
+@private
+@brief  ȡʱ
+@param  none
+@return ʱ()
+*************************/
+static double now_s(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
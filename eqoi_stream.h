@@ -0,0 +1,37 @@
+/************************************************************************************************************************
+ǿQOI(out-of-core)
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ԭʼļадڶȡ(pread)б, Դ˳дEQOIļ,
+		ڴռýȡڸڴ, ͼߴ޹(POSIXļӿ)
+************************************************************************************************************************/
+
+#ifndef __EQOI_STREAM_H
+#define __EQOI_STREAM_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_STREAM_DEFAULT_MEM (64u << 20) // Ĭϵڴ(ֽ)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ͳ(ṹ嶨)
+typedef struct {
+	double read_s; // Դļʱ()
+	double write_s; // дļʱ()
+	double compute_s; // CRCʱ()
+	double total_s; // ܺʱ()
+	uint64_t bytes_read; // ȡֽ
+	uint64_t bytes_written; // дֽ
+	size_t mem_used; // ʵʷĻС(ֽ)
+	uint32_t window_rows; // ÿζȡ
+} eqoi_stream_stats_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int eqoi_encode_raw_file(const char* raw_path, uint64_t raw_offset, uint32_t img_w, uint32_t img_h,
+	uint32_t tile_w, uint32_t tile_h, const char* out_path, size_t mem_limit, eqoi_stream_stats_t* stats); // ԭʼļ
+
+#endif
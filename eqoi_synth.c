@@ -0,0 +1,374 @@
+/************************************************************************************************************************
+ǿQOIĺϳɲͼ
+@brief  ȷ㷨
+@date   2026/10/18
+@info   ֻʹԴα(xorshift32), ƽ̨ͱ޹
+		ذb,g,r˳д, һ
+************************************************************************************************************************/
+
+#include "eqoi_synth.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define UI_PALETTE_L 8 // ͼĵɫ峤
+#define PHOTO_OCTAVES 4 // Ƭֵĳ߶ȸ
+#define PHOTO_CELL 256 // Ƭֵ߶ȵĸ()
+#define PHOTO_NOISE 3 // Ƭķֵ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char* synth_names[EQOI_SYNTH_CNT] = { "ui", "photo", "noise", "gradient", "flat" }; // 
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t rng_next(uint32_t* state); // һα
+static uint32_t hash2(uint32_t x, uint32_t y, uint32_t seed); // Ĺϣ
+static int value_noise(uint32_t x, uint32_t y, uint32_t cell, uint32_t seed); // άֵ
+static void fill_rect(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+	const unsigned char* bgr); // 
+static void gen_ui(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng); // ɽͼ
+static void gen_photo(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t seed, uint32_t* rng); // Ƭ
+static void gen_noise(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng); // ɾ
+static void gen_gradient(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng); // ɽ
+static void gen_flat(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng); // ɴɫ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  ȡ
+@param  cls (EQOI_SYNTH_*)
+@return 
+*************************/
+const char* eqoi_synth_name(int cls) {
+	return (cls >= 0 && cls < EQOI_SYNTH_CNT) ? synth_names[cls] : "?";
+}
+
+/*************************
+@parse
+@public
+@brief  Ʋ
+@param  name 
+@return (δҵ-1)
+*************************/
+int eqoi_synth_class(const char* name) {
+	for (int i = 0; i < EQOI_SYNTH_CNT; i++) {
+		if (!strcmp(name, synth_names[i])) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*************************
+@run
+@public
+@brief  һϳͼ
+@param  cls (EQOI_SYNTH_*)
+		img_w ͼ
+		img_h ͼ߶
+		seed 
+		prgb ػ(ָ, img_w*img_h*3ֽ)
+@return Ƿɹ
+*************************/
+_Bool eqoi_synth_image(int cls, uint32_t img_w, uint32_t img_h, uint32_t seed, unsigned char* prgb) {
+	uint32_t rng = seed * 2654435761u + 0x9e3779b9u;
+
+	if (!img_w || !img_h || img_w > EQOI_SYNTH_MAX_SIZE || img_h > EQOI_SYNTH_MAX_SIZE) {
+		return 0;
+	}
+
+	if (!rng) {
+		rng = 1;
+	}
+
+	switch (cls) {
+	case EQOI_SYNTH_UI: gen_ui(prgb, img_w, img_h, &rng); break;
+	case EQOI_SYNTH_PHOTO: gen_photo(prgb, img_w, img_h, seed, &rng); break;
+	case EQOI_SYNTH_NOISE: gen_noise(prgb, img_w, img_h, &rng); break;
+	case EQOI_SYNTH_GRADIENT: gen_gradient(prgb, img_w, img_h, &rng); break;
+	case EQOI_SYNTH_FLAT: gen_flat(prgb, img_w, img_h, &rng); break;
+	default: return 0;
+	}
+
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@private
+@brief  һα(xorshift32)
+@param  state ״̬(ָ, Ϊ0)
+@return α
+*************************/
+static uint32_t rng_next(uint32_t* state) {
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/*************************
+@calc
+@private
+@brief  Ĺϣ(ֵĸֵ)
+@param  x 
+		y 
+		seed 
+@return ϣֵ
+*************************/
+static uint32_t hash2(uint32_t x, uint32_t y, uint32_t seed) {
+	uint32_t h = x * 0x8da6b343u ^ y * 0xd8163841u ^ seed * 0xcb1ab31fu;
+
+	h ^= h >> 15;
+	h *= 0x2c1b3c6du;
+	h ^= h >> 12;
+	h *= 0x297a2d39u;
+	h ^= h >> 15;
+
+	return h;
+}
+
+/*************************
+@calc
+@private
+@brief  (ͼĲֱü)
+@param  prgb ػ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		x ϽǺ
+		y Ͻ
+		w 
+		h ߶
+		bgr ɫ(׵ַ, b,g,r˳)
+@return none
+*************************/
+static void fill_rect(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+	const unsigned char* bgr) {
+	if (x >= img_w || y >= img_h) {
+		return;
+	}
+
+	w = __MIN(w, img_w - x);
+	h = __MIN(h, img_h - y);
+
+	for (uint32_t j = y; j < y + h; j++) {
+		unsigned char* p = prgb + ((size_t)j * img_w + x) * 3;
+
+		for (uint32_t i = 0; i < w; i++, p += 3) {
+			p[0] = bgr[0];
+			p[1] = bgr[1];
+			p[2] = bgr[2];
+		}
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  ɽͼ(ڡ߿򡢰ť״ʻ)
+@param  prgb ػ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		rng ״̬(ָ)
+@return none
+*************************/
+static void gen_ui(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng) {
+	unsigned char palette[UI_PALETTE_L][3];
+
+	for (int i = 0; i < UI_PALETTE_L; i++) {
+		uint32_t v = rng_next(rng);
+
+		palette[i][0] = (unsigned char)v;
+		palette[i][1] = (unsigned char)(v >> 8);
+		palette[i][2] = (unsigned char)(v >> 16);
+	}
+	// Ϊǳɫ, Ϊɫ
+	memset(palette[0], 0xf0, 3);
+	memset(palette[1], 0x20, 3);
+
+	fill_rect(prgb, img_w, img_h, 0, 0, img_w, img_h, palette[0]);
+
+	uint32_t area = (uint32_t)__MIN((uint64_t)img_w * img_h, (uint64_t)1 << 30);
+	uint32_t windows = 3 + area / (256 * 192);
+
+	for (uint32_t k = 0; k < windows; k++) {
+		uint32_t w = 32 + rng_next(rng) % __MAX(img_w / 2, 1);
+		uint32_t h = 24 + rng_next(rng) % __MAX(img_h / 2, 1);
+		uint32_t x = rng_next(rng) % (img_w - __MIN(w, img_w) / 2);
+		uint32_t y = rng_next(rng) % (img_h - __MIN(h, img_h) / 2);
+		const unsigned char* body = palette[2 + rng_next(rng) % (UI_PALETTE_L - 2)];
+		const unsigned char* title = palette[2 + rng_next(rng) % (UI_PALETTE_L - 2)];
+
+		// ߿, , 
+		fill_rect(prgb, img_w, img_h, x, y, w, h, palette[1]);
+		fill_rect(prgb, img_w, img_h, x + 1, y + 1, w - 2, h - 2, body);
+		fill_rect(prgb, img_w, img_h, x + 1, y + 1, w - 2, 12, title);
+
+		// ť
+		fill_rect(prgb, img_w, img_h, x + w - 40, y + h - 14, 32, 10, palette[0]);
+
+		// : ÿɸ, ÿΪ5x7ڵʻ
+		for (uint32_t ty = y + 18; ty + 8 < y + h - 16; ty += 10) {
+			for (uint32_t tx = x + 4; tx + 6 < x + w - 4; tx += 6) {
+				uint32_t glyph = rng_next(rng);
+
+				if ((glyph & 7) == 0) {
+					continue; // ո
+				}
+
+				for (uint32_t gy = 0; gy < 7; gy++) {
+					for (uint32_t gx = 0; gx < 5; gx++) {
+						if (((glyph >> ((gy * 5 + gx) % 29)) & 3) == 3) {
+							fill_rect(prgb, img_w, img_h, tx + gx, ty + gy, 1, 1, palette[1]);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  άֵ(ֵɹϣ, ֮˫Բֵ)
+@param  x 
+		y 
+		cell ()
+		seed 
+@return ֵ(0~255)
+*************************/
+static int value_noise(uint32_t x, uint32_t y, uint32_t cell, uint32_t seed) {
+	uint32_t gx = x / cell, gy = y / cell;
+	int64_t fx = x % cell, fy = y % cell;
+	int64_t v00 = hash2(gx, gy, seed) & 0xff;
+	int64_t v10 = hash2(gx + 1, gy, seed) & 0xff;
+	int64_t v01 = hash2(gx, gy + 1, seed) & 0xff;
+	int64_t v11 = hash2(gx + 1, gy + 1, seed) & 0xff;
+
+	int64_t top = v00 * (cell - fx) + v10 * fx;
+	int64_t bottom = v01 * (cell - fx) + v11 * fx;
+
+	return (int)((top * (cell - fy) + bottom * fy) / ((int64_t)cell * cell));
+}
+
+/*************************
+@calc
+@private
+@brief  Ƭ(߶ֵΪ, ƵֵΪͨɫ, ٵ΢Ĵ)
+@param  prgb ػ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		seed 
+		rng ״̬(ָ)
+@return none
+*************************/
+static void gen_photo(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t seed, uint32_t* rng) {
+	for (uint32_t y = 0; y < img_h; y++) {
+		unsigned char* p = prgb + (size_t)y * img_w * 3;
+
+		for (uint32_t x = 0; x < img_w; x++, p += 3) {
+			int lum = 0;
+			uint32_t cell = PHOTO_CELL;
+
+			// ߶ȵķֵμ: 128 + 64 + 32 + 16
+			for (int o = 0; o < PHOTO_OCTAVES; o++) {
+				lum += value_noise(x, y, cell, seed * 8 + o) >> (o + 1);
+				cell /= 4;
+			}
+
+			for (int c = 0; c < 3; c++) {
+				int tint = (value_noise(x, y, PHOTO_CELL * 2, seed * 8 + 4 + c) >> 2) - 32;
+				int v = lum + tint + (int)(rng_next(rng) % (2 * PHOTO_NOISE + 1)) - PHOTO_NOISE;
+
+				v = v * 255 / 240;
+				p[c] = (unsigned char)(v < 0 ? 0 : v > 255 ? 255 : v);
+			}
+		}
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  ɾ
+@param  prgb ػ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		rng ״̬(ָ)
+@return none
+*************************/
+static void gen_noise(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng) {
+	size_t len = (size_t)img_w * img_h * 3;
+
+	for (size_t i = 0; i < len; i++) {
+		prgb[i] = (unsigned char)(rng_next(rng) >> 24);
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  ɽ(rˮƽ, gشֱ, bضԽ߷, ֹɫ)
+@param  prgb ػ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		rng ״̬(ָ)
+@return none
+*************************/
+static void gen_gradient(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng) {
+	int r0 = rng_next(rng) & 0xff, r1 = rng_next(rng) & 0xff;
+	int g0 = rng_next(rng) & 0xff, g1 = rng_next(rng) & 0xff;
+	int b0 = rng_next(rng) & 0xff, b1 = rng_next(rng) & 0xff;
+	uint64_t diag = (uint64_t)img_w + img_h;
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		unsigned char* p = prgb + (size_t)y * img_w * 3;
+		int g = g0 + (int)((int64_t)(g1 - g0) * y / img_h);
+
+		for (uint32_t x = 0; x < img_w; x++, p += 3) {
+			p[0] = (unsigned char)(b0 + (int)((int64_t)(b1 - b0) * (x + y) / (int64_t)diag));
+			p[1] = (unsigned char)g;
+			p[2] = (unsigned char)(r0 + (int)((int64_t)(r1 - r0) * x / img_w));
+		}
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  ɴɫ(ɫɸĴɫ)
+@param  prgb ػ(ָ)
+		img_w ͼ
+		img_h ͼ߶
+		rng ״̬(ָ)
+@return none
+*************************/
+static void gen_flat(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t* rng) {
+	unsigned char bgr[3];
+	uint32_t v = rng_next(rng);
+
+	bgr[0] = (unsigned char)v;
+	bgr[1] = (unsigned char)(v >> 8);
+	bgr[2] = (unsigned char)(v >> 16);
+	fill_rect(prgb, img_w, img_h, 0, 0, img_w, img_h, bgr);
+
+	for (int k = 0; k < 4; k++) {
+		v = rng_next(rng);
+		bgr[0] = (unsigned char)v;
+		bgr[1] = (unsigned char)(v >> 8);
+		bgr[2] = (unsigned char)(v >> 16);
+
+		fill_rect(prgb, img_w, img_h, rng_next(rng) % img_w, rng_next(rng) % img_h,
+			img_w / 4 + rng_next(rng) % (img_w / 2 + 1), img_h / 4 + rng_next(rng) % (img_h / 2 + 1), bgr);
+	}
+}
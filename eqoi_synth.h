@@ -0,0 +1,36 @@
+/************************************************************************************************************************
+ǿQOIĺϳɲͼ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ȷԵɲͼ(ͬ𡢳ߴֽͬͼ), ڰѹ:
+		--ui       ͼ: ɫڡ߿򡢰ť״ʻ, ɫɫ
+		--photo    Ƭ: ߶ȵƽֵ, ټ΢Ĵ
+		--noise    : ȫΪQOI_OP_RGB
+		--gradient : ˮƽ/ֱ/ԽԽ, DIFFΪ
+		--flat     ɫ: ȫΪQOI_OP_RUN
+************************************************************************************************************************/
+
+#ifndef __EQOI_SYNTH_H
+#define __EQOI_SYNTH_H
+
+#include "main.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 
+#define EQOI_SYNTH_UI 0 // ͼ
+#define EQOI_SYNTH_PHOTO 1 // Ƭ
+#define EQOI_SYNTH_NOISE 2 // 
+#define EQOI_SYNTH_GRADIENT 3 // 
+#define EQOI_SYNTH_FLAT 4 // ɫ
+#define EQOI_SYNTH_CNT 5 // 
+
+#define EQOI_SYNTH_MAX_SIZE 16384 // ߳(16K)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* eqoi_synth_name(int cls); // ȡ
+int eqoi_synth_class(const char* name); // Ʋ(δҵ-1)
+_Bool eqoi_synth_image(int cls, uint32_t img_w, uint32_t img_h, uint32_t seed, unsigned char* prgb); // һϳͼ
+
+#endif
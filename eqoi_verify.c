@@ -0,0 +1,192 @@
+/************************************************************************************************************************
+ǿQOIнУ
+@brief  (ֿ)벢οбȽ, ׸һµмֹͣ
+@date   2026/10/18
+************************************************************************************************************************/
+
+#include "eqoi_verify.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int verify_med(const unsigned char* file, const eqoi_header_t* hdr, eqoi_ref_row_fn ref_row, void* ctx,
+	eqoi_verify_result_t* res); // 8λRGB MEDн벢Ƚ
+static int verify_tiles(const unsigned char* file, const eqoi_header_t* hdr, eqoi_ref_row_fn ref_row, void* ctx,
+	eqoi_verify_result_t* res); // ֿн벢Ƚ
+static int compare_row(const unsigned char* row, uint32_t y, size_t row_len, size_t px_size, eqoi_ref_row_fn ref_row,
+	void* ctx, eqoi_verify_result_t* res); // Ƚһ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  УĽ뻺С(8λRGBMEDΪ, Ϊһֿиߵ, ֿʱͼ)
+@param  hdr ļͷ(ָ)
+@return С(ֽ)
+*************************/
+size_t eqoi_verify_buf_size(const eqoi_header_t* hdr) {
+	size_t row_len = (size_t)hdr->width * eqoi_pixel_size(hdr);
+
+	return hdr->pixel_fmt == EQOI_FMT_RGB8 && hdr->codec == EQOI_CODEC_MED ? row_len * 2 : row_len * hdr->tile_h;
+}
+
+/*************************
+@check
+@public
+@brief  н벢οͼȽ(׸һµмֹͣ, УCRC32)
+@info   ֻ8λRGBMEDн, ֻռ; ɫ塢λҶ뽥ģʽ, ÿλһ
+		ֿ(ֿ򽥽ģʽʱΪͼ), Сeqoi_verify_buf_size
+@param  file ļ(ָ)
+		hdr ļͷ(ָ, ֧YUV, ֵʱeqoi_use_dictֵָ)
+		ref_row ȡοеĺ(y = 0, 1, ...˳, һºٵ)
+		ctx ref_rowĲ(ָ)
+		res У(ָ)
+@return (οһʱԷEQOI_OK, res->match; οжȡʧʱEQOI_ERR_IO)
+*************************/
+int eqoi_verify_rows(const unsigned char* file, const eqoi_header_t* hdr, eqoi_ref_row_fn ref_row, void* ctx,
+	eqoi_verify_result_t* res) {
+	if (ref_row == NULL || EQOI_FMT_IS_YUV(hdr->pixel_fmt)) {
+		return EQOI_ERR_ARG;
+	}
+
+	res->match = 1;
+	res->x = 0;
+	res->y = 0;
+	res->rows = 0;
+
+	if (hdr->pixel_fmt == EQOI_FMT_RGB8 && hdr->codec == EQOI_CODEC_MED) {
+		return verify_med(file, hdr, ref_row, ctx, res);
+	}
+
+	return verify_tiles(file, hdr, ref_row, ctx, res);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@check
+@private
+@brief  8λRGB MEDн벢Ƚ(ֿеķֿһ, 뵽ȫл)
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+		ref_row ȡοеĺ
+		ctx ref_rowĲ(ָ)
+		res У(ָ)
+@return 
+*************************/
+static int verify_med(const unsigned char* file, const eqoi_header_t* hdr, eqoi_ref_row_fn ref_row, void* ctx,
+	eqoi_verify_result_t* res) {
+	size_t row_len = (size_t)hdr->width * 3;
+	uint32_t tiles_x = (hdr->width + hdr->tile_w - 1) / hdr->tile_w;
+	unsigned char* rows = malloc(eqoi_verify_buf_size(hdr));
+	qoi_decoder_t* decs = malloc(tiles_x * sizeof(qoi_decoder_t));
+	int err = rows == NULL || decs == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (uint32_t i = 0; i < hdr->tile_cnt && err == EQOI_OK && res->match; i += tiles_x) {
+		uint32_t rx, ry, rw, rh;
+		uint32_t opened = 0;
+
+		while (opened < tiles_x && err == EQOI_OK) {
+			err = eqoi_open_tile(file, hdr, i + opened, &decs[opened]);
+			opened += err == EQOI_OK;
+		}
+
+		eqoi_tile_rect(hdr, i, &rx, &ry, &rw, &rh);
+
+		for (uint32_t y = ry; y < ry + rh && err == EQOI_OK && res->match; y++) {
+			unsigned char* row = rows + (y & 1) * row_len;
+
+			for (uint32_t t = 0; t < tiles_x; t++) {
+				enhanced_qoi_decode_rows(&decs[t], row + (size_t)t * hdr->tile_w * 3, row_len, 1);
+			}
+
+			err = compare_row(row, y, row_len, 3, ref_row, ctx, res);
+		}
+
+		// ʧܵķֿδʼ, ֻѴ򿪵Ľ
+		for (uint32_t t = 0; t < opened; t++) {
+			enhanced_qoi_decoder_free(&decs[t]);
+		}
+	}
+
+	free(rows);
+	free(decs);
+
+	return err;
+}
+
+/*************************
+@check
+@private
+@brief  ֿ뵽һֿиߵ, бȽ(ֿļ뽥ģʽͼ)
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+		ref_row ȡοеĺ
+		ctx ref_rowĲ(ָ)
+		res У(ָ)
+@return 
+*************************/
+static int verify_tiles(const unsigned char* file, const eqoi_header_t* hdr, eqoi_ref_row_fn ref_row, void* ctx,
+	eqoi_verify_result_t* res) {
+	size_t px_size = eqoi_pixel_size(hdr);
+	size_t row_len = (size_t)hdr->width * px_size;
+	uint32_t tiles_x = (hdr->width + hdr->tile_w - 1) / hdr->tile_w;
+	unsigned char* strip = malloc(eqoi_verify_buf_size(hdr));
+	int err = strip == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (uint32_t i = 0; i < hdr->tile_cnt && err == EQOI_OK && res->match; i += tiles_x) {
+		uint32_t rx, ry, rw, rh;
+
+		for (uint32_t t = 0; t < tiles_x && err == EQOI_OK; t++) {
+			err = eqoi_decode_tile(file, hdr, i + t, strip + (size_t)t * hdr->tile_w * px_size, row_len);
+		}
+
+		eqoi_tile_rect(hdr, i, &rx, &ry, &rw, &rh);
+
+		for (uint32_t r = 0; r < rh && err == EQOI_OK && res->match; r++) {
+			err = compare_row(strip + (size_t)r * row_len, ry + r, row_len, px_size, ref_row, ctx, res);
+		}
+	}
+
+	free(strip);
+
+	return err;
+}
+
+/*************************
+@check
+@private
+@brief  Ƚһ(ֻͬһmemcmp, ͬʱλ׸ͬ)
+@param  row õ(ָ)
+		y к
+		row_len г(ֽ)
+		px_size ÿصֽ
+		ref_row ȡοеĺ
+		ctx ref_rowĲ(ָ)
+		res У(ָ)
+@return 
+*************************/
+static int compare_row(const unsigned char* row, uint32_t y, size_t row_len, size_t px_size, eqoi_ref_row_fn ref_row,
+	void* ctx, eqoi_verify_result_t* res) {
+	const unsigned char* ref = ref_row(ctx, y);
+
+	if (ref == NULL) {
+		return EQOI_ERR_IO;
+	}
+
+	res->rows++;
+
+	if (memcmp(row, ref, row_len)) {
+		size_t i = 0;
+
+		while (row[i] == ref[i]) {
+			i++;
+		}
+
+		res->match = 0;
+		res->x = (uint32_t)(i / px_size);
+		res->y = y;
+	}
+
+	return EQOI_OK;
+}
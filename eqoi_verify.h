@@ -0,0 +1,41 @@
+/************************************************************************************************************************
+ǿQOIнУ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   οͼȽҪΪͲοһͼ, Ƚʱٰһ; Уÿ
+		һоοͼĶӦбȽ, һһ¼ֹͣ
+		ڴֻ8λRGBMED޹; ɫ塢λ(9~16λ)Ҷ(Ҷ+͸CFA)뽥ģʽ
+		ֻ, 뻺ķֿ, ֿļͼ:
+		8λRGBMED  ֿеķֿһ, 뵽ȫл(ͬeqoi_scale.h),
+						 ֻռ
+		ʽ    ֿ뵽һֿиߵбȽ; ģʽֻһֿ(
+						 ͼ), ҪڴʱӦ-tֿ(ģʽ), 뻺ĴС
+						 eqoi_verify_buf_sizeѯ
+		οɵ߰ṩ(Դļʽȡ), ÿmemcmpȽ(CmemcmpCPUָ
+		ʵ, ͬвرȽ), һʱٶλ׸ͬ; ֧YUV
+************************************************************************************************************************/
+
+#ifndef __EQOI_VERIFY_H
+#define __EQOI_VERIFY_H
+
+#include "eqoi_container.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef const unsigned char* (*eqoi_ref_row_fn)(void* ctx, uint32_t y); // ȡοͼĵy(, ͬ, NULLʾȡʧ)
+
+// УĽ(ṹ嶨)
+typedef struct {
+	_Bool match; // οһ(־)
+	uint32_t x; // ׸ͬصĺ
+	uint32_t y; // ׸ͬص
+	uint32_t rows; // ѱȽϵ
+} eqoi_verify_result_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t eqoi_verify_buf_size(const eqoi_header_t* hdr); // УĽ뻺С
+int eqoi_verify_rows(const unsigned char* file, const eqoi_header_t* hdr, eqoi_ref_row_fn ref_row, void* ctx,
+	eqoi_verify_result_t* res); // н벢οͼȽ(ֻ8λRGBMEDֻ, 建ֿ)
+
+#endif
@@ -0,0 +1,732 @@
+/************************************************************************************************************************
+ǿQOIĸλ
+@brief  uint16_t10/12/16λͼ, MEDԤ7ֱ, ֶΰλӿ
+@date   2026/10/18
+@info   (WIDE_BLOCK)ԤȼεMEDԤ: ʱ//֪ԭʼ, ûд,
+		16λͨÿδ8/16/32(SSE2/AVX2/AVX-512, eqoi_cpu_tier; SSE2޷űȽͨ0x8000
+		תΪзűȽ, SSE4.1ֱʹ޷min/max), ƽ̨ʹõȼ۵ı;
+		֮γ//ѡؽ, 8λͬ
+		һ, Ԥر, ֱӶȡ뻺е//
+		ɫģʽͬ, ֻʹջϵĶ, ڴ
+************************************************************************************************************************/
+
+#include "eqoi_wide.h"
+#include "eqoi_cpu.h"
+
+#ifdef EQOI_X86
+#include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define WIDE_BLOCK 256 // ÿԤȼԤظ
+#define WIDE_MAX_RUN 31 // γ̳(8λͬ)
+#define WIDE_COLOR_HASH(C) (C.r + C.g + C.b) // ϣ(8λͬ)
+
+// ͱ־(8λͬ)
+#define WIDE_OP_INDEX 0x00 /* 000xxxxx */
+#define WIDE_OP_DIFF3 0x20 /* 001xxxxx */
+#define WIDE_OP_DIFF 0x40 /* 01xxxxxx */
+#define WIDE_OP_LUMA 0x80 /* 10xxxxxx */
+#define WIDE_OP_DIFF2 0xc0 /* 110xxxxx */
+#define WIDE_OP_RUN 0xe0 /* 111xxxxx */
+#define WIDE_OP_RGB 0xff /* 11111111 */
+
+#define WIDE_MASK_2 0xc0 /* 11000000 */
+#define WIDE_MASK_3 0xe0 /* 11100000 */
+
+// wide_opsеı
+#define WIDE_DIFF 0
+#define WIDE_DIFF3 1
+#define WIDE_LUMA 2
+#define WIDE_DIFF2 3
+#define WIDE_RGB 4
+
+// ͵Ĳ(ṹ嶨)
+typedef struct {
+	unsigned char tag; // ֽеı־
+	unsigned char tag_bits; // ־λ
+	unsigned char base; // 8λеֽ
+	unsigned char w[3]; // 3ֶ8λеλ(˳)
+	unsigned char id; // ͱ(QOI_ID_*)
+} wide_op_t;
+
+static const wide_op_t wide_ops[] = {
+	{ WIDE_OP_DIFF, 2, 1, { 2, 2, 2 }, QOI_ID_DIFF }, // vr vg vb
+	{ WIDE_OP_DIFF3, 3, 2, { 5, 4, 4 }, QOI_ID_DIFF3 }, // vg vr vb
+	{ WIDE_OP_LUMA, 2, 2, { 6, 4, 4 }, QOI_ID_LUMA }, // vg vr-vg vb-vg
+	{ WIDE_OP_DIFF2, 3, 3, { 7, 7, 7 }, QOI_ID_DIFF2 }, // vr vg vb
+	{ WIDE_OP_RGB, 8, 4, { 8, 8, 8 }, QOI_ID_RGB } // r g b
+};
+
+typedef size_t (*wide_resid_fn)(const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end, int bit_depth,
+	int16_t* resid); // ɿԤں(δ׸λ)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void wide_resid(wide_resid_fn kern, const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid); // һβԤ
+#ifdef EQOI_X86
+static EQOI_TARGET("sse2") size_t resid_sse2(const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid); // ɿԤ(SSE2)
+static EQOI_TARGET("sse4.1") size_t resid_sse41(const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid); // ɿԤ(SSE4.1)
+static EQOI_TARGET("avx2") size_t resid_avx2(const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid); // ɿԤ(AVX2)
+static EQOI_TARGET("avx512f,avx512bw") size_t resid_avx512(const uint16_t* prow, const uint16_t* up, size_t k,
+	size_t k_end, int bit_depth, int16_t* resid); // ɿԤ(AVX-512)
+#endif
+static inline int wide_sext(uint32_t v, int bits); // λչ
+static inline _Bool wide_fits(int v, int bits); // жзָܷλʾ
+static inline uint16_t wide_med(uint16_t a, uint16_t b, uint16_t c); // ͨMEDԤ
+static int wide_op_of(unsigned char b1); // ֽȷ(γ/-1)
+static size_t put_op(unsigned char* dst, int op, int s, int ext, int f0, int f1, int f2); // 
+static uint64_t get_op(const unsigned char* src, size_t n); // ȡ()
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ں(EQOI_TIER_*, NULLʾʹñ)
+static const wide_resid_fn wide_kernels[EQOI_TIER_CNT] = {
+	NULL,
+#ifdef EQOI_X86
+	resid_sse2,
+	resid_sse41,
+	resid_avx2,
+	resid_avx512
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@public
+@brief  λ󳤶(ÿΪRGB4+eֽ)
+@param  img_w ͼ
+		img_h ͼ߶
+		bit_depth λ
+@return 󳤶(ֽ)
+*************************/
+size_t eqoi_wide_max_size(uint32_t img_w, uint32_t img_h, int bit_depth) {
+	int ext = (3 * (bit_depth - 8) + 7) / 8;
+
+	return (size_t)img_w * img_h * (4 + ext);
+}
+
+/*************************
+@check
+@public
+@brief  ǷλΧ(2^bit_depth-1)
+@param  prgb (ָ)
+		stride п()
+		img_w ͼ
+		img_h ͼ߶
+		bit_depth λ
+@return ǷڷΧ
+*************************/
+_Bool eqoi_wide_in_range(const uint16_t* prgb, size_t stride, uint32_t img_w, uint32_t img_h, int bit_depth) {
+	size_t row_len = (size_t)img_w * 3;
+
+	if (bit_depth >= 16) {
+		return 1;
+	}
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const uint16_t* prow = prgb + (size_t)y * stride;
+		uint16_t acc = 0;
+
+		for (size_t k = 0; k < row_len; k++) {
+			acc |= prow[k];
+		}
+
+		if (acc >> bit_depth) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/*************************
+@encode
+@public
+@brief  Ըλ(λΧ, eqoi_wide_in_range)
+@param  prgb (ָ)
+		stride п()
+		img_w ͼ
+		img_h ͼ߶
+		bit_depth λ(EQOI_WIDE_MIN_DEPTH~EQOI_WIDE_MAX_DEPTH)
+		pCompressed ѹݻ(ָ, Сeqoi_wide_max_size)
+@return ѹֽ
+*************************/
+size_t eqoi_wide_encode(const uint16_t* prgb, size_t stride, uint32_t img_w, uint32_t img_h, int bit_depth,
+	unsigned char* pCompressed) {
+	int s = bit_depth - 8;
+	int ext = (3 * s + 7) / 8;
+
+	qoi_rgb16_t index_tb[INDEX_TB_L];
+	qoi_rgb16_t px;
+	qoi_rgb16_t px_prev = { 0, 0, 0 };
+	int16_t resid[WIDE_BLOCK * 3];
+	wide_resid_fn kern = wide_kernels[eqoi_cpu_tier()];
+
+	size_t p = 0;
+	int run = 0;
+	uint64_t px_left = (uint64_t)img_w * img_h;
+
+	memset(index_tb, 0, sizeof(index_tb));
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		const uint16_t* prow = prgb + (size_t)y * stride;
+		const uint16_t* up = y ? prow - stride : NULL;
+
+		for (uint32_t x0 = 0; x0 < img_w; x0 += WIDE_BLOCK) {
+			uint32_t n = __MIN(WIDE_BLOCK, img_w - x0);
+
+			wide_resid(kern, prow, up, (size_t)x0 * 3, (size_t)(x0 + n) * 3, bit_depth, resid);
+
+			for (uint32_t i = 0; i < n; i++) {
+				const uint16_t* q = prow + (size_t)(x0 + i) * 3;
+
+				px = (qoi_rgb16_t){ q[0], q[1], q[2] };
+				px_left--;
+
+				if (px.r == px_prev.r && px.g == px_prev.g && px.b == px_prev.b) {
+					run++;
+					if (run == WIDE_MAX_RUN || !px_left) {
+						pCompressed[p++] = WIDE_OP_RUN | (run - 1);
+						run = 0;
+					}
+
+					continue;
+				}
+
+				if (run) {
+					pCompressed[p++] = WIDE_OP_RUN | (run - 1);
+					run = 0;
+				}
+
+				unsigned char index_pos = WIDE_COLOR_HASH(px) % INDEX_TB_L;
+
+				if (index_tb[index_pos].r == px.r && index_tb[index_pos].g == px.g && index_tb[index_pos].b == px.b) {
+					pCompressed[p++] = WIDE_OP_INDEX | index_pos;
+				}
+				else {
+					int vr = resid[i * 3];
+					int vg = resid[i * 3 + 1];
+					int vb = resid[i * 3 + 2];
+					int vg_r = wide_sext((uint32_t)(vr - vg), bit_depth);
+					int vg_b = wide_sext((uint32_t)(vb - vg), bit_depth);
+
+					if (wide_fits(vr, 2 + s) && wide_fits(vg, 2 + s) && wide_fits(vb, 2 + s)) {
+						p += put_op(pCompressed + p, WIDE_DIFF, s, ext, vr, vg, vb);
+					}
+					else if (wide_fits(vr, 4 + s) && wide_fits(vg, 5 + s) && wide_fits(vb, 4 + s)) {
+						p += put_op(pCompressed + p, WIDE_DIFF3, s, ext, vg, vr, vb);
+					}
+					else if (wide_fits(vg_r, 4 + s) && wide_fits(vg_b, 4 + s) && wide_fits(vg, 6 + s)) {
+						p += put_op(pCompressed + p, WIDE_LUMA, s, ext, vg, vg_r, vg_b);
+					}
+					else if (wide_fits(vr, 7 + s) && wide_fits(vg, 7 + s) && wide_fits(vb, 7 + s)) {
+						p += put_op(pCompressed + p, WIDE_DIFF2, s, ext, vr, vg, vb);
+					}
+					else {
+						p += put_op(pCompressed + p, WIDE_RGB, s, ext, px.r, px.g, px.b);
+					}
+				}
+
+				index_tb[index_pos] = px;
+				px_prev = px;
+			}
+		}
+	}
+
+	return p;
+}
+
+/*************************
+@decode
+@public
+@brief  λ
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		pdecoded 뻺(ָ)
+		stride 뻺п()
+		img_w ͼ
+		img_h ͼ߶
+		bit_depth λ
+@return Ƿɹ(ضʱ0)
+*************************/
+_Bool eqoi_wide_decode(const unsigned char* pencoded, size_t encoded_len, uint16_t* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h, int bit_depth) {
+	int s = bit_depth - 8;
+	int ext = (3 * s + 7) / 8;
+	uint32_t mask = (1u << bit_depth) - 1;
+	size_t row_len = (size_t)img_w * 3;
+
+	qoi_rgb16_t index_tb[INDEX_TB_L];
+	qoi_rgb16_t px = { 0, 0, 0 };
+
+	size_t p = 0;
+	uint32_t run = 0;
+
+	memset(index_tb, 0, sizeof(index_tb));
+
+	for (uint32_t y = 0; y < img_h; y++) {
+		uint16_t* prow = pdecoded + (size_t)y * stride;
+		const uint16_t* up = y ? prow - stride : NULL;
+
+		for (size_t k = 0; k < row_len; k += 3) {
+			if (run) {
+				run--;
+			}
+			else {
+				if (p >= encoded_len) {
+					return 0;
+				}
+
+				unsigned char b1 = pencoded[p];
+				int op = wide_op_of(b1);
+
+				if (op < 0) {
+					p++;
+
+					if ((b1 & WIDE_MASK_3) == WIDE_OP_RUN) {
+						run = b1 & 0x1f;
+					}
+					else {
+						px = index_tb[b1 % INDEX_TB_L];
+					}
+				}
+				else {
+					const wide_op_t* d = wide_ops + op;
+					size_t n = d->base + ext;
+					int w1 = d->w[1] + s;
+					int w2 = d->w[2] + s;
+
+					if (n > encoded_len - p) {
+						return 0;
+					}
+
+					uint64_t word = get_op(pencoded + p, n);
+					p += n;
+
+					if (op == WIDE_RGB) {
+						px.r = (uint16_t)((word >> (w1 + w2)) & mask);
+						px.g = (uint16_t)((word >> w2) & mask);
+						px.b = (uint16_t)(word & mask);
+					}
+					else {
+						int f0 = wide_sext((uint32_t)(word >> (w1 + w2)), d->w[0] + s);
+						int f1 = wide_sext((uint32_t)(word >> w2), w1);
+						int f2 = wide_sext((uint32_t)word, w2);
+						int vr, vg, vb;
+
+						if (op == WIDE_DIFF3) {
+							vr = f1, vg = f0, vb = f2;
+						}
+						else if (op == WIDE_LUMA) {
+							vr = f0 + f1, vg = f0, vb = f0 + f2;
+						}
+						else {
+							vr = f0, vg = f1, vb = f2;
+						}
+
+						// д뻺, ϷϷȡһ
+						uint16_t pr, pg, pb;
+
+						if (up == NULL) {
+							pr = k ? prow[k - 3] : 0;
+							pg = k ? prow[k - 2] : 0;
+							pb = k ? prow[k - 1] : 0;
+						}
+						else if (!k) {
+							pr = up[0];
+							pg = up[1];
+							pb = up[2];
+						}
+						else {
+							pr = wide_med(prow[k - 3], up[k], up[k - 3]);
+							pg = wide_med(prow[k - 2], up[k + 1], up[k - 2]);
+							pb = wide_med(prow[k - 1], up[k + 2], up[k - 1]);
+						}
+
+						px.r = (uint16_t)((pr + vr) & mask);
+						px.g = (uint16_t)((pg + vg) & mask);
+						px.b = (uint16_t)((pb + vb) & mask);
+					}
+				}
+
+				if (op >= 0 || (b1 & WIDE_MASK_3) == WIDE_OP_INDEX) {
+					index_tb[WIDE_COLOR_HASH(px) % INDEX_TB_L] = px;
+				}
+			}
+
+			prow[k] = px.r;
+			prow[k + 1] = px.g;
+			prow[k + 2] = px.b;
+		}
+	}
+
+	return 1;
+}
+
+/*************************
+@calc
+@public
+@brief  ɨλͳƸ()
+@param  pencoded ѹ(ָ)
+		encoded_len ѹݳ
+		px_cnt ͼ
+		bit_depth λ
+		stats ͳƽ(ָ, ԭмۼ)
+@return none
+*************************/
+void eqoi_wide_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, int bit_depth,
+	qoi_op_stats_t* stats) {
+	int ext = (3 * (bit_depth - 8) + 7) / 8;
+	uint64_t px_done = 0;
+	size_t p = 0;
+
+	while (p < encoded_len && px_done < px_cnt) {
+		unsigned char b1 = pencoded[p];
+		int op = wide_op_of(b1);
+		int id = op >= 0 ? wide_ops[op].id : (b1 & WIDE_MASK_3) == WIDE_OP_RUN ? QOI_ID_RUN : QOI_ID_INDEX;
+		size_t len = op >= 0 ? (size_t)(wide_ops[op].base + ext) : 1;
+		uint64_t n = id == QOI_ID_RUN ? (uint64_t)(b1 & 0x1f) + 1 : 1;
+
+		stats->ops[id]++;
+		stats->pixels[id] += n;
+		stats->bytes[id] += len;
+
+		px_done += n;
+		p += len;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@calc
+@private
+@brief  һβԤ(λƺλչ), Ԥ8λͬ:
+		Ԥ(׸ԤΪ0), еϷԤ, ʹMED;
+		ÿ׸ں˴ĩβɱ
+@param  kern ں(NULLʾȫɱ)
+		prow ǰ(ָ)
+		up һ(ָ, ΪNULL)
+		k ʼλ(λ*3)
+		k_end λ()
+		bit_depth λ
+		resid Ԥ(׵ַ, k_end-k)
+@return none
+*************************/
+static void wide_resid(wide_resid_fn kern, const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid) {
+	// ÿ׸û
+	for (; k < k_end && k < 3; k++) {
+		*resid++ = (int16_t)wide_sext((uint32_t)prow[k] - (up != NULL ? up[k] : 0), bit_depth);
+	}
+
+	if (kern != NULL) {
+		size_t k1 = kern(prow, up, k, k_end, bit_depth, resid);
+
+		resid += k1 - k;
+		k = k1;
+	}
+
+	for (; k < k_end; k++) {
+		uint16_t pred = up == NULL ? prow[k - 3] : wide_med(prow[k - 3], up[k], up[k - 3]);
+
+		*resid++ = (int16_t)wide_sext((uint32_t)prow[k] - pred, bit_depth);
+	}
+}
+
+#ifdef EQOI_X86
+/*************************
+@calc
+@private
+@brief  ɿԤ(SSE2, ÿ8, ޷űȽͨ0x8000תΪзűȽ)
+@param  prow ǰ(ָ)
+		up һ(ָ, ΪNULL)
+		k ʼλ(С3)
+		k_end λ()
+		bit_depth λ
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("sse2") size_t resid_sse2(const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid) {
+	const __m128i bias = _mm_set1_epi16((short)0x8000);
+	const __m128i shift = _mm_cvtsi32_si128(16 - bit_depth);
+
+	for (; k + 8 <= k_end; k += 8, resid += 8) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(prow + k));
+		__m128i a = _mm_loadu_si128((const __m128i*)(prow + k - 3));
+		__m128i pred = a;
+
+		if (up != NULL) {
+			__m128i b = _mm_loadu_si128((const __m128i*)(up + k));
+			__m128i c = _mm_loadu_si128((const __m128i*)(up + k - 3));
+			__m128i as = _mm_xor_si128(a, bias);
+			__m128i bs = _mm_xor_si128(b, bias);
+			__m128i cs = _mm_xor_si128(c, bias);
+			__m128i mn = _mm_min_epi16(as, bs);
+			__m128i mx = _mm_max_epi16(as, bs);
+			__m128i ge = _mm_cmpeq_epi16(_mm_max_epi16(cs, mx), cs); // c >= max(a, b)
+			__m128i le = _mm_cmpeq_epi16(_mm_min_epi16(cs, mn), cs); // c <= min(a, b)
+			__m128i grad = _mm_sub_epi16(_mm_add_epi16(a, b), c);
+
+			pred = _mm_or_si128(_mm_and_si128(le, _mm_xor_si128(mx, bias)), _mm_andnot_si128(le, grad));
+			pred = _mm_or_si128(_mm_and_si128(ge, _mm_xor_si128(mn, bias)), _mm_andnot_si128(ge, pred));
+		}
+
+		// λ: Ƶ16λλ
+		__m128i d = _mm_sub_epi16(x, pred);
+		_mm_storeu_si128((__m128i*)resid, _mm_sra_epi16(_mm_sll_epi16(d, shift), shift));
+	}
+
+	return k;
+}
+
+/*************************
+@calc
+@private
+@brief  ɿԤ(SSE4.1, ÿ8, ֱʹ޷min/max, blendvѡMEDĽ)
+@param  prow ǰ(ָ)
+		up һ(ָ, ΪNULL)
+		k ʼλ(С3)
+		k_end λ()
+		bit_depth λ
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("sse4.1") size_t resid_sse41(const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid) {
+	const __m128i shift = _mm_cvtsi32_si128(16 - bit_depth);
+
+	for (; k + 8 <= k_end; k += 8, resid += 8) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(prow + k));
+		__m128i a = _mm_loadu_si128((const __m128i*)(prow + k - 3));
+		__m128i pred = a;
+
+		if (up != NULL) {
+			__m128i b = _mm_loadu_si128((const __m128i*)(up + k));
+			__m128i c = _mm_loadu_si128((const __m128i*)(up + k - 3));
+			__m128i mn = _mm_min_epu16(a, b);
+			__m128i mx = _mm_max_epu16(a, b);
+			__m128i ge = _mm_cmpeq_epi16(_mm_max_epu16(c, mx), c); // c >= max(a, b)
+			__m128i le = _mm_cmpeq_epi16(_mm_min_epu16(c, mn), c); // c <= min(a, b)
+			__m128i grad = _mm_sub_epi16(_mm_add_epi16(a, b), c);
+
+			pred = _mm_blendv_epi8(_mm_blendv_epi8(grad, mx, le), mn, ge);
+		}
+
+		__m128i d = _mm_sub_epi16(x, pred);
+		_mm_storeu_si128((__m128i*)resid, _mm_sra_epi16(_mm_sll_epi16(d, shift), shift));
+	}
+
+	return k;
+}
+
+/*************************
+@calc
+@private
+@brief  ɿԤ(AVX2, ÿ16)
+@param  prow ǰ(ָ)
+		up һ(ָ, ΪNULL)
+		k ʼλ(С3)
+		k_end λ()
+		bit_depth λ
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("avx2") size_t resid_avx2(const uint16_t* prow, const uint16_t* up, size_t k, size_t k_end,
+	int bit_depth, int16_t* resid) {
+	const __m128i shift = _mm_cvtsi32_si128(16 - bit_depth);
+
+	for (; k + 16 <= k_end; k += 16, resid += 16) {
+		__m256i x = _mm256_loadu_si256((const __m256i*)(prow + k));
+		__m256i a = _mm256_loadu_si256((const __m256i*)(prow + k - 3));
+		__m256i pred = a;
+
+		if (up != NULL) {
+			__m256i b = _mm256_loadu_si256((const __m256i*)(up + k));
+			__m256i c = _mm256_loadu_si256((const __m256i*)(up + k - 3));
+			__m256i mn = _mm256_min_epu16(a, b);
+			__m256i mx = _mm256_max_epu16(a, b);
+			__m256i ge = _mm256_cmpeq_epi16(_mm256_max_epu16(c, mx), c); // c >= max(a, b)
+			__m256i le = _mm256_cmpeq_epi16(_mm256_min_epu16(c, mn), c); // c <= min(a, b)
+			__m256i grad = _mm256_sub_epi16(_mm256_add_epi16(a, b), c);
+
+			pred = _mm256_blendv_epi8(_mm256_blendv_epi8(grad, mx, le), mn, ge);
+		}
+
+		__m256i d = _mm256_sub_epi16(x, pred);
+		_mm256_storeu_si256((__m256i*)resid, _mm256_sra_epi16(_mm256_sll_epi16(d, shift), shift));
+	}
+
+	return k;
+}
+
+/*************************
+@calc
+@private
+@brief  ɿԤ(AVX-512, ÿ32, ȽϽֱΪѡ)
+@param  prow ǰ(ָ)
+		up һ(ָ, ΪNULL)
+		k ʼλ(С3)
+		k_end λ()
+		bit_depth λ
+		resid Ԥ(׵ַ)
+@return δ׸λ
+*************************/
+static EQOI_TARGET("avx512f,avx512bw") size_t resid_avx512(const uint16_t* prow, const uint16_t* up, size_t k,
+	size_t k_end, int bit_depth, int16_t* resid) {
+	const __m128i shift = _mm_cvtsi32_si128(16 - bit_depth);
+
+	for (; k + 32 <= k_end; k += 32, resid += 32) {
+		__m512i x = _mm512_loadu_si512((const void*)(prow + k));
+		__m512i a = _mm512_loadu_si512((const void*)(prow + k - 3));
+		__m512i pred = a;
+
+		if (up != NULL) {
+			__m512i b = _mm512_loadu_si512((const void*)(up + k));
+			__m512i c = _mm512_loadu_si512((const void*)(up + k - 3));
+			__m512i mn = _mm512_min_epu16(a, b);
+			__m512i mx = _mm512_max_epu16(a, b);
+			__mmask32 ge = _mm512_cmpge_epu16_mask(c, mx); // c >= max(a, b)
+			__mmask32 le = _mm512_cmple_epu16_mask(c, mn); // c <= min(a, b)
+			__m512i grad = _mm512_sub_epi16(_mm512_add_epi16(a, b), c);
+
+			pred = _mm512_mask_blend_epi16(ge, _mm512_mask_blend_epi16(le, grad, mx), mn);
+		}
+
+		__m512i d = _mm512_sub_epi16(x, pred);
+		_mm512_storeu_si512((void*)resid, _mm512_sra_epi16(_mm512_sll_epi16(d, shift), shift));
+	}
+
+	return k;
+}
+#endif
+
+/*************************
+@calc
+@private
+@brief  λչ(ȡbitsλΪз)
+@param  v ֵ
+		bits λ
+@return з
+*************************/
+static inline int wide_sext(uint32_t v, int bits) {
+	v &= (uint32_t)((1ull << bits) - 1);
+
+	return (int)(v ^ (1u << (bits - 1))) - (1 << (bits - 1));
+}
+
+/*************************
+@calc
+@private
+@brief  жзָܷλʾ
+@param  v з
+		bits λ
+@return ܷʾ
+*************************/
+static inline _Bool wide_fits(int v, int bits) {
+	return (uint32_t)(v + (1 << (bits - 1))) < (1u << bits);
+}
+
+/*************************
+@calc
+@private
+@brief  ͨMEDԤ
+@param  a 
+		b Ϸ
+		c Ϸ
+@return Ԥֵ
+*************************/
+static inline uint16_t wide_med(uint16_t a, uint16_t b, uint16_t c) {
+	if (c >= __MAX(a, b)) {
+		return __MIN(a, b);
+	}
+	else if (c <= __MIN(a, b)) {
+		return __MAX(a, b);
+	}
+	else {
+		return (uint16_t)(a + b - c);
+	}
+}
+
+/*************************
+@calc
+@private
+@brief  ֽȷ
+@param  b1 ֽ
+@return wide_opsеı(γ/-1)
+*************************/
+static int wide_op_of(unsigned char b1) {
+	if (b1 == WIDE_OP_RGB) {
+		return WIDE_RGB;
+	}
+
+	switch (b1 & WIDE_MASK_3) {
+	case WIDE_OP_RUN:
+	case WIDE_OP_INDEX:
+		return -1;
+	case WIDE_OP_DIFF3:
+		return WIDE_DIFF3;
+	case WIDE_OP_DIFF2:
+		return WIDE_DIFF2;
+	default:
+		return (b1 & WIDE_MASK_2) == WIDE_OP_DIFF ? WIDE_DIFF : WIDE_LUMA;
+	}
+}
+
+/*************************
+@encode
+@private
+@brief  (־ֽڸλ, 3ֶڵλ, )
+@param  dst λ(ָ)
+		op wide_opsеı
+		s λ-8
+		ext ÿֲӵֽ
+		f0 1ֶ
+		f1 2ֶ
+		f2 3ֶ
+@return ֽ
+*************************/
+static size_t put_op(unsigned char* dst, int op, int s, int ext, int f0, int f1, int f2) {
+	const wide_op_t* d = wide_ops + op;
+	size_t n = d->base + ext;
+	int w0 = d->w[0] + s;
+	int w1 = d->w[1] + s;
+	int w2 = d->w[2] + s;
+
+	uint64_t word = (uint64_t)d->tag << (n * 8 - 8);
+	word |= ((uint64_t)((uint32_t)f0 & ((1u << w0) - 1)) << (w1 + w2)) |
+		((uint64_t)((uint32_t)f1 & ((1u << w1) - 1)) << w2) | ((uint32_t)f2 & ((1u << w2) - 1));
+
+	for (size_t i = 0; i < n; i++) {
+		dst[i] = (unsigned char)(word >> ((n - 1 - i) * 8));
+	}
+
+	return n;
+}
+
+/*************************
+@decode
+@private
+@brief  ȡ()
+@param  src ʼλ(ָ)
+		n ֽ
+@return 
+*************************/
+static uint64_t get_op(const unsigned char* src, size_t n) {
+	uint64_t word = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		word = (word << 8) | src[i];
+	}
+
+	return word;
+}
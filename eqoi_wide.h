@@ -0,0 +1,48 @@
+/************************************************************************************************************************
+ǿQOIĸλ
+@brief  ӿͷļ
+@date   2026/10/18
+@info   ҽѧӰRAWˮ16λ10~12λ, 8λصԤ붼̶Ϊ8λ
+		λΪ3ͨ֯uint16_t(ֽ, Чλbit_depthΪ9~16), MEDԤ
+		327ֱ, ÿֶελ8λs=bit_depth-8λ:
+		  ־        ֶ(˳, λ)                   ֽ
+		INDEX     000xxxxx    (5)                                   1
+		RUN       111xxxxx    γ̳-1(5), 0xff                    1
+		DIFF      01          vr(2+s) vg(2+s) vb(2+s)                   1+e
+		DIFF3     001         vg(5+s) vr(4+s) vb(4+s)                   2+e
+		LUMA      10          vg(6+s) vr-vg(4+s) vb-vg(4+s)             2+e
+		DIFF2     110         vr(7+s) vg(7+s) vb(7+s)                   3+e
+		RGB       11111111    r g b(bit_depthλ, Ԥ)              4+e
+		e=ceil(3s/8), ־λֽڵĸλ, ֶֽڵĵλ(, ־ֶ֮䲹0),
+		Ԥbit_depthλ; ļͷ, ظʽΪEQOI_FMT_RGB16, ÿͨλΪbit_depth
+************************************************************************************************************************/
+
+#ifndef __EQOI_WIDE_H
+#define __EQOI_WIDE_H
+
+#include "enhanced_qoi.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define EQOI_WIDE_MIN_DEPTH 9 // Сλ
+#define EQOI_WIDE_MAX_DEPTH 16 // λ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// λrgbص(ṹ嶨)
+typedef struct {
+	uint16_t r, g, b;
+} qoi_rgb16_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t eqoi_wide_max_size(uint32_t img_w, uint32_t img_h, int bit_depth); // λ󳤶
+_Bool eqoi_wide_in_range(const uint16_t* prgb, size_t stride, uint32_t img_w, uint32_t img_h, int bit_depth); // ǷλΧ
+size_t eqoi_wide_encode(const uint16_t* prgb, size_t stride, uint32_t img_w, uint32_t img_h, int bit_depth,
+	unsigned char* pCompressed); // Ըλ
+_Bool eqoi_wide_decode(const unsigned char* pencoded, size_t encoded_len, uint16_t* pdecoded, size_t stride,
+	uint32_t img_w, uint32_t img_h, int bit_depth); // λ
+void eqoi_wide_scan_ops(const unsigned char* pencoded, size_t encoded_len, uint64_t px_cnt, int bit_depth,
+	qoi_op_stats_t* stats); // ͳƸλеĸ
+
+#endif
@@ -1,4 +1,22 @@
-#include "enhanced_qoi.h"
+#define _POSIX_C_SOURCE 200809L
+
+#include "eqoi_stream.h"
+#include "eqoi_bench.h"
+#include "eqoi_stats.h"
+#include "eqoi_prof.h"
+#include "eqoi_synth.h"
+#include "eqoi_parallel.h"
+#include "eqoi_dict.h"
+#include "eqoi_png16.h"
+#include "eqoi_index.h"
+#include "eqoi_scale.h"
+#include "eqoi_prog.h"
+#include "eqoi_edit.h"
+#include "eqoi_verify.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -7,151 +25,2301 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define PATH_LEN 4096 // ·󳤶
+
+// ѡ(ṹ嶨)
+typedef struct {
+	const char* out_path; // ļĿ¼
+	const char* ref_path; // οͼ(Ŀ¼)
+	const char* format; // ʽ(NULLʾļչ, ûչʱΪbmp)
+	int threads; // ߳
+	uint32_t tile_w; // ֿ
+	uint32_t tile_h; // ֿ߶
+	int codec; // 
+	uint32_t raw_w; // ԭʼļĿ(0ʾΪͼļ)
+	uint32_t raw_h; // ԭʼļĸ߶
+	size_t mem_limit; // ڴ
+	int reps; // ظ
+	int warmup; // Ԥȴ
+	_Bool no_baseline; // ʱPNG/memcpy׼
+	_Bool quiet; // ļϢ
+	_Bool multi; // ΪļĿ¼
+	eqoi_bench_result_t* bench_total; // ٽĻ(ָ)
+	const char* synth; // ʹõĺϳͼ(ŷָall, NULLʾʹ)
+	const char* synth_sizes; // ϳͼĳߴ(ŷָNWxH)
+	uint32_t seed; // ϳͼ
+	uint32_t batch; // ʱÿĺϳͼ(0ʾ)
+	const char* dict_path; // ֵļ(NULLʾʹֵ)
+	const eqoi_dict_t* dict; // Ѽصֵ(ָ)
+	_Bool train_dict; // ʱһϳͼѵֵ
+	int depth; // 16λPNGЧλ(0ʾ16), ʱΪλλ
+	int channels; // ʱתΪҶ(1)Ҷ+͸(2), 3ʾRGB
+	int bayer; // ΪBayerʱɫƬ(EQOI_FMT_BAYER_*, 0ʾ), ʱв
+	int yuv; // ΪYUVԭʼļʱɫȳ(EQOI_FMT_YUV420/EQOI_FMT_YUV422, 0ʾYUV), ʱóת
+	_Bool yuv_planar; // YUVʹƽ(I420/I422, ΪNV12/NV16), ʱ
+	_Bool tiers; // ʱ𵵲Ըں
+	uint32_t interval; // ೵ļ()
+	uint32_t roi_x, roi_y, roi_w, roi_h; // (roi_wΪ0ʾͼ)
+	int scale; // ʱС(0ʾС)
+	uint32_t cols; // ƴ(0ʾȫųһ)
+} cli_opts_t;
+
+// ·б(ṹ嶨)
+typedef struct {
+	char** paths; // ·(׵ַ)
+	int n; // ·
+	int cap; // 
+} path_list_t;
+
+// жȡĲοͼ(ṹ嶨)
 typedef struct {
-	unsigned short width;
-	unsigned short height;
-	unsigned int encoded_len;
-}QoiHeader;
+	FILE* file; // ʽȡBMPļ(NULLʾ)
+	unsigned char* pixels; // صĲοͼ(ָ)
+	unsigned char* raw; // BMPһԭʼ(ָ)
+	unsigned char* row; // תΪеһ(ָ)
+	size_t row_len; // һеĳ(ֽ)
+	size_t raw_len; // BMPһеĳ(ֽ, 4ֽڶ)
+	long data_offset; // BMPļеƫ
+	int bmp_bytes; // BMPÿصֽ(34)
+	_Bool top_down; // BMPаϵ´(־)
+	_Bool wide; // ص16λοͼ(load_png16malloc)
+	uint32_t w; // ͼ
+	uint32_t h; // ͼ߶
+} ref_rows_t;
+
+typedef int (*file_cmd_fn)(const char* in_path, const cli_opts_t* opts); // Եļִе
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int test_encoder(const char* rgb_img_path, const char* encoded_bin_path);
-int test_decoder(const char* encoded_bin_path, const char* rgb_img_path);
+static const char* codec_names[] = { "auto", "med", "palette", "progressive" }; // (EQOI_CODEC_*)
+static const char* bayer_names[] = { "RGGB", "GRBG", "GBRG", "BGGR" }; // ɫƬ(EQOI_FMT_BAYER_*˳)
+static const char* yuv_names[] = { "nv12", "i420", "nv16", "i422" }; // YUV(Ϊ4:2:0ƽ/ƽ, 4:2:2ƽ/ƽ)
+static const char* bench_corpus[] = { "test/in.bmp", "test/in2.bmp", "test/in3.bmp", "test/in5.bmp" }; // ĬϵĲϿ
+static const char* synth_default_sizes = "64,256,1024,4096"; // ϳͼĬϳߴ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int cmd_encode(const char* in_path, const cli_opts_t* opts);
+int cmd_decode(const char* in_path, const cli_opts_t* opts);
+int cmd_verify(const char* in_path, const cli_opts_t* opts);
+int cmd_bench(const char* in_path, const cli_opts_t* opts);
+int cmd_stats(const char* in_path, const cli_opts_t* opts);
+int cmd_profile(const char* in_path, const cli_opts_t* opts);
+int cmd_index(const char* in_path, const cli_opts_t* opts);
+int cmd_crop(const char* in_path, const cli_opts_t* opts);
+int cmd_stitch(const path_list_t* files, const cli_opts_t* opts);
+int cmd_dict(const path_list_t* files, const cli_opts_t* opts);
 int compare_bmp(char* file1, char* file2);
 
+static void usage(void);
+static int parse_opts(int argc, char** argv, cli_opts_t* opts, path_list_t* inputs);
+static int push_path(path_list_t* list, const char* path);
+static int expand_inputs(path_list_t* inputs, const char* const* exts, path_list_t* files);
+static void free_paths(path_list_t* list);
+static void make_out_path(const char* in_path, const cli_opts_t* opts, const char* ext, char* buf);
+static unsigned char* load_file(const char* path, size_t* len);
+static int save_file(const char* path, const unsigned char* data, size_t len);
+static double now_s(void);
+static uint16_t* load_png16(const char* path, int bit_depth, int* w, int* h); // 16λPNGƵЧλ
+static int encode_yuv_file(const char* in_path, const char* out_path, const cli_opts_t* opts); // YUVԭʼļ
+static int decode_image(const unsigned char* file, const eqoi_header_t* hdr, const cli_opts_t* opts,
+	unsigned char* data); // ͼ(YUV--yuvָ)
+static void bench_cfg(const cli_opts_t* opts, eqoi_bench_cfg_t* cfg);
+static int bench_synth(const cli_opts_t* opts, int* images);
+static int bench_synth_batch(const cli_opts_t* opts, const eqoi_bench_cfg_t* cfg, int cls, uint32_t w, uint32_t h);
+static int load_dict(const char* path, eqoi_dict_t* dict);
+static unsigned char* load_index(const char* in_path, const eqoi_header_t* hdr, eqoi_index_t* index); // ԵĲ೵
+static int ref_open(const char* path, const eqoi_header_t* hdr, ref_rows_t* ref); // 򿪲οͼжȡ
+static const unsigned char* ref_row(void* ctx, uint32_t y); // ȡοͼһ
+static void ref_close(ref_rows_t* ref); // رղοͼ
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int main() {
-	// return test_encoder("test/in7.bmp", "test/compressed.bin");
-	// return test_decoder("test/compressed.bin", "test/out.bmp");
-	// return compare_bmp("test/in7.bmp", "test/out.bmp");
+int main(int argc, char** argv) {
+	static const char* const image_exts[] = { ".bmp", ".png", ".jpg", ".jpeg", ".tga", ".ppm", ".pgm", ".gif", NULL };
+	static const char* const raw_exts[] = { ".raw", ".rgb", ".bin", ".yuv", NULL };
+	static const char* const eqoi_exts[] = { ".eqoi", ".bin", NULL };
+
+	if (argc < 2) {
+		usage();
+
+		return 2;
+	}
+
+	const char* cmd = argv[1];
+
+	if (!strcmp(cmd, "compare")) {
+		return argc == 4 ? (compare_bmp(argv[2], argv[3]) ? 1 : 0) : (usage(), 2);
+	}
+
+	cli_opts_t opts;
+	path_list_t inputs = { NULL, 0, 0 };
+	path_list_t files = { NULL, 0, 0 };
+	file_cmd_fn fn;
+	const char* const* exts;
+	eqoi_dict_t dict;
+
+	if (!strcmp(cmd, "encode")) {
+		fn = cmd_encode;
+		exts = image_exts;
+	}
+	else if (!strcmp(cmd, "decode")) {
+		fn = cmd_decode;
+		exts = eqoi_exts;
+	}
+	else if (!strcmp(cmd, "verify")) {
+		fn = cmd_verify;
+		exts = eqoi_exts;
+	}
+	else if (!strcmp(cmd, "bench")) {
+		fn = cmd_bench;
+		exts = image_exts;
+	}
+	else if (!strcmp(cmd, "stats")) {
+		fn = cmd_stats;
+		exts = image_exts;
+	}
+	else if (!strcmp(cmd, "profile")) {
+		fn = cmd_profile;
+		exts = image_exts;
+	}
+	else if (!strcmp(cmd, "index")) {
+		fn = cmd_index;
+		exts = eqoi_exts;
+	}
+	else if (!strcmp(cmd, "crop")) {
+		fn = cmd_crop;
+		exts = eqoi_exts;
+	}
+	else if (!strcmp(cmd, "stitch")) {
+		fn = NULL;
+		exts = eqoi_exts;
+	}
+	else if (!strcmp(cmd, "dict")) {
+		fn = NULL;
+		exts = image_exts;
+	}
+	else {
+		usage();
+
+		return 2;
+	}
+
+	int ret = 2;
+
+	if (parse_opts(argc - 2, argv + 2, &opts, &inputs) != 0) {
+		usage();
+
+		goto done;
+	}
+	if (!inputs.n && (fn == cmd_stats || fn == cmd_profile || (fn == cmd_bench && opts.synth == NULL))) {
+		for (int i = 0; i < (int)(sizeof(bench_corpus) / sizeof(bench_corpus[0])); i++) {
+			push_path(&inputs, bench_corpus[i]);
+		}
+	}
+	if (!inputs.n && !(fn == cmd_bench && opts.synth != NULL)) {
+		usage();
+
+		goto done;
+	}
+	if (fn == cmd_encode && opts.raw_w) {
+		exts = raw_exts;
+	}
+	if (fn == cmd_encode && opts.raw_w && opts.dict_path != NULL) {
+		printf("ERROR: --dict cannot be used with --raw\n");
+
+		goto done;
+	}
+	if (fn == cmd_encode && opts.raw_w && opts.bayer) {
+		printf("ERROR: --bayer cannot be used with --raw\n");
+
+		goto done;
+	}
+	if (opts.scale && opts.roi_w) {
+		printf("ERROR: --scale cannot be used with --region\n");
+
+		goto done;
+	}
+	if (fn == cmd_encode && opts.yuv && !opts.raw_w) {
+		printf("ERROR: encoding with --yuv needs --raw WxH\n");
+
+		goto done;
+	}
+	if (fn == cmd_crop && !opts.roi_w) {
+		printf("ERROR: crop needs --region X,Y,WxH\n");
+
+		goto done;
+	}
+	if ((fn != NULL || !strcmp(cmd, "stitch")) && opts.dict_path != NULL) {
+		if (load_dict(opts.dict_path, &dict) != 0) {
+			ret = 1;
+			goto done;
+		}
+
+		opts.dict = &dict;
+	}
+	if (expand_inputs(&inputs, exts, &files) != 0) {
+		ret = 1;
+		goto done;
+	}
+	if (fn == NULL) {
+		ret = (!strcmp(cmd, "stitch") ? cmd_stitch(&files, &opts) : cmd_dict(&files, &opts)) ? 1 : 0;
+		goto done;
+	}
+
+	struct stat st;
+	opts.multi = inputs.n > 1 || (inputs.n && stat(inputs.paths[0], &st) == 0 && S_ISDIR(st.st_mode));
+	if ((opts.multi || fn == cmd_stats) && opts.out_path != NULL) {
+		mkdir(opts.out_path, 0755);
+	}
+
+	if (fn == cmd_bench) {
+		printf("cpu tier %s (supported up to %s, set %s to force a tier)\n", eqoi_cpu_tier_name(eqoi_cpu_tier()),
+			eqoi_cpu_tier_name(eqoi_cpu_best_tier()), EQOI_TIER_ENV);
+	}
+
+	int failed = 0;
+	int count = files.n;
+	eqoi_bench_result_t bench_total;
+
+	memset(&bench_total, 0, sizeof(eqoi_bench_result_t));
+	opts.bench_total = &bench_total;
+
+	for (int i = 0; i < files.n; i++) {
+		if (fn(files.paths[i], &opts) != 0) {
+			failed++;
+		}
+	}
+
+	if (fn == cmd_bench && opts.synth != NULL) {
+		int images = 0;
+
+		failed += bench_synth(&opts, &images);
+		count += images;
+	}
+
+	if (fn == cmd_bench && bench_total.images > 1) {
+		eqoi_bench_cfg_t cfg;
+		char title[64];
+
+		bench_cfg(&opts, &cfg);
+		snprintf(title, sizeof(title), "corpus  %d image(s)  %.2f MP", bench_total.images, bench_total.pixels / 1e6);
+		eqoi_bench_print(stdout, title, &bench_total, &cfg);
+	}
+
+	if (count > 1 || failed) {
+		printf("%d file(s), %d failed\n", count, failed);
+	}
+
+	ret = failed ? 1 : 0;
+
+done:
+	free_paths(&files);
+	free_paths(&inputs);
+
+	return ret;
 }
 
-int test_encoder(const char* rgb_img_path, const char* encoded_bin_path) {
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@cmd
+@public
+@brief  뵥ļ(ͼļ, ʹ--rawָߴԭʼļ)
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_encode(const char* in_path, const cli_opts_t* opts) {
+	char out_path[PATH_LEN];
+	make_out_path(in_path, opts, ".eqoi", out_path);
+
+	// YUVԭʼļڴб, ԭʼļʹ
+	if (opts->yuv) {
+		return encode_yuv_file(in_path, out_path, opts);
+	}
+	if (opts->raw_w) {
+		eqoi_stream_stats_t st;
+		int err = eqoi_encode_raw_file(in_path, 0, opts->raw_w, opts->raw_h, opts->tile_w, opts->tile_h,
+			out_path, opts->mem_limit, &st);
+
+		if (err == EQOI_ERR_MEM) {
+			printf("ERROR: %s: --mem %zu is too small for one row (or tile row) and its output\n", in_path, opts->mem_limit);
+
+			return -1;
+		}
+		if (err != EQOI_OK) {
+			printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+
+			return -1;
+		}
+
+		double mp = (double)opts->raw_w * opts->raw_h / 1e6;
+		double io_s = st.read_s + st.write_s;
+
+		if (!opts->quiet) {
+			printf("%s -> %s  %ux%u  ratio %.4f  %.1f MP/s  (read %.3f s, write %.3f s, compute %.3f s, mem %.1f MiB, %u rows/window, %s-bound)\n",
+				in_path, out_path, opts->raw_w, opts->raw_h, (double)st.bytes_written / (mp * 3e6), mp / st.total_s,
+				st.read_s, st.write_s, st.compute_s, st.mem_used / 1048576.0, st.window_rows,
+				io_s > st.compute_s ? "I/O" : "CPU");
+		}
+
+		return 0;
+	}
+
+	// 16λPNGʹøλ
+	_Bool wide = stbi_is_16_bit(in_path);
+	int depth = wide ? (opts->depth ? opts->depth : 16) : 8;
 	int width, height, nrChannels;
+	int comp = 3;
+	unsigned char* data;
+
+	// Ҷ(Ҷ+͸)ԶѡʱʹûҶģʽ, ָ-cʱչΪRGB
+	if (!wide && opts->codec == EQOI_CODEC_AUTO && stbi_info(in_path, &width, &height, &nrChannels) && nrChannels <= 2) {
+		comp = nrChannels;
+	}
 
-	unsigned char* data = stbi_load(rgb_img_path, &width, &height, &nrChannels, STBI_rgb);
-	unsigned char* compressed = malloc(width * height * 4);
+	if (opts->depth && !wide) {
+		printf("ERROR: %s: --depth needs a 16-bit PNG input\n", in_path);
 
-	printf("ͼƬ(w%d h%d)\n", width, height);
-	
-	if (compressed == NULL || data == NULL) {
 		return -1;
 	}
 
-	int compressed_len = enhanced_qoi_encode(data, compressed, width, height);
+	// BayerԵͨͼ񱣴, ÿй1
+	if (opts->bayer) {
+		if (wide || !stbi_info(in_path, &width, &height, &nrChannels) || nrChannels != 1) {
+			printf("ERROR: %s: --bayer needs an 8-bit single-channel mosaic image\n", in_path);
 
-	printf("ѹ = %f\n", compressed_len * 1.0f / (width * height * 3));
+			return -1;
+		}
+		if (((width | height) & 1) || (opts->tile_w && opts->tile_h && ((opts->tile_w | opts->tile_h) & 1))) {
+			printf("ERROR: %s: a Bayer mosaic needs an even width, height and tile size\n", in_path);
 
-	FILE* file;
+			return -1;
+		}
 
-	fopen_s(&file, encoded_bin_path, "wb");
+		comp = 1;
+	}
 
-	if (file == NULL) {
+	if (wide) {
+		data = (unsigned char*)load_png16(in_path, depth, &width, &height);
+	}
+	else {
+		data = stbi_load(in_path, &width, &height, &nrChannels, comp);
+
+		if (data == NULL) {
+			printf("ERROR: cannot open %s\n", in_path);
+		}
+	}
+
+	if (data == NULL) {
 		return -1;
 	}
 
-	QoiHeader header;
-	header.width = (unsigned short)width;
-	header.height = (unsigned short)height;
-	header.encoded_len = (unsigned int)compressed_len;
+	size_t cap = wide ? eqoi_max_file_size_wide(width, height, opts->tile_w, opts->tile_h, depth) :
+		comp < 3 ? eqoi_max_file_size_gray(width, height, opts->tile_w, opts->tile_h, comp) :
+		eqoi_max_file_size(width, height, opts->tile_w, opts->tile_h);
+	unsigned char* file_buf = malloc(cap);
+	size_t file_len = 0;
+	int err = file_buf == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	double t0 = now_s();
+	if (err == EQOI_OK && wide) {
+		err = eqoi_encode_wide((const uint16_t*)data, width, height, depth, opts->tile_w, opts->tile_h, opts->threads,
+			file_buf, cap, &file_len);
+	}
+	else if (err == EQOI_OK && opts->bayer) {
+		err = eqoi_encode_cfa(data, width, height, opts->bayer, opts->tile_w, opts->tile_h, opts->threads, file_buf, cap,
+			&file_len);
+	}
+	else if (err == EQOI_OK && comp < 3) {
+		err = eqoi_encode_gray(data, width, height, comp, opts->tile_w, opts->tile_h, opts->threads, file_buf, cap, &file_len);
+	}
+	else if (err == EQOI_OK) {
+		err = eqoi_encode_codec(data, width, height, opts->tile_w, opts->tile_h, opts->threads, opts->codec, opts->dict,
+			file_buf, cap, &file_len);
+	}
+	double t1 = now_s();
+
+	if (err == EQOI_OK && save_file(out_path, file_buf, file_len) != 0) {
+		err = EQOI_ERR_IO;
+	}
 
-	fwrite(&header, sizeof(QoiHeader), 1, file);
-	fwrite(compressed, 1, compressed_len, file);
+	if (err == EQOI_ERR_ARG && opts->codec == EQOI_CODEC_PALETTE && !wide && !opts->bayer && comp >= 3) {
+		printf("ERROR: %s: more than %d colours, cannot use -c palette (use -c med or -c auto)\n", in_path, EQOI_PALETTE_MAX);
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else if (!opts->quiet) {
+		double mp = (double)width * height / 1e6;
 
-	fclose(file);
+		// ļͷƫ19Ϊʵʹõı, ѹظʽԭʼ
+		printf("%s -> %s  %dx%d  %s  %d-bit  ratio %.4f  encode %.2f ms  %.1f MP/s\n", in_path, out_path, width, height,
+			opts->bayer ? bayer_names[opts->bayer - EQOI_FMT_BAYER_RGGB] : comp == 1 ? "gray" : comp == 2 ? "gray+alpha" :
+			codec_names[file_buf[19]], depth,
+			file_len / (mp * (wide ? 6e6 : comp * 1e6)), (t1 - t0) * 1e3, mp / (t1 - t0));
+	}
 
-	stbi_image_free(data);
-	free(compressed);
+	if (wide) {
+		free(data);
+	}
+	else {
+		stbi_image_free(data);
+	}
+	free(file_buf);
 
-	return 0;
+	return err == EQOI_OK ? 0 : -1;
 }
 
-int test_decoder(const char* encoded_bin_path, const char* rgb_img_path) {
-	FILE* file;
+/*************************
+@cmd
+@public
+@brief  뵥EQOIļ(ʽ--format, δָʱļչ)
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_decode(const char* in_path, const cli_opts_t* opts) {
+	char out_path[PATH_LEN];
+	char ext[16];
 
-	fopen_s(&file, encoded_bin_path, "rb");
+	snprintf(ext, sizeof(ext), ".%s", opts->format != NULL ? opts->format : "bmp");
+	make_out_path(in_path, opts, ext, out_path);
 
-	if (file == NULL) {
-		return -1;
+	// ָ--formatļչ
+	const char* out_ext = ext;
+	const char* dot = strrchr(out_path, '.');
+
+	if (opts->format == NULL && dot != NULL && strchr(dot, '/') == NULL) {
+		out_ext = dot;
 	}
 
-	QoiHeader header;
+	size_t file_len;
+	unsigned char* file_buf = load_file(in_path, &file_len);
+	unsigned char* data = NULL;
+	unsigned char* idx_buf = NULL;
+	eqoi_header_t hdr;
+	eqoi_index_t index;
+	int err = file_buf == NULL ? EQOI_ERR_IO : eqoi_parse_header(file_buf, file_len, &hdr);
+	_Bool preview = 0;
+
+	// ضϵĽģʽļ: ļͷƫƱʱԤ
+	if (err == EQOI_ERR_TRUNC && eqoi_parse_header_prefix(file_buf, file_len, &hdr) == EQOI_OK &&
+		hdr.codec == EQOI_CODEC_PROGRESSIVE) {
+		if (opts->roi_w || opts->scale) {
+			printf("ERROR: %s: a truncated file can only be decoded to a full-size preview\n", in_path);
+			free(file_buf);
 
-	fread_s(&header, sizeof(QoiHeader), sizeof(QoiHeader), 1, file);
+			return -1;
+		}
+
+		preview = 1;
+		err = EQOI_OK;
+	}
 
-	unsigned char* data = malloc(header.width * header.height * 3);
-	unsigned char* compressed = malloc(header.encoded_len);
+	if (err == EQOI_OK && !opts->roi_w && !preview) {
+		err = eqoi_check_data(file_buf, &hdr); // ֻȡѹ, УCRC32
+	}
+	if (err == EQOI_OK) {
+		err = eqoi_use_dict(&hdr, opts->dict);
+	}
+	if (err == EQOI_OK && opts->roi_w && ((uint64_t)opts->roi_x + opts->roi_w > hdr.width ||
+		(uint64_t)opts->roi_y + opts->roi_h > hdr.height)) {
+		printf("ERROR: %s: region %u,%u,%ux%u exceeds the %ux%u image\n", in_path, opts->roi_x, opts->roi_y, opts->roi_w,
+			opts->roi_h, hdr.width, hdr.height);
+		free(file_buf);
 
-	if (compressed == NULL || data == NULL) {
 		return -1;
 	}
+	if (err == EQOI_OK && opts->scale && hdr.pixel_fmt != EQOI_FMT_RGB8) {
+		printf("ERROR: %s: --scale needs an 8-bit RGB file\n", in_path);
+		free(file_buf);
 
-	fread_s(compressed, header.encoded_len, 1, header.encoded_len, file);
+		return -1;
+	}
+	if (err == EQOI_OK && opts->roi_w) {
+		idx_buf = load_index(in_path, &hdr, &index);
+	}
 
-	enhanced_qoi_decode(compressed, data, header.width, header.height);
+	// ĳߴ(ͼͼ)
+	uint32_t out_w = opts->roi_w ? opts->roi_w : hdr.width;
+	uint32_t out_h = opts->roi_w ? opts->roi_h : hdr.height;
 
-	stbi_write_bmp(rgb_img_path, header.width, header.height, STBI_rgb, data);
+	if (err == EQOI_OK && opts->scale) {
+		eqoi_scaled_dims(&hdr, opts->scale, &out_w, &out_h);
+	}
+	if (err == EQOI_OK) {
+		data = malloc(opts->roi_w || opts->scale ? (size_t)out_w * out_h * eqoi_pixel_size(&hdr) : eqoi_decoded_size(&hdr));
+		err = data == NULL ? EQOI_ERR_MEM : EQOI_OK;
+	}
 
-	printf("ͼƬ(w%d h%d)\n", header.width, header.height);
+	int streams = 0;
 
-	fclose(file);
+	double t0 = now_s();
+	if (err == EQOI_OK && opts->roi_w) {
+		err = eqoi_decode_region(file_buf, &hdr, idx_buf != NULL ? &index : NULL, opts->roi_x, opts->roi_y, opts->roi_w,
+			opts->roi_h, data, (size_t)opts->roi_w * eqoi_pixel_size(&hdr));
+	}
+	else if (err == EQOI_OK && opts->scale) {
+		err = eqoi_decode_scaled(file_buf, &hdr, opts->scale, data, (size_t)out_w * 3);
+	}
+	else if (err == EQOI_OK && preview) {
+		err = eqoi_decode_progressive(file_buf, file_len, &hdr, data, &streams);
+	}
+	else if (err == EQOI_OK) {
+		err = decode_image(file_buf, &hdr, opts, data);
+	}
+	double t1 = now_s();
 
-	free(data);
-	free(compressed);
+	if (err == EQOI_OK) {
+		// °ĳߴд
+		hdr.width = out_w;
+		hdr.height = out_h;
+	}
 
-	return 0;
-}
+	if (err == EQOI_OK && EQOI_FMT_IS_YUV(hdr.pixel_fmt)) {
+		// YUVֻΪԭʼļ(.yuv.raw)
+		if (strcmp(out_ext, ".yuv") && strcmp(out_ext, ".raw")) {
+			printf("ERROR: %s: YUV images can only be decoded to .yuv or .raw\n", in_path);
+			free(file_buf);
+			free(data);
+			free(idx_buf);
 
-int compare_bmp(char* file1, char* file2) {
-	int width, height, nrChannels;
-	int w2, h2, ch2;
-	unsigned char* data1 = stbi_load(file1, &width, &height, &nrChannels, STBI_rgb_alpha);
+			return -1;
+		}
 
-	if (data1 == NULL) {
-		printf("ERROR: cannot open file1: %s\n", file1);
+		err = save_file(out_path, data, eqoi_decoded_size(&hdr)) == 0 ? EQOI_OK : EQOI_ERR_IO;
+	}
+	else if (err == EQOI_OK && hdr.pixel_fmt == EQOI_FMT_RGB16) {
+		// λ: .rawЧλԭʼ, .pngƵ16λĲ, ֧BMP
+		size_t n = (size_t)hdr.width * hdr.height * 3;
+		uint16_t* samples = (uint16_t*)data;
 
-		return -1;
+		if (!strcmp(out_ext, ".raw")) {
+			err = save_file(out_path, data, n * sizeof(uint16_t)) == 0 ? EQOI_OK : EQOI_ERR_IO;
+		}
+		else if (!strcmp(out_ext, ".png")) {
+			for (size_t i = 0; i < n; i++) {
+				samples[i] <<= 16 - hdr.bit_depth;
+			}
+
+			err = eqoi_png16_write(out_path, samples, hdr.width, hdr.height) ? EQOI_OK : EQOI_ERR_IO;
+		}
+		else {
+			printf("ERROR: %s: %d-bit images can only be decoded to .png or .raw\n", in_path, hdr.bit_depth);
+			free(file_buf);
+			free(data);
+			free(idx_buf);
+
+			return -1;
+		}
 	}
+	else if (err == EQOI_OK) {
+		// ҶΪͨPNG(Ҷ+͸PNG), BMPչΪRGB(͸)
+		int comp = (int)eqoi_pixel_size(&hdr);
+		int ok;
 
-	unsigned char* data2 = stbi_load(file2, &w2, &h2, &ch2, STBI_rgb_alpha);
-	if (NULL == data2) {
-		stbi_image_free(data1);
-		printf("ERROR: cannot open file2: %s\n", file2);
+		if (!strcmp(out_ext, ".png")) {
+			ok = stbi_write_png(out_path, hdr.width, hdr.height, comp, data, hdr.width * comp);
+		}
+		else if (!strcmp(out_ext, ".raw")) {
+			ok = save_file(out_path, data, (size_t)hdr.width * hdr.height * comp) == 0;
+		}
+		else {
+			ok = stbi_write_bmp(out_path, hdr.width, hdr.height, comp, data);
+		}
 
-		return -1;
+		err = ok ? EQOI_OK : EQOI_ERR_IO;
 	}
-	printf("INFO: file1 size = %dx%d (%d channels)\n", width, height, nrChannels);
-	printf("INFO: file2 size = %dx%d (%d channels)\n", w2, h2, ch2);
 
-	if (width != w2 || height != h2 || nrChannels != ch2) {
-		printf("INFO: the two files's size not equal\n");
+	if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
 	}
-	else {
-		unsigned int* pImg1 = (unsigned int*)data1;
-		unsigned int* pImg2 = (unsigned int*)data2;
-		int errCnt = 0;
-		for (int i = 0; i < height; i++) {
-			for (int j = 0; j < width; j++) {
-				if (*pImg1 != *pImg2) {
-					errCnt++;
+	else if (!opts->quiet && opts->scale) {
+		printf("%s -> %s  1/%d thumbnail %ux%u  %u tile(s)  decode %.2f ms\n", in_path, out_path, opts->scale, hdr.width,
+			hdr.height, hdr.tile_cnt, (t1 - t0) * 1e3);
+	}
+	else if (!opts->quiet && preview) {
+		printf("%s -> %s  %ux%u  preview from %zu of %llu bytes (%d of %d passes complete)  decode %.2f ms\n", in_path,
+			out_path, hdr.width, hdr.height, file_len, (unsigned long long)(hdr.data_offset + hdr.data_len), streams,
+			EQOI_PROG_STREAMS, (t1 - t0) * 1e3);
+	}
+	else if (!opts->quiet && opts->roi_w) {
+		double mp = (double)hdr.width * hdr.height / 1e6;
+
+		printf("%s -> %s  region %u,%u,%ux%u%s  %u tile(s)  decode %.2f ms  %.1f MP/s\n", in_path, out_path, opts->roi_x,
+			opts->roi_y, hdr.width, hdr.height, idx_buf != NULL ? " (sidecar index)" : "", hdr.tile_cnt, (t1 - t0) * 1e3,
+			mp / (t1 - t0));
+	}
+	else if (!opts->quiet) {
+		double mp = (double)hdr.width * hdr.height / 1e6;
+
+		printf("%s -> %s  %ux%u  %d-bit  %u tile(s)  decode %.2f ms  %.1f MP/s\n", in_path, out_path, hdr.width, hdr.height,
+			hdr.bit_depth, hdr.tile_cnt, (t1 - t0) * 1e3, mp / (t1 - t0));
+	}
+
+	free(file_buf);
+	free(data);
+	free(idx_buf);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  У鵥EQOIļ(ļͷ/CRC32/, ָ--refʱοͼرȽ)
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_verify(const char* in_path, const cli_opts_t* opts) {
+	size_t file_len;
+	unsigned char* file_buf = load_file(in_path, &file_len);
+	unsigned char* data = NULL;
+	eqoi_header_t hdr;
+	int err = file_buf == NULL ? EQOI_ERR_IO : eqoi_parse_header(file_buf, file_len, &hdr);
+	int diff = 0;
+	char ref_path[PATH_LEN];
+	ref_rows_t ref;
+	eqoi_verify_result_t res;
+
+	memset(&ref, 0, sizeof(ref_rows_t));
+
+	if (opts->ref_path != NULL) {
+		struct stat st;
+
+		if (stat(opts->ref_path, &st) == 0 && S_ISDIR(st.st_mode)) {
+			// οĿ¼: ͬͼļ
+			static const char* const ref_exts[] = { ".bmp", ".png", ".jpg", ".tga", ".yuv", NULL };
+			cli_opts_t ref_opts = *opts;
+
+			ref_opts.out_path = opts->ref_path;
+			ref_opts.multi = 1;
+
+			for (int i = 0; ref_exts[i] != NULL; i++) {
+				make_out_path(in_path, &ref_opts, ref_exts[i], ref_path);
+				if (stat(ref_path, &st) == 0) {
+					break;
 				}
-				pImg1++;
-				pImg2++;
 			}
 		}
-		if (errCnt > 0) {
-			printf("INFO: there are %d different pixels\n", errCnt);
+		else {
+			snprintf(ref_path, sizeof(ref_path), "%s", opts->ref_path);
+		}
+	}
 
-			return -1;
+	double t0 = now_s();
+	if (err == EQOI_OK) {
+		err = eqoi_check_data(file_buf, &hdr);
+	}
+	if (err == EQOI_OK) {
+		err = eqoi_use_dict(&hdr, opts->dict);
+	}
+	if (err == EQOI_OK && opts->ref_path != NULL && !EQOI_FMT_IS_YUV(hdr.pixel_fmt)) {
+		// н벢οбȽ, 
+		if (ref_open(ref_path, &hdr, &ref) != 0) {
+			diff = -1;
+		}
+		else if (ref.w != hdr.width || ref.h != hdr.height) {
+			printf("FAIL: %s: size %ux%u differs from reference %ux%u\n", in_path, hdr.width, hdr.height, ref.w, ref.h);
+			diff = -1;
 		}
 		else {
-			printf("INFO: the two files are same\n");
+			err = eqoi_verify_rows(file_buf, &hdr, ref_row, &ref, &res);
+
+			if (err == EQOI_OK && !res.match) {
+				printf("FAIL: %s: first mismatch at pixel (%u, %u)\n", in_path, res.x, res.y);
+				diff = -1;
+			}
 		}
 	}
+	else if (err == EQOI_OK) {
+		data = malloc(eqoi_decoded_size(&hdr));
+		err = data == NULL ? EQOI_ERR_MEM : decode_image(file_buf, &hdr, opts, data);
+	}
+	double t1 = now_s();
 
-	stbi_image_free(data1);
-	stbi_image_free(data2);
+	if (err == EQOI_OK && opts->ref_path != NULL && EQOI_FMT_IS_YUV(hdr.pixel_fmt)) {
+		// YUVοΪԭʼļ(ͬ), ֽڱȽ
+		size_t ref_len;
+		unsigned char* yuv_ref = load_file(ref_path, &ref_len);
 
-	return 0;
+		if (yuv_ref == NULL) {
+			printf("ERROR: cannot open reference %s\n", ref_path);
+			diff = -1;
+		}
+		else if (ref_len != eqoi_decoded_size(&hdr) || memcmp(yuv_ref, data, ref_len)) {
+			printf("FAIL: %s: differs from reference %s\n", in_path, ref_path);
+			diff = -1;
+		}
+
+		free(yuv_ref);
+	}
+
+	if (err != EQOI_OK) {
+		printf("FAIL: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else if (!diff && !opts->quiet) {
+		printf("OK: %s  %ux%u  %s%s  %.1f MP/s\n", in_path, hdr.width, hdr.height,
+			hdr.version ? "crc ok" : "legacy", opts->ref_path != NULL ? ", matches reference" : "",
+			(double)hdr.width * hdr.height / 1e6 / (t1 - t0));
+	}
+
+	free(file_buf);
+	free(data);
+	ref_close(&ref);
+
+	return err == EQOI_OK && !diff ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  ٵͼļ(ԤȺظ, λp99ʡѹʡռȼPNG/memcpy׼)
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_bench(const char* in_path, const cli_opts_t* opts) {
+	int width, height, nrChannels;
+	unsigned char* data = stbi_load(in_path, &width, &height, &nrChannels, STBI_rgb);
+
+	if (data == NULL) {
+		printf("ERROR: cannot open %s\n", in_path);
+
+		return -1;
+	}
+
+	eqoi_bench_cfg_t cfg;
+	eqoi_bench_result_t res;
+
+	bench_cfg(opts, &cfg);
+
+	int err = eqoi_bench_image(data, width, height, &cfg, &res);
+
+	if (err == EQOI_ERR_FORMAT) {
+		printf("ERROR: %s: round trip mismatch\n", in_path);
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else {
+		char title[PATH_LEN + 128];
+		eqoi_header_t hdr;
+
+		eqoi_init_header(&hdr, width, height, cfg.tile_w, cfg.tile_h);
+		snprintf(title, sizeof(title), "%s  %dx%d  (%d thread(s), %u tile(s), %d reps after %d warmup)", in_path,
+			width, height, cfg.threads <= 0 ? eqoi_cpu_count() : cfg.threads, hdr.tile_cnt, cfg.reps, cfg.warmup);
+
+		if (!opts->quiet) {
+			eqoi_bench_print(stdout, title, &res, &cfg);
+		}
+
+		eqoi_bench_accumulate(opts->bench_total, &res);
+	}
+
+	stbi_image_free(data);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  ͳƵͼļı뿪(͵ֽԤֱͼ, ÿֽͼ)
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_stats(const char* in_path, const cli_opts_t* opts) {
+	int width, height, nrChannels;
+	unsigned char* data = stbi_load(in_path, &width, &height, &nrChannels, STBI_rgb);
+
+	if (data == NULL) {
+		printf("ERROR: cannot open %s\n", in_path);
+
+		return -1;
+	}
+
+	char heat_path[PATH_LEN];
+	qoi_enc_stats_t stats;
+	int err = eqoi_collect_stats(data, width, height, opts->tile_w, opts->tile_h, &stats);
+
+	// ͼдĿ¼(δָ-oʱΪǰĿ¼), дļԱ
+	cli_opts_t heat_opts = *opts;
+
+	heat_opts.out_path = opts->out_path != NULL ? opts->out_path : ".";
+	heat_opts.multi = 1;
+	make_out_path(in_path, &heat_opts, ".heat.png", heat_path);
+
+	if (err == EQOI_OK) {
+		err = eqoi_write_heatmap(&stats, heat_path, width, height);
+	}
+
+	if (err == EQOI_ERR_UNSUPPORTED) {
+		printf("ERROR: %s: statistics need a build with -DEQOI_STATS\n", in_path);
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else if (!opts->quiet) {
+		printf("%s  %dx%d  heatmap -> %s\n", in_path, width, height, heat_path);
+		eqoi_print_stats(stdout, &stats);
+	}
+
+	eqoi_free_stats(&stats);
+	stbi_image_free(data);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  ֽ׶ͼļı(ÿصĽ׶ʱӲ)
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_profile(const char* in_path, const cli_opts_t* opts) {
+	int width, height, nrChannels;
+	unsigned char* data = stbi_load(in_path, &width, &height, &nrChannels, STBI_rgb);
+
+	if (data == NULL) {
+		printf("ERROR: cannot open %s\n", in_path);
+
+		return -1;
+	}
+
+	eqoi_prof_result_t res;
+	int err = eqoi_profile_image(data, width, height, opts->reps, &res);
+
+	if (err == EQOI_ERR_UNSUPPORTED) {
+		printf("ERROR: %s: profiling needs a build with -DEQOI_PROFILE\n", in_path);
+	}
+	else if (err == EQOI_ERR_FORMAT) {
+		printf("ERROR: %s: round trip mismatch\n", in_path);
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else if (!opts->quiet) {
+		printf("%s  %dx%d  (%d reps)\n", in_path, width, height, opts->reps);
+		eqoi_print_profile(stdout, &res);
+	}
+
+	stbi_image_free(data);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  ΪEQOIļ೵(.eqix), Ӽָһеĺʱ
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_index(const char* in_path, const cli_opts_t* opts) {
+	char out_path[PATH_LEN];
+
+	make_out_path(in_path, opts, ".eqix", out_path);
+
+	size_t file_len;
+	unsigned char* file_buf = load_file(in_path, &file_len);
+	unsigned char* idx = NULL;
+	unsigned char* row = NULL;
+	size_t idx_cap = 0;
+	size_t idx_len = 0;
+	eqoi_header_t hdr;
+	eqoi_index_t index;
+	int err = file_buf == NULL ? EQOI_ERR_IO : eqoi_parse_header(file_buf, file_len, &hdr);
+
+	if (err == EQOI_OK) {
+		err = eqoi_check_data(file_buf, &hdr);
+	}
+	if (err == EQOI_OK) {
+		err = eqoi_use_dict(&hdr, opts->dict);
+	}
+	if (err == EQOI_OK) {
+		idx_cap = eqoi_index_size(&hdr, opts->interval);
+		err = idx_cap ? EQOI_OK : EQOI_ERR_ARG;
+	}
+	if (err == EQOI_OK) {
+		idx = malloc(idx_cap);
+		row = malloc((size_t)hdr.width * 3);
+		err = idx == NULL || row == NULL ? EQOI_ERR_MEM : EQOI_OK;
+	}
+
+	double t0 = now_s();
+	if (err == EQOI_OK) {
+		err = eqoi_build_index(file_buf, &hdr, opts->interval, idx, idx_cap, &idx_len);
+	}
+	double t1 = now_s();
+	if (err == EQOI_OK) {
+		err = eqoi_parse_index(idx, idx_len, &hdr, &index);
+	}
+	if (err == EQOI_OK) {
+		err = eqoi_decode_rows_indexed(file_buf, &hdr, &index, hdr.height - 1, 1, row, (size_t)hdr.width * 3);
+	}
+	double t2 = now_s();
+
+	if (err == EQOI_OK) {
+		err = save_file(out_path, idx, idx_len) == 0 ? EQOI_OK : EQOI_ERR_IO;
+	}
+
+	if (err == EQOI_ERR_ARG) {
+		printf("ERROR: %s: only single-stream 8-bit RGB files with the med codec can be indexed\n", in_path);
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else if (!opts->quiet) {
+		printf("%s -> %s  %ux%u  %u checkpoint(s) every %u rows  %.1f KB (%.2f%% of file)  build %.2f ms  "
+			"last row %.3f ms\n", in_path, out_path, hdr.width, hdr.height, index.cp_cnt, index.interval, idx_len / 1024.0,
+			100.0 * idx_len / file_len, (t1 - t0) * 1e3, (t2 - t1) * 1e3);
+	}
+
+	free(file_buf);
+	free(idx);
+	free(row);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  ѹвüEQOIļ(--regionָ, δ߽пķֱֿӸ)
+@param  in_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_crop(const char* in_path, const cli_opts_t* opts) {
+	char out_path[PATH_LEN];
+
+	make_out_path(in_path, opts, ".crop.eqoi", out_path);
+
+	size_t file_len;
+	unsigned char* file_buf = load_file(in_path, &file_len);
+	unsigned char* dst = NULL;
+	size_t cap = 0;
+	size_t out_len = 0;
+	eqoi_header_t hdr;
+	eqoi_edit_stats_t st;
+	int err = file_buf == NULL ? EQOI_ERR_IO : eqoi_parse_header(file_buf, file_len, &hdr);
+
+	if (err == EQOI_OK) {
+		err = eqoi_check_data(file_buf, &hdr);
+	}
+	if (err == EQOI_OK) {
+		err = eqoi_use_dict(&hdr, opts->dict);
+	}
+	if (err == EQOI_OK && (opts->roi_x >= hdr.width || opts->roi_y >= hdr.height || opts->roi_w > hdr.width - opts->roi_x ||
+		opts->roi_h > hdr.height - opts->roi_y)) {
+		printf("ERROR: %s: region %u,%u,%ux%u exceeds the %ux%u image\n", in_path, opts->roi_x, opts->roi_y, opts->roi_w,
+			opts->roi_h, hdr.width, hdr.height);
+		free(file_buf);
+
+		return -1;
+	}
+	if (err == EQOI_OK) {
+		cap = eqoi_edit_max_size(&hdr, opts->roi_w, opts->roi_h);
+		dst = malloc(cap);
+		err = dst == NULL ? EQOI_ERR_MEM : EQOI_OK;
+	}
+
+	double t0 = now_s();
+	if (err == EQOI_OK) {
+		err = eqoi_crop(file_buf, &hdr, opts->roi_x, opts->roi_y, opts->roi_w, opts->roi_h, opts->threads, dst, cap, &out_len,
+			&st);
+	}
+	double t1 = now_s();
+
+	if (err == EQOI_OK) {
+		err = save_file(out_path, dst, out_len) == 0 ? EQOI_OK : EQOI_ERR_IO;
+	}
+
+	if (err == EQOI_ERR_ARG) {
+		printf("ERROR: %s: YUV and progressive files cannot be cropped, Bayer regions must start and end on even "
+			"rows and columns\n", in_path);
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else if (!opts->quiet) {
+		printf("%s -> %s  region %u,%u,%ux%u  %u tile(s) copied (%.1f KB), %u re-encoded  %.1f KB  %.2f ms\n", in_path,
+			out_path, opts->roi_x, opts->roi_y, opts->roi_w, opts->roi_h, st.copied, st.copied_bytes / 1024.0, st.reencoded,
+			out_len / 1024.0, (t1 - t0) * 1e3);
+	}
+
+	free(file_buf);
+	free(dst);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  ѹнEQOIļƴΪһ(--colsÿеĸų, -oָ, ĬΪstitch.eqoi)
+@param  files ļ·б(ָ, դ˳)
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_stitch(const path_list_t* files, const cli_opts_t* opts) {
+	const char* out_path = opts->out_path != NULL ? opts->out_path : "stitch.eqoi";
+	uint32_t cols = opts->cols ? opts->cols : (uint32_t)files->n;
+	uint32_t rows = cols ? (uint32_t)files->n / cols : 0;
+
+	if (!files->n || (uint32_t)files->n != cols * rows) {
+		printf("ERROR: %d input(s) do not fill a grid of %u column(s)\n", files->n, cols);
+
+		return -1;
+	}
+
+	unsigned char** bufs = calloc(files->n, sizeof(unsigned char*));
+	eqoi_header_t* hdrs = calloc(files->n, sizeof(eqoi_header_t));
+	unsigned char* dst = NULL;
+	size_t cap = 0;
+	size_t out_len = 0;
+	uint32_t img_w = 0;
+	uint32_t img_h = 0;
+	uint64_t in_len = 0;
+	eqoi_edit_stats_t st;
+	int err = bufs == NULL || hdrs == NULL ? EQOI_ERR_MEM : EQOI_OK;
+	int bad = -1; // 
+
+	for (int i = 0; i < files->n && err == EQOI_OK; i++) {
+		size_t len;
+
+		bufs[i] = load_file(files->paths[i], &len);
+		err = bufs[i] == NULL ? EQOI_ERR_IO : eqoi_parse_header(bufs[i], len, &hdrs[i]);
+
+		if (err == EQOI_OK) {
+			err = eqoi_check_data(bufs[i], &hdrs[i]);
+		}
+		if (err == EQOI_OK) {
+			err = eqoi_use_dict(&hdrs[i], opts->dict);
+		}
+
+		bad = err == EQOI_OK ? -1 : i;
+		in_len += len;
+	}
+
+	if (err == EQOI_OK) {
+		err = eqoi_stitch_dims(hdrs, cols, rows, &img_w, &img_h);
+	}
+	if (err == EQOI_OK) {
+		cap = eqoi_edit_max_size(&hdrs[0], img_w, img_h);
+		dst = malloc(cap);
+		err = dst == NULL ? EQOI_ERR_MEM : EQOI_OK;
+	}
+
+	double t0 = now_s();
+	if (err == EQOI_OK) {
+		err = eqoi_stitch((const unsigned char* const*)bufs, hdrs, cols, rows, opts->threads, dst, cap, &out_len, &st);
+	}
+	double t1 = now_s();
+
+	if (err == EQOI_OK) {
+		err = save_file(out_path, dst, out_len) == 0 ? EQOI_OK : EQOI_ERR_IO;
+	}
+
+	if (bad >= 0) {
+		printf("ERROR: %s: %s\n", files->paths[bad], eqoi_strerror(err));
+	}
+	else if (err == EQOI_ERR_ARG) {
+		printf("ERROR: inputs must share pixel format, bit depth, codec and dictionary (no YUV or progressive files), "
+			"and images in a grid row (column) must have the same height (width)\n");
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", out_path, eqoi_strerror(err));
+	}
+	else {
+		printf("%d file(s) -> %s  %ux%u (%ux%u grid)  %u tile(s) copied (%.1f KB), %u re-encoded  %.1f KB (inputs %.1f KB)  "
+			"%.2f ms\n", files->n, out_path, img_w, img_h, cols, rows, st.copied, st.copied_bytes / 1024.0, st.reencoded,
+			out_len / 1024.0, in_len / 1024.0, (t1 - t0) * 1e3);
+	}
+
+	for (int i = 0; bufs != NULL && i < files->n; i++) {
+		free(bufs[i]);
+	}
+
+	free(bufs);
+	free(hdrs);
+	free(dst);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@cmd
+@public
+@brief  һͼѵֵ䲢дֵļ(-oָ, ĬΪdict.eqdc)
+@param  files ͼ·б(ָ)
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+int cmd_dict(const path_list_t* files, const cli_opts_t* opts) {
+	const char* out_path = opts->out_path != NULL ? opts->out_path : "dict.eqdc";
+	eqoi_image_t* imgs = calloc(files->n + 1, sizeof(eqoi_image_t));
+	eqoi_dict_t dict;
+	uint32_t n = 0;
+	uint64_t pixels = 0;
+	int err = imgs == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	for (int i = 0; i < files->n && err == EQOI_OK; i++) {
+		int width, height, nrChannels;
+		unsigned char* data = stbi_load(files->paths[i], &width, &height, &nrChannels, STBI_rgb);
+
+		if (data == NULL) {
+			printf("ERROR: cannot open %s\n", files->paths[i]);
+			continue;
+		}
+
+		imgs[n++] = (eqoi_image_t){ data, 0, (uint32_t)width, (uint32_t)height };
+		pixels += (uint64_t)width * height;
+	}
+
+	if (err == EQOI_OK) {
+		err = n ? eqoi_train_dict(imgs, n, &dict) : EQOI_ERR_ARG;
+	}
+	if (err == EQOI_OK) {
+		unsigned char buf[EQOI_DICT_SIZE];
+
+		eqoi_write_dict(buf, &dict);
+		err = save_file(out_path, buf, EQOI_DICT_SIZE) == 0 ? EQOI_OK : EQOI_ERR_IO;
+	}
+
+	if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", out_path, eqoi_strerror(err));
+	}
+	else if (!opts->quiet) {
+		printf("%s  dictionary id %08x  trained on %u image(s), %.2f MP\n", out_path, dict.id, n, pixels / 1e6);
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		stbi_image_free(imgs[i].prgb);
+	}
+
+	free(imgs);
+
+	return err == EQOI_OK && n == (uint32_t)files->n ? 0 : -1;
+}
+
+int compare_bmp(char* file1, char* file2) {
+	int width, height, nrChannels;
+	int w2, h2, ch2;
+	unsigned char* data1 = stbi_load(file1, &width, &height, &nrChannels, STBI_rgb_alpha);
+
+	if (data1 == NULL) {
+		printf("ERROR: cannot open file1: %s\n", file1);
+
+		return -1;
+	}
+
+	unsigned char* data2 = stbi_load(file2, &w2, &h2, &ch2, STBI_rgb_alpha);
+	if (NULL == data2) {
+		stbi_image_free(data1);
+		printf("ERROR: cannot open file2: %s\n", file2);
+
+		return -1;
+	}
+	printf("INFO: file1 size = %dx%d (%d channels)\n", width, height, nrChannels);
+	printf("INFO: file2 size = %dx%d (%d channels)\n", w2, h2, ch2);
+
+	if (width != w2 || height != h2 || nrChannels != ch2) {
+		printf("INFO: the two files's size not equal\n");
+	}
+	else {
+		unsigned int* pImg1 = (unsigned int*)data1;
+		unsigned int* pImg2 = (unsigned int*)data2;
+		int errCnt = 0;
+		for (int i = 0; i < height; i++) {
+			for (int j = 0; j < width; j++) {
+				if (*pImg1 != *pImg2) {
+					errCnt++;
+				}
+				pImg1++;
+				pImg2++;
+			}
+		}
+		if (errCnt > 0) {
+			printf("INFO: there are %d different pixels\n", errCnt);
+
+			return -1;
+		}
+		else {
+			printf("INFO: the two files are same\n");
+		}
+	}
+
+	stbi_image_free(data1);
+	stbi_image_free(data2);
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void usage(void) {
+	fputs(
+		"usage: eqoi <command> [options] <file|dir>...\n"
+		"\n"
+		"commands:\n"
+		"  encode    encode images (or raw pixel files with --raw) to .eqoi; gray and gray+alpha images use\n"
+		"            the grayscale mode unless -c med or -c palette is given\n"
+		"  decode    decode .eqoi files to .bmp/.png/.raw (9-16 bit files: .png or .raw, YUV files: .yuv or .raw);\n"
+		"            a truncated progressive file decodes to a full-size preview\n"
+		"  verify    check header and CRC, decode, and optionally compare with --ref (decoded and compared\n"
+		"            row by row, stopping at the first mismatching pixel; 8-bit RGB med files hold two decoded\n"
+		"            rows, other codecs one tile row, i.e. the whole image when untiled or progressive)\n"
+		"  bench     time encode/decode against PNG and memcpy baselines, report median/p99 MP/s,\n"
+		"            compression ratio and opcode shares (default corpus: test/in*.bmp)\n"
+		"  stats     per-opcode bytes, residual histograms and a 16x16 bytes/pixel heatmap (.heat.png);\n"
+		"            needs a build with -DEQOI_STATS; heatmaps go to the -o directory (default: current directory)\n"
+		"  profile   cycles per pixel of each encode/decode stage (rdtsc) and perf counters;\n"
+		"            needs a build with -DEQOI_PROFILE\n"
+		"  index     build a .eqix sidecar of row checkpoints for single-stream 8-bit RGB files, so that rows\n"
+		"            can be decoded from the nearest checkpoint instead of the start of the stream\n"
+		"  crop      cut --region out of .eqoi files without a full decode: tiles that the region boundaries\n"
+		"            do not cut are copied, only the cut tiles are re-encoded (output <name>.crop.eqoi)\n"
+		"  stitch    join .eqoi files into one mosaic, row by row with --cols per row: eqoi stitch --cols 2\n"
+		"            -o out.eqoi a b c d; inputs whose sizes are multiples of the tile size are copied tile by tile\n"
+		"  dict      train a shared dictionary (seed index table and first pixel) from sample images:\n"
+		"            eqoi dict -o family.eqdc <samples>...\n"
+		"  compare   compare two images pixel by pixel: eqoi compare <a> <b>\n"
+		"\n", stdout);
+
+	fputs(
+		"options:\n"
+		"  -o, --output PATH    output file, or output directory for several inputs (always a directory for stats)\n"
+		"  -j, --threads N      worker threads, 0 = all cores (default 1); single-stream 8-bit RGB files (legacy, or\n"
+		"                       one tile) of at least 1 MP are decoded in parallel segments when more than one\n"
+		"                       CPU core is available\n"
+		"  -t, --tile WxH|N     tile size (default: one tile for the whole image)\n"
+		"  -c, --codec NAME     codec variant: auto (default: palette when the image has at most 256 colours\n"
+		"                       and tiles of at least 1024 pixels, otherwise med), med, palette, progressive\n"
+		"                       (coarse-to-fine passes in one tile, so that a truncated file still decodes;\n"
+		"                       photos cost about 1-8% more than med, screenshots and flat colour about 10-13%,\n"
+		"                       smooth gradients up to 84%, so use med for those unless previews are needed)\n"
+		"  -f, --format EXT     decode output format: bmp, png, raw or yuv, used even when the -o name has another\n"
+		"                       extension (default: the -o extension, else bmp)\n"
+		"      --channels N     bench inputs converted to gray (1) or gray+alpha (2) with the grayscale mode;\n"
+		"                       1 also benches the same gray image expanded to RGB\n"
+		"      --bayer PATTERN  inputs are single-channel Bayer mosaics (RGGB, GRBG, GBRG or BGGR), encoded with the\n"
+		"                       CFA mode; bench samples the RGB inputs to a mosaic and also benches the RGB image\n"
+		"      --yuv LAYOUT     raw YUV layout: nv12, i420 (4:2:0), nv16 or i422 (4:2:2); encode reads raw files of the\n"
+		"                       --raw size, decode writes this layout (default nv12/nv16), bench converts the RGB\n"
+		"                       inputs (BT.601 full range) and also benches the RGB image\n"
+		"      --depth N        significant bits (9-16) of 16-bit PNG inputs, which are encoded with the wide-sample\n"
+		"                       variant (default 16); bench widens the 8-bit inputs to N bits with low-bit noise\n", stdout);
+
+	fputs(
+		"      --raw WxH        inputs are raw 3-channel 8-bit pixels, encoded out of core (with --yuv: raw YUV\n"
+		"                       files of this size, encoded in memory)\n"
+		"      --mem SIZE       memory limit for --raw encoding, e.g. 256M (default 64M)\n"
+		"      --ref PATH       reference image or directory for verify\n"
+		"  -n, --reps N         bench/profile repetitions (default 15)\n"
+		"      --warmup N       untimed bench repetitions before timing (default 2)\n"
+		"      --no-baseline    skip the PNG and memcpy baselines in bench\n"
+		"      --tiers          bench every SIMD tier the CPU supports (scalar, sse2, sse41, avx2, avx512) and check\n"
+		"                       that they produce identical files; the gray, CFA, YUV and 9-16 bit modes use them\n"
+		"      --synth LIST     bench synthetic images: all or a comma list of ui,photo,noise,gradient,flat;\n"
+		"                       with -o DIR the generated images are also saved as .bmp\n"
+		"      --sizes LIST     synthetic image sizes, N or WxH up to 16384 (default 64,256,1024,4096)\n"
+		"      --seed N         synthetic image seed (default 1)\n"
+		"      --batch N        bench N synthetic images per class and size (seeds seed..seed+N-1) as one batch,\n"
+		"                       comparing per-image eqoi_encode/eqoi_decode with eqoi_encode_batch/eqoi_decode_batch\n"
+		"                       (both with the med codec, the only one the batch API writes)\n"
+		"      --dict FILE      dictionary for encode (files then need it to decode), decode, verify and bench\n"
+		"      --train-dict     with --batch, train a dictionary on seeds seed+N..seed+2N-1 and bench with it\n"
+		"      --region X,Y,WxH decode only this rectangle: tiled files decode the tiles it touches, single-stream\n"
+		"                       files resume from the <name>.eqix sidecar next to the input when there is one\n"
+		"      --cols N         stitch grid columns (default: all inputs in one row)\n"
+		"      --scale N        decode a 1/N box-filtered thumbnail (N = 2, 4 or 8) of an 8-bit RGB file row by\n"
+		"                       row, without the full-size image in memory\n"
+		"      --interval N     rows between index checkpoints (default 128); the sidecar is about 1/N of the\n"
+		"                       decoded image\n"
+		"  -q, --quiet          only report errors and totals\n", stdout);
+}
+
+/*************************
+@parse
+@private
+@brief  WxHNĳߴ
+@param  s ַ
+		w (ָ)
+		h ߶(ָ)
+@return 0ʾɹ
+*************************/
+static int parse_dims(const char* s, uint32_t* w, uint32_t* h) {
+	char* end;
+	unsigned long a = strtoul(s, &end, 10);
+	unsigned long b = a;
+
+	if (*end == 'x' || *end == 'X') {
+		b = strtoul(end + 1, &end, 10);
+	}
+
+	if (*end || !a || !b || a > UINT32_MAX || b > UINT32_MAX) {
+		return -1;
+	}
+
+	*w = (uint32_t)a;
+	*h = (uint32_t)b;
+
+	return 0;
+}
+
+/*************************
+@parse
+@private
+@brief  ѡ
+@param  argc 
+		argv (׵ַ)
+		opts ѡ(ָ)
+		inputs ·б(ָ)
+@return 0ʾɹ
+*************************/
+static int parse_opts(int argc, char** argv, cli_opts_t* opts, path_list_t* inputs) {
+	memset(opts, 0, sizeof(cli_opts_t));
+	opts->threads = 1;
+	opts->codec = EQOI_CODEC_AUTO;
+	opts->reps = EQOI_BENCH_DEFAULT_REPS;
+	opts->warmup = EQOI_BENCH_DEFAULT_WARMUP;
+	opts->mem_limit = EQOI_STREAM_DEFAULT_MEM;
+	opts->interval = EQOI_INDEX_INTERVAL;
+	opts->synth_sizes = synth_default_sizes;
+	opts->seed = 1;
+	opts->channels = 3;
+
+	inputs->paths = NULL;
+	inputs->n = 0;
+	inputs->cap = 0;
+
+	for (int i = 0; i < argc; i++) {
+		const char* a = argv[i];
+		const char* v = i + 1 < argc ? argv[i + 1] : NULL;
+		_Bool takes_value = 1;
+
+		if (a[0] != '-') {
+			if (push_path(inputs, a) != 0) {
+				return -1;
+			}
+
+			continue;
+		}
+
+		if ((!strcmp(a, "-q") || !strcmp(a, "--quiet"))) {
+			opts->quiet = 1;
+			takes_value = 0;
+		}
+		else if (!strcmp(a, "--no-baseline")) {
+			opts->no_baseline = 1;
+			takes_value = 0;
+		}
+		else if (!strcmp(a, "--train-dict")) {
+			opts->train_dict = 1;
+			takes_value = 0;
+		}
+		else if (!strcmp(a, "--tiers")) {
+			opts->tiers = 1;
+			takes_value = 0;
+		}
+		else if (v == NULL) {
+			printf("ERROR: option %s needs a value\n", a);
+
+			return -1;
+		}
+		else if (!strcmp(a, "-o") || !strcmp(a, "--output")) {
+			opts->out_path = v;
+		}
+		else if (!strcmp(a, "-j") || !strcmp(a, "--threads")) {
+			opts->threads = atoi(v);
+		}
+		else if (!strcmp(a, "-t") || !strcmp(a, "--tile")) {
+			if (parse_dims(v, &opts->tile_w, &opts->tile_h) != 0) {
+				printf("ERROR: bad tile size %s\n", v);
+
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "-c") || !strcmp(a, "--codec")) {
+			opts->codec = -1;
+
+			for (int k = 0; k < (int)(sizeof(codec_names) / sizeof(codec_names[0])); k++) {
+				if (!strcmp(v, codec_names[k])) {
+					opts->codec = k;
+				}
+			}
+
+			if (opts->codec < 0) {
+				printf("ERROR: unknown codec %s\n", v);
+
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "-f") || !strcmp(a, "--format")) {
+			if (strcmp(v, "bmp") && strcmp(v, "png") && strcmp(v, "raw") && strcmp(v, "yuv")) {
+				printf("ERROR: unknown output format %s (bmp, png, raw or yuv)\n", v);
+
+				return -1;
+			}
+
+			opts->format = v;
+		}
+		else if (!strcmp(a, "--raw")) {
+			if (parse_dims(v, &opts->raw_w, &opts->raw_h) != 0) {
+				printf("ERROR: bad raw size %s\n", v);
+
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "--mem")) {
+			char* end;
+			double m = strtod(v, &end);
+
+			m *= (*end == 'G' || *end == 'g') ? 1073741824.0 : (*end == 'M' || *end == 'm') ? 1048576.0 :
+				(*end == 'K' || *end == 'k') ? 1024.0 : 1.0;
+			opts->mem_limit = (size_t)m;
+		}
+		else if (!strcmp(a, "--ref")) {
+			opts->ref_path = v;
+		}
+		else if (!strcmp(a, "-n") || !strcmp(a, "--reps")) {
+			opts->reps = __MAX(atoi(v), 1);
+		}
+		else if (!strcmp(a, "--synth")) {
+			opts->synth = v;
+		}
+		else if (!strcmp(a, "--sizes")) {
+			opts->synth_sizes = v;
+		}
+		else if (!strcmp(a, "--seed")) {
+			opts->seed = (uint32_t)strtoul(v, NULL, 10);
+		}
+		else if (!strcmp(a, "--batch")) {
+			opts->batch = (uint32_t)strtoul(v, NULL, 10);
+		}
+		else if (!strcmp(a, "--dict")) {
+			opts->dict_path = v;
+		}
+		else if (!strcmp(a, "--region")) {
+			if (sscanf(v, "%u,%u,%ux%u", &opts->roi_x, &opts->roi_y, &opts->roi_w, &opts->roi_h) != 4 || !opts->roi_w ||
+				!opts->roi_h) {
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "--cols")) {
+			opts->cols = (uint32_t)strtoul(v, NULL, 10);
+
+			if (!opts->cols) {
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "--scale")) {
+			opts->scale = atoi(v);
+
+			if (opts->scale != 2 && opts->scale != 4 && opts->scale != 8) {
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "--interval")) {
+			opts->interval = (uint32_t)__MAX(strtoul(v, NULL, 10), 1);
+		}
+		else if (!strcmp(a, "--warmup")) {
+			opts->warmup = __MAX(atoi(v), 0);
+		}
+		else if (!strcmp(a, "--channels")) {
+			opts->channels = atoi(v);
+
+			if (opts->channels < 1 || opts->channels > 3) {
+				printf("ERROR: --channels must be 1, 2 or 3\n");
+
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "--bayer")) {
+			opts->bayer = 0;
+
+			for (int k = 0; k < (int)(sizeof(bayer_names) / sizeof(bayer_names[0])); k++) {
+				if (!strcmp(v, bayer_names[k])) {
+					opts->bayer = EQOI_FMT_BAYER_RGGB + k;
+				}
+			}
+
+			if (!opts->bayer) {
+				printf("ERROR: unknown Bayer pattern %s (RGGB, GRBG, GBRG or BGGR)\n", v);
+
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "--yuv")) {
+			opts->yuv = 0;
+
+			for (int k = 0; k < (int)(sizeof(yuv_names) / sizeof(yuv_names[0])); k++) {
+				if (!strcmp(v, yuv_names[k])) {
+					opts->yuv = EQOI_FMT_YUV420 + k / 2;
+					opts->yuv_planar = k & 1;
+				}
+			}
+
+			if (!opts->yuv) {
+				printf("ERROR: unknown YUV layout %s (nv12, i420, nv16 or i422)\n", v);
+
+				return -1;
+			}
+		}
+		else if (!strcmp(a, "--depth")) {
+			opts->depth = atoi(v);
+
+			if (opts->depth < EQOI_WIDE_MIN_DEPTH || opts->depth > EQOI_WIDE_MAX_DEPTH) {
+				printf("ERROR: --depth must be %d to %d\n", EQOI_WIDE_MIN_DEPTH, EQOI_WIDE_MAX_DEPTH);
+
+				return -1;
+			}
+		}
+		else {
+			printf("ERROR: unknown option %s\n", a);
+
+			return -1;
+		}
+
+		i += takes_value;
+	}
+
+	return 0;
+}
+
+/*************************
+@parse
+@private
+@brief  ·б׷һ·(ַ)
+@param  list ·б(ָ)
+		path ·
+@return 0ʾɹ
+*************************/
+static int push_path(path_list_t* list, const char* path) {
+	if (list->n == list->cap) {
+		int cap = list->cap ? list->cap * 2 : 16;
+		char** paths = realloc(list->paths, sizeof(char*) * cap);
+
+		if (paths == NULL) {
+			printf("ERROR: %s\n", eqoi_strerror(EQOI_ERR_MEM));
+
+			return -1;
+		}
+
+		list->paths = paths;
+		list->cap = cap;
+	}
+
+	size_t len = strlen(path) + 1;
+	list->paths[list->n] = malloc(len);
+
+	if (list->paths[list->n] == NULL) {
+		printf("ERROR: %s\n", eqoi_strerror(EQOI_ERR_MEM));
+
+		return -1;
+	}
+
+	memcpy(list->paths[list->n++], path, len);
+
+	return 0;
+}
+
+static int cmp_path(const void* a, const void* b) {
+	return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/*************************
+@parse
+@private
+@brief  չ·(Ŀ¼չΪչƥļ, )
+@param  inputs ·б(ָ)
+		exts Ŀ¼Ҫƥչ(NULLβ)
+		files չļб(ָ)
+@return 0ʾɹ
+*************************/
+static int expand_inputs(path_list_t* inputs, const char* const* exts, path_list_t* files) {
+	int err = 0;
+
+	for (int i = 0; i < inputs->n && !err; i++) {
+		struct stat st;
+		const char* in = inputs->paths[i];
+
+		if (stat(in, &st) != 0) {
+			printf("ERROR: cannot access %s\n", in);
+			err = -1;
+
+			break;
+		}
+
+		if (!S_ISDIR(st.st_mode)) {
+			err = push_path(files, in);
+			continue;
+		}
+
+		DIR* dir = opendir(in);
+		struct dirent* ent;
+		int first = files->n;
+
+		if (dir == NULL) {
+			printf("ERROR: cannot open directory %s\n", in);
+			err = -1;
+
+			break;
+		}
+
+		while (!err && (ent = readdir(dir)) != NULL) {
+			const char* dot = strrchr(ent->d_name, '.');
+
+			for (int k = 0; dot != NULL && exts[k] != NULL; k++) {
+				if (!strcmp(dot, exts[k])) {
+					char path[PATH_LEN];
+
+					snprintf(path, sizeof(path), "%s/%s", in, ent->d_name);
+					err = push_path(files, path);
+					break;
+				}
+			}
+		}
+
+		closedir(dir);
+		qsort(files->paths + first, files->n - first, sizeof(char*), cmp_path);
+	}
+
+	if (err) {
+		// չĲһͷ
+		free_paths(files);
+	}
+
+	return err;
+}
+
+/*************************
+@parse
+@private
+@brief  ͷ·б(·ַָ)
+@param  list ·б(ָ)
+@return none
+*************************/
+static void free_paths(path_list_t* list) {
+	for (int i = 0; i < list->n; i++) {
+		free(list->paths[i]);
+	}
+
+	free(list->paths);
+	list->paths = NULL;
+	list->n = 0;
+	list->cap = 0;
+}
+
+/*************************
+@parse
+@private
+@brief  ·(Ŀ¼µͬļ, ļ滻չ)
+@param  in_path ļ·
+		opts ѡ(ָ)
+		ext չ('.')
+		buf ·(PATH_LEN)
+@return none
+*************************/
+static void make_out_path(const char* in_path, const cli_opts_t* opts, const char* ext, char* buf) {
+	const char* base = strrchr(in_path, '/');
+	base = base == NULL ? in_path : base + 1;
+
+	const char* dot = strrchr(base, '.');
+	int stem_len = dot == NULL ? (int)strlen(base) : (int)(dot - base);
+
+	if (opts->out_path != NULL && !opts->multi) {
+		snprintf(buf, PATH_LEN, "%s", opts->out_path);
+	}
+	else if (opts->out_path != NULL) {
+		snprintf(buf, PATH_LEN, "%s/%.*s%s", opts->out_path, stem_len, base, ext);
+	}
+	else {
+		snprintf(buf, PATH_LEN, "%.*s%.*s%s", (int)(base - in_path), in_path, stem_len, base, ext);
+	}
+}
+
+static unsigned char* load_file(const char* path, size_t* len) {
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL) {
+		return NULL;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long n = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	unsigned char* buf = n > 0 ? malloc((size_t)n) : NULL;
+
+	if (buf != NULL && fread(buf, 1, (size_t)n, file) != (size_t)n) {
+		free(buf);
+		buf = NULL;
+	}
+
+	fclose(file);
+	*len = (size_t)n;
+
+	return buf;
+}
+
+static int save_file(const char* path, const unsigned char* data, size_t len) {
+	FILE* file = fopen(path, "wb");
+
+	if (file == NULL) {
+		return -1;
+	}
+
+	size_t n = fwrite(data, 1, len, file);
+
+	return (fclose(file) == 0 && n == len) ? 0 : -1;
+}
+
+/*************************
+@cmd
+@private
+@brief  Ժϳͼв(ߴһ, ÿͼÿĻ)
+@param  opts ѡ(ָ)
+		images ٵͼ(ָ)
+@return ʧܵͼ
+*************************/
+static int bench_synth(const cli_opts_t* opts, int* images) {
+	_Bool use[EQOI_SYNTH_CNT];
+	char list[256];
+	int failed = 0;
+
+	// б
+	snprintf(list, sizeof(list), "%s", opts->synth);
+	for (int c = 0; c < EQOI_SYNTH_CNT; c++) {
+		use[c] = !strcmp(list, "all");
+	}
+	for (char* tok = strtok(list, ","); tok != NULL && strcmp(opts->synth, "all"); tok = strtok(NULL, ",")) {
+		int c = eqoi_synth_class(tok);
+
+		if (c < 0) {
+			printf("ERROR: unknown synthetic class %s\n", tok);
+
+			return 1;
+		}
+		use[c] = 1;
+	}
+
+	eqoi_bench_cfg_t cfg;
+	bench_cfg(opts, &cfg);
+
+	if (opts->out_path != NULL) {
+		mkdir(opts->out_path, 0755);
+	}
+
+	for (int c = 0; c < EQOI_SYNTH_CNT; c++) {
+		eqoi_bench_result_t cls_total;
+		char sizes[256];
+
+		if (!use[c]) {
+			continue;
+		}
+
+		memset(&cls_total, 0, sizeof(eqoi_bench_result_t));
+		snprintf(sizes, sizeof(sizes), "%s", opts->synth_sizes);
+
+		for (char* tok = strtok(sizes, ","); tok != NULL; tok = strtok(NULL, ",")) {
+			uint32_t w, h;
+
+			if (parse_dims(tok, &w, &h) != 0 || w > EQOI_SYNTH_MAX_SIZE || h > EQOI_SYNTH_MAX_SIZE) {
+				printf("ERROR: bad synthetic size %s\n", tok);
+				(*images)++;
+				failed++;
+				continue;
+			}
+
+			if (opts->batch) {
+				(*images)++;
+				failed += bench_synth_batch(opts, &cfg, c, w, h);
+				continue;
+			}
+
+			unsigned char* data = malloc((size_t)w * h * 3);
+			char name[64];
+			eqoi_bench_result_t res;
+			int err = data == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+			snprintf(name, sizeof(name), "%s_%ux%u", eqoi_synth_name(c), w, h);
+			(*images)++;
+
+			if (err == EQOI_OK) {
+				eqoi_synth_image(c, w, h, opts->seed, data);
+
+				if (opts->out_path != NULL) {
+					char path[PATH_LEN];
+
+					snprintf(path, sizeof(path), "%s/%s.bmp", opts->out_path, name);
+					if (!stbi_write_bmp(path, (int)w, (int)h, 3, data)) {
+						printf("ERROR: cannot write %s\n", path);
+					}
+				}
+
+				err = eqoi_bench_image(data, w, h, &cfg, &res);
+			}
+
+			if (err == EQOI_ERR_FORMAT) {
+				printf("ERROR: synth:%s: round trip mismatch\n", name);
+			}
+			else if (err != EQOI_OK) {
+				printf("ERROR: synth:%s: %s\n", name, eqoi_strerror(err));
+			}
+			else {
+				char title[128];
+
+				snprintf(title, sizeof(title), "synth:%s  (seed %u, %d thread(s), %d reps after %d warmup)", name,
+					opts->seed, cfg.threads <= 0 ? eqoi_cpu_count() : cfg.threads, cfg.reps, cfg.warmup);
+
+				if (!opts->quiet) {
+					eqoi_bench_print(stdout, title, &res, &cfg);
+				}
+
+				eqoi_bench_accumulate(&cls_total, &res);
+				eqoi_bench_accumulate(opts->bench_total, &res);
+			}
+
+			failed += err != EQOI_OK;
+			free(data);
+		}
+
+		if (cls_total.images) {
+			char title[64];
+
+			snprintf(title, sizeof(title), "class %s  %d image(s)  %.2f MP", eqoi_synth_name(c), cls_total.images,
+				cls_total.pixels / 1e6);
+			eqoi_bench_print(stdout, title, &cls_total, &cfg);
+		}
+	}
+
+	return failed;
+}
+
+/*************************
+@cmd
+@private
+@brief  һͬͬߴĺϳͼ
+@param  opts ѡ(ָ)
+		cfg ׼(ָ)
+		cls 
+		w ͼ
+		h ͼ߶
+@return 0ʾɹ
+*************************/
+static int bench_synth_batch(const cli_opts_t* opts, const eqoi_bench_cfg_t* cfg, int cls, uint32_t w, uint32_t h) {
+	size_t raw_len = (size_t)w * h * 3;
+	unsigned char* data = malloc(raw_len * opts->batch);
+	eqoi_image_t* imgs = malloc(sizeof(eqoi_image_t) * opts->batch);
+	eqoi_bench_batch_result_t res;
+	eqoi_bench_cfg_t batch_cfg = *cfg;
+	eqoi_dict_t dict;
+	int err = (data == NULL || imgs == NULL) ? EQOI_ERR_MEM : EQOI_OK;
+	char name[64];
+
+	snprintf(name, sizeof(name), "%s_%ux%u", eqoi_synth_name(cls), w, h);
+
+	if (err == EQOI_OK && opts->train_dict) {
+		// Բٵһѵ, ߹ֵЧ
+		for (uint32_t i = 0; i < opts->batch; i++) {
+			imgs[i] = (eqoi_image_t){ data + raw_len * i, 0, w, h };
+			eqoi_synth_image(cls, w, h, opts->seed + opts->batch + i, imgs[i].prgb);
+		}
+
+		err = eqoi_train_dict(imgs, opts->batch, &dict);
+		batch_cfg.dict = &dict;
+	}
+	if (err == EQOI_OK) {
+		for (uint32_t i = 0; i < opts->batch; i++) {
+			imgs[i] = (eqoi_image_t){ data + raw_len * i, 0, w, h };
+			eqoi_synth_image(cls, w, h, opts->seed + i, imgs[i].prgb);
+		}
+
+		err = eqoi_bench_batch(imgs, opts->batch, &batch_cfg, &res);
+	}
+
+	if (err == EQOI_ERR_FORMAT) {
+		printf("ERROR: synth:%s: batch round trip mismatch\n", name);
+	}
+	else if (err != EQOI_OK) {
+		printf("ERROR: synth:%s: %s\n", name, eqoi_strerror(err));
+	}
+	else {
+		char title[160];
+
+		snprintf(title, sizeof(title), "synth:%s  batch of %u (seeds %u..%u, %d thread(s), %d reps after %d warmup%s)",
+			name, opts->batch, opts->seed, opts->seed + opts->batch - 1,
+			cfg->threads <= 0 ? eqoi_cpu_count() : cfg->threads, cfg->reps, cfg->warmup,
+			batch_cfg.dict == NULL ? "" : opts->train_dict ? ", trained dictionary" : ", dictionary");
+		eqoi_bench_print_batch(stdout, title, &res);
+	}
+
+	free(data);
+	free(imgs);
+
+	return err != EQOI_OK;
+}
+
+/*************************
+@parse
+@private
+@brief  ѡɻ׼
+@param  opts ѡ(ָ)
+		cfg ׼(ָ)
+@return none
+*************************/
+static void bench_cfg(const cli_opts_t* opts, eqoi_bench_cfg_t* cfg) {
+	eqoi_bench_init_cfg(cfg);
+
+	cfg->reps = opts->reps;
+	cfg->warmup = opts->warmup;
+	cfg->threads = opts->threads;
+	cfg->tile_w = opts->tile_w;
+	cfg->tile_h = opts->tile_h;
+	cfg->baselines = !opts->no_baseline;
+	cfg->dict = opts->dict;
+	cfg->codec = opts->codec;
+	cfg->bit_depth = opts->depth ? opts->depth : 8;
+	cfg->channels = opts->channels;
+	cfg->bayer = opts->bayer;
+	cfg->yuv = opts->yuv;
+	cfg->yuv_planar = opts->yuv_planar;
+	cfg->tiers = opts->tiers;
+}
+
+/*************************
+@io
+@private
+@brief  زУֵļ
+@param  path ֵļ·
+		dict ֵ(ָ)
+@return 0ʾɹ
+*************************/
+static int load_dict(const char* path, eqoi_dict_t* dict) {
+	size_t len;
+	unsigned char* buf = load_file(path, &len);
+	int err = buf == NULL ? EQOI_ERR_IO : eqoi_parse_dict(buf, len, dict);
+
+	if (err != EQOI_OK) {
+		printf("ERROR: dictionary %s: %s\n", path, eqoi_strerror(err));
+	}
+
+	free(buf);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@io
+@private
+@brief  ԵĲ೵(<>.eqix, ֻڵļ)
+@param  in_path ļ·
+		hdr ļļͷ(ָ)
+		index õ(ָ)
+@return (malloc, ûļӦʱNULL)
+*************************/
+static unsigned char* load_index(const char* in_path, const eqoi_header_t* hdr, eqoi_index_t* index) {
+	if (hdr->tile_cnt != 1) {
+		return NULL;
+	}
+
+	char idx_path[PATH_LEN];
+	cli_opts_t idx_opts;
+	size_t len;
+
+	memset(&idx_opts, 0, sizeof(cli_opts_t));
+	make_out_path(in_path, &idx_opts, ".eqix", idx_path);
+
+	unsigned char* buf = load_file(idx_path, &len);
+	int err = buf == NULL ? EQOI_ERR_IO : eqoi_parse_index(buf, len, hdr, index);
+
+	if (buf != NULL && err != EQOI_OK) {
+		printf("WARNING: ignoring sidecar index %s: %s\n", idx_path, eqoi_strerror(err));
+		free(buf);
+		buf = NULL;
+	}
+
+	return buf;
+}
+
+/*************************
+@io
+@private
+@brief  򿪲οͼжȡ: 8λRGBļĲοΪδѹ24/32λBMPʱʽȡ, ֻռһеڴ; ʽĲοͼ
+		(Ҷ/Bayerοstb_imageתΪͨ, 16λοload_png16)
+@param  path οͼ·
+		hdr Уļļͷ(ָ, οе)
+		ref οͼ(ָ, ref_closeر)
+@return 0ʾɹ(ʧʱ)
+*************************/
+static int ref_open(const char* path, const eqoi_header_t* hdr, ref_rows_t* ref) {
+	unsigned char bmp[34];
+	size_t px = eqoi_pixel_size(hdr);
+	int w, h, n;
+
+	memset(ref, 0, sizeof(ref_rows_t));
+	ref->file = hdr->pixel_fmt == EQOI_FMT_RGB8 ? fopen(path, "rb") : NULL;
+
+	if (ref->file != NULL && fread(bmp, 1, sizeof(bmp), ref->file) == sizeof(bmp) && bmp[0] == 'B' && bmp[1] == 'M' &&
+		(bmp[28] == 24 || bmp[28] == 32) && !bmp[29] && !(bmp[30] | bmp[31] | bmp[32] | bmp[33])) {
+		// δѹBMP(BI_RGB): а4ֽڶ, ذb, g, r(, x), ߶Ϊʱϵ´
+		int32_t bw = (int32_t)(bmp[18] | bmp[19] << 8 | bmp[20] << 16 | (uint32_t)bmp[21] << 24);
+		int32_t bh = (int32_t)(bmp[22] | bmp[23] << 8 | bmp[24] << 16 | (uint32_t)bmp[25] << 24);
+
+		ref->data_offset = (long)(bmp[10] | bmp[11] << 8 | bmp[12] << 16 | (uint32_t)bmp[13] << 24);
+		ref->bmp_bytes = bmp[28] / 8;
+		ref->top_down = bh < 0;
+		ref->w = bw > 0 ? (uint32_t)bw : 0;
+		ref->h = bh < 0 ? 0u - (uint32_t)bh : (uint32_t)bh;
+		ref->row_len = (size_t)ref->w * 3;
+		ref->raw_len = ((size_t)ref->w * ref->bmp_bytes + 3) & ~(size_t)3;
+		ref->raw = malloc(ref->raw_len);
+		ref->row = malloc(ref->row_len);
+
+		if (ref->raw == NULL || ref->row == NULL) {
+			printf("ERROR: %s: %s\n", path, eqoi_strerror(EQOI_ERR_MEM));
+			ref_close(ref);
+
+			return -1;
+		}
+
+		return 0;
+	}
+
+	if (ref->file != NULL) {
+		fclose(ref->file);
+		ref->file = NULL;
+	}
+
+	if (hdr->pixel_fmt == EQOI_FMT_RGB16) {
+		ref->pixels = (unsigned char*)load_png16(path, hdr->bit_depth, &w, &h);
+		ref->wide = 1;
+	}
+	else if ((ref->pixels = stbi_load(path, &w, &h, &n, (int)px)) == NULL) {
+		printf("ERROR: cannot open reference %s\n", path);
+	}
+
+	if (ref->pixels == NULL) {
+		return -1;
+	}
+
+	ref->w = (uint32_t)w;
+	ref->h = (uint32_t)h;
+	ref->row_len = (size_t)w * px;
+
+	return 0;
+}
+
+/*************************
+@io
+@private
+@brief  ȡοͼһ(eqoi_verify_rowsĲοлص)
+@param  ctx οͼ(ָ, ref_rows_t)
+		y к
+@return (ָ, ͬ, ȡʧʱNULL)
+*************************/
+static const unsigned char* ref_row(void* ctx, uint32_t y) {
+	ref_rows_t* ref = (ref_rows_t*)ctx;
+
+	if (ref->file == NULL) {
+		return ref->pixels + (size_t)y * ref->row_len;
+	}
+
+	long pos = ref->data_offset + (long)((ref->top_down ? y : ref->h - 1 - y) * ref->raw_len);
+
+	if (fseek(ref->file, pos, SEEK_SET) != 0 || fread(ref->raw, 1, ref->raw_len, ref->file) != ref->raw_len) {
+		return NULL;
+	}
+
+	const unsigned char* src = ref->raw;
+	unsigned char* dst = ref->row;
+
+	for (uint32_t x = 0; x < ref->w; x++, src += ref->bmp_bytes, dst += 3) {
+		dst[0] = src[2];
+		dst[1] = src[1];
+		dst[2] = src[0];
+	}
+
+	return ref->row;
+}
+
+/*************************
+@io
+@private
+@brief  رղοͼ
+@param  ref οͼ(ָ)
+@return none
+*************************/
+static void ref_close(ref_rows_t* ref) {
+	if (ref->file != NULL) {
+		fclose(ref->file);
+	}
+	if (ref->wide) {
+		free(ref->pixels);
+	}
+	else if (ref->pixels != NULL) {
+		stbi_image_free(ref->pixels);
+	}
+
+	free(ref->raw);
+	free(ref->row);
+	memset(ref, 0, sizeof(ref_rows_t));
+}
+
+/*************************
+@io
+@private
+@brief  16λPNGƵЧλ(PNG16λŵλ, ƳĵλΪ0)
+@param  path ļ·
+		bit_depth Чλ
+		w ͼ(ָ)
+		h ͼ߶(ָ)
+@return (malloc, ʧʱ󲢷NULL)
+*************************/
+static uint16_t* load_png16(const char* path, int bit_depth, int* w, int* h) {
+	int n;
+	stbi_us* data = stbi_load_16(path, w, h, &n, STBI_rgb);
+
+	if (data == NULL) {
+		printf("ERROR: cannot open %s\n", path);
+
+		return NULL;
+	}
+
+	size_t cnt = (size_t)*w * *h * 3;
+	uint16_t* samples = malloc(cnt * sizeof(uint16_t));
+	int s = 16 - bit_depth;
+	uint16_t low = 0;
+
+	if (samples != NULL) {
+		for (size_t i = 0; i < cnt; i++) {
+			low |= data[i];
+			samples[i] = data[i] >> s;
+		}
+	}
+
+	stbi_image_free(data);
+
+	if (samples == NULL || (low & ((1u << s) - 1))) {
+		printf("ERROR: %s: %s\n", path, samples == NULL ? eqoi_strerror(EQOI_ERR_MEM) : "samples exceed the given bit depth");
+		free(samples);
+
+		return NULL;
+	}
+
+	return samples;
+}
+
+/*************************
+@encode
+@private
+@brief  YUVԭʼļ(ߴ--rawָ, --yuvָ)
+@param  in_path ļ·
+		out_path ļ·
+		opts ѡ(ָ)
+@return 0ʾɹ
+*************************/
+static int encode_yuv_file(const char* in_path, const char* out_path, const cli_opts_t* opts) {
+	uint32_t width = opts->raw_w, height = opts->raw_h;
+	int sub_y = EQOI_YUV_SUB_Y(opts->yuv);
+	size_t len;
+	unsigned char* data = load_file(in_path, &len);
+	eqoi_yuv_t img;
+
+	if (data == NULL) {
+		printf("ERROR: cannot open %s\n", in_path);
+
+		return -1;
+	}
+	if (len != eqoi_yuv_layout(data, width, height, sub_y, opts->yuv_planar, &img)) {
+		printf("ERROR: %s: %zu bytes, a %ux%u %s image has %zu\n", in_path, len, width, height,
+			yuv_names[(opts->yuv - EQOI_FMT_YUV420) * 2 + opts->yuv_planar], eqoi_yuv_layout(NULL, width, height, sub_y,
+			opts->yuv_planar, &img));
+		free(data);
+
+		return -1;
+	}
+
+	// ֿ밴ɫȳ(ͼȻ߶ȵķֿ)
+	if ((opts->tile_w && opts->tile_w < width && (opts->tile_w & 1)) ||
+		(opts->tile_h && opts->tile_h < height && opts->tile_h % sub_y)) {
+		printf("ERROR: %s: YUV tiles need an even width%s\n", in_path, sub_y == 2 ? " and height" : "");
+		free(data);
+
+		return -1;
+	}
+
+	size_t cap = eqoi_max_file_size_yuv(width, height, opts->tile_w, opts->tile_h, opts->yuv);
+	unsigned char* file_buf = malloc(cap);
+	size_t file_len = 0;
+	int err = file_buf == NULL ? EQOI_ERR_MEM : EQOI_OK;
+
+	double t0 = now_s();
+	if (err == EQOI_OK) {
+		err = eqoi_encode_yuv(&img, width, height, opts->yuv, opts->tile_w, opts->tile_h, opts->threads, file_buf, cap,
+			&file_len);
+	}
+	double t1 = now_s();
+
+	if (err == EQOI_OK && save_file(out_path, file_buf, file_len) != 0) {
+		err = EQOI_ERR_IO;
+	}
+
+	if (err != EQOI_OK) {
+		printf("ERROR: %s: %s\n", in_path, eqoi_strerror(err));
+	}
+	else if (!opts->quiet) {
+		double mp = (double)width * height / 1e6;
+
+		// ѹYUVԭʼ
+		printf("%s -> %s  %ux%u  %s  ratio %.4f  encode %.2f ms  %.1f MP/s\n", in_path, out_path, width, height,
+			yuv_names[(opts->yuv - EQOI_FMT_YUV420) * 2 + opts->yuv_planar], (double)file_len / len, (t1 - t0) * 1e3,
+			mp / (t1 - t0));
+	}
+
+	free(data);
+	free(file_buf);
+
+	return err == EQOI_OK ? 0 : -1;
+}
+
+/*************************
+@decode
+@private
+@brief  ͼ(YUVļ--yuvָƽƽ, ĬΪNV12/NV16, ʽļ)
+@param  file EQOIļ(ָ)
+		hdr ļͷ(ָ)
+		opts ѡ(ָ)
+		data (Сeqoi_decoded_size)
+@return 
+*************************/
+static int decode_image(const unsigned char* file, const eqoi_header_t* hdr, const cli_opts_t* opts,
+	unsigned char* data) {
+	if (EQOI_FMT_IS_YUV(hdr->pixel_fmt) && opts->yuv_planar) {
+		eqoi_yuv_t img;
+
+		eqoi_yuv_layout(data, hdr->width, hdr->height, EQOI_YUV_SUB_Y(hdr->pixel_fmt), 1, &img);
+
+		return eqoi_decode_yuv(file, hdr, opts->threads, &img);
+	}
+
+	return eqoi_decode(file, hdr, opts->threads, data);
+}
+
+static double now_s(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
 }
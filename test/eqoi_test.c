@@ -0,0 +1,1545 @@
+/************************************************************************************************************************
+ǿQOIĻع
+@brief  ʽ·һԼ
+@date   2026/10/18
+@info   ڲֿĿ¼±벢(ȡtest/in*.bmp):
+		gcc -O2 -std=c99 -I. test/eqoi_test.c enhanced_qoi.c eqoi_*.c -o eqoi_test -lm -lpthread
+		./eqoi_test [...]
+		ʱȫ, PASS/FAIL, ʧʱʧܵļ; ȫͨʱ0
+************************************************************************************************************************/
+
+#include "eqoi_synth.h"
+#include "eqoi_batch.h"
+#include "eqoi_split.h"
+#include "eqoi_index.h"
+#include "eqoi_scale.h"
+#include "eqoi_prog.h"
+#include "eqoi_edit.h"
+#include "eqoi_verify.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define TEST_IMAGE_CNT 4 // test/Ŀ¼µĲͼ
+
+// ͼ(ṹ嶨)
+typedef struct {
+	unsigned char* prgb; // (ָ, 8λRGB)
+	uint32_t width; // ͼ
+	uint32_t height; // ͼ߶
+} test_image_t;
+
+// (ṹ嶨)
+typedef struct {
+	const char* name; // 
+	void (*run)(void); // Ժ
+} test_case_t;
+
+// УĲοͼ(ṹ嶨)
+typedef struct {
+	const unsigned char* pixels; // ο(ָ)
+	size_t row_len; // ÿеֽ
+	uint32_t next; // һӦк
+	uint32_t fail_at; // ȡʧܵк(UINT32_MAXʾʧ)
+	_Bool in_order; // (־)
+} verify_ref_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void check(_Bool cond, const char* what); // ¼һĽ
+static unsigned char* encode_rgb(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h,
+	int codec, const eqoi_dict_t* dict, size_t* len); // 8λRGBͼ
+static unsigned char* decode_file(const unsigned char* file, size_t len, const eqoi_dict_t* dict, eqoi_header_t* hdr); // У鲢ͼ
+static unsigned char* synth_image(int cls, uint32_t img_w, uint32_t img_h, uint32_t seed); // һϳͼ
+static void make_dict(eqoi_dict_t* dict); // õֵ
+static unsigned char* encode_legacy(unsigned char* prgb, uint32_t img_w, uint32_t img_h, size_t* len); // Ϊɰļ
+
+static void test_container(void); // ʽ: ضCRC32У
+static void test_batch(void); // : һ
+static void test_palette(void); // ɫģʽ: ɫ
+static void test_wide(void); // λ: 9~16λλΧ
+static void test_gray(void); // Ҷģʽ: ҶҶ+͸
+static void test_cfa(void); // Bayer: 4ߴ
+static void test_yuv(void); // YUV: 4:2:0/4:2:2ƽƽ
+static void test_split(void); // ֶβн: ˳ֽͬ
+static void test_index(void); // ೵: еĲУ
+static void test_region(void); // : ĶӦͬ
+static void check_regions(const unsigned char* file, const eqoi_header_t* hdr, const eqoi_index_t* index,
+	const unsigned char* full, uint32_t* seed); // Ա߽Ƚ
+static void test_scale(void); // ͼ: ƽķСͬ
+static void test_progressive(void); // ģʽ: ضļԤ
+static void test_edit(void); // ѹüƴ: ±ļֽͬ
+static unsigned char* encode_like(const eqoi_header_t* like, unsigned char* pixels, uint32_t img_w, uint32_t img_h,
+	const eqoi_dict_t* dict, size_t* len); // ͬظʽֿߴ
+static void test_verify(void); // У: һ׸ͬصĶλ
+static const unsigned char* verify_row(void* ctx, uint32_t y); // ṩУĲο
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const test_case_t tests[] = {
+	{ "container", test_container },
+	{ "batch", test_batch },
+	{ "palette", test_palette },
+	{ "wide", test_wide },
+	{ "gray", test_gray },
+	{ "cfa", test_cfa },
+	{ "yuv", test_yuv },
+	{ "split", test_split },
+	{ "index", test_index },
+	{ "region", test_region },
+	{ "scale", test_scale },
+	{ "progressive", test_progressive },
+	{ "edit", test_edit },
+	{ "verify", test_verify },
+};
+
+static test_image_t images[TEST_IMAGE_CNT]; // test/in*.bmp
+static const char* cur_test; // еĲ
+static int fail_cnt; // ʧܵļ
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+	static const char* const paths[TEST_IMAGE_CNT] = { "test/in.bmp", "test/in2.bmp", "test/in3.bmp", "test/in5.bmp" };
+
+	for (int i = 0; i < TEST_IMAGE_CNT; i++) {
+		int w, h, n;
+
+		images[i].prgb = stbi_load(paths[i], &w, &h, &n, 3);
+
+		if (images[i].prgb == NULL) {
+			fprintf(stderr, "failed to load %s (run from the repository root)\n", paths[i]);
+
+			return 2;
+		}
+
+		images[i].width = (uint32_t)w;
+		images[i].height = (uint32_t)h;
+	}
+
+	int failed = 0;
+
+	for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+		_Bool selected = argc < 2;
+
+		for (int j = 1; j < argc; j++) {
+			selected |= !strcmp(argv[j], tests[i].name);
+		}
+
+		if (!selected) {
+			continue;
+		}
+
+		int before = fail_cnt;
+
+		cur_test = tests[i].name;
+		tests[i].run();
+		printf("%-12s %s\n", tests[i].name, fail_cnt == before ? "PASS" : "FAIL");
+		failed += fail_cnt != before;
+	}
+
+	for (int i = 0; i < TEST_IMAGE_CNT; i++) {
+		stbi_image_free(images[i].prgb);
+	}
+
+	return failed ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@test
+@private
+@brief  ¼һĽ(ʧʱ)
+@param  cond 
+		what 
+@return 
+*************************/
+static void check(_Bool cond, const char* what) {
+	if (!cond) {
+		printf("  %s: %s\n", cur_test, what);
+		fail_cnt++;
+	}
+}
+
+/*************************
+@test
+@private
+@brief  ָı8λRGBͼ
+@param  prgb (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		tile_w ֿ(0ʾֿ)
+		tile_h ֿ߶(0ʾֿ)
+		codec 
+		dict ֵ(ָ, ΪNULLʱʹֵ)
+		len ļ(ָ)
+@return ļ(ָ, ɵͷ, ʧʱΪNULL)
+*************************/
+static unsigned char* encode_rgb(unsigned char* prgb, uint32_t img_w, uint32_t img_h, uint32_t tile_w, uint32_t tile_h,
+	int codec, const eqoi_dict_t* dict, size_t* len) {
+	size_t cap = eqoi_max_file_size(img_w, img_h, tile_w, tile_h);
+	unsigned char* file = malloc(cap);
+
+	if (file != NULL && eqoi_encode_codec(prgb, img_w, img_h, tile_w, tile_h, 2, codec, dict, file, cap, len) != EQOI_OK) {
+		free(file);
+		file = NULL;
+	}
+
+	check(file != NULL, "encode");
+
+	return file;
+}
+
+/*************************
+@test
+@private
+@brief  ļͷУCRC32ͼ
+@param  file ļ(ָ)
+		len ļ
+		dict ļõֵ(ָ, ΪNULLʱʹֵ)
+		hdr ļͷ(ָ)
+@return (ָ, ɵͷ, ʧʱΪNULL)
+*************************/
+static unsigned char* decode_file(const unsigned char* file, size_t len, const eqoi_dict_t* dict, eqoi_header_t* hdr) {
+	unsigned char* out = NULL;
+
+	if (eqoi_parse_header(file, len, hdr) == EQOI_OK && (dict == NULL || eqoi_use_dict(hdr, dict) == EQOI_OK) &&
+		eqoi_check_data(file, hdr) == EQOI_OK) {
+		out = malloc(eqoi_decoded_size(hdr));
+
+		if (out != NULL && eqoi_decode(file, hdr, 2, out) != EQOI_OK) {
+			free(out);
+			out = NULL;
+		}
+	}
+
+	check(out != NULL, "decode");
+
+	return out;
+}
+
+/*************************
+@test
+@private
+@brief  һϳͼ
+@param  cls (EQOI_SYNTH_*)
+		img_w ͼ
+		img_h ͼ߶
+		seed 
+@return (ָ, 8λRGB, ɵͷ)
+*************************/
+static unsigned char* synth_image(int cls, uint32_t img_w, uint32_t img_h, uint32_t seed) {
+	unsigned char* prgb = malloc((size_t)img_w * img_h * 3);
+
+	if (prgb == NULL || !eqoi_synth_image(cls, img_w, img_h, seed, prgb)) {
+		fprintf(stderr, "failed to generate a %ux%u test image\n", img_w, img_h);
+		exit(2);
+	}
+
+	return prgb;
+}
+
+/*************************
+@test
+@private
+@brief  õֵ(һȡ̶ķֵ)
+@param  dict ֵ(ָ)
+@return 
+*************************/
+static void make_dict(eqoi_dict_t* dict) {
+	memset(dict, 0, sizeof(*dict));
+
+	for (int i = 0; i < 32; i++) {
+		dict->state.index_tb[i] = (qoi_rgb_t){ (unsigned char)(i * 7), (unsigned char)(i * 3), (unsigned char)(255 - i) };
+	}
+
+	dict->state.px = (qoi_rgb_t){ 9, 8, 7 };
+	dict->id = eqoi_dict_id(&dict->state);
+}
+
+/*************************
+@test
+@private
+@brief  Ϊɰļ(16λ+32λȵQoiHeader)
+@param  prgb (ָ)
+		img_w ͼ(С65536)
+		img_h ͼ߶(С65536)
+		len ļ(ָ)
+@return ļ(ָ, ɵͷ)
+*************************/
+static unsigned char* encode_legacy(unsigned char* prgb, uint32_t img_w, uint32_t img_h, size_t* len) {
+	unsigned char* file = malloc((size_t)img_w * img_h * 4 + EQOI_LEGACY_HEADER_SIZE);
+	size_t sl = enhanced_qoi_encode(prgb, file + EQOI_LEGACY_HEADER_SIZE, img_w, img_h);
+
+	file[0] = (unsigned char)img_w;
+	file[1] = (unsigned char)(img_w >> 8);
+	file[2] = (unsigned char)img_h;
+	file[3] = (unsigned char)(img_h >> 8);
+	for (int b = 0; b < 4; b++) {
+		file[4 + b] = (unsigned char)(sl >> (b * 8));
+	}
+
+	*len = sl + EQOI_LEGACY_HEADER_SIZE;
+
+	return file;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*************************
+@test
+@private
+@brief  ʽ: ַֿɰļͷÿضϵǰ׺ܾļͷ/ƫƱ/ѹʱCRC32Уʧ
+@return 
+*************************/
+static void test_container(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 256, 256 }, { 100, 37 }, { 7, 3 } };
+
+	for (int i = 0; i < TEST_IMAGE_CNT; i++) {
+		test_image_t* img = &images[i];
+		size_t n = (size_t)img->width * img->height * 3;
+
+		for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+			size_t len;
+			eqoi_header_t hdr;
+			unsigned char* file = encode_rgb(img->prgb, img->width, img->height, tiles[t][0], tiles[t][1], EQOI_CODEC_AUTO,
+				NULL, &len);
+			unsigned char* out = file ? decode_file(file, len, NULL, &hdr) : NULL;
+
+			if (out != NULL) {
+				check(hdr.width == img->width && hdr.height == img->height && hdr.pixel_fmt == EQOI_FMT_RGB8, "header fields");
+				check(!memcmp(out, img->prgb, n), "tiled round trip");
+			}
+
+			free(file);
+			free(out);
+		}
+
+		size_t ll;
+		eqoi_header_t hdr;
+		unsigned char* legacy = encode_legacy(img->prgb, img->width, img->height, &ll);
+		unsigned char* out = decode_file(legacy, ll, NULL, &hdr);
+
+		check(out != NULL && hdr.version == 0 && !memcmp(out, img->prgb, n), "legacy header round trip");
+		free(out);
+		free(legacy);
+	}
+
+	// ض: Сͼǰ׺ֽڼ
+	uint32_t w = 61, h = 43;
+	unsigned char* prgb = synth_image(EQOI_SYNTH_PHOTO, w, h, 1);
+	size_t len;
+	unsigned char* file = encode_rgb(prgb, w, h, 16, 16, EQOI_CODEC_MED, NULL, &len);
+
+	if (file != NULL) {
+		unsigned char* copy = malloc(len);
+		eqoi_header_t hdr;
+		_Bool trunc_ok = 1, crc_ok = 1;
+
+		for (size_t cut = 0; cut < len; cut++) {
+			memcpy(copy, file, cut);
+			trunc_ok &= eqoi_parse_header(copy, cut, &hdr) != EQOI_OK;
+		}
+
+		check(trunc_ok, "every truncated prefix is rejected");
+
+		for (size_t pos = 0; pos < len; pos++) {
+			memcpy(copy, file, len);
+			copy[pos] ^= 0x10;
+
+			int err = eqoi_parse_header(copy, len, &hdr);
+
+			if (err == EQOI_OK) {
+				err = eqoi_check_data(copy, &hdr);
+			}
+
+			// ƫֶʱȱض, ѹʱļͷЧ, CRC32
+			crc_ok &= eqoi_parse_header(file, len, &hdr) == EQOI_OK && pos >= hdr.data_offset ? err == EQOI_ERR_CRC :
+				err != EQOI_OK;
+		}
+
+		check(crc_ok, "every flipped byte is rejected (data bytes with EQOI_ERR_CRC)");
+		free(copy);
+	}
+
+	free(file);
+	free(prgb);
+}
+
+/*************************
+@test
+@private
+@brief  : ԽһСͼ(пȴڿȵͼ)Զ̱߳, ֵֽڻԭ,
+		ÿͼ뵥ΪһֿMEDͬ
+@return 
+*************************/
+static void test_batch(void) {
+	const uint32_t n = EQOI_BATCH_CHUNK * 2 + 45;
+	eqoi_image_t* imgs = calloc(n, sizeof(eqoi_image_t));
+	eqoi_image_t* outs = calloc(n, sizeof(eqoi_image_t));
+	uint64_t* offsets = malloc((n + 1) * sizeof(uint64_t));
+	eqoi_dict_t dict;
+
+	make_dict(&dict);
+
+	for (uint32_t i = 0; i < n; i++) {
+		uint32_t w = 1 + i % 37, h = 1 + i * 7 % 23;
+
+		imgs[i].width = outs[i].width = w;
+		imgs[i].height = outs[i].height = h;
+		imgs[i].stride = i % 5 ? 0 : (size_t)w * 3 + 5;
+
+		size_t stride = imgs[i].stride ? imgs[i].stride : (size_t)w * 3;
+		unsigned char* prgb = synth_image(i % EQOI_SYNTH_CNT, w, h, i);
+
+		imgs[i].prgb = malloc(stride * h);
+		memset(imgs[i].prgb, 0xee, stride * h);
+		for (uint32_t y = 0; y < h; y++) {
+			memcpy(imgs[i].prgb + y * stride, prgb + (size_t)y * w * 3, (size_t)w * 3);
+		}
+
+		outs[i].prgb = malloc((size_t)w * h * 3);
+		free(prgb);
+	}
+
+	size_t cap = eqoi_batch_max_size(imgs, n), len;
+	unsigned char* dst = malloc(cap);
+
+	for (int d = 0; d < 2; d++) {
+		const eqoi_dict_t* pdict = d ? &dict : NULL;
+		_Bool same = 1, streams = 1;
+
+		check(eqoi_encode_batch(imgs, n, 2, pdict, dst, cap, offsets, &len) == EQOI_OK && offsets[0] == 0 &&
+			offsets[n] == len, "batch encode");
+
+		for (uint32_t i = 0; i < n; i++) {
+			memset(outs[i].prgb, 0x55, (size_t)outs[i].width * outs[i].height * 3);
+		}
+
+		check(eqoi_decode_batch(dst, len, offsets, outs, n, 2, pdict) == EQOI_OK, "batch decode");
+
+		for (uint32_t i = 0; i < n; i++) {
+			size_t stride = imgs[i].stride ? imgs[i].stride : (size_t)imgs[i].width * 3;
+
+			for (uint32_t y = 0; y < imgs[i].height; y++) {
+				same &= !memcmp(outs[i].prgb + (size_t)y * outs[i].width * 3, imgs[i].prgb + y * stride,
+					(size_t)imgs[i].width * 3);
+			}
+
+			// MEDֿ
+			if (i % 17 == 0) {
+				size_t fl;
+				eqoi_header_t hdr;
+				unsigned char* file = encode_rgb(outs[i].prgb, outs[i].width, outs[i].height, 0, 0, EQOI_CODEC_MED, pdict,
+					&fl);
+
+				streams &= file != NULL && eqoi_parse_header(file, fl, &hdr) == EQOI_OK &&
+					hdr.data_len == offsets[i + 1] - offsets[i] && !memcmp(file + hdr.data_offset, dst + offsets[i], hdr.data_len);
+				free(file);
+			}
+		}
+
+		check(same, d ? "batch round trip with a dictionary" : "batch round trip");
+		check(streams, "batch streams equal single-tile med streams");
+	}
+
+	// ƫƱѹݲʱܾ
+	check(eqoi_decode_batch(dst, len - 1, offsets, outs, n, 1, &dict) != EQOI_OK, "truncated batch is rejected");
+
+	for (uint32_t i = 0; i < n; i++) {
+		free(imgs[i].prgb);
+		free(outs[i].prgb);
+	}
+
+	free(dst);
+	free(offsets);
+	free(outs);
+	free(imgs);
+}
+
+/*************************
+@test
+@private
+@brief  ɫģʽ: 1~256ɫͼԸַֿ, Զѡʱʹõɫ; 256ɫʱܾ,
+		Զѡʱ(ԼֿСEQOI_PALETTE_MIN_PIXELSʱ)ʹMED
+@return 
+*************************/
+static void test_palette(void) {
+	static const uint32_t colors[] = { 1, 2, 5, 16, 17, 200, 256, 257 };
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 64, 16 }, { 50, 7 } };
+	uint32_t w = 203, h = 101, seed = 1;
+	size_t n = (size_t)w * h * 3;
+	unsigned char* prgb = malloc(n);
+
+	for (size_t k = 0; k < sizeof(colors) / sizeof(colors[0]); k++) {
+		// ȵγ, ǰcolors[k]ȡɫ, ȡɫ
+		for (size_t i = 0, run = 0; i < n; i += 3) {
+			seed = seed * 1103515245 + 12345;
+
+			if (i > 0 && (seed >> 16) % 4) {
+				memcpy(prgb + i, prgb + i - 3, 3);
+				continue;
+			}
+
+			uint32_t c = (uint32_t)(run < colors[k] ? run : seed >> 20) % colors[k];
+
+			run++;
+			prgb[i] = (unsigned char)c;
+			prgb[i + 1] = (unsigned char)(c * 7);
+			prgb[i + 2] = (unsigned char)(c >> 3);
+		}
+
+		_Bool fits = colors[k] <= EQOI_PALETTE_MAX;
+
+		check(eqoi_palette_count(prgb, (size_t)w * 3, w, h) == (fits ? colors[k] : EQOI_PALETTE_MAX + 1),
+			"colour count");
+
+		for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+			size_t cap = eqoi_max_file_size(w, h, tiles[t][0], tiles[t][1]), len;
+			unsigned char* file = malloc(cap);
+			int err = eqoi_encode_codec(prgb, w, h, tiles[t][0], tiles[t][1], 2, EQOI_CODEC_PALETTE, NULL, file, cap, &len);
+
+			if (!fits) {
+				check(err == EQOI_ERR_ARG, "more than 256 colours is rejected");
+				err = eqoi_encode_codec(prgb, w, h, tiles[t][0], tiles[t][1], 2, EQOI_CODEC_AUTO, NULL, file, cap, &len);
+			}
+
+			check(err == EQOI_OK, "encode");
+
+			eqoi_header_t hdr;
+			unsigned char* out = err == EQOI_OK ? decode_file(file, len, NULL, &hdr) : NULL;
+
+			if (out != NULL) {
+				check(hdr.codec == (fits ? EQOI_CODEC_PALETTE : EQOI_CODEC_MED), "codec");
+				check(!memcmp(out, prgb, n), "palette round trip");
+
+				// Զѡɫʱָɫֽͬ
+				_Bool auto_palette = fits && (!tiles[t][0] || tiles[t][0] * tiles[t][1] >= EQOI_PALETTE_MIN_PIXELS);
+				size_t al;
+				eqoi_header_t ah;
+				unsigned char* af = encode_rgb(prgb, w, h, tiles[t][0], tiles[t][1], EQOI_CODEC_AUTO, NULL, &al);
+
+				check(af != NULL && eqoi_parse_header(af, al, &ah) == EQOI_OK &&
+					ah.codec == (auto_palette ? EQOI_CODEC_PALETTE : EQOI_CODEC_MED) &&
+					(!auto_palette || (al == len && !memcmp(af, file, len))), "auto codec choice");
+				free(af);
+			}
+
+			free(out);
+			free(file);
+		}
+	}
+
+	free(prgb);
+}
+
+/*************************
+@test
+@private
+@brief  λ: test/in.bmpչ9~16λ(λ)Ըַֿ; λʱܾ
+@return 
+*************************/
+static void test_wide(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 128, 96 }, { 33, 5 } };
+	const test_image_t* img = &images[0];
+	size_t n = (size_t)img->width * img->height * 3;
+	uint16_t* prgb = malloc(n * sizeof(uint16_t));
+	uint16_t* out = malloc(n * sizeof(uint16_t));
+	uint32_t seed = 7;
+
+	for (int depth = EQOI_WIDE_MIN_DEPTH; depth <= EQOI_WIDE_MAX_DEPTH; depth++) {
+		uint16_t max = (uint16_t)((1u << depth) - 1);
+
+		for (int noise = 0; noise < 2; noise++) {
+			for (size_t i = 0; i < n; i++) {
+				seed = seed * 1103515245 + 12345;
+				prgb[i] = noise ? (uint16_t)(seed >> 12 & max) :
+					(uint16_t)(img->prgb[i] << (depth - 8) | (seed >> 16 & ((1u << (depth - 8)) - 1)));
+			}
+
+			for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+				size_t cap = eqoi_max_file_size_wide(img->width, img->height, tiles[t][0], tiles[t][1], depth), len;
+				unsigned char* file = malloc(cap);
+				eqoi_header_t hdr;
+
+				check(eqoi_encode_wide(prgb, img->width, img->height, depth, tiles[t][0], tiles[t][1], 2, file, cap, &len) ==
+					EQOI_OK, "encode");
+				check(eqoi_parse_header(file, len, &hdr) == EQOI_OK && eqoi_check_data(file, &hdr) == EQOI_OK &&
+					hdr.pixel_fmt == EQOI_FMT_RGB16 && hdr.bit_depth == depth && eqoi_decoded_size(&hdr) == n * sizeof(uint16_t),
+					"header fields");
+				memset(out, 0x55, n * sizeof(uint16_t));
+				check(eqoi_decode(file, &hdr, 2, (unsigned char*)out) == EQOI_OK && !memcmp(out, prgb, n * sizeof(uint16_t)),
+					"wide round trip");
+
+				// λΧĲ
+				if (depth < 16 && t == 0) {
+					prgb[n / 2] = (uint16_t)(max + 1);
+					check(eqoi_encode_wide(prgb, img->width, img->height, depth, 0, 0, 1, file, cap, &len) == EQOI_ERR_ARG,
+						"sample above the bit depth is rejected");
+					prgb[n / 2] = max;
+				}
+
+				free(file);
+			}
+		}
+	}
+
+	free(out);
+	free(prgb);
+}
+
+/*************************
+@test
+@private
+@brief  Ҷģʽ: test/in*.bmp(͸ͨ)Ըַֿ, ͳƸȫѹ,
+		ضϵܾ
+@return 
+*************************/
+static void test_gray(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 64, 64 }, { 100, 7 } };
+
+	for (int i = 0; i < TEST_IMAGE_CNT; i++) {
+		const test_image_t* img = &images[i];
+		size_t px_cnt = (size_t)img->width * img->height;
+
+		for (int channels = 1; channels <= 2; channels++) {
+			size_t n = px_cnt * channels;
+			unsigned char* pgray = malloc(n);
+			unsigned char* out = malloc(n);
+
+			// ͸ΪĲ͸뽥Ե
+			for (size_t p = 0; p < px_cnt; p++) {
+				const unsigned char* c = img->prgb + p * 3;
+				uint32_t x = (uint32_t)(p % img->width), y = (uint32_t)(p / img->width);
+
+				pgray[p * channels] = (unsigned char)((c[0] * 77 + c[1] * 150 + c[2] * 29 + 128) >> 8);
+				if (channels == 2) {
+					pgray[p * 2 + 1] = (unsigned char)(x < img->width / 2 ? 255 : (x + y) & 255);
+				}
+			}
+
+			for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+				size_t cap = eqoi_max_file_size_gray(img->width, img->height, tiles[t][0], tiles[t][1], channels), len;
+				unsigned char* file = malloc(cap);
+				eqoi_header_t hdr;
+				qoi_op_stats_t stats;
+				uint64_t samples = 0, bytes = 0;
+
+				check(eqoi_encode_gray(pgray, img->width, img->height, channels, tiles[t][0], tiles[t][1], 2, file, cap, &len) ==
+					EQOI_OK, "encode");
+				check(eqoi_parse_header(file, len, &hdr) == EQOI_OK && eqoi_check_data(file, &hdr) == EQOI_OK &&
+					hdr.pixel_fmt == (channels == 1 ? EQOI_FMT_GRAY8 : EQOI_FMT_GA8) && eqoi_decoded_size(&hdr) == n,
+					"header fields");
+				memset(out, 0x55, n);
+				check(eqoi_decode(file, &hdr, 2, out) == EQOI_OK && !memcmp(out, pgray, n), "gray round trip");
+
+				memset(&stats, 0, sizeof(stats));
+				check(eqoi_scan_ops(file, &hdr, &stats) == EQOI_OK, "scan ops");
+				for (int id = 0; id < QOI_ID_CNT; id++) {
+					samples += stats.pixels[id];
+					bytes += stats.bytes[id];
+					check(stats.pixels[id] == 0 || eqoi_gray_op_name(id) != NULL, "gray op name");
+				}
+
+				check(samples == n && bytes == hdr.data_len, "op stats cover every sample and byte");
+
+				// ضϵķֿ
+				unsigned char* stream = malloc(len);
+				size_t tl = (size_t)(eqoi_tile_offset(&hdr, 1) - eqoi_tile_offset(&hdr, 0));
+				uint32_t tx, ty, tw, th;
+
+				eqoi_tile_rect(&hdr, 0, &tx, &ty, &tw, &th);
+				memcpy(stream, file + hdr.data_offset + eqoi_tile_offset(&hdr, 0), tl);
+				check(!eqoi_gray_decode(stream, tl - 1, out, (size_t)tw * channels, tw, th, channels),
+					"truncated gray stream is rejected");
+				free(stream);
+				free(file);
+			}
+
+			free(out);
+			free(pgray);
+		}
+	}
+}
+
+/*************************
+@test
+@private
+@brief  Bayer: test/in*.bmp4ɫƬвԸַֿ; Ŀֿߴ硢
+		Bayerظʽܾ
+@return 
+*************************/
+static void test_cfa(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 64, 50 }, { 130, 2 }, { 2, 2 } };
+	static const unsigned char layouts[4][4] = { { 0, 1, 1, 2 }, { 1, 0, 2, 1 }, { 1, 2, 0, 1 }, { 2, 1, 1, 0 } }; // Ͻ2x2ͨ
+
+	for (int i = 0; i < TEST_IMAGE_CNT; i++) {
+		const test_image_t* img = &images[i];
+		uint32_t w = img->width & ~1u, h = img->height & ~1u;
+		size_t n = (size_t)w * h;
+		unsigned char* pcfa = malloc(n);
+		unsigned char* out = malloc(n);
+
+		for (int fmt = EQOI_FMT_BAYER_RGGB; fmt <= EQOI_FMT_BAYER_BGGR; fmt++) {
+			const unsigned char* ch = layouts[fmt - EQOI_FMT_BAYER_RGGB];
+
+			for (uint32_t y = 0; y < h; y++) {
+				for (uint32_t x = 0; x < w; x++) {
+					pcfa[(size_t)y * w + x] = img->prgb[((size_t)y * img->width + x) * 3 + ch[(y & 1) * 2 + (x & 1)]];
+				}
+			}
+
+			for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+				size_t cap = eqoi_max_file_size_gray(w, h, tiles[t][0], tiles[t][1], 1), len;
+				unsigned char* file = malloc(cap);
+				eqoi_header_t hdr;
+
+				check(eqoi_encode_cfa(pcfa, w, h, fmt, tiles[t][0], tiles[t][1], 2, file, cap, &len) == EQOI_OK, "encode");
+				check(eqoi_parse_header(file, len, &hdr) == EQOI_OK && eqoi_check_data(file, &hdr) == EQOI_OK &&
+					hdr.pixel_fmt == fmt && eqoi_decoded_size(&hdr) == n, "header fields");
+				memset(out, 0x55, n);
+				check(eqoi_decode(file, &hdr, 2, out) == EQOI_OK && !memcmp(out, pcfa, n), "cfa round trip");
+				free(file);
+			}
+		}
+
+		size_t cap = eqoi_max_file_size_gray(w, h, 0, 0, 1), len;
+		unsigned char* file = malloc(cap);
+
+		check(eqoi_encode_cfa(pcfa, w - 1, h, EQOI_FMT_BAYER_RGGB, 0, 0, 1, file, cap, &len) == EQOI_ERR_ARG &&
+			eqoi_encode_cfa(pcfa, w, h - 1, EQOI_FMT_BAYER_RGGB, 0, 0, 1, file, cap, &len) == EQOI_ERR_ARG,
+			"odd image size is rejected");
+		check(eqoi_encode_cfa(pcfa, w, h, EQOI_FMT_BAYER_RGGB, 63, 50, 1, file, cap, &len) == EQOI_ERR_ARG,
+			"odd tile size is rejected");
+		check(eqoi_encode_cfa(pcfa, w, h, EQOI_FMT_GA8, 0, 0, 1, file, cap, &len) == EQOI_ERR_ARG,
+			"non-Bayer pixel format is rejected");
+		free(file);
+		free(out);
+		free(pcfa);
+	}
+}
+
+/*************************
+@test
+@private
+@brief  YUV: test/in*.bmpתΪ4:2:04:2:2, ƽƽбõͬļ, Ըַֿ,
+		ƽ
+@return 
+*************************/
+static void test_yuv(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 64, 64 }, { 32, 8 } };
+
+	for (int i = 0; i < TEST_IMAGE_CNT; i++) {
+		const test_image_t* img = &images[i];
+		uint32_t w = img->width, h = img->height;
+
+		for (int fmt = EQOI_FMT_YUV420; fmt <= EQOI_FMT_YUV422; fmt++) {
+			int sub_y = EQOI_YUV_SUB_Y(fmt);
+			eqoi_yuv_t yuv[4]; // ԭͼ(ƽ, ƽ)(ƽ, ƽ)
+			unsigned char* bufs[4];
+			size_t n = eqoi_yuv_layout(NULL, w, h, sub_y, 1, &yuv[0]);
+
+			for (int b = 0; b < 4; b++) {
+				bufs[b] = malloc(n);
+				eqoi_yuv_layout(bufs[b], w, h, sub_y, !(b & 1), &yuv[b]);
+			}
+
+			// BT.601, ɫȡϽǵ
+			for (int b = 0; b < 2; b++) {
+				for (uint32_t y = 0; y < h; y++) {
+					for (uint32_t x = 0; x < w; x++) {
+						const unsigned char* c = img->prgb + ((size_t)y * w + x) * 3;
+
+						yuv[b].y[y * yuv[b].y_stride + x] = (unsigned char)((66 * c[0] + 129 * c[1] + 25 * c[2] + 128) / 256 + 16);
+						if (!(x & 1) && y % sub_y == 0) {
+							size_t pos = y / sub_y * yuv[b].c_stride + x / 2 * yuv[b].c_step;
+
+							yuv[b].u[pos] = (unsigned char)((-38 * c[0] - 74 * c[1] + 112 * c[2] + 128) / 256 + 128);
+							yuv[b].v[pos] = (unsigned char)((112 * c[0] - 94 * c[1] - 18 * c[2] + 128) / 256 + 128);
+						}
+					}
+				}
+			}
+
+			for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+				size_t cap = eqoi_max_file_size_yuv(w, h, tiles[t][0], tiles[t][1], fmt), len, len2;
+				unsigned char* file = malloc(cap);
+				unsigned char* file2 = malloc(cap);
+				eqoi_header_t hdr;
+
+				check(eqoi_encode_yuv(&yuv[0], w, h, fmt, tiles[t][0], tiles[t][1], 2, file, cap, &len) == EQOI_OK &&
+					eqoi_encode_yuv(&yuv[1], w, h, fmt, tiles[t][0], tiles[t][1], 1, file2, cap, &len2) == EQOI_OK, "encode");
+				check(len == len2 && !memcmp(file, file2, len), "planar and semi-planar input give the same file");
+				check(eqoi_parse_header(file, len, &hdr) == EQOI_OK && eqoi_check_data(file, &hdr) == EQOI_OK &&
+					hdr.pixel_fmt == fmt && eqoi_decoded_size(&hdr) == n, "header fields");
+
+				for (int b = 2; b < 4; b++) {
+					memset(bufs[b], 0x55, n);
+					check(eqoi_decode_yuv(file, &hdr, 2, &yuv[b]) == EQOI_OK && !memcmp(bufs[b], bufs[b - 2], n),
+						b == 2 ? "planar round trip" : "semi-planar round trip");
+				}
+
+				memset(bufs[3], 0x55, n);
+				check(eqoi_decode(file, &hdr, 2, bufs[3]) == EQOI_OK && !memcmp(bufs[3], bufs[1], n),
+					"whole-image decode gives semi-planar output");
+				free(file2);
+				free(file);
+			}
+
+			for (int b = 0; b < 4; b++) {
+				free(bufs[b]);
+			}
+		}
+	}
+}
+
+/*************************
+@test
+@private
+@brief  ֶβн: test/in*.bmp(ֿ顢ɰļͷֵ)ϳͼ(С)Բͬ߳
+		ֶν, ˳ֽͬ; ֿļܾ
+@return 
+*************************/
+static void test_split(void) {
+	static const int threads[] = { 1, 2, 3, 8, 0 };
+	static const uint32_t sizes[][2] = { { 1, 1 }, { 1, 100 }, { 100, 1 }, { 37, 53 }, { 640, 9 }, { 1025, 77 } };
+	const int size_cnt = (int)(sizeof(sizes) / sizeof(sizes[0]));
+	eqoi_dict_t dict;
+
+	make_dict(&dict);
+
+	// Ϊtest/in*.bmp, Ϊ𡢸ߴĺϳͼ
+	for (int i = 0; i < TEST_IMAGE_CNT + EQOI_SYNTH_CNT * size_cnt; i++) {
+		_Bool synth = i >= TEST_IMAGE_CNT;
+		int k = synth ? i - TEST_IMAGE_CNT : i;
+		uint32_t w = synth ? sizes[k % size_cnt][0] : images[i].width, h = synth ? sizes[k % size_cnt][1] : images[i].height;
+		unsigned char* prgb = synth ? synth_image(k / size_cnt, w, h, (uint32_t)k) : images[i].prgb;
+		size_t n = (size_t)w * h * 3;
+		unsigned char* ref = malloc(n);
+		unsigned char* out = malloc(n);
+
+		for (int kind = 0; kind < 3; kind++) {
+			const eqoi_dict_t* pdict = kind == 2 ? &dict : NULL;
+			size_t len;
+			unsigned char* file = kind == 1 ? encode_legacy(prgb, w, h, &len) :
+				encode_rgb(prgb, w, h, 0, 0, EQOI_CODEC_MED, pdict, &len);
+			eqoi_header_t hdr;
+
+			if (file == NULL) {
+				continue;
+			}
+
+			check(eqoi_parse_header(file, len, &hdr) == EQOI_OK && (pdict == NULL || eqoi_use_dict(&hdr, pdict) == EQOI_OK) &&
+				eqoi_decode_tile(file, &hdr, 0, ref, (size_t)w * 3) == EQOI_OK && !memcmp(ref, prgb, n), "serial decode");
+
+			for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+				memset(out, 0x77, n);
+				check(eqoi_decode_split(file, &hdr, threads[t], out) == EQOI_OK && !memcmp(out, ref, n),
+					"split decode equals serial decode");
+			}
+
+			free(file);
+		}
+
+		// ֿļûеһ
+		if (!synth) {
+			size_t len;
+			eqoi_header_t hdr;
+			unsigned char* file = encode_rgb(prgb, w, h, 256, 256, EQOI_CODEC_MED, NULL, &len);
+
+			check(file != NULL && eqoi_parse_header(file, len, &hdr) == EQOI_OK &&
+				eqoi_decode_split(file, &hdr, 2, out) == EQOI_ERR_ARG, "tiled file is rejected");
+			free(file);
+		}
+
+		free(out);
+		free(ref);
+		if (synth) {
+			free(prgb);
+		}
+	}
+}
+
+/*************************
+@test
+@private
+@brief  ೵: test/in*.bmpĵļ(ֿ顢ɰļͷֵ)Բͬļ, ָ
+		жͬ; 𻵡ضϻһļܾ
+@return 
+*************************/
+static void test_index(void) {
+	static const uint32_t intervals[] = { 1, 7, 64, EQOI_INDEX_INTERVAL, 100000 };
+	eqoi_dict_t dict;
+	uint32_t seed = 1234;
+
+	make_dict(&dict);
+
+	for (int i = 0; i < TEST_IMAGE_CNT; i++) {
+		const test_image_t* img = &images[i];
+		uint32_t w = img->width, h = img->height;
+		size_t row_len = (size_t)w * 3, stride = row_len + 7;
+		unsigned char* out = malloc(stride * h);
+
+		for (int kind = 0; kind < 3; kind++) {
+			const eqoi_dict_t* pdict = kind == 2 ? &dict : NULL;
+			size_t len;
+			unsigned char* file = kind == 1 ? encode_legacy(img->prgb, w, h, &len) :
+				encode_rgb(img->prgb, w, h, 0, 0, EQOI_CODEC_MED, pdict, &len);
+			eqoi_header_t hdr;
+
+			if (file == NULL || eqoi_parse_header(file, len, &hdr) != EQOI_OK ||
+				(pdict != NULL && eqoi_use_dict(&hdr, pdict) != EQOI_OK)) {
+				check(0, "parse header");
+				free(file);
+				continue;
+			}
+
+			for (size_t v = 0; v < sizeof(intervals) / sizeof(intervals[0]); v++) {
+				size_t cap = eqoi_index_size(&hdr, intervals[v]), il;
+				unsigned char* idx = malloc(cap);
+				eqoi_index_t index;
+				_Bool same = 1;
+
+				if (eqoi_build_index(file, &hdr, intervals[v], idx, cap, &il) != EQOI_OK || il != cap ||
+					eqoi_parse_index(idx, il, &hdr, &index) != EQOI_OK) {
+					check(0, "build and parse index");
+					free(idx);
+					continue;
+				}
+
+				// ĩĶж
+				for (int q = 0; q < 10; q++) {
+					uint32_t y = 0, rows = h;
+
+					if (q == 1) {
+						y = h - 1;
+						rows = 1;
+					}
+					else if (q > 1) {
+						seed = seed * 1103515245 + 12345;
+						y = (seed >> 8) % h;
+						seed = seed * 1103515245 + 12345;
+						rows = 1 + (seed >> 8) % __MIN(h - y, 64);
+					}
+
+					memset(out, 0x55, stride * rows);
+					same &= eqoi_decode_rows_indexed(file, &hdr, &index, y, rows, out, stride) == EQOI_OK;
+					for (uint32_t r = 0; r < rows && same; r++) {
+						same &= !memcmp(out + r * stride, img->prgb + (y + r) * row_len, row_len);
+					}
+				}
+
+				check(same, "indexed rows equal the full decode");
+				check(eqoi_parse_index(idx, il - 1, &hdr, &index) != EQOI_OK, "truncated index is rejected");
+
+				// 𻵼(ûмʱCRC32)
+				size_t pos = il > EQOI_INDEX_HEADER_SIZE + 4 ? EQOI_INDEX_HEADER_SIZE + (il - EQOI_INDEX_HEADER_SIZE - 4) / 2 :
+					il - 1;
+
+				idx[pos] ^= 1;
+				check(eqoi_parse_index(idx, il, &hdr, &index) == EQOI_ERR_CRC, "corrupt index gives EQOI_ERR_CRC");
+				idx[pos] ^= 1;
+
+				// ͬһһͼļ
+				if (kind == 0 && i > 0) {
+					size_t ol;
+					eqoi_header_t oh;
+					unsigned char* other = encode_rgb(images[i - 1].prgb, images[i - 1].width, images[i - 1].height, 0, 0,
+						EQOI_CODEC_MED, NULL, &ol);
+
+					check(other != NULL && eqoi_parse_header(other, ol, &oh) == EQOI_OK &&
+						eqoi_parse_index(idx, il, &oh, &index) != EQOI_OK, "index of another file is rejected");
+					free(other);
+				}
+
+				free(idx);
+			}
+
+			free(file);
+		}
+
+		free(out);
+	}
+}
+
+/*************************
+@test
+@private
+@brief  : ַֿMEDɫ塢Ҷ+͸ļĵļ, ߽Ľ
+		ĶӦͬ, ⲻд; ͼ򱻾ܾ
+@return 
+*************************/
+static void test_region(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 256, 256 }, { 100, 37 }, { 1, 1 } };
+	uint32_t seed = 99;
+
+	for (int kind = 0; kind < 4; kind++) {
+		const test_image_t* img = &images[kind];
+		uint32_t w = kind == 2 ? 300 : img->width, h = kind == 2 ? 200 : img->height;
+		unsigned char* prgb = kind == 2 ? synth_image(EQOI_SYNTH_UI, w, h, 3) : img->prgb;
+		unsigned char* pga = NULL;
+
+		// Ҷ+͸: ͸
+		if (kind == 3) {
+			pga = malloc((size_t)w * h * 2);
+			for (size_t p = 0; p < (size_t)w * h; p++) {
+				pga[p * 2] = (unsigned char)((prgb[p * 3] + prgb[p * 3 + 1] * 2 + prgb[p * 3 + 2]) / 4);
+				pga[p * 2 + 1] = (unsigned char)(p % w < w / 3 ? 255 : p);
+			}
+		}
+
+		for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+			// 1x1ֻֿںϳɵСͼ
+			if (tiles[t][0] == 1 && kind != 2) {
+				continue;
+			}
+
+			size_t cap = kind == 3 ? eqoi_max_file_size_gray(w, h, tiles[t][0], tiles[t][1], 2) :
+				eqoi_max_file_size(w, h, tiles[t][0], tiles[t][1]), len;
+			unsigned char* file = malloc(cap);
+			int err = kind == 3 ? eqoi_encode_gray(pga, w, h, 2, tiles[t][0], tiles[t][1], 2, file, cap, &len) :
+				eqoi_encode_codec(prgb, w, h, tiles[t][0], tiles[t][1], 2, kind == 2 ? EQOI_CODEC_PALETTE : EQOI_CODEC_MED,
+					NULL, file, cap, &len);
+			eqoi_header_t hdr;
+			unsigned char* full = err == EQOI_OK ? decode_file(file, len, NULL, &hdr) : NULL;
+
+			check(err == EQOI_OK, "encode");
+			if (full != NULL) {
+				check_regions(file, &hdr, NULL, full, &seed);
+
+				// ļԲ೵
+				if (hdr.tile_cnt == 1 && hdr.pixel_fmt == EQOI_FMT_RGB8 && hdr.codec == EQOI_CODEC_MED) {
+					size_t icap = eqoi_index_size(&hdr, 64), il;
+					unsigned char* idx = malloc(icap);
+					eqoi_index_t index;
+
+					check(eqoi_build_index(file, &hdr, 64, idx, icap, &il) == EQOI_OK &&
+						eqoi_parse_index(idx, il, &hdr, &index) == EQOI_OK, "build index");
+					check_regions(file, &hdr, &index, full, &seed);
+					free(idx);
+				}
+
+				check(eqoi_decode_region(file, &hdr, NULL, w - 4, 0, 5, 1, full, (size_t)w * 3) == EQOI_ERR_ARG &&
+					eqoi_decode_region(file, &hdr, NULL, 0, h - 1, 1, 2, full, (size_t)w * 3) == EQOI_ERR_ARG &&
+					eqoi_decode_region(file, &hdr, NULL, 0, 0, 0, 1, full, (size_t)w * 3) == EQOI_ERR_ARG,
+					"region outside the image is rejected");
+			}
+
+			free(full);
+			free(file);
+		}
+
+		free(pga);
+		if (kind == 2) {
+			free(prgb);
+		}
+	}
+}
+
+/*************************
+@test
+@private
+@brief  ĽǵĵȽ(뻺пȴ, δд)
+@param  file ļ(ָ)
+		hdr ļͷ(ָ)
+		index ѽĲ೵(ָ, ΪNULL)
+		full Ľ(ָ)
+		seed ״̬(ָ)
+@return 
+*************************/
+static void check_regions(const unsigned char* file, const eqoi_header_t* hdr, const eqoi_index_t* index,
+	const unsigned char* full, uint32_t* seed) {
+	uint32_t img_w = hdr->width, img_h = hdr->height;
+	size_t ps = eqoi_pixel_size(hdr), full_stride = (size_t)img_w * ps;
+	unsigned char* out = malloc((full_stride + 5) * img_h);
+	_Bool same = 1, untouched = 1;
+
+	for (int q = 0; q < 16; q++) {
+		uint32_t x = 0, y = 0, w = img_w, h = img_h;
+
+		if (q >= 1 && q <= 4) {
+			x = q & 1 ? 0 : img_w - 1;
+			y = q <= 2 ? 0 : img_h - 1;
+			w = h = 1;
+		}
+		else if (q > 4) {
+			*seed = *seed * 1103515245 + 12345;
+			x = (*seed >> 8) % img_w;
+			*seed = *seed * 1103515245 + 12345;
+			y = (*seed >> 8) % img_h;
+			*seed = *seed * 1103515245 + 12345;
+			w = 1 + (*seed >> 8) % (img_w - x);
+			*seed = *seed * 1103515245 + 12345;
+			h = 1 + (*seed >> 8) % (img_h - y);
+		}
+
+		size_t stride = (size_t)w * ps + 5;
+
+		memset(out, 0x55, stride * h);
+		same &= eqoi_decode_region(file, hdr, index, x, y, w, h, out, stride) == EQOI_OK;
+		for (uint32_t r = 0; r < h && same; r++) {
+			same &= !memcmp(out + r * stride, full + (y + r) * full_stride + x * ps, (size_t)w * ps);
+			for (size_t b = (size_t)w * ps; b < stride; b++) {
+				untouched &= out[r * stride + b] == 0x55;
+			}
+		}
+	}
+
+	check(same, index ? "indexed region equals the full decode" : "region equals the full decode");
+	check(untouched, "bytes outside the region are not written");
+	free(out);
+}
+
+/*************************
+@test
+@private
+@brief  ͼ: test/in*.bmp(ַֿ顢ֵ)ϳɵĵɫͼ2/4/8С, ƽ(,
+		Ҳײķʵ)Ľͬ, eqoi_box_reduceͬͬ; ֵ֧ıܾ
+@return 
+*************************/
+static void test_scale(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 256, 256 }, { 100, 37 } };
+	eqoi_dict_t dict;
+
+	make_dict(&dict);
+
+	for (int i = 0; i <= TEST_IMAGE_CNT; i++) {
+		_Bool synth = i == TEST_IMAGE_CNT;
+		uint32_t w = synth ? 333 : images[i].width, h = synth ? 123 : images[i].height;
+		unsigned char* prgb = synth ? synth_image(EQOI_SYNTH_UI, w, h, 5) : images[i].prgb;
+
+		for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+			const eqoi_dict_t* pdict = t == 1 ? &dict : NULL;
+			size_t len;
+			unsigned char* file = encode_rgb(prgb, w, h, tiles[t][0], tiles[t][1], synth ? EQOI_CODEC_PALETTE :
+				EQOI_CODEC_MED, pdict, &len);
+			eqoi_header_t hdr;
+
+			if (file == NULL || eqoi_parse_header(file, len, &hdr) != EQOI_OK ||
+				(hdr.dict_id && eqoi_use_dict(&hdr, pdict) != EQOI_OK)) {
+				check(0, "parse header");
+				free(file);
+				continue;
+			}
+
+			for (int scale = 2; scale <= EQOI_SCALE_MAX; scale *= 2) {
+				uint32_t ow, oh;
+
+				eqoi_scaled_dims(&hdr, scale, &ow, &oh);
+				check(ow == (w + scale - 1) / scale && oh == (h + scale - 1) / scale, "scaled size");
+
+				size_t stride = (size_t)ow * 3 + 3;
+				unsigned char* ref = malloc(stride * oh);
+				unsigned char* out = malloc(stride * oh);
+
+				memset(ref, 0x44, stride * oh);
+				for (uint32_t oy = 0; oy < oh; oy++) {
+					for (uint32_t ox = 0; ox < ow; ox++) {
+						for (int c = 0; c < 3; c++) {
+							uint32_t sum = 0, cnt = 0;
+
+							for (uint32_t y = oy * scale; y < (oy + 1) * scale && y < h; y++) {
+								for (uint32_t x = ox * scale; x < (ox + 1) * scale && x < w; x++) {
+									sum += prgb[((size_t)y * w + x) * 3 + c];
+									cnt++;
+								}
+							}
+
+							ref[oy * stride + ox * 3 + c] = (unsigned char)((sum + cnt / 2) / cnt);
+						}
+					}
+				}
+
+				memset(out, 0x44, stride * oh);
+				check(eqoi_decode_scaled(file, &hdr, scale, out, stride) == EQOI_OK && !memcmp(out, ref, stride * oh),
+					"scaled decode equals the box average");
+
+				if (t == 0) {
+					memset(out, 0x44, stride * oh);
+					eqoi_box_reduce(prgb, (size_t)w * 3, w, h, scale, out, stride);
+					check(!memcmp(out, ref, stride * oh), "eqoi_box_reduce equals the box average");
+				}
+
+				free(out);
+				free(ref);
+			}
+
+			unsigned char dummy[64];
+
+			check(eqoi_decode_scaled(file, &hdr, 3, dummy, sizeof(dummy)) == EQOI_ERR_ARG &&
+				eqoi_decode_scaled(file, &hdr, 16, dummy, sizeof(dummy)) == EQOI_ERR_ARG, "unsupported scale is rejected");
+			free(file);
+		}
+
+		if (synth) {
+			free(prgb);
+		}
+	}
+}
+
+/*************************
+@test
+@private
+@brief  ģʽ: test/in2.bmpֳߴĺϳͼ; ļĸǰ׺, ļͷıܾ, ͼ
+		EQOI_ERR_TRUNC, Ԥ, 泤Ȳ, Ĳԭͼͬ
+@return 
+*************************/
+static void test_progressive(void) {
+	static const uint32_t sizes[][2] = { { 1, 1 }, { 7, 3 }, { 9, 17 }, { 64, 64 }, { 301, 199 } };
+	const int size_cnt = (int)(sizeof(sizes) / sizeof(sizes[0]));
+
+	for (int i = 0; i <= size_cnt; i++) {
+		_Bool synth = i < size_cnt;
+		uint32_t w = synth ? sizes[i][0] : images[1].width, h = synth ? sizes[i][1] : images[1].height;
+		unsigned char* prgb = synth ? synth_image(EQOI_SYNTH_PHOTO, w, h, (uint32_t)i) : images[1].prgb;
+		size_t n = (size_t)w * h * 3, len;
+		unsigned char* file = encode_rgb(prgb, w, h, 16, 16, EQOI_CODEC_PROGRESSIVE, NULL, &len);
+		eqoi_header_t hdr;
+		unsigned char* out = file ? decode_file(file, len, NULL, &hdr) : NULL;
+
+		if (out == NULL) {
+			free(file);
+			continue;
+		}
+
+		check(hdr.codec == EQOI_CODEC_PROGRESSIVE && hdr.tile_cnt == 1, "progressive files have one tile");
+		check(!memcmp(out, prgb, n), "progressive round trip");
+
+		unsigned char* prefix = malloc(len);
+		int last = 0;
+		_Bool ok = 1;
+
+		for (size_t cut = 0; cut <= len; cut += cut < len && cut + len / 40 + 1 > len ? len - cut : len / 40 + 1) {
+			eqoi_header_t ph;
+			int streams = -1;
+
+			memcpy(prefix, file, cut);
+			if (cut < hdr.data_offset) {
+				ok &= eqoi_parse_header_prefix(prefix, cut, &ph) != EQOI_OK;
+				continue;
+			}
+
+			ok &= cut == len || eqoi_parse_header(prefix, cut, &ph) != EQOI_OK;
+
+			if (eqoi_parse_header_prefix(prefix, cut, &ph) != EQOI_OK) {
+				ok = 0;
+				break;
+			}
+
+			memset(out, 0x55, n);
+
+			int err = eqoi_decode_progressive(prefix, cut, &ph, out, &streams);
+
+			if (err == EQOI_ERR_TRUNC) {
+				ok &= last == 0;
+				continue;
+			}
+
+			ok &= err == EQOI_OK && streams >= __MAX(last, 1) && streams <= EQOI_PROG_STREAMS;
+			last = streams;
+
+			// ͼ֮ÿʹ֪ļ
+			uint32_t step = EQOI_PROG_STEP >> (streams - 1) / 2;
+
+			for (uint32_t y = 0; y < h && ok; y += step) {
+				for (uint32_t x = 0; x < w; x += step) {
+					ok &= !memcmp(out + ((size_t)y * w + x) * 3, prgb + ((size_t)y * w + x) * 3, 3);
+				}
+			}
+
+			if (cut == len) {
+				break;
+			}
+		}
+
+		check(ok, "truncated prefixes decode to previews");
+		check(last == EQOI_PROG_STREAMS && !memcmp(out, prgb, n), "the whole file decodes every stream");
+		free(prefix);
+		free(out);
+		free(file);
+		if (synth) {
+			free(prgb);
+		}
+	}
+}
+
+/*************************
+@test
+@private
+@brief  ѹüƴ: test/in.bmpMEDֵҶļ, 벻ֿĲü, Լ벻
+		2x2ƴ, ͬķֿ±ü/ƴӺصõļֽͬ; ʱԴļ
+@return 
+*************************/
+static void test_edit(void) {
+	static const uint32_t rects[][4] = { { 64, 48, 500, 300 }, { 128, 96, 1072, 690 }, { 5, 3, 640, 480 },
+		{ 0, 0, 1200, 786 }, { 1199, 785, 1, 1 }, { 700, 10, 77, 776 } }; // ü(x, y, , )
+	static const uint32_t splits[][2] = { { 256, 192 }, { 250, 100 } }; // ƴķֽ(, )
+	const test_image_t* img = &images[0];
+	uint32_t w = img->width, h = img->height, tw = 64, th = 48;
+	eqoi_dict_t dict;
+
+	make_dict(&dict);
+
+	for (int kind = 0; kind < 3; kind++) {
+		const eqoi_dict_t* pdict = kind == 1 ? &dict : NULL;
+		size_t ps = kind == 2 ? 1 : 3, len;
+		unsigned char* pixels = malloc((size_t)w * h * ps);
+		unsigned char* file;
+		eqoi_header_t hdr;
+
+		if (kind == 2) {
+			for (size_t p = 0; p < (size_t)w * h; p++) {
+				pixels[p] = (unsigned char)((img->prgb[p * 3] + img->prgb[p * 3 + 1] * 2 + img->prgb[p * 3 + 2]) / 4);
+			}
+		}
+		else {
+			memcpy(pixels, img->prgb, (size_t)w * h * 3);
+		}
+
+		// Դļ64x48ֿ
+		eqoi_init_header(&hdr, w, h, tw, th);
+		if (kind == 2) {
+			hdr.pixel_fmt = EQOI_FMT_GRAY8;
+			hdr.channels = 1;
+		}
+
+		file = encode_like(&hdr, pixels, w, h, pdict, &len);
+		if (file == NULL || eqoi_parse_header(file, len, &hdr) != EQOI_OK ||
+			(pdict != NULL && eqoi_use_dict(&hdr, pdict) != EQOI_OK)) {
+			check(0, "parse header");
+			free(file);
+			free(pixels);
+			continue;
+		}
+
+		for (size_t r = 0; r < sizeof(rects) / sizeof(rects[0]); r++) {
+			uint32_t cx = rects[r][0], cy = rects[r][1], cw = rects[r][2], ch = rects[r][3];
+			size_t cap = eqoi_edit_max_size(&hdr, cw, ch), ol, rl;
+			unsigned char* out = malloc(cap);
+			unsigned char* sub = malloc((size_t)cw * ch * ps);
+			eqoi_edit_stats_t stats;
+
+			for (uint32_t y = 0; y < ch; y++) {
+				memcpy(sub + (size_t)y * cw * ps, pixels + ((size_t)(cy + y) * w + cx) * ps, (size_t)cw * ps);
+			}
+
+			unsigned char* ref = encode_like(&hdr, sub, cw, ch, pdict, &rl);
+
+			check(eqoi_crop(file, &hdr, cx, cy, cw, ch, 2, out, cap, &ol, &stats) == EQOI_OK, "crop");
+			check(ref != NULL && ol == rl && !memcmp(out, ref, rl), "crop equals a re-encode of the cropped pixels");
+			check(cx % tw || cy % th || cw < tw || ch < th || stats.copied > 0, "aligned crop copies tiles");
+			free(ref);
+			free(sub);
+			free(out);
+		}
+
+		check(eqoi_crop(file, &hdr, 1, 0, w, 1, 1, NULL, 0, &len, NULL) == EQOI_ERR_ARG, "crop outside the image is rejected");
+
+		for (size_t sp = 0; sp < sizeof(splits) / sizeof(splits[0]); sp++) {
+			uint32_t xs[3] = { 0, splits[sp][0], w }, ys[3] = { 0, splits[sp][1], h };
+			unsigned char* parts[4];
+			eqoi_header_t hdrs[4];
+			uint32_t sw, sh;
+
+			for (int q = 0; q < 4; q++) {
+				uint32_t qx = xs[q % 2], qy = ys[q / 2], qw = xs[q % 2 + 1] - qx, qh = ys[q / 2 + 1] - qy;
+				unsigned char* sub = malloc((size_t)qw * qh * ps);
+				size_t ql;
+
+				for (uint32_t y = 0; y < qh; y++) {
+					memcpy(sub + (size_t)y * qw * ps, pixels + ((size_t)(qy + y) * w + qx) * ps, (size_t)qw * ps);
+				}
+
+				parts[q] = encode_like(&hdr, sub, qw, qh, pdict, &ql);
+				if (parts[q] == NULL || eqoi_parse_header(parts[q], ql, &hdrs[q]) != EQOI_OK ||
+					(pdict != NULL && eqoi_use_dict(&hdrs[q], pdict) != EQOI_OK)) {
+					check(0, "parse part header");
+				}
+
+				free(sub);
+			}
+
+			size_t cap = eqoi_edit_max_size(&hdrs[0], w, h), ol;
+			unsigned char* out = malloc(cap);
+			eqoi_edit_stats_t stats;
+
+			check(eqoi_stitch_dims(hdrs, 2, 2, &sw, &sh) == EQOI_OK && sw == w && sh == h, "stitch size");
+			check(eqoi_stitch((const unsigned char* const*)parts, hdrs, 2, 2, 2, out, cap, &ol, &stats) == EQOI_OK &&
+				ol == len && !memcmp(out, file, len), "stitch equals a re-encode of the whole image");
+			check(sp != 0 || stats.reencoded == 0, "aligned stitch copies every tile");
+			check(eqoi_stitch_dims(hdrs, 4, 1, &sw, &sh) == EQOI_ERR_ARG, "inconsistent grid is rejected");
+
+			for (int q = 0; q < 4; q++) {
+				free(parts[q]);
+			}
+
+			free(out);
+		}
+
+		free(file);
+		free(pixels);
+	}
+}
+
+/*************************
+@test
+@private
+@brief  Ըļͷظʽֿߴһͼ(8λRGBҶ)
+@param  like յļͷ(ָ)
+		pixels (ָ)
+		img_w ͼ
+		img_h ͼ߶
+		dict ֵ(ָ, ΪNULLʱʹֵ)
+		len ļ(ָ)
+@return ļ(ָ, ɵͷ, ʧʱΪNULL)
+*************************/
+static unsigned char* encode_like(const eqoi_header_t* like, unsigned char* pixels, uint32_t img_w, uint32_t img_h,
+	const eqoi_dict_t* dict, size_t* len) {
+	if (like->pixel_fmt == EQOI_FMT_RGB8) {
+		return encode_rgb(pixels, img_w, img_h, like->tile_w, like->tile_h, like->codec, dict, len);
+	}
+
+	size_t cap = eqoi_max_file_size_gray(img_w, img_h, like->tile_w, like->tile_h, like->channels);
+	unsigned char* file = malloc(cap);
+
+	if (eqoi_encode_gray(pixels, img_w, img_h, like->channels, like->tile_w, like->tile_h, 2, file, cap, len) != EQOI_OK) {
+		free(file);
+		file = NULL;
+	}
+
+	check(file != NULL, "encode");
+
+	return file;
+}
+
+/*************************
+@test
+@private
+@brief  У: нMED(ֿ벻ֿ顢ֵ)ĵɫ塢Ҷ+͸ȡλBayerˡ
+		ģʽļһ; οͼסСĩһֽڲͬʱλӦҲ֮; οжȡ
+		ʧʱEQOI_ERR_IO; С; YUVܾ
+@return 
+*************************/
+static void test_verify(void) {
+	static const uint32_t tiles[][2] = { { 0, 0 }, { 256, 128 }, { 100, 38 } }; // Bayer˵ķֿߴΪż
+	const test_image_t* img = &images[3];
+	uint32_t w = img->width, h = img->height;
+	unsigned char* palette = synth_image(EQOI_SYNTH_UI, w, h, 11);
+	unsigned char* pga = malloc((size_t)w * h * 2);
+	uint16_t* pwide = malloc((size_t)w * h * 3 * sizeof(uint16_t));
+	eqoi_dict_t dict;
+
+	make_dict(&dict);
+	for (size_t p = 0; p < (size_t)w * h; p++) {
+		pga[p * 2] = img->prgb[p * 3 + 1];
+		pga[p * 2 + 1] = (unsigned char)(p % w < w / 2 ? 255 : p / w);
+		for (int c = 0; c < 3; c++) {
+			pwide[p * 3 + c] = (uint16_t)(img->prgb[p * 3 + c] << 4 | (p + c) % 16);
+		}
+	}
+
+	// 0 MED, 1 MED+ֵ, 2 ɫ, 3 Ҷ+͸, 4 12λ, 5 Bayer, 6 ģʽ
+	for (int kind = 0; kind < 7; kind++) {
+		for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+			size_t cap = eqoi_max_file_size_wide(w, h, tiles[t][0], tiles[t][1], 16), len = 0;
+			unsigned char* file = malloc(cap);
+			const eqoi_dict_t* pdict = kind == 1 ? &dict : NULL;
+			int err;
+
+			if (kind <= 2 || kind == 6) {
+				err = eqoi_encode_codec(kind == 2 ? palette : img->prgb, w, h, tiles[t][0], tiles[t][1], 2,
+					kind == 2 ? EQOI_CODEC_PALETTE : kind == 6 ? EQOI_CODEC_PROGRESSIVE : EQOI_CODEC_MED, pdict, file, cap, &len);
+			}
+			else if (kind == 3) {
+				err = eqoi_encode_gray(pga, w, h, 2, tiles[t][0], tiles[t][1], 2, file, cap, &len);
+			}
+			else if (kind == 4) {
+				err = eqoi_encode_wide(pwide, w, h, 12, tiles[t][0], tiles[t][1], 2, file, cap, &len);
+			}
+			else {
+				err = eqoi_encode_cfa(pga, w, h, EQOI_FMT_BAYER_RGGB, tiles[t][0], tiles[t][1], 2, file, cap, &len);
+			}
+
+			check(err == EQOI_OK, "encode");
+
+			eqoi_header_t hdr;
+			unsigned char* ref = err == EQOI_OK ? decode_file(file, len, pdict, &hdr) : NULL;
+
+			if (ref == NULL) {
+				free(file);
+				continue;
+			}
+
+			size_t ps = eqoi_pixel_size(&hdr), row_len = (size_t)w * ps, n = row_len * h;
+			_Bool row_by_row = hdr.pixel_fmt == EQOI_FMT_RGB8 && hdr.codec == EQOI_CODEC_MED;
+			verify_ref_t vr = { ref, row_len, 0, UINT32_MAX, 1 };
+			eqoi_verify_result_t res;
+
+			check(eqoi_verify_buf_size(&hdr) == (row_by_row ? row_len * 2 : row_len * hdr.tile_h), "buffer size");
+			check(eqoi_verify_rows(file, &hdr, verify_row, &vr, &res) == EQOI_OK && res.match && res.rows == h &&
+				vr.next == h && vr.in_order, "matching reference");
+
+			for (int k = 0; k < 3; k++) {
+				size_t pos = k == 0 ? 0 : k == 1 ? n / 2 + 1 : n - 1;
+				uint32_t y = (uint32_t)(pos / row_len);
+
+				ref[pos] ^= 0x04;
+				vr.next = 0;
+				check(eqoi_verify_rows(file, &hdr, verify_row, &vr, &res) == EQOI_OK && !res.match && res.y == y &&
+					res.x == pos % row_len / ps && vr.next == y + 1 && vr.in_order, "mismatch is located");
+				ref[pos] ^= 0x04;
+			}
+
+			vr.next = 0;
+			vr.fail_at = h / 2;
+			check(eqoi_verify_rows(file, &hdr, verify_row, &vr, &res) == EQOI_ERR_IO, "reference read failure");
+
+			free(ref);
+			free(file);
+		}
+	}
+
+	// YUV֧У
+	eqoi_yuv_t yuv;
+	size_t yuv_len = eqoi_yuv_layout(NULL, 64, 32, 2, 1, &yuv);
+	unsigned char* buf = malloc(yuv_len);
+	size_t cap = eqoi_max_file_size_yuv(64, 32, 0, 0, EQOI_FMT_YUV420), len;
+	unsigned char* file = malloc(cap);
+	eqoi_header_t hdr;
+	verify_ref_t vr = { buf, 64, 0, UINT32_MAX, 1 };
+	eqoi_verify_result_t res;
+
+	eqoi_yuv_layout(buf, 64, 32, 2, 1, &yuv);
+	memset(buf, 0x80, yuv_len);
+	check(eqoi_encode_yuv(&yuv, 64, 32, EQOI_FMT_YUV420, 0, 0, 1, file, cap, &len) == EQOI_OK &&
+		eqoi_parse_header(file, len, &hdr) == EQOI_OK &&
+		eqoi_verify_rows(file, &hdr, verify_row, &vr, &res) == EQOI_ERR_ARG, "YUV is rejected");
+
+	free(file);
+	free(buf);
+	free(pwide);
+	free(pga);
+	free(palette);
+}
+
+/*************************
+@test
+@private
+@brief  ṩУĲο(¼Ƿ)
+@param  ctx οͼ(ָ)
+		y к
+@return ο(ָ, fail_atзNULL)
+*************************/
+static const unsigned char* verify_row(void* ctx, uint32_t y) {
+	verify_ref_t* ref = ctx;
+
+	ref->in_order &= y == ref->next;
+	ref->next = y + 1;
+
+	return y == ref->fail_at ? NULL : ref->pixels + y * ref->row_len;
+}